@@ -84,6 +84,7 @@ SET( LifeV_TPLS_FINDMODS_CLASSIFICATIONS
   ParMETIS        "cmake/TPLs/"    PS
   HDF5            "cmake/TPLs/"    PS
   QHull           "cmake/TPLs/"    SS
+  Zlib            "cmake/TPLs/"    SS
   Trilinos        "cmake/TPLs/"    PS
   )
 
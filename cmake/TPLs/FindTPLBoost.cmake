@@ -62,15 +62,11 @@ TRIBITS_TPL_DECLARE_LIBRARIES( Boost
 set(BOOST_INCLUDEDIR ${TPL_Boost_INCLUDE_DIRS})
 
 find_package (Boost REQUIRED)
-set (HAVE_BOOST_SPIRIT_QI FALSE)
 if (Boost_FOUND)
     set (HAVE_BOOST_VERSION ${Boost_VERSION})
     if (Boost_MINOR_VERSION GREATER 39)
         set (HAVE_BOOST_GT_1_39 TRUE)
     endif(Boost_MINOR_VERSION GREATER 39)
-    if (Boost_MINOR_VERSION GREATER 40)
-        set (HAVE_BOOST_SPIRIT_QI TRUE)
-    endif(Boost_MINOR_VERSION GREATER 40)
 endif()
 
 # This broke trilinos configuration:
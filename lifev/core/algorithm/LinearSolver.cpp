@@ -101,6 +101,20 @@ LinearSolver::~LinearSolver()
 Int
 LinearSolver::solve ( vectorPtr_Type solutionPtr )
 {
+    if ( M_rhs.get() == 0 )
+    {
+        M_displayer->leaderPrint ( "SLV-  ERROR: LinearSolver failed to set up correctly!\n" );
+        return -1;
+    }
+
+    return solve ( M_rhs->epetraVector(), solutionPtr->epetraVector() );
+}
+
+Int
+LinearSolver::solve ( const multiVector_Type& rhs, multiVector_Type& solution )
+{
+    ASSERT ( rhs.NumVectors() == solution.NumVectors(), "LinearSolver::solve: the right hand side and the solution must have the same number of vectors" );
+
     // Build preconditioners if needed
     bool retry ( true );
     if ( !isPreconditionerSet() || !M_reusePreconditioner  )
@@ -118,7 +132,7 @@ LinearSolver::solve ( vectorPtr_Type solutionPtr )
         }
     }
 
-    if ( M_rhs.get() == 0 || M_operator == 0 )
+    if ( M_operator == 0 )
     {
         M_displayer->leaderPrint ( "SLV-  ERROR: LinearSolver failed to set up correctly!\n" );
         return -1;
@@ -136,7 +150,7 @@ LinearSolver::solve ( vectorPtr_Type solutionPtr )
     WallClock chrono;
     chrono.start();
 
-    M_solverOperator->ApplyInverse ( M_rhs->epetraVector(), solutionPtr->epetraVector() );
+    M_solverOperator->ApplyInverse ( rhs, solution );
     M_converged         = M_solverOperator->hasConverged();
     M_lossOfPrecision   = M_solverOperator->isLossOfAccuracyDetected();
     chrono.stop();
@@ -162,7 +176,7 @@ LinearSolver::solve ( vectorPtr_Type solutionPtr )
 
         // Solving again, but only once (retry = false)
         chrono.start();
-        M_solverOperator->ApplyInverse ( M_rhs->epetraVector(), solutionPtr->epetraVector() );
+        M_solverOperator->ApplyInverse ( rhs, solution );
         M_converged         = M_solverOperator->hasConverged();
         M_lossOfPrecision   = M_solverOperator->isLossOfAccuracyDetected();
         chrono.stop();
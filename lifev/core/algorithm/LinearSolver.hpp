@@ -150,6 +150,21 @@ public:
      */
     Int solve ( vectorPtr_Type solutionPtr );
 
+    //! Solves the system for several right hand sides and returns the number of iterations.
+    /*!
+      The Matrix has already been passed by the method
+      setMatrix or setOperator; the right hand side set with setRightHandSide is ignored.
+
+      All the columns share the same preconditioner. With a Belos block solver manager
+      (e.g., "Solver Manager Type" = "BlockGmres" or "BlockCG", with the "Block Size" of the
+      Belos list equal to the number of columns) they are solved together in a single block
+      Krylov space; with AztecOO they are solved one after the other.
+      @param rhs Right hand sides, one for each column
+      @param solution Multivector to store the solutions (also used as initial guesses)
+      @return Number of iterations, M_maxIter+1 if solve failed.
+     */
+    Int solve ( const multiVector_Type& rhs, multiVector_Type& solution );
+
     //! Compute the residual
     /*!
       @param solutionPtr Shared pointer on the solution of the system
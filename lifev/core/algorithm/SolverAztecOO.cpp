@@ -250,6 +250,78 @@ Int SolverAztecOO::solveSystem ( const vector_type& rhsFull,
     return numIter;
 }
 
+Int SolverAztecOO::solveSystem ( const std::vector<vector_ptrtype>& rhsFull,
+                                 std::vector<vector_ptrtype>&       solution,
+                                 matrix_ptrtype&                    baseMatrixForPreconditioner )
+{
+    ASSERT ( rhsFull.size() == solution.size(), "SolverAztecOO::solveSystem: the number of right hand sides and solutions differs" );
+
+    bool retry ( true );
+
+    LifeChrono chrono;
+
+    M_displayer->leaderPrint ( "SLV-  Setting up the solver ...                \n" );
+
+    if ( baseMatrixForPreconditioner.get() == 0 )
+    {
+        M_displayer->leaderPrint ( "SLV-  Warning: baseMatrixForPreconditioner is empty     \n" );
+    }
+
+    if ( !isPreconditionerSet() || !M_reusePreconditioner  )
+    {
+        buildPreconditioner ( baseMatrixForPreconditioner );
+        // do not retry if I am recomputing the preconditioner
+        retry = false;
+    }
+    else
+    {
+        M_displayer->leaderPrint ( "SLV-  Reusing precond ...                 \n" );
+    }
+
+    Int totalIter ( 0 );
+    Int maxIter ( 0 );
+    bool failure ( false );
+    for ( UInt i ( 0 ); i < rhsFull.size(); ++i )
+    {
+        Int numIter = solveSystem ( *rhsFull[i], *solution[i], M_preconditioner );
+
+        // If we do not want to retry, go on with the next right hand side.
+        // Otherwise rebuild the preconditioner, solve again and use it for the next ones:
+        if ( numIter < 0  && retry )
+        {
+            chrono.start();
+
+            M_displayer->leaderPrint ( "SLV-  Iterative solver failed, numiter = " , - numIter );
+            M_displayer->leaderPrint ( "SLV-  maxIterSolver = " , M_maxIter );
+            M_displayer->leaderPrint ( "SLV-  retrying:          " );
+
+            buildPreconditioner ( baseMatrixForPreconditioner );
+
+            chrono.stop();
+            M_displayer->leaderPrintMax ( "done in " , chrono.diff() );
+            // Solving again, but only once (retry = false)
+            numIter = solveSystem ( *rhsFull[i], *solution[i], M_preconditioner );
+            retry = false;
+
+            if ( numIter < 0 )
+            {
+                M_displayer->leaderPrint ( " ERROR: Iterative solver failed again.\n" );
+            }
+        }
+
+        failure = failure || numIter < 0;
+        totalIter += std::abs ( numIter );
+        maxIter = std::max ( maxIter, std::abs ( numIter ) );
+    }
+
+    if ( maxIter > M_maxIterForReuse )
+    {
+        resetPreconditioner();
+    }
+
+    return failure ? -totalIter : totalIter;
+}
+
 void SolverAztecOO::setupPreconditioner ( const GetPot& dataFile,  const std::string& section )
 {
     std::string precType = dataFile ( (section + "/prectype").data(), "Ifpack" );
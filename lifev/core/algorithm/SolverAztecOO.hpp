@@ -150,6 +150,24 @@ public:
                       vector_type&       solution,
                       matrix_ptrtype&    baseMatrixForPreconditioner );
 
+    //! Solves the system for several right hand sides and returns the total number of iterations.
+    /*!
+      The Matrix has already been passed by the method
+      setMatrix or setOperator
+
+      The preconditioner is built (or reused) once, as in the single right hand side
+      version, and then shared by all the solves. AztecOO has no block Krylov method,
+      therefore the right hand sides are solved one after the other.
+      @param  rhsFull Right hand sides
+      @param  solution Vectors to store the solutions (one for each right hand side)
+      @param  baseMatrixForPreconditioner Base matrix for the preconditioner construction
+      @return total number of iterations. If negative, the solver did not converge for at least
+               one right hand side, even after the preconditioner has been recomputed
+    */
+    Int solveSystem ( const std::vector<vector_ptrtype>& rhsFull,
+                      std::vector<vector_ptrtype>&       solution,
+                      matrix_ptrtype&                    baseMatrixForPreconditioner );
+
     //! Solves the system and returns the number of iterations.
     /*!
       The Matrix has already been passed by the method
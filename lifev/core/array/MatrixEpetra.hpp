@@ -45,6 +45,9 @@
 #include <Epetra_MpiComm.h>
 #include <Epetra_FECrsMatrix.h>
 #include <Epetra_FECrsGraph.h>
+#include <Epetra_Vector.h>
+#include <Epetra_Export.h>
+#include <Epetra_Import.h>
 #include <EpetraExt_MatrixMatrix.h>
 #include <EpetraExt_Transpose_RowMatrix.h>
 #include <EpetraExt_RowMatrixOut.h>
@@ -261,6 +264,8 @@ public:
 
     //! Set entries (rVec(i),rVec(i)) to coefficient and the rest of the row entries to zero
     /*!
+      The rows listed by a process do not need to be owned by it: they are sent to
+      their owner, see diagonalizeRows.
       @param rVec Vector of the Id that should be set to "coefficient"
       @param coefficient Value to be set on the diagonal
       @param offset Offset used for the indices
@@ -277,6 +282,8 @@ public:
 
     //! apply constraint on all rows rVec
     /*!
+      The rows listed by a process do not need to be owned by it: they are sent to
+      their owner, see diagonalizeRows.
       @param rVec vector of rows
       @param coefficient Value to set entry (r,r) at
       @param rhs Right hand side Vector of the system to be adapted accordingly
@@ -599,6 +606,30 @@ public:
     //@}
 private:
 
+    //! @name Private Methods
+    //@{
+
+    //! Diagonalize the rows listed by the processes, each process working only on its own rows
+    /*!
+      The listed rows (and the data) are sent to their owners with an Epetra_Export, so
+      that only the processes sharing rows communicate. Each process then zeroes its own
+      rows and sets the diagonal entries to coefficient. When EPETRAMATRIX_SYMMETRIC_DIAGONALIZE
+      is defined, the columns of the rows are also zeroed: the rows are imported on the column
+      map and the right hand side (if any) is lifted accordingly.
+      @param rVec Rows to be diagonalized (without offset)
+      @param coefficient Value to be set on the diagonal
+      @param rhs Pointer to the right hand side to be adapted, can be null
+      @param datumVec Pointer to the values of the solution on the rows, null if rhs is null
+      @param offset Offset used for the indices
+     */
+    void diagonalizeRows ( const std::vector<UInt>& rVec,
+                           DataType const coefficient,
+                           vector_type* rhs,
+                           const std::vector<DataType>* datumVec,
+                           UInt offset );
+
+    //@}
+
 
     // Shared pointer on the row MapEpetra used in the assembling
     boost::shared_ptr< MapEpetra > M_map;
@@ -953,52 +984,7 @@ boost::shared_ptr<MatrixEpetra<DataType> > MatrixEpetra<DataType>::transpose( )
 template <typename DataType>
 void MatrixEpetra<DataType>::diagonalize ( std::vector<UInt> rVec, DataType const coefficient, UInt offset )
 {
-
-    const Epetra_Comm&  Comm ( M_epetraCrs->Comm() );
-    Int numProcs ( Comm.NumProc() );
-    Int MyPID   ( Comm.MyPID() );
-    Int i;
-
-
-    // Note: Epetra_Comm::broadcast does not support passing of uint, hence
-    //       I define an int pointer to make the broadcast but then come back to an
-    //       UInt pointer to insert the data
-    Int*  r;
-    UInt* Ur;
-
-
-    // loop on all proc
-    for ( Int p (0); p < numProcs; p++ )
-    {
-        Int sizeVec ( rVec.size() );
-
-        Comm.Broadcast ( &sizeVec, 1, p );
-
-        if ( p == MyPID )
-        {
-            Ur = &rVec.front();
-        }
-        else
-        {
-            Ur = new UInt[sizeVec];
-        }
-
-        r = (Int*) Ur;
-
-        Comm.Broadcast ( r, sizeVec, p );
-
-        for ( i = 0; i < sizeVec; i++ )
-        {
-            diagonalize ( Ur[i], coefficient, offset );
-        }
-
-        if ( p != MyPID )
-        {
-            delete[] Ur;
-        }
-
-    }
-
+    diagonalizeRows ( rVec, coefficient, 0, 0, offset );
 }
 
 template <typename DataType>
@@ -1048,194 +1034,13 @@ void MatrixEpetra<DataType>::diagonalize ( std::vector<UInt> rVec,
                                            std::vector<DataType> datumVec,
                                            UInt offset )
 {
-
-
-    const Epetra_Comm&  Comm ( M_epetraCrs->Comm() );
-    Int numProcs ( Comm.NumProc() );
-    Int MyPID   ( Comm.MyPID() );
-    Int i;
-
-    // Note: Epetra_Comm::broadcast does not support passing of uint, hence
-    //       I define an int pointer to make the broadcast but then come back to an
-    //       UInt pointer to insert the data
-    Int*     r;
-    UInt*    Ur;
-    DataType* datum;
-
-#if 1
-    // 2 arrays to store le local and remote IDs
-
-    Int me = Comm.MyPID();
-
-    std::vector<Int> localIDs;
-    std::vector<Int> remoteIDs;
-
-    std::vector<Real> localData;
-    std::vector<Real> remoteData;
-
-    std::map<Int, Real>           localBC;
-    std::map<Int, Real>::iterator im;
-
-    const Epetra_Map& rowMap ( M_epetraCrs->RowMap() );
-
-
-    //Comm.Barrier();
-    // we want to know which IDs are our or not
-
-    for ( Int ii = 0; ii < (Int) rVec.size(); ++ii )
+    if ( rVec.size() != datumVec.size() )
     {
-        Int lID = rowMap.LID ( static_cast<EpetraInt_Type> (rVec[ii]) );
-        if ( ! ( lID < 0 ) )
-        {
-
-            localIDs.push_back ( rVec[ii] );
-            localData.push_back ( datumVec[ii] );
-            localBC.insert ( std::pair<Int, Real> ( rVec[ii], datumVec[ii] ) );
-        }
-        else
-        {
-            remoteIDs.push_back ( rVec[ii] );
-            remoteData.push_back ( datumVec[ii] );
-        }
-    }
-
-    // now, we have to fill our localIDs with IDs from other processors
-    // first, we have to build the map of all the remoteIDs and their processor owner
-
-
-    Int numIDs = remoteIDs.size();
-
-    Int* PIDList = new Int[numIDs];
-    Int* LIDList = new Int[numIDs];
-
-    rowMap.RemoteIDList ( numIDs,
-                          &remoteIDs[0],
-                          PIDList,
-                          LIDList );
-
-    std::vector< std::vector<Int> > procToID  ( Comm.NumProc() );
-    std::vector< std::vector<Real> > procToData ( Comm.NumProc() );
-
-    for ( Int ii = 0; ii < numIDs; ++ii )
-    {
-        Int pi = PIDList[ii];
-        procToID[pi].push_back ( remoteIDs[ii] );
-        procToData[pi].push_back ( remoteData[ii] );
-    }
-
-    // then, we send all the nodes where they belong
-
-    const Epetra_MpiComm* comm = dynamic_cast<Epetra_MpiComm const*> ( &Comm );
-
-    assert ( comm != 0 );
-
-    for ( Int ii = 0; ii < (Int) procToID.size(); ++ii )
-    {
-        if ( ii != me )
-        {
-            Int length;
-            length = procToID[ii].size();
-            MPI_Send ( &length, 1, MPI_INT, ii, 666, comm->Comm() );
-            if ( length > 0 )
-            {
-                MPI_Send ( &procToID[ii][0], length, MPI_INT, ii, 667, comm->Comm() );
-                MPI_Send ( &procToData[ii][0], length, MPI_DOUBLE, ii, 668, comm->Comm() );
-            }
-        }
-
-    }
-
-    for ( Int ii = 0; ii < (Int) procToID.size(); ++ii )
-    {
-        if ( ii != me )
-        {
-            Int length;
-            MPI_Status status;
-            MPI_Recv ( &length, 1, MPI_INT, ii, 666, comm->Comm(), &status );
-
-
-            if ( length > 0 )
-            {
-                Int* bufferID = new Int[length];
-                Int* ptrID (0); //    = new Int[length];
-
-                MPI_Recv ( bufferID, length, MPI_INT, ii, 667, comm->Comm(), &status );
-
-                ptrID = bufferID;
-
-                Real* bufferData = new Real[length];
-                Real* ptrData (0);
-
-                MPI_Recv ( bufferData, length, MPI_DOUBLE, ii, 668, comm->Comm(), &status );
-                ptrData = bufferData;
-
-                for ( Int ii = 0; ii < length; ++ii, ++ptrID, ++ptrData )
-                {
-                    localBC.insert ( std::pair<Int, Real>
-                                     ( *ptrID, *ptrData ) );
-                }
-
-                delete[] bufferID;
-                delete[] bufferData;
-
-            }
-
-        }
-    }
-
-    delete[] PIDList;
-    delete[] LIDList;
-
-    for ( im = localBC.begin(); im != localBC.end(); ++im )
-    {
-        diagonalize ( im->first, coefficient, rhs, im->second, offset );
-    }
-
-    return;
-#endif
-
-
-    // loop on all proc
-    for ( Int p (0); p < numProcs; p++ )
-    {
-        Int sizeVec (rVec.size() );
-        if ( sizeVec != Int (datumVec.size() ) )
-        {
-            // vectors must be of the same size
-            ERROR_MSG ( "diagonalize: vectors must be of the same size\n" );
-        }
-
-        Comm.Broadcast ( &sizeVec, 1, p );
-
-        if ( p == MyPID )
-        {
-            Ur    =  &rVec.front();
-            datum = &datumVec.front();
-        }
-        else
-        {
-            Ur    = new UInt    [sizeVec];
-            datum = new DataType[sizeVec];
-        }
-
-        r = (Int*) Ur;
-
-        Comm.Broadcast ( r,    sizeVec, p );
-        Comm.Broadcast ( datum, sizeVec, p );
-
-        for ( i = 0; i < sizeVec; i++ )
-        {
-            diagonalize ( Ur[i], coefficient, rhs, datum[i], offset );
-        }
-
-        if ( p != MyPID )
-        {
-            delete[] Ur;
-            delete[] datum;
-        }
-
+        // vectors must be of the same size
+        ERROR_MSG ( "diagonalize: vectors must be of the same size\n" );
     }
 
+    diagonalizeRows ( rVec, coefficient, &rhs, &datumVec, offset );
 }
 
 template <typename DataType>
@@ -1296,6 +1101,130 @@ void MatrixEpetra<DataType>::diagonalize ( UInt const row,
 
 }
 
+// ===================================================
+// Private Methods
+// ===================================================
+
+template <typename DataType>
+void MatrixEpetra<DataType>::diagonalizeRows ( const std::vector<UInt>& rVec,
+                                               DataType const coefficient,
+                                               vector_type* rhs,
+                                               const std::vector<DataType>* datumVec,
+                                               UInt offset )
+{
+    if ( !M_epetraCrs->Filled() )
+    {
+        // if not filled, I do not know how to diagonalize.
+        ERROR_MSG ( "if not filled, I do not know how to diagonalize\n" );
+    }
+
+    const Epetra_Map& rowMap ( M_epetraCrs->RowMap() );
+    const Epetra_Map& colMap ( M_epetraCrs->ColMap() );
+
+    // Rows listed by this process, without duplicates (the map must be 1-1 on each process)
+    std::map<EpetraInt_Type, Real> listedBC;
+    for ( UInt i (0); i < rVec.size(); ++i )
+    {
+        listedBC[ static_cast<EpetraInt_Type> ( rVec[i] + offset ) ] = ( datumVec ? (*datumVec) [i] : 0. );
+    }
+
+    std::vector<EpetraInt_Type> listedRows;
+    listedRows.reserve ( listedBC.size() );
+    for ( std::map<EpetraInt_Type, Real>::const_iterator it = listedBC.begin(); it != listedBC.end(); ++it )
+    {
+        listedRows.push_back ( it->first );
+    }
+
+    // A row can be listed by several processes, hence the map is not 1-1
+    Epetra_Map listedMap ( -1, listedRows.size(), listedRows.empty() ? 0 : &listedRows[0],
+                           rowMap.IndexBase(), rowMap.Comm() );
+
+    Epetra_Vector listedMarker ( listedMap );
+    Epetra_Vector listedData   ( listedMap );
+    Int lid (0);
+    for ( std::map<EpetraInt_Type, Real>::const_iterator it = listedBC.begin(); it != listedBC.end(); ++it, ++lid )
+    {
+        listedMarker[lid] = 1.;
+        listedData[lid]   = it->second;
+    }
+
+    // Send the rows to their owners
+    Epetra_Export exporter ( listedMap, rowMap );
+
+    Epetra_Vector rowMarker ( rowMap );
+    Epetra_Vector rowData   ( rowMap );
+    rowMarker.Export ( listedMarker, exporter, Insert );
+    if ( rhs )
+    {
+        rowData.Export ( listedData, exporter, Insert );
+    }
+
+    Int    numEntries;
+    Real*  values;
+    Int*   indices;
+
+#ifdef EPETRAMATRIX_SYMMETRIC_DIAGONALIZE
+    // Columns of the diagonalized rows, through the column map of the matrix
+    Epetra_Vector colMarker ( colMap );
+    Epetra_Vector colData   ( colMap );
+    Epetra_Import importer ( colMap, rowMap );
+    colMarker.Import ( rowMarker, importer, Insert );
+    if ( rhs )
+    {
+        colData.Import ( rowData, importer, Insert );
+    }
+
+    for ( Int myRow (0); myRow < rowMap.NumMyElements(); ++myRow )
+    {
+        if ( rowMarker[myRow] != 0. )
+        {
+            continue;
+        }
+
+        M_epetraCrs->ExtractMyRowView ( myRow, numEntries, values, indices );
+
+        for ( Int i (0); i < numEntries; ++i )
+        {
+            if ( colMarker[ indices[i] ] != 0. )
+            {
+                if ( rhs )
+                {
+                    (*rhs) [ rowMap.GID ( myRow ) ] -= values[i] * colData[ indices[i] ];
+                }
+                values[i] = 0.;
+            }
+        }
+    }
+#endif
+
+    // Rows: each process zeroes out its own rows
+    for ( Int myRow (0); myRow < rowMap.NumMyElements(); ++myRow )
+    {
+        if ( rowMarker[myRow] == 0. )
+        {
+            continue;
+        }
+
+        const EpetraInt_Type row ( rowMap.GID ( myRow ) );
+        Int myCol = colMap.LID ( row );
+
+        M_epetraCrs->ExtractMyRowView ( myRow, numEntries, values, indices );
+
+        for ( Int i (0); i < numEntries; ++i )
+        {
+            values[i] = 0.;
+        }
+
+        DataType coeff ( coefficient );
+        M_epetraCrs->ReplaceMyValues ( myRow, 1, &coeff, &myCol ); // A(r,r) = coefficient
+
+        if ( rhs )
+        {
+            (*rhs) [row] = coefficient * rowData[myRow]; // correct right hand side for row r
+        }
+    }
+}
+
 template <typename DataType>
 void MatrixEpetra<DataType>::matrixMarket ( std::string const& fileName, const bool headers )
 {
@@ -1061,6 +1061,38 @@ VectorEpetra::size() const
     return 0;
 }
 
+VectorEpetra::localView_Type
+VectorEpetra::localView()
+{
+    data_type* data ( 0 );
+    Int leadingDimension ( 0 );
+    M_epetraVector->ExtractView ( &data, &leadingDimension );
+
+    return localView_Type ( data, blockMap().MyGlobalElements(), M_epetraVector->MyLength() );
+}
+
+VectorEpetra::constLocalView_Type
+VectorEpetra::localView() const
+{
+    data_type* data ( 0 );
+    Int leadingDimension ( 0 );
+    M_epetraVector->ExtractView ( &data, &leadingDimension );
+
+    return constLocalView_Type ( data, blockMap().MyGlobalElements(), M_epetraVector->MyLength() );
+}
+
+VectorEpetra::localView_Type
+VectorEpetra::componentView ( const UInt& component, const UInt& numberOfComponents )
+{
+    return localView().component ( component, numberOfComponents );
+}
+
+VectorEpetra::constLocalView_Type
+VectorEpetra::componentView ( const UInt& component, const UInt& numberOfComponents ) const
+{
+    return localView().component ( component, numberOfComponents );
+}
+
 // ===================================================
 // Private Methods
 // ===================================================
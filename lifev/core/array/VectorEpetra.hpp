@@ -47,6 +47,7 @@
 
 #include <lifev/core/LifeV.hpp>
 #include <lifev/core/array/MapEpetra.hpp>
+#include <lifev/core/array/VectorEpetraLocalView.hpp>
 
 namespace LifeV
 {
@@ -70,6 +71,8 @@ public:
     typedef boost::shared_ptr< vector_type > vectorPtr_Type;
     typedef Real                             data_type;
     typedef Epetra_CombineMode               combineMode_Type;
+    typedef VectorEpetraLocalView<data_type>       localView_Type;
+    typedef VectorEpetraLocalView<const data_type> constLocalView_Type;
 
     //@}
 
@@ -763,6 +766,26 @@ public:
     //! Return the size of the vector
     Int size() const;
 
+    //! Return a view on the local entries of the vector
+    /*!
+      The entries of the view are accessed through their local index, without
+      any lookup in the map: use it for loops over the local entries.
+     */
+    localView_Type localView();
+
+    //! Return a read-only view on the local entries of the vector
+    constLocalView_Type localView() const;
+
+    //! Return a view on the local entries of one component of a vectorial field
+    /*!
+      @param component Index of the component
+      @param numberOfComponents Number of components of the field
+     */
+    localView_Type componentView ( const UInt& component, const UInt& numberOfComponents );
+
+    //! Return a read-only view on the local entries of one component of a vectorial field
+    constLocalView_Type componentView ( const UInt& component, const UInt& numberOfComponents ) const;
+
     //@}
 
 private:
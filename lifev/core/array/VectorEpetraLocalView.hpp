@@ -0,0 +1,194 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief This file contains the VectorEpetraLocalView class
+
+    @date 10-2026
+ */
+
+#ifndef _VECTOREPETRALOCALVIEW_HPP_
+#define _VECTOREPETRALOCALVIEW_HPP_ 1
+
+#include <lifev/core/LifeV.hpp>
+
+namespace LifeV
+{
+
+//! VectorEpetraLocalView - A view on the local entries of a VectorEpetra
+/*!
+    The view is a typed span over the local data of the vector (as
+    returned by Epetra ExtractView), which is accessed through the local
+    index of the entries. It does not own the data: it is valid as long as
+    the viewed vector exists and its map is not changed.
+
+    Local access avoids the lookup of the global index in the map that is
+    done by VectorEpetra::operator[], hence loops over the local entries
+    should use a view. The global index of a local entry is still available
+    through globalId().
+
+    The DataType can be Real (read-write view) or const Real (read-only view).
+ */
+template <typename DataType>
+class VectorEpetraLocalView
+{
+public:
+
+    //! @name Public Types
+    //@{
+
+    typedef DataType  value_Type;
+    typedef DataType* iterator_Type;
+
+    //@}
+
+
+    //! @name Constructors & Destructor
+    //@{
+
+    //! Empty constructor
+    VectorEpetraLocalView() :
+        M_data ( 0 ),
+        M_globalIds ( 0 ),
+        M_size ( 0 )
+    {}
+
+    //! Constructor
+    /*!
+      @param data Pointer to the first local entry of the view
+      @param globalIds Pointer to the global index of the first local entry of the view
+      @param size Number of entries of the view
+     */
+    VectorEpetraLocalView ( DataType* data, const EpetraInt_Type* globalIds, const UInt& size ) :
+        M_data ( data ),
+        M_globalIds ( globalIds ),
+        M_size ( size )
+    {}
+
+    //! Conversion from a read-write to a read-only view
+    template <typename OtherDataType>
+    VectorEpetraLocalView ( const VectorEpetraLocalView<OtherDataType>& view ) :
+        M_data ( view.data() ),
+        M_globalIds ( view.globalIds() ),
+        M_size ( view.size() )
+    {}
+
+    //@}
+
+
+    //! @name Operators
+    //@{
+
+    //! Access to the entry with the given local index
+    DataType& operator[] ( const UInt& localId ) const
+    {
+        ASSERT_PRE ( localId < M_size, "VectorEpetraLocalView: local index out of range" );
+        return M_data[localId];
+    }
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! View on the entries [first, first + size) of this view
+    VectorEpetraLocalView block ( const UInt& first, const UInt& size ) const
+    {
+        ASSERT_PRE ( first + size <= M_size, "VectorEpetraLocalView: block out of range" );
+        return VectorEpetraLocalView ( M_data + first, M_globalIds + first, size );
+    }
+
+    //! View on one component of a vectorial field
+    /*!
+      The local entries of a vectorial field are stored by component
+      (see FESpace::createMap), thus each component is a contiguous block.
+      @param component Index of the component
+      @param numberOfComponents Number of components of the field
+     */
+    VectorEpetraLocalView component ( const UInt& component, const UInt& numberOfComponents ) const
+    {
+        ASSERT_PRE ( M_size % numberOfComponents == 0, "VectorEpetraLocalView: the size is not a multiple of the number of components" );
+        const UInt componentSize ( M_size / numberOfComponents );
+        return block ( component * componentSize, componentSize );
+    }
+
+    //! Global index of the entry with the given local index
+    EpetraInt_Type globalId ( const UInt& localId ) const
+    {
+        ASSERT_PRE ( localId < M_size, "VectorEpetraLocalView: local index out of range" );
+        return M_globalIds[localId];
+    }
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! Number of entries of the view
+    UInt size() const
+    {
+        return M_size;
+    }
+
+    //! Pointer to the first entry of the view
+    DataType* data() const
+    {
+        return M_data;
+    }
+
+    //! Pointer to the global index of the first entry of the view
+    const EpetraInt_Type* globalIds() const
+    {
+        return M_globalIds;
+    }
+
+    //! Iterator to the first entry of the view
+    iterator_Type begin() const
+    {
+        return M_data;
+    }
+
+    //! Iterator past the last entry of the view
+    iterator_Type end() const
+    {
+        return M_data + M_size;
+    }
+
+    //@}
+
+private:
+
+    DataType*             M_data;
+    const EpetraInt_Type* M_globalIds;
+    UInt                  M_size;
+};
+
+} // namespace LifeV
+
+#endif // _VECTOREPETRALOCALVIEW_HPP_
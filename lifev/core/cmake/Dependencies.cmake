@@ -3,6 +3,6 @@ SET(LIB_OPTIONAL_DEP_PACKAGES)
 SET(TEST_REQUIRED_DEP_PACKAGES)
 SET(TEST_OPTIONAL_DEP_PACKAGES)
 SET(LIB_REQUIRED_DEP_TPLS BLAS LAPACK Trilinos ParMETIS Boost MPI)
-SET(LIB_OPTIONAL_DEP_TPLS QHull HDF5)
+SET(LIB_OPTIONAL_DEP_TPLS QHull HDF5 Zlib)
 SET(TEST_REQUIRED_DEP_TPLS)
 SET(TEST_OPTIONAL_DEP_TPLS)
@@ -44,6 +44,9 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include <Epetra_MultiVector.h>
+#include <Epetra_Vector.h>
+
 namespace LifeV
 {
 
@@ -166,33 +169,351 @@ VectorType ZZGradient (boost::shared_ptr<FESpaceType> fespace,
 }
 
 
-/*! Laplacian recovery following Zienkiewicz and Zhu.
+/*! Gradient recovery procedure from Zienkiewicz and Zhu, for all the directions at once.
+
+  The class computes the same recovered gradient as ZZGradient, but:
+  <ul>
+  <li> the patch areas, the element weights (measure times the derivatives of the basis
+       functions in the nodes) and the local indices of the dofs are computed once at
+       construction and reused by every call;
+  <li> all the components of the field and all the directions are recovered in a single
+       loop over the elements, with a single communication for all the directions.
+  </ul>
+  The cached data depend only on the mesh and on the finite element space: keep one
+  object per finite element space and reuse it for all the fields defined on it
+  (build a new one when the space changes: in debug mode a field defined on another
+  space is rejected).
+ */
+template<typename FESpaceType, typename VectorType>
+class ZZRecovery
+{
+public:
+
+    //! @name Public Types
+    //@{
+
+    typedef FESpaceType                      fespace_Type;
+    typedef boost::shared_ptr<fespace_Type>  fespacePtr_Type;
+    typedef VectorType                       vector_Type;
+    typedef typename fespace_Type::map_Type  map_Type;
+
+    //@}
+
+
+    //! @name Constructors & Destructor
+    //@{
+
+    //! Constructor: computes the patch areas and the element weights
+    explicit ZZRecovery (const fespacePtr_Type& fespace);
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! Recover the gradient of a field
+    /*!
+      @param inputData The vector of data (pass it as repeated if possible)
+      @param recoveredGradient On exit, recoveredGradient[dxi] is the recovered derivative in the direction dxi
+             of all the components of the field, as returned by ZZGradient (unique map)
+     */
+    void gradient (const vector_Type& inputData, std::vector<vector_Type>& recoveredGradient);
+
+    //! Recover the laplacian of a field, as done by ZZLaplacian
+    /*!
+      @param inputData The vector of data (pass it as repeated if possible)
+      @return recovered laplacian (unique map!)
+     */
+    vector_Type laplacian (const vector_Type& inputData);
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! The finite element space of the recovery
+    const fespacePtr_Type& fespacePtr() const
+    {
+        return M_fespace;
+    }
+
+    //! Number of directions of the recovered gradient
+    UInt numberOfDirections() const
+    {
+        return M_nbDirections;
+    }
+
+    //@}
+
+private:
+
+    //! Sum the patch contributions of the derivatives of the given repeated fields
+    /*!
+      If trace is true, only the derivative in the direction d of the field d is
+      computed and summed over d (as needed by the laplacian).
+     */
+    void recover (const Epetra_MultiVector& repeatedInput, Epetra_MultiVector& uniqueOutput, const bool trace);
+
+    fespacePtr_Type     M_fespace;
+    map_Type            M_map;
+
+    UInt                M_nbElements;
+    UInt                M_nbLocalDof;
+    UInt                M_fieldDim;
+    UInt                M_nbDirections;
+
+    //! measure * dphi (jDof, dxi, iDof), stored by [element][iDof][jDof][dxi]
+    std::vector<Real>   M_weights;
+
+    //! local id in the repeated map of the dofs, stored by [element][component][iDof]
+    std::vector<Int>    M_localIds;
+
+    //! inverse of the patch areas, on the local entries of the unique map
+    std::vector<Real>   M_inversePatchArea;
+};
 
-  @param fespace The finite element space describing the data
-  @param inputData The vector of data (pass it as repeated if possible)
-  @return recovered laplacian (unique map!)
 
- */
 template<typename FESpaceType, typename VectorType>
-VectorType ZZLaplacian (boost::shared_ptr<FESpaceType> fespace,
-                        const VectorType& inputData)
+ZZRecovery<FESpaceType, VectorType>::ZZRecovery (const fespacePtr_Type& fespace) :
+    M_fespace      ( fespace ),
+    M_map          ( fespace->map() ),
+    M_nbElements   ( fespace->mesh()->numElements() ),
+    M_nbLocalDof   ( fespace->dof().numLocalDof() ),
+    M_fieldDim     ( fespace->fieldDim() ),
+    M_nbDirections ( 0 )
+{
+    // Same reference area and interpolation rule used by ZZGradient
+    Real refElemArea (0);
+
+    switch ( fespace->refFE().shape() )
+    {
+        case TETRA:
+            refElemArea = 1.0 / 6.0;
+            break;
+        case PRISM:
+            refElemArea = 1.0 / 2.0;
+            break;
+        case HEXA:
+            refElemArea = 1.0;
+            break;
+        case QUAD:
+            refElemArea = 1.0;
+            break;
+        case TRIANGLE:
+            refElemArea = 1.0 / 2.0;
+            break;
+        case LINE:
+            refElemArea = 1.0;
+            break;
+        case POINT:
+            refElemArea = 1.0;
+            break;
+        default:
+            std::cerr << "ZZ Gradient Recovery: unknown shape! Aborting. " << std::endl;
+            std::abort();
+    }
+
+    QuadratureRule interpQuad;
+    interpQuad.setDimensionShape ( shapeDimension (fespace->refFE().shape() ) , fespace->refFE().shape() );
+
+    Real wQuad (refElemArea / fespace->refFE().nbDof() );
+
+    for (UInt iQuadPt (0); iQuadPt < fespace->refFE().nbDof(); ++ iQuadPt)
+    {
+        interpQuad.addPoint (QuadraturePoint ( fespace->refFE().xi (iQuadPt),
+                                               fespace->refFE().eta (iQuadPt),
+                                               fespace->refFE().zeta (iQuadPt),
+                                               wQuad) );
+    }
+
+    CurrentFE interpCFE ( fespace->refFE(), getGeometricMap (*fespace->mesh() ), interpQuad );
+
+    M_nbDirections = interpCFE.nbLocalCoor();
+
+    const Epetra_BlockMap& repeatedMap ( *M_map.map (Repeated) );
+    const UInt totalDof ( fespace->dof().numTotalDof() );
+
+    M_weights.resize ( M_nbElements * M_nbLocalDof * M_nbLocalDof * M_nbDirections );
+    M_localIds.resize ( M_nbElements * M_fieldDim * M_nbLocalDof );
+
+    Epetra_Vector patchArea ( repeatedMap );
+
+    for (UInt iElement (0); iElement < M_nbElements; ++iElement)
+    {
+        interpCFE.update ( fespace->mesh()->element (iElement), UPDATE_DPHI | UPDATE_WDET);
+
+        const Real measure ( interpCFE.measure() );
+        Real* weights ( &M_weights[iElement * M_nbLocalDof * M_nbLocalDof * M_nbDirections] );
+
+        for (UInt iDof (0); iDof < M_nbLocalDof; ++iDof)
+        {
+            for (UInt jDof (0); jDof < M_nbLocalDof; ++jDof)
+            {
+                for (UInt dxi (0); dxi < M_nbDirections; ++dxi)
+                {
+                    weights[ (iDof * M_nbLocalDof + jDof) * M_nbDirections + dxi] = measure * interpCFE.dphi (jDof, dxi, iDof);
+                }
+            }
+        }
+
+        for (UInt iDim (0); iDim < M_fieldDim; ++iDim)
+        {
+            for (UInt iDof (0); iDof < M_nbLocalDof; ++iDof)
+            {
+                const Int localId ( repeatedMap.LID ( static_cast<EpetraInt_Type> ( fespace->dof().localToGlobalMap (iElement, iDof)
+                                                                                    + iDim * totalDof ) ) );
+                M_localIds[ (iElement * M_fieldDim + iDim) * M_nbLocalDof + iDof] = localId;
+                patchArea[localId] += measure;
+            }
+        }
+    }
+
+    Epetra_Vector uniquePatchArea ( *M_map.map (Unique) );
+    uniquePatchArea.Export ( patchArea, M_map.importer(), Add );
+
+    M_inversePatchArea.resize ( uniquePatchArea.MyLength() );
+    for (Int i (0); i < uniquePatchArea.MyLength(); ++i)
+    {
+        M_inversePatchArea[i] = 1.0 / uniquePatchArea[i];
+    }
+}
+
+template<typename FESpaceType, typename VectorType>
+void
+ZZRecovery<FESpaceType, VectorType>::gradient (const vector_Type& inputData, std::vector<vector_Type>& recoveredGradient)
 {
-    // Need a repeated input
     if (inputData.mapType() != Repeated)
     {
-        return ZZLaplacian (fespace, VectorType (inputData, Repeated) );
+        gradient (vector_Type (inputData, Repeated), recoveredGradient);
+        return;
     }
+    ASSERT ( inputData.blockMap().SameAs ( *M_map.map (Repeated) ),
+             "ZZRecovery: the field is not defined on the finite element space of the recovery" );
 
-    VectorType laplacian (inputData, Unique);
-    laplacian *= 0.0;
+    Epetra_MultiVector uniqueGradient ( *M_map.map (Unique), M_nbDirections );
+    recover (inputData.epetraVector(), uniqueGradient, false);
 
-    // Loop over the components
-    for (UInt iDim (0); iDim < fespace->fieldDim(); ++iDim)
+    recoveredGradient.resize (M_nbDirections, vector_Type (M_map, Unique) );
+    for (UInt dxi (0); dxi < M_nbDirections; ++dxi)
     {
-        laplacian += ZZGradient (fespace, ZZGradient (fespace, inputData, iDim) , iDim);
+        typename vector_Type::localView_Type view ( recoveredGradient[dxi].localView() );
+        for (UInt i (0); i < view.size(); ++i)
+        {
+            view[i] = uniqueGradient[dxi][i] * M_inversePatchArea[i];
+        }
     }
+}
+
+template<typename FESpaceType, typename VectorType>
+VectorType
+ZZRecovery<FESpaceType, VectorType>::laplacian (const vector_Type& inputData)
+{
+    if (inputData.mapType() != Repeated)
+    {
+        return laplacian (vector_Type (inputData, Repeated) );
+    }
+    ASSERT ( inputData.blockMap().SameAs ( *M_map.map (Repeated) ),
+             "ZZRecovery: the field is not defined on the finite element space of the recovery" );
+
+    // First pass: the gradient in all the directions, imported back in one communication
+    Epetra_MultiVector uniqueGradient ( *M_map.map (Unique), M_nbDirections );
+    recover (inputData.epetraVector(), uniqueGradient, false);
+
+    for (UInt dxi (0); dxi < M_nbDirections; ++dxi)
+    {
+        for (UInt i (0); i < M_inversePatchArea.size(); ++i)
+        {
+            uniqueGradient[dxi][i] *= M_inversePatchArea[i];
+        }
+    }
+
+    Epetra_MultiVector repeatedGradient ( *M_map.map (Repeated), M_nbDirections );
+    repeatedGradient.Import ( uniqueGradient, M_map.exporter(), Insert );
 
-    return laplacian;
+    // Second pass: sum over the directions of the derivative of each gradient component
+    Epetra_MultiVector uniqueLaplacian ( *M_map.map (Unique), 1 );
+    recover (repeatedGradient, uniqueLaplacian, true);
+
+    vector_Type recoveredLaplacian (M_map, Unique);
+    typename vector_Type::localView_Type view ( recoveredLaplacian.localView() );
+    for (UInt i (0); i < view.size(); ++i)
+    {
+        view[i] = uniqueLaplacian[0][i] * M_inversePatchArea[i];
+    }
+
+    return recoveredLaplacian;
+}
+
+template<typename FESpaceType, typename VectorType>
+void
+ZZRecovery<FESpaceType, VectorType>::recover (const Epetra_MultiVector& repeatedInput, Epetra_MultiVector& uniqueOutput, const bool trace)
+{
+    Epetra_MultiVector repeatedOutput ( *M_map.map (Repeated), uniqueOutput.NumVectors() );
+
+    std::vector<Real> sum (M_nbDirections);
+
+    for (UInt iElement (0); iElement < M_nbElements; ++iElement)
+    {
+        const Real* weights ( &M_weights[iElement * M_nbLocalDof * M_nbLocalDof * M_nbDirections] );
+
+        for (UInt iDim (0); iDim < M_fieldDim; ++iDim)
+        {
+            const Int* localIds ( &M_localIds[ (iElement * M_fieldDim + iDim) * M_nbLocalDof] );
+
+            for (UInt iDof (0); iDof < M_nbLocalDof; ++iDof)
+            {
+                std::fill (sum.begin(), sum.end(), 0.0);
+
+                for (UInt jDof (0); jDof < M_nbLocalDof; ++jDof)
+                {
+                    const Real* w ( weights + (iDof * M_nbLocalDof + jDof) * M_nbDirections );
+                    for (UInt dxi (0); dxi < M_nbDirections; ++dxi)
+                    {
+                        sum[dxi] += w[dxi] * repeatedInput[trace ? dxi : 0][localIds[jDof]];
+                    }
+                }
+
+                if (trace)
+                {
+                    for (UInt dxi (0); dxi < M_nbDirections; ++dxi)
+                    {
+                        repeatedOutput[0][localIds[iDof]] += sum[dxi];
+                    }
+                }
+                else
+                {
+                    for (UInt dxi (0); dxi < M_nbDirections; ++dxi)
+                    {
+                        repeatedOutput[dxi][localIds[iDof]] += sum[dxi];
+                    }
+                }
+            }
+        }
+    }
+
+    uniqueOutput.PutScalar (0.0);
+    uniqueOutput.Export ( repeatedOutput, M_map.importer(), Add );
+}
+
+
+/*! Laplacian recovery following Zienkiewicz and Zhu.
+
+  The laplacian is computed with a ZZRecovery object: the gradient in all the
+  directions is recovered in one pass, and its divergence in a second pass.
+
+  @param fespace The finite element space describing the data
+  @param inputData The vector of data (pass it as repeated if possible)
+  @return recovered laplacian (unique map!)
+
+ */
+template<typename FESpaceType, typename VectorType>
+VectorType ZZLaplacian (boost::shared_ptr<FESpaceType> fespace,
+                        const VectorType& inputData)
+{
+    ZZRecovery<FESpaceType, VectorType> recovery (fespace);
+    return recovery.laplacian (inputData);
 }
 
 
@@ -38,9 +38,14 @@ along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
 #define EXPORTER_HDF5_H 1
 
 #include <sstream>
+#include <algorithm>
+#include <map>
 
 
 #include <Epetra_ConfigDefs.h>
+#ifdef HAVE_MPI
+#include <Epetra_MpiComm.h>
+#endif
 #include <EpetraExt_DistArray.h>
 #include <EpetraExt_HDF5.h>
 #include <Epetra_Comm.h>
@@ -51,6 +56,16 @@ along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
 #include <boost/shared_array.hpp>
 #include <boost/shared_ptr.hpp>
 
+// The asynchronous writing relies on the C++11 threads
+#if __cplusplus >= 201103L
+#define LIFEV_HDF5_ASYNC_WRITE 1
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#endif
+
 #ifndef HAVE_HDF5
 
 #warning warning you should reconfigure Trilinos with  -D TPL_ENABLE_HDF5:BOOL=ON
@@ -68,6 +83,145 @@ along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
 namespace LifeV
 {
 
+#ifdef LIFEV_HDF5_ASYNC_WRITE
+//! ExporterHDF5Writer - Background thread writing the snapshots of all the ExporterHDF5
+/*!
+  There is a single thread per process, shared by all the exporters, which runs the
+  writing tasks in the order they are queued. The main thread queues them in the same
+  order on all the processes, so the collective HDF5 calls of the thread match across
+  the processes whatever the number of exporters (two threads, or two exporters taking
+  a lock in a different order, could enter different collective calls and deadlock).
+
+  The exporters call wait() before any HDF5 call of the main thread, hence the library
+  is never entered at the same time by the two threads through the exporters.
+*/
+class ExporterHDF5Writer
+{
+public:
+
+    //! @name Public Types
+    //@{
+    typedef std::function<void()> task_Type;
+    //@}
+
+    //! @name Constructors & Destructor
+    //@{
+
+    //! Destructor: stop the thread once the queued tasks have been run
+    ~ExporterHDF5Writer()
+    {
+        if ( M_thread.joinable() )
+        {
+            {
+                std::unique_lock<std::mutex> lock ( M_mutex );
+                M_stop = true;
+            }
+            M_condition.notify_all();
+            M_thread.join();
+        }
+    }
+
+    //@}
+
+    //! @name Methods
+    //@{
+
+    //! The writer of the process
+    static ExporterHDF5Writer& instance()
+    {
+        static ExporterHDF5Writer writer;
+        return writer;
+    }
+
+    //! Queue a task, the thread is started at the first call
+    void push ( const task_Type& task )
+    {
+        {
+            std::unique_lock<std::mutex> lock ( M_mutex );
+            if ( !M_thread.joinable() )
+            {
+                M_thread = std::thread ( &ExporterHDF5Writer::loop, this );
+            }
+            M_tasks.push_back ( task );
+        }
+        M_condition.notify_all();
+    }
+
+    //! Wait until all the queued tasks have been run
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock ( M_mutex );
+        while ( !M_tasks.empty() || M_busy )
+        {
+            M_condition.wait ( lock );
+        }
+    }
+
+    //@}
+
+private:
+
+    //! @name Private Methods
+    //@{
+
+    ExporterHDF5Writer() :
+        M_tasks     (),
+        M_busy      ( false ),
+        M_stop      ( false ),
+        M_thread    (),
+        M_mutex     (),
+        M_condition ()
+    {}
+
+    //! No copy constructor
+    ExporterHDF5Writer ( const ExporterHDF5Writer& );
+
+    //! Loop of the thread: run the queued tasks
+    void loop()
+    {
+        while ( true )
+        {
+            task_Type task;
+            {
+                std::unique_lock<std::mutex> lock ( M_mutex );
+                while ( M_tasks.empty() && !M_stop )
+                {
+                    M_condition.wait ( lock );
+                }
+                if ( M_tasks.empty() )
+                {
+                    // stop requested and nothing left to run
+                    return;
+                }
+                task = M_tasks.front();
+                M_tasks.pop_front();
+                M_busy = true;
+            }
+
+            task();
+
+            {
+                std::unique_lock<std::mutex> lock ( M_mutex );
+                M_busy = false;
+            }
+            M_condition.notify_all();
+        }
+    }
+
+    //@}
+
+    std::deque<task_Type>       M_tasks;
+    //! is the thread running a task?
+    bool                        M_busy;
+    //! has the thread to stop?
+    bool                        M_stop;
+
+    std::thread                 M_thread;
+    std::mutex                  M_mutex;
+    std::condition_variable     M_condition;
+};
+#endif
+
 //! Hdf5 data exporter, implementation of Exporter
 /*!
   @author Simone Deparis <simone.deparis@epfl.ch>
@@ -78,6 +232,22 @@ namespace LifeV
   <li> first: add the variables using addVariable
   <li> second: call postProcess( time );
   </ol>
+
+  With asyncWrite = true in the data file, postProcess only copies the variables
+  in staging buffers (a pool of asyncQueueSize snapshots) and writes the XDMF file:
+  the HDF5 writing is done by a background thread while the computation continues.
+  When all the snapshots are waiting to be written, postProcess blocks until one is
+  free. Call wait() before using the files (e.g. at checkpoints); it is also called
+  before any reading and when the file is closed.
+
+  The thread (ExporterHDF5Writer) is shared by all the exporters of the process, and
+  every exporter waits for it before calling HDF5 from the main thread, so that the
+  exporters never call HDF5 concurrently.
+
+  The background thread performs collective MPI-IO operations, hence MPI must be
+  initialized with MPI_Init_thread and MPI_THREAD_MULTIPLE, and HDF5 may be called
+  elsewhere in the main thread, hence the library must be thread-safe; otherwise (or
+  without C++11 threads) the variables are written synchronously.
 */
 template<typename MeshType>
 class ExporterHDF5 : public Exporter<MeshType>
@@ -136,7 +306,7 @@ public:
     ExporterHDF5 (const GetPot& dfile, const std::string& prefix);
 
     //! Destructor for ExporterHDF5
-    virtual ~ExporterHDF5() {}
+    virtual ~ExporterHDF5();
 
     //@}
 
@@ -180,9 +350,17 @@ public:
     */
     void closeFile()
     {
+        wait();
         M_HDF5->Close();
     }
 
+    //! Wait until all the snapshots have been written
+    /*!
+      Block until the background thread has written and flushed all the pending
+      snapshots, of all the exporters. Nothing is done without C++11 threads.
+    */
+    void wait();
+
     //! Read variable
     void readVariable ( exporterData_Type& dvar);
 
@@ -237,6 +415,85 @@ protected:
 
     void readScalar ( exporterData_Type& dvar);
     void readVector ( exporterData_Type& dvar);
+
+    //! Copy the variables in a free snapshot and queue it for the background thread
+    void postProcessAsync();
+
+    //! Allocate the staging buffers of all the snapshots, when the background thread is idle
+    void allocateSnapshots();
+
+    //! True if a snapshot has not been allocated for the current variables and their maps
+    bool isSnapshotOutdated ( const UInt& slot ) const;
+
+    //! Staging multivector of a variable, built on first use and then reused
+    /*!
+      The multivector lives on the unique map of one component of the variable
+      and has one column for each component (nDimensions for vector fields).
+      It is shared by the variables with the same FE space, start and number of
+      components, and it is rebuilt only if the map of the stored vector changes.
+      @param dvar the variable
+    */
+    Epetra_MultiVector& stagingBuffer ( const exporterData_Type& dvar );
+
+    //! Copy the values of a variable in a staging multivector
+    /*!
+      @param dvar the variable
+      @param staging the multivector, with one column for each component, on the unique map of one component
+    */
+    void stageVariable ( const exporterData_Type& dvar, Epetra_MultiVector& staging ) const;
+
+#ifdef LIFEV_HDF5_ASYNC_WRITE
+    //! Prepare the asynchronous writing, if the MPI and HDF5 libraries allow it
+    void startWriter();
+
+    //! Write a snapshot and give it back to the pool (run by the background thread)
+    void writeSnapshot ( const UInt& slot );
+#endif
+    //@}
+
+    //! @name Protected Types
+    //@{
+
+    //! A variable copied for the asynchronous writing
+    struct stagedVariable_Type
+    {
+        std::string                           name;
+        boost::shared_ptr<Epetra_BlockMap>    storedMap;
+        boost::shared_ptr<Epetra_MultiVector> data;
+    };
+
+    //! The variables of a post-processing step
+    typedef std::vector<stagedVariable_Type> snapshot_Type;
+
+    //! Key of the staging buffers: FE space, start and number of components
+    struct stagingKey_Type
+    {
+        const void* feSpace;
+        UInt        start;
+        Int         numComponents;
+
+        bool operator< ( const stagingKey_Type& key ) const
+        {
+            if ( feSpace != key.feSpace )
+            {
+                return feSpace < key.feSpace;
+            }
+            if ( start != key.start )
+            {
+                return start < key.start;
+            }
+            return numComponents < key.numComponents;
+        }
+    };
+
+    //! A staging buffer and the map of the stored vector it was built from
+    struct stagingBuffer_Type
+    {
+        boost::shared_ptr<Epetra_BlockMap>    storedMap;
+        boost::shared_ptr<Epetra_MultiVector> data;
+    };
+
+    typedef std::map<stagingKey_Type, stagingBuffer_Type> stagingBufferMap_Type;
     //@}
 
     //! @name Protected data members
@@ -250,6 +507,29 @@ protected:
 
     //! do we want to write on file the connectivity?
     bool                        M_printConnectivity;
+
+    //! do we want to write in a background thread?
+    bool                        M_asyncWrite;
+
+    //! number of snapshots that can be queued
+    UInt                        M_asyncQueueSize;
+
+    //! staging buffers of the synchronous writing
+    stagingBufferMap_Type       M_stagingBuffers;
+
+    //! pool of snapshots (staging buffers)
+    std::vector<snapshot_Type>  M_snapshots;
+
+    //! communicator of the background thread (a duplicate of the one of the variables)
+    boost::shared_ptr<Epetra_Comm> M_writerComm;
+
+#ifdef LIFEV_HDF5_ASYNC_WRITE
+    //! free snapshots
+    std::deque<UInt>            M_freeSnapshots;
+
+    std::mutex                  M_queueMutex;
+    std::condition_variable     M_queueCondition;
+#endif
     //@}
 
 };
@@ -267,7 +547,9 @@ ExporterHDF5<MeshType>::ExporterHDF5() :
     M_HDF5              (),
     M_closingLines      ( "\n    </Grid>\n\n  </Domain>\n</Xdmf>\n"),
     M_outputFileName    ( "noninitialisedFileName" ),
-    M_printConnectivity ( true )
+    M_printConnectivity ( true ),
+    M_asyncWrite        ( false ),
+    M_asyncQueueSize    ( 2 )
 {
 }
 
@@ -277,9 +559,13 @@ ExporterHDF5<MeshType>::ExporterHDF5 (const GetPot& dfile, meshPtr_Type mesh, co
     super               ( dfile, prefix ),
     M_HDF5              (),
     M_closingLines      ( "\n    </Grid>\n\n  </Domain>\n</Xdmf>\n"),
-    M_outputFileName    ( "noninitialisedFileName" )
+    M_outputFileName    ( "noninitialisedFileName" ),
+    M_asyncWrite        ( false ),
+    M_asyncQueueSize    ( 2 )
 {
     M_printConnectivity = dfile ( ( prefix + "/printConnectivity" ).data(), 1);
+    M_asyncWrite        = dfile ( ( prefix + "/asyncWrite" ).data(), false);
+    M_asyncQueueSize    = dfile ( ( prefix + "/asyncQueueSize" ).data(), 2);
     this->setMeshProcId ( mesh, procId );
 }
 
@@ -288,9 +574,36 @@ ExporterHDF5<MeshType>::ExporterHDF5 (const GetPot& dfile, const std::string& pr
     super               ( dfile, prefix ),
     M_HDF5              (),
     M_closingLines      ( "\n    </Grid>\n\n  </Domain>\n</Xdmf>\n"),
-    M_outputFileName    ( "noninitialisedFileName" )
+    M_outputFileName    ( "noninitialisedFileName" ),
+    M_asyncWrite        ( false ),
+    M_asyncQueueSize    ( 2 )
 {
     M_printConnectivity = dfile ( ( prefix + "/printConnectivity" ).data(), 1);
+    M_asyncWrite        = dfile ( ( prefix + "/asyncWrite" ).data(), false);
+    M_asyncQueueSize    = dfile ( ( prefix + "/asyncQueueSize" ).data(), 2);
+}
+
+template<typename MeshType>
+ExporterHDF5<MeshType>::~ExporterHDF5()
+{
+    // the queued snapshots refer to this exporter
+    wait();
+
+    // the file refers to the communicator of the background thread
+    M_HDF5.reset();
+    M_snapshots.clear();
+
+#ifdef HAVE_MPI
+    Epetra_MpiComm* writerComm ( dynamic_cast<Epetra_MpiComm*> ( M_writerComm.get() ) );
+    Int finalized (0);
+    MPI_Finalized ( &finalized );
+    if ( writerComm && !finalized )
+    {
+        MPI_Comm comm ( writerComm->Comm() );
+        M_writerComm.reset();
+        MPI_Comm_free ( &comm );
+    }
+#endif
 }
 
 // ===================================================
@@ -302,7 +615,27 @@ void ExporterHDF5<MeshType>::postProcess (const Real& time)
 {
     if ( M_HDF5.get() == 0 )
     {
-        M_HDF5.reset (new hdf5_Type (this->M_dataVector.begin()->storedArrayPtr()->comm() ) );
+        // the background thread may be writing for another exporter
+        wait();
+
+#ifdef LIFEV_HDF5_ASYNC_WRITE
+        if ( M_asyncWrite )
+        {
+            startWriter();
+        }
+#else
+        M_asyncWrite = false;
+#endif
+
+        // in the asynchronous mode the file is accessed through the communicator of the background thread
+        if ( M_asyncWrite )
+        {
+            M_HDF5.reset (new hdf5_Type (*M_writerComm) );
+        }
+        else
+        {
+            M_HDF5.reset (new hdf5_Type (this->M_dataVector.begin()->storedArrayPtr()->comm() ) );
+        }
         M_outputFileName = this->M_prefix + ".h5";
         M_HDF5->Create (this->M_postDir + M_outputFileName);
         
@@ -329,10 +662,22 @@ void ExporterHDF5<MeshType>::postProcess (const Real& time)
         }
         LifeChrono chrono;
         chrono.start();
-        for (typename super::dataVectorIterator_Type i = this->M_dataVector.begin(); i != this->M_dataVector.end(); ++i)
+
+        if ( M_asyncWrite )
         {
-            writeVariable (*i);
+            // the variables are written by the background thread
+            postProcessAsync();
         }
+        else
+        {
+            // the background thread may be writing for another exporter
+            wait();
+            for (typename super::dataVectorIterator_Type i = this->M_dataVector.begin(); i != this->M_dataVector.end(); ++i)
+            {
+                writeVariable (*i);
+            }
+        }
+
         // pushing time
         this->M_timeSteps.push_back (time);
         
@@ -340,13 +685,18 @@ void ExporterHDF5<MeshType>::postProcess (const Real& time)
         
         if (this->M_multimesh)
         {
+            // the background thread must not write at the same time
+            wait();
             writeGeometry(); // see also writeGeometry
         }
         
         chrono.stop();
         
         // Write to file without closing the file
-        M_HDF5->Flush();
+        if ( !M_asyncWrite || this->M_multimesh )
+        {
+            M_HDF5->Flush();
+        }
         
         if (!this->M_procId)
         {
@@ -356,9 +706,19 @@ void ExporterHDF5<MeshType>::postProcess (const Real& time)
 }
 
     
+template<typename MeshType>
+void ExporterHDF5<MeshType>::wait()
+{
+#ifdef LIFEV_HDF5_ASYNC_WRITE
+    ExporterHDF5Writer::instance().wait();
+#endif
+}
+
 template<typename MeshType>
 void ExporterHDF5<MeshType>::importHdf5 (Real t)
 {
+    wait();
+
     if ( M_HDF5.get() == 0 )
     {
         M_HDF5.reset (new hdf5_Type (this->M_dataVector.begin()->storedArrayPtr()->comm() ) );
@@ -556,6 +916,8 @@ void ExporterHDF5<MeshType>::import (const Real& Tstart, const Real& dt)
 template<typename MeshType>
 void ExporterHDF5<MeshType>::import (const Real& time)
 {
+    wait();
+
     std::cout << time << std::endl;
     if ( M_HDF5.get() == 0)
     {
@@ -590,6 +952,8 @@ void ExporterHDF5<MeshType>::import (const Real& time)
 template <typename MeshType>
 void ExporterHDF5<MeshType>::readVariable (exporterData_Type& dvar)
 {
+    wait();
+
     if ( M_HDF5.get() == 0)
     {
         M_HDF5.reset (new hdf5_Type (dvar.storedArrayPtr()->blockMap().Comm() ) );
@@ -606,6 +970,8 @@ void ExporterHDF5<MeshType>::setDataFromGetPot ( const GetPot& dataFile, const s
 {
     super::setDataFromGetPot ( dataFile, section );
     M_printConnectivity = dataFile ( ( section + "/printConnectivity" ).data(), 1);
+    M_asyncWrite        = dataFile ( ( section + "/asyncWrite" ).data(), false);
+    M_asyncQueueSize    = dataFile ( ( section + "/asyncQueueSize" ).data(), 2);
 }
 
 // ===================================================
@@ -968,67 +1334,259 @@ void ExporterHDF5<MeshType>::writeScalar (const exporterData_Type& dvar)
        M_HDF5->Write("RHS", RHS);
     */
 
-    UInt size  = dvar.numDOF();
-    UInt start = dvar.start();
-
-    MapEpetra subMap (dvar.storedArrayPtr()->blockMap(), start, size);
-    vector_Type subVar (subMap);
-    subVar.subset (*dvar.storedArrayPtr(), start);
+    // the sub-map and the staging vector are built once and reused at each step
+    Epetra_MultiVector& subVar ( stagingBuffer (dvar) );
+    stageVariable (dvar, subVar);
 
     std::string varname (dvar.variableName() + this->M_postfix); // see also in writeAttributes
     bool writeTranspose (true);
-    M_HDF5->Write (varname, subVar.epetraVector(), writeTranspose );
+    M_HDF5->Write (varname, subVar, writeTranspose );
 }
 
 template <typename MeshType>
 void ExporterHDF5<MeshType>::writeVector (const exporterData_Type& dvar)
 {
+    // solution array has to be reordered and stored in a Multivector,
+    // with one column for each component (the missing ones are zero).
+    // The sub-map and the multivector are built once and reused at each step
+    Epetra_MultiVector& multiVector ( stagingBuffer (dvar) );
+    stageVariable (dvar, multiVector);
 
-    UInt size  = dvar.numDOF();
-    UInt start = dvar.start();
+    bool writeTranspose (true);
+    std::string varname (dvar.variableName() + this->M_postfix); // see also in writeAttributes
+    M_HDF5->Write (varname, multiVector, writeTranspose);
+}
 
-    // solution array has to be reordered and stored in a Multivector.
-    // Using auxiliary arrays:
-    Real**                                  ArrayOfPointers (new Real*[nDimensions]);
-    boost::shared_array< boost::shared_ptr<vector_Type> >
-    ArrayOfVectors (new boost::shared_ptr<vector_Type>[nDimensions]);
+template <typename MeshType>
+Epetra_MultiVector& ExporterHDF5<MeshType>::stagingBuffer ( const exporterData_Type& dvar )
+{
+    stagingKey_Type key;
+    key.feSpace       = dvar.feSpacePtr().get();
+    key.start         = dvar.start();
+    key.numComponents = ( dvar.fieldType() == exporterData_Type::ScalarField ? 1 : nDimensions );
 
-    Int MyLDA;
+    const Epetra_BlockMap& storedMap ( dvar.storedArrayPtr()->blockMap() );
+    stagingBuffer_Type& buffer ( M_stagingBuffers[key] );
 
+    // the buffer is rebuilt if the stored vector lives on a different map
+    // (e.g. a new FE space at the same address, or a new mesh)
+    if ( buffer.data.get() == 0 || !buffer.storedMap->SameBlockMapDataAs ( storedMap ) )
+    {
+        MapEpetra subMap ( storedMap, dvar.start(), dvar.numDOF() );
+        buffer.storedMap.reset ( new Epetra_BlockMap ( storedMap ) );
+        buffer.data.reset ( new Epetra_MultiVector ( *subMap.map (Unique), key.numComponents ) );
+    }
 
-    // Building subsets (new vectors) of the original data and than taking a view of them to
-    // build a multivector.
-    // Note: the contents of ArrayOfPointers[0,1,2] must not be deleted explicitly, since their
-    // content belongs to ArrayOfVectors[0,1,2].
-    // ArrayOfVectors[0,1,2] are deleted when ArrayOfVectors is destroyed
+    return *buffer.data;
+}
 
-    for (UInt d ( 0 ); d < dvar.fieldDim(); ++d)
+template <typename MeshType>
+void ExporterHDF5<MeshType>::postProcessAsync()
+{
+    // get a free snapshot, waiting for the background thread if needed
+    UInt slot (0);
+#ifdef LIFEV_HDF5_ASYNC_WRITE
     {
-        MapEpetra subMap (dvar.storedArrayPtr()->blockMap(), start + d * size, size);
-        ArrayOfVectors[d].reset (new  vector_Type (subMap) );
-        ArrayOfVectors[d]->subset (*dvar.storedArrayPtr(), start + d * size);
+        std::unique_lock<std::mutex> lock ( M_queueMutex );
+        while ( M_freeSnapshots.empty() )
+        {
+            M_queueCondition.wait ( lock );
+        }
+        slot = M_freeSnapshots.front();
+        M_freeSnapshots.pop_front();
+    }
+#endif
 
-        ArrayOfVectors[d]->epetraVector().ExtractView (&ArrayOfPointers[d], &MyLDA);
+    // the staging buffers are allocated when the variables are first seen,
+    // and again if one of them now lives on a different map
+    if ( isSnapshotOutdated ( slot ) )
+    {
+        allocateSnapshots();
     }
 
-    for (UInt d ( dvar.fieldDim() ); d < nDimensions; ++d)
+    snapshot_Type& snapshot ( M_snapshots[slot] );
+
+    UInt iVariable (0);
+    for (typename super::dataVectorIterator_Type i = this->M_dataVector.begin(); i != this->M_dataVector.end(); ++i, ++iVariable)
     {
-        MapEpetra subMap (dvar.storedArrayPtr()->blockMap(), start, size);
-        ArrayOfVectors[d].reset (new  vector_Type (subMap) );
+        snapshot[iVariable].name = i->variableName() + this->M_postfix; // see also in writeAttributes
+        stageVariable ( *i, *snapshot[iVariable].data );
+    }
+
+#ifdef LIFEV_HDF5_ASYNC_WRITE
+    ExporterHDF5Writer::instance().push ( std::bind ( &ExporterHDF5<MeshType>::writeSnapshot, this, slot ) );
+#endif
+}
+
+template <typename MeshType>
+void ExporterHDF5<MeshType>::allocateSnapshots()
+{
+    // building the maps requires communication, which must not overlap with the
+    // one of the background thread
+    wait();
 
-        ArrayOfVectors[d]->epetraVector().ExtractView (&ArrayOfPointers[d], &MyLDA);
+    for ( UInt slot (0); slot < M_snapshots.size(); ++slot )
+    {
+        M_snapshots[slot].resize ( this->M_dataVector.size() );
     }
 
-    MapEpetra subMap (dvar.storedArrayPtr()->blockMap(), start, size);
-    Epetra_MultiVector multiVector (View, *subMap.map (Unique), ArrayOfPointers, nDimensions);
+    UInt iVariable (0);
+    for (typename super::dataVectorIterator_Type i = this->M_dataVector.begin(); i != this->M_dataVector.end(); ++i, ++iVariable)
+    {
+        // the sub-map is the one of the synchronous writing, moved to the communicator of the thread
+        const Epetra_MultiVector& buffer ( stagingBuffer (*i) );
+        const Int numComponents ( buffer.NumVectors() );
+        const Epetra_BlockMap& uniqueSubMap ( buffer.Map() );
+        const Epetra_Map writerMap ( -1, uniqueSubMap.NumMyElements(), uniqueSubMap.MyGlobalElements(),
+                                     uniqueSubMap.IndexBase(), *M_writerComm );
+
+        for ( UInt slot (0); slot < M_snapshots.size(); ++slot )
+        {
+            M_snapshots[slot][iVariable].storedMap.reset ( new Epetra_BlockMap ( i->storedArrayPtr()->blockMap() ) );
+            M_snapshots[slot][iVariable].data.reset ( new Epetra_MultiVector ( writerMap, numComponents ) );
+        }
+    }
+}
 
+template <typename MeshType>
+bool ExporterHDF5<MeshType>::isSnapshotOutdated ( const UInt& slot ) const
+{
+    const snapshot_Type& snapshot ( M_snapshots[slot] );
+    if ( snapshot.size() != this->M_dataVector.size() )
+    {
+        return true;
+    }
 
-    bool writeTranspose (true);
-    std::string varname (dvar.variableName() + this->M_postfix); // see also in writeAttributes
-    M_HDF5->Write (varname, multiVector, writeTranspose);
+    // same check as for the staging buffers of the synchronous writing
+    UInt iVariable (0);
+    for (typename super::dataVector_Type::const_iterator i = this->M_dataVector.begin(); i != this->M_dataVector.end(); ++i, ++iVariable)
+    {
+        if ( snapshot[iVariable].storedMap.get() == 0
+                || !snapshot[iVariable].storedMap->SameBlockMapDataAs ( i->storedArrayPtr()->blockMap() ) )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename MeshType>
+void ExporterHDF5<MeshType>::stageVariable ( const exporterData_Type& dvar, Epetra_MultiVector& staging ) const
+{
+    const UInt size  ( dvar.numDOF() );
+    const UInt start ( dvar.start() );
+
+    const Epetra_BlockMap& storedMap ( dvar.storedArrayPtr()->blockMap() );
+    const Epetra_MultiVector& stored ( dvar.storedArrayPtr()->epetraVector() );
+
+    // the unique map of one component, shifted by start + d * size, is a subset
+    // of the local entries of the stored vector (unique or repeated)
+    const Int* gids ( staging.Map().MyGlobalElements() );
+    const Int numMyEntries ( staging.Map().NumMyElements() );
+
+    for ( UInt d (0); d < dvar.fieldDim(); ++d )
+    {
+        for ( Int i (0); i < numMyEntries; ++i )
+        {
+            const Int lid ( storedMap.LID ( static_cast<EpetraInt_Type> ( gids[i] + start + d * size ) ) );
+            ASSERT ( lid >= 0, "ExporterHDF5::stageVariable ERROR : !! lid < 0\n" );
+            staging[d][i] = stored[0][lid];
+        }
+    }
+
+    // the missing components of a vector field are zero, see writeVector
+    for ( Int d ( dvar.fieldDim() ); d < staging.NumVectors(); ++d )
+    {
+        staging (d)->PutScalar ( 0. );
+    }
+}
+
+#ifdef LIFEV_HDF5_ASYNC_WRITE
+template <typename MeshType>
+void ExporterHDF5<MeshType>::startWriter()
+{
+#ifdef HAVE_MPI
+    // the background thread calls MPI while the computation goes on
+    Int initialized (0);
+    Int provided ( MPI_THREAD_SINGLE );
+    MPI_Initialized ( &initialized );
+    if ( initialized )
+    {
+        MPI_Query_thread ( &provided );
+    }
+    if ( initialized && provided < MPI_THREAD_MULTIPLE )
+    {
+        if ( !this->M_procId )
+        {
+            std::cout << "  X-  HDF5 asynchronous writing requires MPI_THREAD_MULTIPLE, "
+                      << "the variables will be written synchronously" << std::endl;
+        }
+        M_asyncWrite = false;
+        return;
+    }
+#endif
+
+    // HDF5 may be called by the main thread (e.g. by HDF5IO) while the background thread writes
+    hbool_t threadSafe ( 0 );
+#ifdef H5_VERSION_GE
+#if H5_VERSION_GE(1,8,16)
+    H5is_library_threadsafe ( &threadSafe );
+#endif
+#endif
+    if ( !threadSafe )
+    {
+        if ( !this->M_procId )
+        {
+            std::cout << "  X-  HDF5 asynchronous writing requires a thread-safe HDF5 library, "
+                      << "the variables will be written synchronously" << std::endl;
+        }
+        M_asyncWrite = false;
+        return;
+    }
 
-    delete[] ArrayOfPointers;
+    // the background thread has its own communicator
+    const Epetra_Comm& comm ( this->M_dataVector.begin()->storedArrayPtr()->comm() );
+#ifdef HAVE_MPI
+    const Epetra_MpiComm* mpiComm ( dynamic_cast<const Epetra_MpiComm*> ( &comm ) );
+    if ( mpiComm )
+    {
+        MPI_Comm writerComm;
+        MPI_Comm_dup ( mpiComm->Comm(), &writerComm );
+        M_writerComm.reset ( new Epetra_MpiComm ( writerComm ) );
+    }
+    else
+#endif
+    {
+        M_writerComm.reset ( comm.Clone() );
+    }
+
+    M_snapshots.resize ( std::max ( M_asyncQueueSize, static_cast<UInt> (1) ) );
+    for ( UInt slot (0); slot < M_snapshots.size(); ++slot )
+    {
+        M_freeSnapshots.push_back ( slot );
+    }
+}
+
+template <typename MeshType>
+void ExporterHDF5<MeshType>::writeSnapshot ( const UInt& slot )
+{
+    const bool writeTranspose (true);
+    const snapshot_Type& snapshot ( M_snapshots[slot] );
+    for ( UInt iVariable (0); iVariable < snapshot.size(); ++iVariable )
+    {
+        M_HDF5->Write ( snapshot[iVariable].name, *snapshot[iVariable].data, writeTranspose );
+    }
+
+    // Write to file without closing the file
+    M_HDF5->Flush();
+
+    {
+        std::unique_lock<std::mutex> lock ( M_queueMutex );
+        M_freeSnapshots.push_back ( slot );
+    }
+    M_queueCondition.notify_all();
 }
+#endif
 
 template <typename MeshType>
 void ExporterHDF5<MeshType>::writeGeometry()
@@ -43,15 +43,33 @@ along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef EXPORTERVTK_H
 #define EXPORTERVTK_H 1
 
+#include <boost/unordered_map.hpp>
+
 #include <lifev/core/filter/Exporter.hpp>
 #include <lifev/core/util/EncoderBase64.hpp>
 
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
 namespace LifeV
 {
 
 /**
  * @class ExporterVTK
  * @brief ExporterVTK data exporter
+ *
+ * In the ascii and binary modes each process writes one VTU file per variable
+ * at each post-processing step, the geometry being recomposed every time.
+ *
+ * In the appended mode (exportMode = 3) the variables defined on the same kind
+ * of finite element share a single VTU file per process and per step. The point
+ * maps, the connectivity and (if multimesh = false) the coordinates are built and
+ * encoded once per mesh, then copied as they are in the files: at each step only
+ * the data arrays are computed. All the arrays are stored as raw binary data in the
+ * AppendedData section and, if LifeV is built with zlib, they can be compressed
+ * (compress = true). Cell data are still written with one file per variable.
+ * An importer with exportMode = 3 reads the node variables back from these files.
  */
 template<typename MeshType>
 class ExporterVTK : public Exporter<MeshType>
@@ -93,12 +111,14 @@ public:
     };
 
     /*! @enum EXPORT_MODE
-        The export modes currently supported are ascii and binary
+        The export modes currently supported are ascii, binary (base64 inline)
+        and appended (raw binary, one file for all the variables)
      */
     enum EXPORT_MODE
     {
         ASCII_EXPORT = 1,
-        BINARY_EXPORT = 2
+        BINARY_EXPORT = 2,
+        APPENDED_EXPORT = 3
     };
 
     /*! @enum FLOAT_PRECISION
@@ -220,6 +240,41 @@ public:
 
 private:
 
+    //! @name Private Types
+    //@{
+
+    //! The geometry of the VTU files in the appended mode
+    /*!
+      The geometry is shared by all the node variables defined on the same kind of
+      finite element. The arrays that do not change in time are stored already encoded.
+     */
+    struct appendedGeometry_Type
+    {
+        //! The FE space used to build the geometry
+        feSpacePtr_Type feSpacePtr;
+
+        //! The suffix of the file names
+        std::string name;
+
+        //! The global ID of the points, in the order of the VTU file
+        std::vector<UInt> localToGlobalPoints;
+
+        //! The element and the local DOF defining each point that is not a vertex
+        std::vector< std::pair<UInt, UInt> > nonVertexPoints;
+
+        //! The encoded arrays
+        std::string pointsBlock;
+        std::string connectivityBlock;
+        std::string offsetsBlock;
+        std::string typesBlock;
+        std::string globalIdBlock;
+
+        //! The node variables written with this geometry (updated at each step)
+        std::vector<const exporterData_Type*> variables;
+    };
+
+    //@}
+
     //! @name Private methods
     //@{
     /*!
@@ -336,6 +391,68 @@ private:
     void composeDataArrayStream (where_Type where,
                                  std::stringstream& dataArraysStringStream);
 
+    //! @name Private methods for the appended mode
+    //@{
+
+    //! Write the VTU (and PVTU) files of all the node variables in the appended mode
+    void postProcessAppended();
+
+    //! Assign the node variables to the geometries, building the missing geometries
+    void updateAppendedGeometries();
+
+    //! Build the point maps and encode the connectivity of a geometry
+    /*!
+       \param geometry the geometry, whose feSpacePtr is already set
+     */
+    void buildAppendedGeometry ( appendedGeometry_Type& geometry );
+
+    //! Encode the coordinates of the points of a geometry
+    void composeAppendedPointsBlock ( appendedGeometry_Type& geometry );
+
+    //! Encode the values of a variable on the points of a geometry
+    /*!
+       \param dvar the ExporterData object
+       \param geometry the geometry of the variable
+       \param[out] block the encoded block
+     */
+    void composeAppendedDataBlock ( const exporterData_Type& dvar,
+                                    const appendedGeometry_Type& geometry,
+                                    std::string& block ) const;
+
+    //! Fill a buffer with the values of a variable, in the given precision
+    template <typename FloatType>
+    void fillAppendedValues ( const exporterData_Type& dvar,
+                              const appendedGeometry_Type& geometry,
+                              std::vector<FloatType>& values ) const;
+
+    //! Encode a raw array as a block of the AppendedData section
+    /*!
+       The block is made of a UInt32 header with the number of bytes, followed by the
+       data. When compression is enabled the header is the one of vtkZLibDataCompressor
+       (a single compressed block).
+       \param data pointer to the raw data
+       \param numBytes size of the raw data
+       \param[out] block the encoded block
+     */
+    void encodeAppendedBlock ( const void* data, const UInt numBytes, std::string& block ) const;
+
+    /*!
+       This method fills a buffer for the *.pvtu file of a geometry in the appended mode,
+       listing all the variables and the VTU files of the processes.
+
+       \param geometry the geometry
+       \param pieceName the name of the VTU files without the process id and extension
+       \param[out] pVTUStringStream the stringstream object (a file buffer)
+     */
+    void composeAppendedPVTUStream ( const appendedGeometry_Type& geometry,
+                                     const std::string& pieceName,
+                                     std::stringstream& pVTUStringStream );
+
+    //! The name of the VTK type used for the floats
+    std::string vtkFloatType() const;
+
+    //@}
+
     //! The scalar reader (specialization of the parent class method)
     /*!
       @param dvar the ExporterData object
@@ -357,6 +474,27 @@ private:
       @param dvar the ExporterData object
     */
     void readVTUFiles ( exporterData_Type& dvar );
+    //! The reader for the VTU files written in the appended mode
+    /*!
+      @param dvar the ExporterData object, defined on the nodes
+    */
+    void readAppendedVTUFiles ( exporterData_Type& dvar );
+    //! The suffix of the appended VTU files holding a variable
+    /*!
+      The geometries are numbered as in updateAppendedGeometries(), so the variables
+      must be added to the importer in the same order as to the exporter.
+      @param dvar the ExporterData object, defined on the nodes
+    */
+    std::string appendedGeometryName ( const exporterData_Type& dvar ) const;
+    //! A routine for loading a block of the AppendedData section of a VTU file
+    /*!
+      @param inputFile the VTU file
+      @param position the position of the block in the file
+      @param compressed true if the file is written with vtkZLibDataCompressor
+      @param[out] block the raw data of the block
+    */
+    void readAppendedBlock ( std::ifstream& inputFile, const std::streampos& position,
+                             const bool compressed, std::vector<char>& block ) const;
     //! A routine for loading values stored in binary format in a VTU file
     /*!
       @param line a line read from file
@@ -379,6 +517,15 @@ private:
     FLOAT_PRECISION M_floatPrecision;
 
     std::map< std::string, std::list<std::string> > M_pvtuFiles;
+
+    // Compression of the appended data
+    bool M_compress;
+
+    // Geometries of the appended mode, one for each kind of finite element
+    std::vector<appendedGeometry_Type> M_appendedGeometries;
+
+    // Mesh used to build the geometries
+    const mesh_Type* M_appendedMesh;
     //@}
 
 };
@@ -399,7 +546,9 @@ template<typename MeshType>
 ExporterVTK<MeshType>::ExporterVTK() :
     super(),
     M_exportMode (ASCII_EXPORT),
-    M_floatPrecision ( DOUBLE_PRECISION )
+    M_floatPrecision ( DOUBLE_PRECISION ),
+    M_compress ( false ),
+    M_appendedMesh ( 0 )
 {
 }
 
@@ -408,7 +557,9 @@ template<typename MeshType> ExporterVTK<MeshType >::ExporterVTK (
     const GetPot& data_file,
     const std::string prefix)
     :
-    super (data_file, prefix)
+    super (data_file, prefix),
+    M_compress ( false ),
+    M_appendedMesh ( 0 )
 {
     this->setDataFromGetPot (data_file);
 }
@@ -429,11 +580,23 @@ void ExporterVTK<MeshType >::setDataFromGetPot (
         case 2:
             M_exportMode = BINARY_EXPORT;
             break;
+        case 3:
+            M_exportMode = APPENDED_EXPORT;
+            break;
         default:
             ERROR_MSG ( "Unsupported export mode!" );
             break;
     }
 
+    M_compress = data_file ( (section + "/compress").c_str(), false );
+#ifndef HAVE_ZLIB
+    if ( M_compress && this->M_procId == 0 )
+    {
+        std::cerr << "  X-  ExporterVTK: compression requires zlib, the data will not be compressed" << std::endl;
+    }
+    M_compress = false;
+#endif
+
     switch ( data_file ( (section + "/floatPrecision").c_str(), 2) )
     {
         case 1:
@@ -465,9 +628,31 @@ ExporterVTK<MeshType>::~ExporterVTK()
         // a unique time collection is produced by the leader process
         if (this->M_procId == 0)
         {
+            // in the appended mode, a collection for each geometry
+            for ( UInt iGeometry = 0; iGeometry < M_appendedGeometries.size(); ++iGeometry )
+            {
+                const std::string& name ( M_appendedGeometries[iGeometry].name );
+                composeVTKCollection ( name, buffer );
+
+                std::string filename ( this->M_postDir + this->M_prefix + name + ".pvd" );
+                std::ofstream vtkCollectionFile;
+                vtkCollectionFile.open ( filename.c_str() );
+                ASSERT (vtkCollectionFile.is_open(), "There is an error while opening " + filename );
+                ASSERT (vtkCollectionFile.good(), "There is an error while writing to " + filename );
+                vtkCollectionFile << buffer.str();
+                vtkCollectionFile.close();
+
+                buffer.str ("");
+            }
+
             for (typename super::dataVectorIterator_Type iData = this->M_dataVector.begin();
                     iData != this->M_dataVector.end(); ++iData)
             {
+                if ( M_exportMode == APPENDED_EXPORT && iData->where() == exporterData_Type::Node )
+                {
+                    continue;
+                }
+
                 composeVTKCollection ( iData->variableName(), buffer );
 
                 std::string filename ( this->M_postDir + this->M_prefix + "_" + iData->variableName() + ".pvd" );
@@ -509,9 +694,20 @@ void ExporterVTK<MeshType>::postProcess (const Real& time)
 
         this->M_timeSteps.push_back (time);
 
+        if ( M_exportMode == APPENDED_EXPORT )
+        {
+            postProcessAppended();
+        }
+
         for (typename super::dataVectorIterator_Type iData = this->M_dataVector.begin();
                 iData != this->M_dataVector.end(); ++iData)
         {
+            // node data are written by postProcessAppended
+            if ( M_exportMode == APPENDED_EXPORT && iData->where() == exporterData_Type::Node )
+            {
+                continue;
+            }
+
             std::ofstream vtkFile;
             std::stringstream buffer ("");
 
@@ -706,6 +902,7 @@ ExporterVTK<MeshType>::composeDataArrayStream (const exporterData_Type& dvar,
             formatString = "ascii";
             break;
         case BINARY_EXPORT:
+        case APPENDED_EXPORT:
             formatString = "binary";
             dataToBeEncoded.write ( reinterpret_cast<char*> ( &lengthOfRawData ),
                                     sizeof (int32_type) );
@@ -738,6 +935,7 @@ ExporterVTK<MeshType>::composeDataArrayStream (const exporterData_Type& dvar,
             }
             break;
         case BINARY_EXPORT:
+        case APPENDED_EXPORT:
             for (UInt iDOF = 0; iDOF < numMyDOF; ++iDOF)
             {
                 const Int id = localToGlobalMap.find (iDOF)->second;
@@ -784,6 +982,13 @@ ExporterVTK<MeshType>::readVTUFiles ( exporterData_Type& dvar )
 {
     ASSERT ( this->M_numImportProc, "The number of pieces to be loaded was not specified." );
 
+    // node data are stored in the files of their geometry
+    if ( M_exportMode == APPENDED_EXPORT && dvar.where() == exporterData_Type::Node )
+    {
+        readAppendedVTUFiles ( dvar );
+        return;
+    }
+
     UInt numPoints, numCells;
     std::vector<Real> inputValues;
     std::vector<Real> globalIDs;
@@ -885,6 +1090,229 @@ ExporterVTK<MeshType>::readVTUFiles ( exporterData_Type& dvar )
 }
 
 
+template <typename MeshType>
+void
+ExporterVTK<MeshType>::readAppendedVTUFiles ( exporterData_Type& dvar )
+{
+    const UInt start        ( dvar.start() );
+    const UInt numGlobalDOF ( dvar.numDOF() );
+    const UInt fieldDim     ( dvar.fieldDim() );
+
+    const std::string arrayName ( "Name=\"" + dvar.variableName() + "\"" );
+    const std::string pieceName ( this->M_prefix + appendedGeometryName ( dvar ) + this->M_postfix );
+
+    // Each processor will read all the files, and fill just its own component of the vectors
+    for ( UInt iProc = 0; iProc < this->M_numImportProc; ++iProc )
+    {
+        std::ostringstream procId;
+        procId << iProc;
+        std::string filename ( this->M_postDir + pieceName + "." + procId.str() + ".vtu" );
+        std::ifstream inputFile ( filename.c_str(), std::ios::in | std::ios::binary );
+
+        if (this->M_procId == 0)
+        {
+            std::cout << "\tfile " << filename << std::endl;
+        }
+
+        ASSERT (inputFile.is_open(), "There is an error while opening " + filename );
+
+        // parse the XML header, up to the AppendedData section
+        UInt numPoints (0);
+        UInt numBitsFloat (0);
+        bool compressed (false);
+        std::streamoff valuesOffset (-1), globalIdOffset (-1);
+
+        std::string line;
+        std::stringstream parseLine;
+        size_t found;
+
+        while ( inputFile.good() && getline ( inputFile, line ) && line.find ( "<AppendedData" ) == std::string::npos )
+        {
+            if ( line.find ( "vtkZLibDataCompressor" ) != std::string::npos )
+            {
+                compressed = true;
+            }
+
+            found = line.find ( "NumberOfPoints" );
+            if ( found != std::string::npos )
+            {
+                found = line.find ( "\"", found, 1 );
+                parseLine.clear();
+                parseLine.str ( line.substr (found + 1) );
+                parseLine >> numPoints;
+            }
+
+            if ( line.find ( arrayName ) != std::string::npos || line.find ( "Name=\"GlobalId\"" ) != std::string::npos )
+            {
+                found = line.find ( "offset=\"" );
+                ASSERT ( found != std::string::npos, "The data arrays of " + filename + " are not appended" );
+                std::streamoff offset;
+                parseLine.clear();
+                parseLine.str ( line.substr (found + 8) );
+                parseLine >> offset;
+
+                if ( line.find ( arrayName ) != std::string::npos )
+                {
+                    valuesOffset = offset;
+                    numBitsFloat = ( line.find ( "Float32" ) != std::string::npos ) ? 32 : 64;
+                }
+                else
+                {
+                    globalIdOffset = offset;
+                }
+            }
+        }
+
+        ASSERT ( valuesOffset >= 0, "The variable " + dvar.variableName() + " is not in " + filename );
+        ASSERT ( globalIdOffset >= 0, "The global IDs are not in " + filename );
+
+        // the raw data start after the underscore
+        char character (0);
+        while ( inputFile.good() && character != '_' )
+        {
+            inputFile.get ( character );
+        }
+        ASSERT ( inputFile.good(), "There is an error while reading " + filename );
+        const std::streampos dataPosition ( inputFile.tellg() );
+
+        std::vector<char> block;
+        std::vector<Real> inputValues ( fieldDim * numPoints );
+        readAppendedBlock ( inputFile, dataPosition + valuesOffset, compressed, block );
+        if ( numBitsFloat == 32 )
+        {
+            ASSERT ( block.size() == inputValues.size() * sizeof (float), "Inconsistent size of data!" );
+            const float* values ( reinterpret_cast<const float*> ( block.empty() ? 0 : &block[0] ) );
+            inputValues.assign ( values, values + inputValues.size() );
+        }
+        else
+        {
+            ASSERT ( block.size() == inputValues.size() * sizeof (Real), "Inconsistent size of data!" );
+            const Real* values ( reinterpret_cast<const Real*> ( block.empty() ? 0 : &block[0] ) );
+            inputValues.assign ( values, values + inputValues.size() );
+        }
+
+        readAppendedBlock ( inputFile, dataPosition + globalIdOffset, compressed, block );
+        ASSERT ( block.size() == numPoints * sizeof (int32_type), "Inconsistent size of data!" );
+        const int32_type* globalIDs ( reinterpret_cast<const int32_type*> ( block.empty() ? 0 : &block[0] ) );
+
+        for (UInt iPoint = 0; iPoint < numPoints; ++iPoint)
+        {
+            const Int id = globalIDs[iPoint];
+            if ( dvar.feSpacePtr()->map().map (Repeated)->MyGID ( id ) )
+            {
+                for (UInt iCoor = 0; iCoor < fieldDim; ++iCoor)
+                {
+                    dvar ( start + id + iCoor * numGlobalDOF ) =
+                        inputValues[ iPoint * fieldDim + iCoor ];
+                }
+            }
+        }
+        inputFile.close();
+    }
+}
+
+
+template <typename MeshType>
+std::string
+ExporterVTK<MeshType>::appendedGeometryName ( const exporterData_Type& dvar ) const
+{
+    // first FE space of each geometry
+    std::vector<const typename super::feSpace_Type*> geometries;
+
+    for (typename super::dataVector_Type::const_iterator iData = this->M_dataVector.begin();
+            iData != this->M_dataVector.end(); ++iData)
+    {
+        if ( iData->where() != exporterData_Type::Node )
+        {
+            continue;
+        }
+
+        UInt iGeometry (0);
+        while ( iGeometry < geometries.size() &&
+                geometries[iGeometry]->refFE().type() != iData->feSpacePtr()->refFE().type() )
+        {
+            ++iGeometry;
+        }
+
+        if ( iGeometry == geometries.size() )
+        {
+            geometries.push_back ( iData->feSpacePtr().get() );
+        }
+
+        if ( iData->variableName() == dvar.variableName() )
+        {
+            if ( iGeometry == 0 )
+            {
+                return "";
+            }
+            std::ostringstream name;
+            name << "_" << iGeometry;
+            return name.str();
+        }
+    }
+
+    ERROR_MSG ( "The variable " + dvar.variableName() + " has not been added" );
+    return "";
+}
+
+
+template <typename MeshType>
+void
+ExporterVTK<MeshType>::readAppendedBlock ( std::ifstream& inputFile, const std::streampos& position,
+                                           const bool compressed, std::vector<char>& block ) const
+{
+    inputFile.seekg ( position );
+
+    if ( !compressed )
+    {
+        uint32_type numBytes (0);
+        inputFile.read ( reinterpret_cast<char*> ( &numBytes ), sizeof (uint32_type) );
+        block.resize ( numBytes );
+        if ( numBytes > 0 )
+        {
+            inputFile.read ( &block[0], numBytes );
+        }
+        ASSERT ( inputFile.good(), "There is an error while reading an appended block" );
+        return;
+    }
+
+#ifdef HAVE_ZLIB
+    // header of vtkZLibDataCompressor: number of blocks, size of the blocks,
+    // size of the last block (0 if full) and compressed size of each block
+    uint32_type header[3];
+    inputFile.read ( reinterpret_cast<char*> ( header ), 3 * sizeof (uint32_type) );
+    const uint32_type numBlocks ( header[0] );
+    const uint32_type blockSize ( header[1] );
+    const uint32_type lastBlockSize ( header[2] == 0 ? blockSize : header[2] );
+
+    std::vector<uint32_type> compressedSizes ( numBlocks );
+    if ( numBlocks > 0 )
+    {
+        inputFile.read ( reinterpret_cast<char*> ( &compressedSizes[0] ), numBlocks * sizeof (uint32_type) );
+    }
+
+    block.resize ( numBlocks > 0 ? ( numBlocks - 1 ) * blockSize + lastBlockSize : 0 );
+
+    std::vector<Bytef> compressedData;
+    UInt blockOffset (0);
+    for ( UInt iBlock = 0; iBlock < numBlocks; ++iBlock )
+    {
+        compressedData.resize ( compressedSizes[iBlock] );
+        inputFile.read ( reinterpret_cast<char*> ( &compressedData[0] ), compressedSizes[iBlock] );
+
+        uLongf size ( iBlock + 1 == numBlocks ? lastBlockSize : blockSize );
+        const int status = uncompress ( reinterpret_cast<Bytef*> ( &block[blockOffset] ), &size,
+                                        &compressedData[0], compressedSizes[iBlock] );
+        ASSERT ( status == Z_OK, "Decompression of the VTK data failed" );
+        blockOffset += size;
+    }
+    ASSERT ( inputFile.good(), "There is an error while reading an appended block" );
+#else
+    ERROR_MSG ( "Reading compressed VTK files requires zlib" );
+#endif
+}
+
+
 template <typename MeshType>
 void
 ExporterVTK<MeshType>::readBinaryData ( const std::string& line, std::vector<Real>& values, const UInt& numBits )
@@ -1116,6 +1544,7 @@ void ExporterVTK<MeshType>::composePVTUStream (const exporterData_Type& dvar,
             formatString = "ascii";
             break;
         case BINARY_EXPORT:
+        case APPENDED_EXPORT:
             formatString = "binary";
             break;
         default:
@@ -1415,5 +1844,460 @@ ExporterVTK<MeshType>::composeTypeDataFooterStream (where_Type where,
     dataFooterStringStream << "\t\t\t</" << whereString << ">\n";
 }
 
+
+// ===================
+// Appended mode
+// ===================
+
+template <typename MeshType>
+void ExporterVTK<MeshType>::postProcessAppended()
+{
+    updateAppendedGeometries();
+
+    for ( UInt iGeometry = 0; iGeometry < M_appendedGeometries.size(); ++iGeometry )
+    {
+        appendedGeometry_Type& geometry ( M_appendedGeometries[iGeometry] );
+
+        if ( geometry.variables.empty() )
+        {
+            continue;
+        }
+
+        // with a moving mesh the coordinates have to be encoded at each step
+        if ( this->M_multimesh )
+        {
+            composeAppendedPointsBlock ( geometry );
+        }
+
+        const std::string pieceName ( this->M_prefix + geometry.name + this->M_postfix );
+
+        // a unique PVTU file + a time collection is produced by the leader process
+        if ( this->M_procId == 0 )
+        {
+            std::stringstream buffer ("");
+            composeAppendedPVTUStream ( geometry, pieceName, buffer );
+
+            std::string vtkPFileName ( pieceName + ".pvtu" );
+            std::string vtkPFileNameWithDir ( this->M_postDir + vtkPFileName );
+
+            std::ofstream vtkPFile;
+            vtkPFile.open ( vtkPFileNameWithDir.c_str() );
+            ASSERT (vtkPFile.is_open(), "There is an error while opening " + vtkPFileName );
+            ASSERT (vtkPFile.good(), "There is an error while writing to " + vtkPFileName );
+            vtkPFile << buffer.str();
+            vtkPFile.close();
+
+            M_pvtuFiles[geometry.name].push_back (vtkPFileName);
+        }
+
+        // only the data arrays are computed at each step
+        const UInt numVariables ( geometry.variables.size() );
+        std::vector<std::string> dataBlocks ( numVariables );
+        for ( UInt iVariable = 0; iVariable < numVariables; ++iVariable )
+        {
+            composeAppendedDataBlock ( *geometry.variables[iVariable], geometry, dataBlocks[iVariable] );
+        }
+
+        const UInt numPoints ( geometry.localToGlobalPoints.size() );
+        const UInt numElements ( this->M_mesh->numElements() );
+        const std::string floatType ( vtkFloatType() );
+
+        std::stringstream buffer ("");
+        UInt offset (0);
+
+        buffer << "<?xml version=\"1.0\"?>\n";
+        buffer << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\"";
+        if ( M_compress )
+        {
+            buffer << " compressor=\"vtkZLibDataCompressor\"";
+        }
+        buffer << ">\n";
+        buffer << "\t<UnstructuredGrid>\n";
+        buffer << "\t\t<Piece NumberOfPoints=\"" << numPoints << "\""
+               << " NumberOfCells=\"" << numElements << "\">\n";
+
+        buffer << "\t\t\t<Points>\n";
+        buffer << "\t\t\t\t<DataArray type=\"" << floatType << "\" NumberOfComponents=\"" << nDimensions
+               << "\" format=\"appended\" offset=\"" << offset << "\"/>\n";
+        offset += geometry.pointsBlock.size();
+        buffer << "\t\t\t</Points>\n";
+
+        buffer << "\t\t\t<Cells>\n";
+        buffer << "\t\t\t\t<DataArray type=\"Int32\" Name=\"connectivity\" format=\"appended\" offset=\""
+               << offset << "\"/>\n";
+        offset += geometry.connectivityBlock.size();
+        buffer << "\t\t\t\t<DataArray type=\"Int32\" Name=\"offsets\" format=\"appended\" offset=\""
+               << offset << "\"/>\n";
+        offset += geometry.offsetsBlock.size();
+        buffer << "\t\t\t\t<DataArray type=\"UInt8\" Name=\"types\" format=\"appended\" offset=\""
+               << offset << "\"/>\n";
+        offset += geometry.typesBlock.size();
+        buffer << "\t\t\t</Cells>\n";
+
+        buffer << "\t\t\t<PointData>\n";
+        for ( UInt iVariable = 0; iVariable < numVariables; ++iVariable )
+        {
+            buffer << "\t\t\t\t<DataArray type=\"" << floatType << "\" Name=\""
+                   << geometry.variables[iVariable]->variableName() << "\" NumberOfComponents=\""
+                   << geometry.variables[iVariable]->fieldDim() << "\" format=\"appended\" offset=\""
+                   << offset << "\"/>\n";
+            offset += dataBlocks[iVariable].size();
+        }
+        buffer << "\t\t\t\t<DataArray type=\"Int32\" Name=\"GlobalId\" NumberOfComponents=\"1\" "
+               << "format=\"appended\" offset=\"" << offset << "\"/>\n";
+        buffer << "\t\t\t</PointData>\n";
+
+        buffer << "\t\t</Piece>\n";
+        buffer << "\t</UnstructuredGrid>\n";
+        buffer << "\t<AppendedData encoding=\"raw\">\n_";
+
+        // each process writes its own file
+        std::ostringstream procId;
+        procId << this->M_procId;
+        std::string filename ( this->M_postDir + pieceName + "." + procId.str() + ".vtu" );
+
+        std::ofstream vtkFile;
+        vtkFile.open ( filename.c_str(), std::ios::out | std::ios::binary );
+        ASSERT (vtkFile.is_open(), "There is an error while opening " + filename );
+        ASSERT (vtkFile.good(), "There is an error while writing to " + filename );
+
+        vtkFile << buffer.str();
+        vtkFile.write ( geometry.pointsBlock.data(), geometry.pointsBlock.size() );
+        vtkFile.write ( geometry.connectivityBlock.data(), geometry.connectivityBlock.size() );
+        vtkFile.write ( geometry.offsetsBlock.data(), geometry.offsetsBlock.size() );
+        vtkFile.write ( geometry.typesBlock.data(), geometry.typesBlock.size() );
+        for ( UInt iVariable = 0; iVariable < numVariables; ++iVariable )
+        {
+            vtkFile.write ( dataBlocks[iVariable].data(), dataBlocks[iVariable].size() );
+        }
+        vtkFile.write ( geometry.globalIdBlock.data(), geometry.globalIdBlock.size() );
+        vtkFile << "\n\t</AppendedData>\n";
+        vtkFile << "</VTKFile>\n";
+        vtkFile.close();
+    }
+}
+
+
+template <typename MeshType>
+void ExporterVTK<MeshType>::updateAppendedGeometries()
+{
+    ASSERT ( this->M_mesh.get(), "\nA pointer to a valid mesh object is required!");
+
+    // a new mesh requires new geometries
+    if ( this->M_mesh.get() != M_appendedMesh )
+    {
+        M_appendedGeometries.clear();
+        M_appendedMesh = this->M_mesh.get();
+    }
+
+    for ( UInt iGeometry = 0; iGeometry < M_appendedGeometries.size(); ++iGeometry )
+    {
+        M_appendedGeometries[iGeometry].variables.clear();
+    }
+
+    for (typename super::dataVectorIterator_Type iData = this->M_dataVector.begin();
+            iData != this->M_dataVector.end(); ++iData)
+    {
+        if ( iData->where() != exporterData_Type::Node )
+        {
+            continue;
+        }
+
+        // the variables on the same kind of finite element share the points
+        UInt iGeometry (0);
+        while ( iGeometry < M_appendedGeometries.size() &&
+                M_appendedGeometries[iGeometry].feSpacePtr->refFE().type() != iData->feSpacePtr()->refFE().type() )
+        {
+            ++iGeometry;
+        }
+
+        if ( iGeometry == M_appendedGeometries.size() )
+        {
+            M_appendedGeometries.push_back ( appendedGeometry_Type() );
+            appendedGeometry_Type& geometry ( M_appendedGeometries.back() );
+
+            geometry.feSpacePtr = iData->feSpacePtr();
+            if ( iGeometry > 0 )
+            {
+                std::ostringstream name;
+                name << "_" << iGeometry;
+                geometry.name = name.str();
+            }
+
+            buildAppendedGeometry ( geometry );
+        }
+
+        M_appendedGeometries[iGeometry].variables.push_back ( & (*iData) );
+    }
+}
+
+
+template <typename MeshType>
+void ExporterVTK<MeshType>::buildAppendedGeometry ( appendedGeometry_Type& geometry )
+{
+    const feSpacePtr_Type& feSpacePtr ( geometry.feSpacePtr );
+    ASSERT ( feSpacePtr.get(), "\nA pointer to a valid FESpace object is required!");
+
+    const UInt numVertices ( this->M_mesh->numVertices() );
+    const UInt numElements ( this->M_mesh->numElements() );
+    const UInt numLocalVertices ( feSpacePtr->dof().numLocalVertices() );
+    const UInt numLocalDof ( feSpacePtr->dof().numLocalDof() );
+
+    // careful: the vertex map in the mesh is repeated. to know how many non vertex dofs I have
+    // in the partitioned mesh I need to look at repeated maps
+    const UInt numPoints ( feSpacePtr->map().map (Repeated)->NumMyElements() / feSpacePtr->fieldDim() );
+
+    // this map is needed only to build the connectivity: a hash table, since it is
+    // queried for every DOF of every element
+    boost::unordered_map<UInt, UInt> globalToLocalPointsMap;
+    globalToLocalPointsMap.rehash ( numPoints );
+
+    geometry.localToGlobalPoints.clear();
+    geometry.localToGlobalPoints.reserve ( numPoints );
+    geometry.nonVertexPoints.clear();
+
+    // Vertex based Dof: the points are ordered as in the Point List
+    for ( UInt iVertex = 0; iVertex < numVertices; ++iVertex )
+    {
+        const UInt globalPointId ( this->M_mesh->point (iVertex).id() );
+        globalToLocalPointsMap.insert ( std::make_pair ( globalPointId, iVertex ) );
+        geometry.localToGlobalPoints.push_back ( globalPointId );
+    }
+
+    // The other Dof are numbered when first found in the elements
+    for ( UInt iElement = 0; iElement < numElements; ++iElement )
+    {
+        for ( UInt iPoint = numLocalVertices; iPoint < numLocalDof; ++iPoint )
+        {
+            const UInt globalPointId ( feSpacePtr->dof().localToGlobalMap ( iElement, iPoint ) );
+            if ( globalToLocalPointsMap.insert ( std::make_pair ( globalPointId,
+                                                                  geometry.localToGlobalPoints.size() ) ).second )
+            {
+                geometry.localToGlobalPoints.push_back ( globalPointId );
+                geometry.nonVertexPoints.push_back ( std::make_pair ( iElement, iPoint ) );
+            }
+        }
+    }
+    ASSERT ( geometry.localToGlobalPoints.size() == numPoints, "didn't store all points in the maps" );
+
+    // Connectivity, offsets and types of the cells
+    std::vector<int32_type> connectivity ( numElements * numLocalDof );
+    std::vector<int32_type> offsets ( numElements );
+    std::vector<uint8_type> types ( numElements, static_cast<uint8_type> ( whichCellType ( feSpacePtr ) ) );
+
+    for ( UInt iElement = 0; iElement < numElements; ++iElement )
+    {
+        for ( UInt jPoint = 0; jPoint < numLocalDof; ++jPoint )
+        {
+            const UInt globalPointId ( feSpacePtr->dof().localToGlobalMap ( iElement, jPoint ) );
+            connectivity[iElement * numLocalDof + jPoint] = globalToLocalPointsMap.find ( globalPointId )->second;
+        }
+        offsets[iElement] = ( iElement + 1 ) * numLocalDof;
+    }
+
+    std::vector<int32_type> globalIds ( geometry.localToGlobalPoints.begin(), geometry.localToGlobalPoints.end() );
+
+    encodeAppendedBlock ( connectivity.empty() ? 0 : &connectivity[0], connectivity.size() * sizeof (int32_type), geometry.connectivityBlock );
+    encodeAppendedBlock ( offsets.empty() ? 0 : &offsets[0], offsets.size() * sizeof (int32_type), geometry.offsetsBlock );
+    encodeAppendedBlock ( types.empty() ? 0 : &types[0], types.size() * sizeof (uint8_type), geometry.typesBlock );
+    encodeAppendedBlock ( globalIds.empty() ? 0 : &globalIds[0], globalIds.size() * sizeof (int32_type), geometry.globalIdBlock );
+
+    composeAppendedPointsBlock ( geometry );
+}
+
+
+template <typename MeshType>
+void ExporterVTK<MeshType>::composeAppendedPointsBlock ( appendedGeometry_Type& geometry )
+{
+    const feSpacePtr_Type& feSpacePtr ( geometry.feSpacePtr );
+    const UInt numVertices ( this->M_mesh->numVertices() );
+    const UInt numPoints ( geometry.localToGlobalPoints.size() );
+
+    std::vector<Real> coordinates ( nDimensions * numPoints );
+
+    // Vertex based Dof: the coordinates are available from the Point List
+    for ( UInt iVertex = 0; iVertex < numVertices; ++iVertex )
+    {
+        for ( UInt jCoor = 0; jCoor < nDimensions; ++jCoor )
+        {
+            coordinates[iVertex * nDimensions + jCoor] = this->M_mesh->point (iVertex).coordinate (jCoor);
+        }
+    }
+
+    // The other Dof: the coordinates are computed with the geometric map of their element
+    Real x, y, z;
+    for ( UInt iPoint = 0; iPoint < geometry.nonVertexPoints.size(); ++iPoint )
+    {
+        const UInt iElement ( geometry.nonVertexPoints[iPoint].first );
+        const UInt iDof ( geometry.nonVertexPoints[iPoint].second );
+
+        feSpacePtr->fe().update ( this->M_mesh->element ( iElement ), UPDATE_ONLY_CELL_NODES );
+        feSpacePtr->fe().coorMap ( x, y, z,
+                                   feSpacePtr->fe().refFE().xi ( iDof ),
+                                   feSpacePtr->fe().refFE().eta ( iDof ),
+                                   feSpacePtr->fe().refFE().zeta ( iDof ) );
+
+        const UInt position ( ( numVertices + iPoint ) * nDimensions );
+        coordinates[position] = x;
+        coordinates[position + 1] = y;
+        coordinates[position + 2] = z;
+    }
+
+    if ( M_floatPrecision == SINGLE_PRECISION )
+    {
+        std::vector<float> singleCoordinates ( coordinates.begin(), coordinates.end() );
+        encodeAppendedBlock ( singleCoordinates.empty() ? 0 : &singleCoordinates[0],
+                              singleCoordinates.size() * sizeof (float), geometry.pointsBlock );
+    }
+    else
+    {
+        encodeAppendedBlock ( coordinates.empty() ? 0 : &coordinates[0],
+                              coordinates.size() * sizeof (Real), geometry.pointsBlock );
+    }
+}
+
+
+template <typename MeshType>
+void ExporterVTK<MeshType>::composeAppendedDataBlock ( const exporterData_Type& dvar,
+                                                       const appendedGeometry_Type& geometry,
+                                                       std::string& block ) const
+{
+    if ( M_floatPrecision == SINGLE_PRECISION )
+    {
+        std::vector<float> values;
+        fillAppendedValues ( dvar, geometry, values );
+        encodeAppendedBlock ( values.empty() ? 0 : &values[0], values.size() * sizeof (float), block );
+    }
+    else
+    {
+        std::vector<Real> values;
+        fillAppendedValues ( dvar, geometry, values );
+        encodeAppendedBlock ( values.empty() ? 0 : &values[0], values.size() * sizeof (Real), block );
+    }
+}
+
+
+template <typename MeshType>
+template <typename FloatType>
+void ExporterVTK<MeshType>::fillAppendedValues ( const exporterData_Type& dvar,
+                                                 const appendedGeometry_Type& geometry,
+                                                 std::vector<FloatType>& values ) const
+{
+    const UInt start        ( dvar.start() );
+    const UInt numGlobalDOF ( dvar.numDOF() );
+    const UInt fieldDim     ( dvar.fieldDim() );
+    const UInt numMyDOF     ( geometry.localToGlobalPoints.size() );
+
+    values.resize ( fieldDim * numMyDOF );
+
+    for ( UInt iDOF = 0; iDOF < numMyDOF; ++iDOF )
+    {
+        const UInt id ( geometry.localToGlobalPoints[iDOF] );
+        for ( UInt iCoor = 0; iCoor < fieldDim; ++iCoor )
+        {
+            values[iDOF * fieldDim + iCoor] = dvar ( start + id + iCoor * numGlobalDOF );
+        }
+    }
+}
+
+
+template <typename MeshType>
+void ExporterVTK<MeshType>::encodeAppendedBlock ( const void* data, const UInt numBytes, std::string& block ) const
+{
+    block.clear();
+
+#ifdef HAVE_ZLIB
+    if ( M_compress )
+    {
+        // header of vtkZLibDataCompressor: number of blocks, size of the blocks,
+        // size of the last block (0 if full) and compressed size of each block
+        std::vector<Bytef> compressedData ( compressBound ( numBytes ) );
+        uLongf compressedSize ( compressedData.size() );
+        if ( numBytes > 0 )
+        {
+            const int status = compress2 ( &compressedData[0], &compressedSize,
+                                           static_cast<const Bytef*> ( data ), numBytes,
+                                           Z_DEFAULT_COMPRESSION );
+            ASSERT ( status == Z_OK, "Compression of the VTK data failed" );
+        }
+
+        const uint32_type header[4] = { numBytes > 0 ? 1u : 0u, numBytes, 0u,
+                                        numBytes > 0 ? static_cast<uint32_type> ( compressedSize ) : 0u
+                                      };
+        const UInt headerSize ( numBytes > 0 ? 4 : 3 );
+
+        block.append ( reinterpret_cast<const char*> ( header ), headerSize * sizeof (uint32_type) );
+        if ( numBytes > 0 )
+        {
+            block.append ( reinterpret_cast<const char*> ( &compressedData[0] ), compressedSize );
+        }
+        return;
+    }
+#endif
+
+    const uint32_type header ( numBytes );
+    block.reserve ( sizeof (uint32_type) + numBytes );
+    block.append ( reinterpret_cast<const char*> ( &header ), sizeof (uint32_type) );
+    if ( numBytes > 0 )
+    {
+        block.append ( static_cast<const char*> ( data ), numBytes );
+    }
+}
+
+
+template <typename MeshType>
+void ExporterVTK<MeshType>::composeAppendedPVTUStream ( const appendedGeometry_Type& geometry,
+                                                        const std::string& pieceName,
+                                                        std::stringstream& pVTUStringStream )
+{
+    const std::string floatType ( vtkFloatType() );
+
+    //header part of the file
+    pVTUStringStream << "<?xml version=\"1.0\"?>\n";
+    pVTUStringStream << "<VTKFile type=\"PUnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\">\n";
+    pVTUStringStream << "\t<PUnstructuredGrid GhostLevel=\"0\">\n";
+
+    pVTUStringStream << "\t\t<PPoints>\n";
+    pVTUStringStream << "\t\t\t<PDataArray type=\"" << floatType << "\" NumberOfComponents=\"" << nDimensions
+                     << "\"/>\n";
+    pVTUStringStream << "\t\t</PPoints>\n";
+
+    pVTUStringStream << "\t\t<PPointData>\n";
+    for ( UInt iVariable = 0; iVariable < geometry.variables.size(); ++iVariable )
+    {
+        pVTUStringStream << "\t\t\t<PDataArray type=\"" << floatType << "\" Name=\""
+                         << geometry.variables[iVariable]->variableName() << "\" NumberOfComponents=\""
+                         << geometry.variables[iVariable]->fieldDim() << "\"/>\n";
+    }
+    pVTUStringStream << "\t\t\t<PDataArray type=\"Int32\" Name=\"GlobalId\" NumberOfComponents=\"1\"/>\n";
+    pVTUStringStream << "\t\t</PPointData>\n";
+
+    for ( Int iProc = 0; iProc < geometry.feSpacePtr->map().comm().NumProc(); ++iProc )
+    {
+        //footer part of the file
+        pVTUStringStream << "\t\t<Piece Source=\"" << pieceName << "." << iProc << ".vtu\"/>\n";
+    }
+
+    pVTUStringStream << "\t</PUnstructuredGrid>\n";
+    pVTUStringStream << "</VTKFile>\n";
+}
+
+
+template <typename MeshType>
+std::string ExporterVTK<MeshType>::vtkFloatType() const
+{
+    switch ( M_floatPrecision )
+    {
+        case SINGLE_PRECISION:
+            return "Float32";
+        case DOUBLE_PRECISION:
+            return "Float64";
+        default:
+            ERROR_MSG ( "unmanaged float type" );
+            break;
+    }
+    return "";
+}
+
 }
 #endif // define EXPORTERVTK_H
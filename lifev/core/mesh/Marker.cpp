@@ -43,6 +43,12 @@ namespace LifeV
 //                                           IMPLEMENTATION
 //  ***********************************************************************************************************
 
+//////////////////////
+// MarkerIDRevision //
+//////////////////////
+
+MarkerIDRevision::revision_Type MarkerIDRevision::S_revision = 0;
+
 ///////////////////////
 // MarkerIDStandardPolicy //
 ///////////////////////
@@ -67,6 +67,7 @@
 #define MARKER_H 1
 
 #include <iostream>
+#include <boost/cstdint.hpp>
 #include <lifev/core/LifeV.hpp>
 namespace LifeV
 {
@@ -124,6 +125,48 @@ public:
 
 };
 
+//! MarkerIDRevision - Counter of the changes of the marker IDs
+/*!
+  It is increased whenever the marker ID of an entity is set, copied or unset, so that the data
+  built from the marker IDs (e.g. the lists of entities by marker of RegionMesh) can tell that
+  they are outdated and have to be built again.
+
+  The entities do not know the mesh they belong to, so that the counter is shared by all the
+  meshes: a change of a marker in one mesh makes the data of all the meshes outdated. This only
+  costs a rebuild of the lists, which are correct in any case. The counter is 64 bit, so that it
+  does not wrap around, and it is changed and read atomically by the OpenMP threads.
+ */
+class MarkerIDRevision
+{
+public:
+
+    typedef boost::uint64_t revision_Type;
+
+    //! Current revision
+    static revision_Type current()
+    {
+        revision_Type revision;
+#ifdef _OPENMP
+        #pragma omp atomic read
+#endif
+        revision = S_revision;
+        return revision;
+    }
+
+    //! Record a change of a marker ID
+    static void increase()
+    {
+#ifdef _OPENMP
+        #pragma omp atomic
+#endif
+        ++S_revision;
+    }
+
+private:
+
+    static revision_Type S_revision;
+};
+
 //! Marker - Base marker class.
 /*!
   It stores an object of markerID_Type which may be used for marking a geometric entity.
@@ -174,6 +217,14 @@ public:
 
     //@}
 
+    //! @name Operators
+    //@{
+
+    //! Assignment operator
+    Marker<MarkerIDPolicy>& operator= ( Marker<MarkerIDPolicy> const& markerBase );
+
+    //@}
+
     //! @name Methods
     //@{
 
@@ -287,9 +338,17 @@ markerID_Type const& Marker<MarkerIDPolicy>::nullMarkerID()
     return MarkerIDPolicy::S_NULLMARKERID;
 }
 
+template <typename MarkerIDPolicy>
+Marker<MarkerIDPolicy>& Marker<MarkerIDPolicy>::operator= ( Marker<MarkerIDPolicy> const& markerBase )
+{
+    setMarkerID ( markerBase.markerID() );
+    return *this;
+}
+
 template <typename MarkerIDPolicy>
 markerID_Type Marker<MarkerIDPolicy>::setMarkerID ( markerID_Type const& markerID )
 {
+    MarkerIDRevision::increase();
     return M_markerID = markerID;
 }
 
@@ -321,7 +380,7 @@ markerID_Type Marker<MarkerIDPolicy>::setStrongerMarkerID ( markerID_Type const&
 {
     if ( isMarkerUnset() )
     {
-        return M_markerID = markerID;
+        return setMarkerID ( markerID );
     }
     return setMarkerID ( MarkerIDPolicy::strongerMarkerID ( this->markerID(), markerID ) );
 }
@@ -331,7 +390,7 @@ markerID_Type Marker<MarkerIDPolicy>::setWeakerMarkerID ( markerID_Type const& m
 {
     if ( isMarkerUnset() )
     {
-        return M_markerID = markerID;
+        return setMarkerID ( markerID );
     }
     return setMarkerID ( MarkerIDPolicy::weakerMarkerID ( this->markerID(), markerID ) );
 }
@@ -351,6 +410,7 @@ bool Marker<MarkerIDPolicy>::isMarkerUnset() const
 template <typename MarkerIDPolicy>
 void Marker<MarkerIDPolicy>::unsetMarkerID()
 {
+    MarkerIDRevision::increase();
     M_markerID = nullMarkerID();
 }
 
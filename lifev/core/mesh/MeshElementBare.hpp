@@ -121,6 +121,7 @@
 
 #include <utility>
 #include <algorithm>
+#include <vector>
 
 #include <lifev/core/LifeV.hpp>
 #include <lifev/core/mesh/ElementShapes.hpp>
@@ -785,5 +786,189 @@ MeshElementBareHandler<BareItemType>::setId ( const bareItem_Type& item, ID cons
 // ===================================================
 
 
+
+//! MeshElementBareOccurrence - A bare item met while looping on the mesh elements
+/*!
+    It stores the bare item, the ID of the element where it has been met, the
+    local position of the item in the element and the order of the visit.
+    Sorting a list of occurrences (see cmpBareItemOccurrence) gathers the
+    occurrences of the same item, in the order of the visits: it replaces the
+    insertion of the items in a std::map while looping on the elements.
+ */
+template <typename BareItemType>
+struct MeshElementBareOccurrence
+{
+    //! @name Constructor & Destructor
+    //@{
+    //! Constructor
+    /*!
+        @param bareItem the item
+        @param elementId ID of the element
+        @param localId local position of the item in the element
+        @param visit order of the visit
+        @param flag additional information on the visit
+     */
+    MeshElementBareOccurrence ( const BareItemType& bareItem, const ID& elementId, const ID& localId,
+                                const UInt& visit, const bool& flag = false ) :
+        item ( bareItem ),
+        elementIdentity ( elementId ),
+        elementPosition ( localId ),
+        visitOrder ( visit ),
+        visitFlag ( flag )
+    {}
+    //@}
+
+    BareItemType item;            //!< The bare item
+    ID           elementIdentity; //!< ID of the element
+    ID           elementPosition; //!< Local position of the item in the element
+    UInt         visitOrder;      //!< Order of the visit
+    bool         visitFlag;       //!< Additional information on the visit
+};
+
+/*! \ingroup comparison
+  \brief Functor for the occurrences: by item, then by order of the visit
+ */
+template <typename BareItemType>
+struct cmpBareItemOccurrence
+{
+    bool operator() ( const MeshElementBareOccurrence<BareItemType>& occurrence1,
+                      const MeshElementBareOccurrence<BareItemType>& occurrence2 ) const
+    {
+        if ( cmpBareItem<BareItemType>() ( occurrence1.item, occurrence2.item ) )
+        {
+            return true;
+        }
+        if ( cmpBareItem<BareItemType>() ( occurrence2.item, occurrence1.item ) )
+        {
+            return false;
+        }
+        return occurrence1.visitOrder < occurrence2.visitOrder;
+    }
+};
+
+//! Tells if two bare items are equal
+template <typename BareItemType>
+inline
+bool
+sameBareItem ( const BareItemType& item1, const BareItemType& item2 )
+{
+    return ! cmpBareItem<BareItemType>() ( item1, item2 ) && ! cmpBareItem<BareItemType>() ( item2, item1 );
+}
+
+
+//! MeshElementBareTable class - A sorted table of bare items and their IDs
+/*!
+    It replaces a std::map<BareItemType, ID> when all the items are known before
+    they are searched: the items are stored contiguously and, once sorted, they
+    are searched by bisection. Used only in mesh builders.
+
+    Usage: add() all the items, then sort(), then find().
+ */
+template <typename BareItemType>
+class MeshElementBareTable
+{
+public:
+    //! @name Public Types
+    //@{
+    typedef BareItemType                       bareItem_Type;
+    typedef std::pair<bareItem_Type, ID>       value_Type;
+    typedef std::vector<value_Type>            container_Type;
+    //@}
+
+    //! @name Methods
+    //@{
+
+    //! Reserve the memory for a number of items
+    void reserve ( const UInt& size )
+    {
+        M_items.reserve ( size );
+    }
+
+    //! Add an item
+    /*!
+        @param item the item
+        @param id the ID of the item
+     */
+    void add ( const bareItem_Type& item, const ID& id )
+    {
+        M_items.push_back ( std::make_pair ( item, id ) );
+    }
+
+    //! Sort the items (and, among equal items, the IDs)
+    void sort()
+    {
+        std::sort ( M_items.begin(), M_items.end(), compare );
+    }
+
+    //! Position of an item in the sorted table
+    /*!
+        @param item Item we are looking for
+        @return the position of the (first) item, NotAnId if the item doesn't exist
+     */
+    UInt find ( const bareItem_Type& item ) const
+    {
+        typename container_Type::const_iterator i ( std::lower_bound ( M_items.begin(), M_items.end(),
+                                                                       std::make_pair ( item, static_cast<ID> ( 0 ) ),
+                                                                       compare ) );
+        if ( i != M_items.end() && sameBareItem ( i->first, item ) )
+        {
+            return static_cast<UInt> ( i - M_items.begin() );
+        }
+        return NotAnId;
+    }
+
+    //! Position of the first of two equal items in the sorted table
+    /*!
+        @return the position of the first duplicated item, NotAnId if the items are unique
+     */
+    UInt findDuplicate() const
+    {
+        for ( UInt i ( 1 ); i < M_items.size(); ++i )
+        {
+            if ( sameBareItem ( M_items[i - 1].first, M_items[i].first ) )
+            {
+                return i - 1;
+            }
+        }
+        return NotAnId;
+    }
+
+    //@}
+
+    //! @name Get Methods
+    //@{
+
+    //! The item (and its ID) in a position of the table
+    const value_Type& operator[] ( const UInt& position ) const
+    {
+        return M_items[position];
+    }
+
+    //! Number of items
+    UInt size() const
+    {
+        return M_items.size();
+    }
+
+    //@}
+
+private:
+
+    static bool compare ( const value_Type& value1, const value_Type& value2 )
+    {
+        if ( cmpBareItem<bareItem_Type>() ( value1.first, value2.first ) )
+        {
+            return true;
+        }
+        if ( cmpBareItem<bareItem_Type>() ( value2.first, value1.first ) )
+        {
+            return false;
+        }
+        return value1.second < value2.second;
+    }
+
+    container_Type M_items;
+};
+
 }
 #endif /* MESHELEMENTBARE_H */
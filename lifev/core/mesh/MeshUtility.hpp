@@ -40,6 +40,7 @@
 
 
 #include <algorithm>
+#include <vector>
 #include <iterator>
 
 #include <boost/numeric/ublas/matrix.hpp>
@@ -451,7 +452,7 @@ UInt findFaces ( const MeshType& mesh, temporaryFaceContainer_Type& boundaryFace
     BareFace                              bareFace;
     typename MeshType::elementShape_Type   volumeShape;
     typedef typename MeshType::volumes_Type    volumeContainer_Type;
-    temporaryFaceContainer_Type::iterator faceContainerIterator;
+    typedef MeshElementBareOccurrence<BareFace> faceOccurrence_Type;
 
     // clean first in case it has been already used
     boundaryFaceContainer.clear();
@@ -461,6 +462,11 @@ UInt findFaces ( const MeshType& mesh, temporaryFaceContainer_Type& boundaryFace
     }
     numInternalFaces = 0;
 
+    // Collect the faces of all the elements and sort them, so that the
+    // occurrences of the same face are contiguous, in the order of the visits
+    std::vector<faceOccurrence_Type> faceOccurrences;
+    faceOccurrences.reserve ( mesh.volumeList.size() * mesh.numLocalFaces() );
+
     for ( typename volumeContainer_Type::const_iterator volumeContainerIterator = mesh.volumeList.begin();
             volumeContainerIterator != mesh.volumeList.end(); ++volumeContainerIterator )
     {
@@ -484,22 +490,45 @@ UInt findFaces ( const MeshType& mesh, temporaryFaceContainer_Type& boundaryFace
                 bareFace = ( makeBareFace ( point1Id, point2Id, point3Id ) ).first;
             }
 
-            if ( ( faceContainerIterator = boundaryFaceContainer.find ( bareFace ) ) == boundaryFaceContainer.end() )
+            faceOccurrences.push_back ( faceOccurrence_Type ( bareFace, volumeContainerIterator->localId(), jFaceLocalId,
+                                                              faceOccurrences.size(), point1Id > point2Id ) );
+        }
+    }
+
+    std::sort ( faceOccurrences.begin(), faceOccurrences.end(), cmpBareItemOccurrence<BareFace>() );
+
+    // A face met twice is internal. The faces are found in increasing order,
+    // thus they are appended at the end of the containers
+    typename std::vector<faceOccurrence_Type>::const_iterator firstOccurrence ( faceOccurrences.begin() );
+    while ( firstOccurrence != faceOccurrences.end() )
+    {
+        typename std::vector<faceOccurrence_Type>::const_iterator openOccurrence ( faceOccurrences.end() );
+        typename std::vector<faceOccurrence_Type>::const_iterator occurrence ( firstOccurrence );
+        for ( ; occurrence != faceOccurrences.end() && sameBareItem ( occurrence->item, firstOccurrence->item ); ++occurrence )
+        {
+            if ( openOccurrence == faceOccurrences.end() )
             {
-                boundaryFaceContainer.insert (
-                    std::make_pair ( bareFace, std::make_pair ( volumeContainerIterator->localId(), jFaceLocalId ) ) );
+                openOccurrence = occurrence;
             }
             else
             {
-                if ( buildAllFaces && point1Id > point2Id )
+                if ( buildAllFaces && occurrence->visitFlag )
                 {
-                    internalFaces.insert (
-                        ( std::make_pair ( bareFace, std::make_pair ( volumeContainerIterator->localId(), jFaceLocalId ) ) ) );
+                    internalFaces.insert ( internalFaces.end(),
+                                           std::make_pair ( occurrence->item,
+                                                            std::make_pair ( occurrence->elementIdentity, occurrence->elementPosition ) ) );
                 }
-                boundaryFaceContainer.erase ( faceContainerIterator ); // counted twice: internal face
+                openOccurrence = faceOccurrences.end(); // counted twice: internal face
                 ++numInternalFaces;
             }
         }
+        if ( openOccurrence != faceOccurrences.end() )
+        {
+            boundaryFaceContainer.insert ( boundaryFaceContainer.end(),
+                                           std::make_pair ( openOccurrence->item,
+                                                            std::make_pair ( openOccurrence->elementIdentity, openOccurrence->elementPosition ) ) );
+        }
+        firstOccurrence = occurrence;
     }
     return boundaryFaceContainer.size();
 }
@@ -558,6 +587,7 @@ UInt findBoundaryEdges ( const MeshType& mesh, temporaryEdgeContainer_Type& boun
     BareEdge                             bareEdge;
     typedef typename MeshType::facetShape_Type facetShape_Type;
     typedef typename MeshType::faces_Type     faceContainer_Type;
+    typedef MeshElementBareOccurrence<BareEdge> edgeOccurrence_Type;
 
 
     if ( ! mesh.hasFaces() )
@@ -568,6 +598,10 @@ UInt findBoundaryEdges ( const MeshType& mesh, temporaryEdgeContainer_Type& boun
     // clean first in case it has been already used
     boundaryEdgeContainer.clear();
 
+    // Collect the edges of the boundary faces and sort them
+    std::vector<edgeOccurrence_Type> edgeOccurrences;
+    edgeOccurrences.reserve ( mesh.numBFaces() * mesh.numLocalEdgesOfFace() );
+
     // the following cycle assumes to visit only the boundary faces in mesh.faceList()
     for ( typename faceContainer_Type::const_iterator faceContainerIterator = mesh.faceList.begin();
             faceContainerIterator != mesh.faceList.begin() + mesh.numBFaces(); ++faceContainerIterator )
@@ -580,8 +614,22 @@ UInt findBoundaryEdges ( const MeshType& mesh, temporaryEdgeContainer_Type& boun
             point1Id = ( faceContainerIterator->point ( point1Id ) ).localId();
             point2Id = ( faceContainerIterator->point ( point2Id ) ).localId();
             bareEdge = ( makeBareEdge ( point1Id, point2Id ) ).first;
-            boundaryEdgeContainer.insert (
-                std::make_pair ( bareEdge, std::make_pair ( faceContainerIterator->localId(), jEdgeLocalId ) ) );
+            edgeOccurrences.push_back ( edgeOccurrence_Type ( bareEdge, faceContainerIterator->localId(), jEdgeLocalId,
+                                                              edgeOccurrences.size() ) );
+        }
+    }
+
+    std::sort ( edgeOccurrences.begin(), edgeOccurrences.end(), cmpBareItemOccurrence<BareEdge>() );
+
+    // each edge is stored with the first face where it has been met
+    for ( UInt iOccurrence = 0; iOccurrence < edgeOccurrences.size(); ++iOccurrence )
+    {
+        if ( iOccurrence == 0 || !sameBareItem ( edgeOccurrences[iOccurrence - 1].item, edgeOccurrences[iOccurrence].item ) )
+        {
+            boundaryEdgeContainer.insert ( boundaryEdgeContainer.end(),
+                                           std::make_pair ( edgeOccurrences[iOccurrence].item,
+                                                            std::make_pair ( edgeOccurrences[iOccurrence].elementIdentity,
+                                                                             edgeOccurrences[iOccurrence].elementPosition ) ) );
         }
     }
     return boundaryEdgeContainer.size();
@@ -618,6 +666,7 @@ UInt findInternalEdges ( const MeshType& mesh,
     BareEdge                               bareEdge;
     typedef typename MeshType::elementShape_Type volumeShape_Type;
     typedef typename MeshType::volumes_Type     volumeContainer_Type;
+    typedef MeshElementBareOccurrence<BareEdge> edgeOccurrence_Type;
     temporaryEdgeContainer_Type            temporaryEdgeContainer;
 
     ASSERT0 ( mesh.numVolumes() > 0, "We must have some 3D elements stored n the mesh to use this function!" );
@@ -625,6 +674,10 @@ UInt findInternalEdges ( const MeshType& mesh,
     internalEdgeContainer.clear();
     internalEdgeContainer.swap (temporaryEdgeContainer);
 
+    // Collect the edges of all the elements and sort them
+    std::vector<edgeOccurrence_Type> edgeOccurrences;
+    edgeOccurrences.reserve ( mesh.volumeList.size() * mesh.numLocalEdges() );
+
     for ( typename volumeContainer_Type::const_iterator volumeContainerIterator = mesh.volumeList.begin();
             volumeContainerIterator != mesh.volumeList.end(); ++volumeContainerIterator )
     {
@@ -636,9 +689,33 @@ UInt findInternalEdges ( const MeshType& mesh,
             point1Id = ( volumeContainerIterator->point ( point1Id ) ).localId();
             point2Id = ( volumeContainerIterator->point ( point2Id ) ).localId();
             bareEdge = ( makeBareEdge ( point1Id, point2Id ) ).first;
-            if ( boundaryEdgeContainer.find ( bareEdge ) == boundaryEdgeContainer.end() )
-                internalEdgeContainer.insert
-                ( std::make_pair ( bareEdge, std::make_pair ( volumeContainerIterator->localId(), jEdgeLocalId ) ) );
+            edgeOccurrences.push_back ( edgeOccurrence_Type ( bareEdge, volumeContainerIterator->localId(), jEdgeLocalId,
+                                                              edgeOccurrences.size() ) );
+        }
+    }
+
+    std::sort ( edgeOccurrences.begin(), edgeOccurrences.end(), cmpBareItemOccurrence<BareEdge>() );
+
+    // each edge not on the boundary is stored with the first element where it has been met;
+    // both lists are sorted, so they are merged
+    temporaryEdgeContainer_Type::const_iterator boundaryEdgeIterator ( boundaryEdgeContainer.begin() );
+    for ( UInt iOccurrence = 0; iOccurrence < edgeOccurrences.size(); ++iOccurrence )
+    {
+        bareEdge = edgeOccurrences[iOccurrence].item;
+        if ( iOccurrence > 0 && sameBareItem ( edgeOccurrences[iOccurrence - 1].item, bareEdge ) )
+        {
+            continue;
+        }
+        while ( boundaryEdgeIterator != boundaryEdgeContainer.end() && cmpBareItem<BareEdge>() ( boundaryEdgeIterator->first, bareEdge ) )
+        {
+            ++boundaryEdgeIterator;
+        }
+        if ( boundaryEdgeIterator == boundaryEdgeContainer.end() || !sameBareItem ( boundaryEdgeIterator->first, bareEdge ) )
+        {
+            internalEdgeContainer.insert ( internalEdgeContainer.end(),
+                                           std::make_pair ( bareEdge,
+                                                            std::make_pair ( edgeOccurrences[iOccurrence].elementIdentity,
+                                                                             edgeOccurrences[iOccurrence].elementPosition ) ) );
         }
     }
     return internalEdgeContainer.size();
@@ -1609,9 +1686,10 @@ bool buildFaces ( MeshType& mesh,
     std::pair<ID, ID>                     volumeIdToLocalFaceIdPair;
     ID                                    jFaceLocalId, newFaceId;
     ID                                    volumeId;
-    std::map<BareFace, ID>                 existingFacesMap;
-    std::map<BareFace, ID>::iterator       existingFacesMap_It;
-    std::pair<std::map<BareFace, ID>::iterator, bool>   existingFacesMap_insert;
+    MeshElementBareTable<BareFace>        existingFaces;
+    UInt                                  existingFacePosition;
+    std::vector<bool>                     existingFaceIsBoundary;
+    UInt                                  numExistingInternalFaces;
     bool                                  faceExists (false);
     // Handle boundary face container
     if ( (externalContainerIsProvided = ( externalFaceContainer != 0 ) ) )
@@ -1625,6 +1703,7 @@ bool buildFaces ( MeshType& mesh,
         numBoundaryFaces = findBoundaryFaces ( mesh, *boundaryFaceContainerPtr, numInternalFaces );
     }
     // Maybe we have already faces stored, save them!
+    existingFaces.reserve ( mesh.faceList.size() );
     for ( UInt jFaceId = 0; jFaceId < mesh.faceList.size(); ++jFaceId )
     {
         point1Id = ( mesh.faceList[ jFaceId ].point ( 0 ) ).localId();
@@ -1633,28 +1712,33 @@ bool buildFaces ( MeshType& mesh,
         if ( MeshType::facetShape_Type::S_numVertices == 4 )
         {
             point4Id = ( mesh.faceList[ jFaceId ].point ( 3 ) ).localId();
-            existingFacesMap_insert = existingFacesMap.insert (
-                                          std::make_pair ( makeBareFace ( point1Id, point2Id, point3Id, point4Id).first, jFaceId )
-                                      );
-
+            existingFaces.add ( makeBareFace ( point1Id, point2Id, point3Id, point4Id).first, jFaceId );
         }
         else
         {
-            existingFacesMap_insert = existingFacesMap.insert (
-                                          std::make_pair ( makeBareFace ( point1Id, point2Id, point3Id).first, jFaceId )
-                                      );
+            existingFaces.add ( makeBareFace ( point1Id, point2Id, point3Id).first, jFaceId );
         }
-        if (! existingFacesMap_insert.second)
+    }
+    existingFaces.sort();
+
+    existingFacePosition = existingFaces.findDuplicate();
+    if ( existingFacePosition != NotAnId )
+    {
+        // the second of the two identical faces in the list
+        const ID jFaceId ( existingFaces[ existingFacePosition + 1 ].second );
+        point1Id = ( mesh.faceList[ jFaceId ].point ( 0 ) ).localId();
+        point2Id = ( mesh.faceList[ jFaceId ].point ( 1 ) ).localId();
+        point3Id = ( mesh.faceList[ jFaceId ].point ( 2 ) ).localId();
+        errorStream << point1Id << " " << point2Id << " " << point3Id << " " << jFaceId << std::endl;
+        errorStream << "ERROR in BuildFaces. Mesh stores two identical faces" << std::endl;
+        if ( !externalContainerIsProvided )
         {
-            errorStream << point1Id << " " << point2Id << " " << point3Id << " " << jFaceId << std::endl;
-            errorStream << "ERROR in BuildFaces. Mesh stores two identical faces" << std::endl;
-            if ( !externalContainerIsProvided )
-            {
-                delete boundaryFaceContainerPtr;
-            }
-            return false;
+            delete boundaryFaceContainerPtr;
         }
+        return false;
     }
+    existingFaceIsBoundary.assign ( existingFaces.size(), false );
+    numExistingInternalFaces = existingFaces.size();
 
 
     if ( buildBoundaryFaces )
@@ -1686,12 +1770,13 @@ bool buildFaces ( MeshType& mesh,
         for ( boundaryFaceContainerIterator = boundaryFaceContainerPtr->begin();
                 boundaryFaceContainerIterator != boundaryFaceContainerPtr->end(); ++boundaryFaceContainerIterator )
         {
-            existingFacesMap_It = existingFacesMap.find (boundaryFaceContainerIterator->first);
-            if (existingFacesMap_It != existingFacesMap.end() )
+            existingFacePosition = existingFaces.find (boundaryFaceContainerIterator->first);
+            if ( existingFacePosition != NotAnId && !existingFaceIsBoundary[existingFacePosition] )
             {
                 faceExists = true;
-                face = mesh.faceList[existingFacesMap_It->second];
-                existingFacesMap.erase (existingFacesMap_It);
+                face = mesh.faceList[existingFaces[existingFacePosition].second];
+                existingFaceIsBoundary[existingFacePosition] = true;
+                --numExistingInternalFaces;
             }
             else
             {
@@ -1753,15 +1838,17 @@ bool buildFaces ( MeshType& mesh,
         delete boundaryFaceContainerPtr;
     }
     // All possibly remaining faces are necessarly internal
-    for (existingFacesMap_It = existingFacesMap.begin(); existingFacesMap_It != existingFacesMap.end();
-            ++existingFacesMap_It)
+    for ( existingFacePosition = 0; existingFacePosition < existingFaces.size(); ++existingFacePosition )
     {
-        mesh.faceList[existingFacesMap_It->second].setBoundary (false);
+        if ( !existingFaceIsBoundary[existingFacePosition] )
+        {
+            mesh.faceList[existingFaces[existingFacePosition].second].setBoundary (false);
+        }
     }
 
     // If there where faces stored originally I need to be sure that bfaces go first!
     // I need to do it now because of the tests I do later
-    if (!existingFacesMap.empty() )
+    if ( numExistingInternalFaces > 0 )
     {
         mesh.faceList.reorderAccordingToFlag (EntityFlags::PHYSICAL_BOUNDARY, &Flag::testOneSet);
     }
@@ -1789,18 +1876,19 @@ bool buildFaces ( MeshType& mesh,
 
 
     /*
-      I may get rid of the boundaryFaces container. Unfortunately now I need a more
-      complex structure, a MeshElementBareHandler, in order to generate the internal
-      faces id. An alternative would be to use the point data to identify
-      boundary faces as the ones with all point on the boundary. Yet in this
-      function we do not want to use a priori information, so that it might
-      work even if the points boundary flag is not properly set.
+      The boundary faces are identified by the stored faces flagged as boundary,
+      so that the function might work even if the points boundary flag is not
+      properly set. The faces of the elements are then sorted, so that the
+      occurrences of each internal face are contiguous: the first one creates
+      the face (or updates the stored one), the last one sets the second
+      adjacent element. The new faces are numbered in the order in which
+      they are met looping on the elements.
      */
 
-    MeshElementBareHandler<BareFace> bareFaceHandler;
-    std::pair<UInt, bool> faceIdToBoolPair;
-    std::pair<BareFace, bool> _face;
-    existingFacesMap.clear();
+    typedef MeshElementBareOccurrence<BareFace> faceOccurrence_Type;
+    MeshElementBareTable<BareFace> boundaryFaces;
+    MeshElementBareTable<BareFace> storedInternalFaces;
+    BareFace bareFace;
     for ( UInt jFaceId = 0; jFaceId < mesh.faceList.size(); ++jFaceId )
     {
         point1Id = ( mesh.faceList[ jFaceId ].point ( 0 ) ).localId();
@@ -1809,31 +1897,44 @@ bool buildFaces ( MeshType& mesh,
         if ( MeshType::facetShape_Type::S_numVertices == 4 )
         {
             point4Id = ( mesh.faceList[ jFaceId ].point ( 3 ) ).localId();
-            _face = makeBareFace ( point1Id, point2Id, point3Id, point4Id );
+            bareFace = makeBareFace ( point1Id, point2Id, point3Id, point4Id ).first;
         }
         else
         {
-            _face = makeBareFace ( point1Id, point2Id, point3Id );
+            bareFace = makeBareFace ( point1Id, point2Id, point3Id ).first;
         }
         // Store only bfaces by now so if I not find the face is
         // certainly an internal face
         if (mesh.faceList[ jFaceId ].boundary() )
         {
-            bareFaceHandler.addIfNotThere ( _face.first );
+            boundaryFaces.add ( bareFace, jFaceId );
         }
         else
             // I need to track the numbering
         {
-            existingFacesMap.insert (std::make_pair (_face.first, jFaceId) );
+            storedInternalFaces.add ( bareFace, jFaceId );
         }
     }
-    if (bareFaceHandler.howMany() > numBoundaryFaces)
+    boundaryFaces.sort();
+    storedInternalFaces.sort();
+
+    UInt numStoredBoundaryFaces ( 0 );
+    for ( UInt iFace = 0; iFace < boundaryFaces.size(); ++iFace )
+    {
+        if ( iFace == 0 || !sameBareItem ( boundaryFaces[iFace - 1].first, boundaryFaces[iFace].first ) )
+        {
+            ++numStoredBoundaryFaces;
+        }
+    }
+    if ( numStoredBoundaryFaces > numBoundaryFaces )
     {
         errorStream << "ERROR in BuildFaces. Not all boundary faces found, very strange" << std::endl;
         errorStream << "ABORT CONDITION" << std::endl;
         return false;
     }
 
+    std::vector<faceOccurrence_Type> faceOccurrences;
+    faceOccurrences.reserve ( mesh.volumeList.size() * mesh.numLocalFaces() );
     for ( typename volumeContainer_Type::iterator volumeContainerIterator = mesh.volumeList.begin();
             volumeContainerIterator != mesh.volumeList.end(); ++volumeContainerIterator )
     {
@@ -1851,63 +1952,82 @@ bool buildFaces ( MeshType& mesh,
             {
                 point4Id = volumeShape.faceToPoint ( jFaceLocalId, 3 );
                 point4Id = ( volumeContainerIterator->point ( point4Id ) ).localId();
-                _face = makeBareFace ( point1Id, point2Id, point3Id, point4Id );
+                bareFace = makeBareFace ( point1Id, point2Id, point3Id, point4Id ).first;
             }
             else
             {
-                _face = makeBareFace ( point1Id, point2Id, point3Id );
+                bareFace = makeBareFace ( point1Id, point2Id, point3Id ).first;
             }
-            faceIdToBoolPair = bareFaceHandler.addIfNotThere ( _face.first );
-            if ( faceIdToBoolPair.second )
-            {
-                // a new face It must be internal.
-                existingFacesMap_It = existingFacesMap.find (_face.first);
-                if ( existingFacesMap_It != existingFacesMap.end() )
-                {
-                    faceExists = true;
-                    face = mesh.faceList[existingFacesMap_It->second];
-                }
-                else
-                {
-                    faceExists = false;
-                    face = face_Type();
-                    face.setId ( mesh.faceList.size() );
-                }
+            faceOccurrences.push_back ( faceOccurrence_Type ( bareFace, volumeId, jFaceLocalId, faceOccurrences.size() ) );
+        }
+    }
+    std::sort ( faceOccurrences.begin(), faceOccurrences.end(), cmpBareItemOccurrence<BareFace>() );
 
-                for ( UInt kPointId = 0; kPointId < face_Type::S_numPoints; ++kPointId )
-                {
-                    face.setPoint ( kPointId, volumeContainerIterator->point ( volumeShape.faceToPoint ( jFaceLocalId, kPointId ) ) );
-                }
-                face.firstAdjacentElementIdentity() = volumeId;
-                face.firstAdjacentElementPosition() = jFaceLocalId;
-                // Marker is unset
-                if (!faceExists)
-                {
-                    face.setMarkerID (face.nullMarkerID() );
-                }
-                face.setBoundary (false);
-                if (faceExists)
-                {
-                    mesh.setFace (face, face.localId() );
-                    // Add it so we can recover the numbering later on!
-                    existingFacesMap.insert ( std::make_pair (_face.first, face.localId() ) );
-                }
-                else
-                {
-                    mesh.addFace ( face);
-                    // Add it so we can recover the numbering
-                    existingFacesMap.insert ( std::make_pair (_face.first, mesh.lastFace().localId() ) );
-                }
-            }
-            else
-            {
-                if ( faceIdToBoolPair.first > numBoundaryFaces )  // internal
-                {
-                    existingFacesMap_It = existingFacesMap.find (_face.first);
-                    mesh.faceList ( existingFacesMap_It->second).secondAdjacentElementIdentity() = volumeId;
-                    mesh.faceList ( existingFacesMap_It->second).secondAdjacentElementPosition() = jFaceLocalId;
-                }
-            }
+    // The internal faces: order of the first visit, first and last occurrence
+    std::vector<std::pair<UInt, std::pair<UInt, UInt> > > internalFaceOccurrences;
+    for ( UInt firstOccurrence = 0; firstOccurrence < faceOccurrences.size(); )
+    {
+        UInt lastOccurrence ( firstOccurrence );
+        while ( lastOccurrence + 1 < faceOccurrences.size()
+                && sameBareItem ( faceOccurrences[lastOccurrence + 1].item, faceOccurrences[firstOccurrence].item ) )
+        {
+            ++lastOccurrence;
+        }
+        if ( boundaryFaces.find ( faceOccurrences[firstOccurrence].item ) == NotAnId )
+        {
+            internalFaceOccurrences.push_back ( std::make_pair ( faceOccurrences[firstOccurrence].visitOrder,
+                                                                 std::make_pair ( firstOccurrence, lastOccurrence ) ) );
+        }
+        firstOccurrence = lastOccurrence + 1;
+    }
+    std::sort ( internalFaceOccurrences.begin(), internalFaceOccurrences.end() );
+
+    for ( UInt iFace = 0; iFace < internalFaceOccurrences.size(); ++iFace )
+    {
+        const faceOccurrence_Type& firstOccurrence ( faceOccurrences[internalFaceOccurrences[iFace].second.first] );
+        const faceOccurrence_Type& lastOccurrence ( faceOccurrences[internalFaceOccurrences[iFace].second.second] );
+
+        volumeId = firstOccurrence.elementIdentity;
+        volumePtr = &mesh.volume ( volumeId );
+        jFaceLocalId = firstOccurrence.elementPosition;
+
+        existingFacePosition = storedInternalFaces.find ( firstOccurrence.item );
+        if ( existingFacePosition != NotAnId )
+        {
+            faceExists = true;
+            face = mesh.faceList[storedInternalFaces[existingFacePosition].second];
+        }
+        else
+        {
+            faceExists = false;
+            face = face_Type();
+            face.setId ( mesh.faceList.size() );
+        }
+
+        for ( UInt kPointId = 0; kPointId < face_Type::S_numPoints; ++kPointId )
+        {
+            face.setPoint ( kPointId, volumePtr->point ( volumeShape.faceToPoint ( jFaceLocalId, kPointId ) ) );
+        }
+        face.firstAdjacentElementIdentity() = volumeId;
+        face.firstAdjacentElementPosition() = jFaceLocalId;
+        if ( &lastOccurrence != &firstOccurrence )
+        {
+            face.secondAdjacentElementIdentity() = lastOccurrence.elementIdentity;
+            face.secondAdjacentElementPosition() = lastOccurrence.elementPosition;
+        }
+        // Marker is unset
+        if (!faceExists)
+        {
+            face.setMarkerID (face.nullMarkerID() );
+        }
+        face.setBoundary (false);
+        if (faceExists)
+        {
+            mesh.setFace (face, face.localId() );
+        }
+        else
+        {
+            mesh.addFace ( face);
         }
     }
     mesh.setLinkSwitch ( std::string ( "HAS_ALL_FACETS" ) );
@@ -1973,9 +2093,8 @@ bool buildEdges ( MeshType& mesh,
     typename MeshType::face_Type* facePtr;
 
 
-    std::map<BareEdge, ID> existingEdges;
-    typedef std::map<BareEdge, ID>::iterator ExistingEdges_Iterator;
-    ExistingEdges_Iterator existingEdges_It;
+    MeshElementBareTable<BareEdge> existingEdges;
+    UInt existingEdgePosition;
     bool edgeExists (false);
 
     temporaryEdgeContainer_Type* temporaryEdgeContainer;
@@ -2004,12 +2123,15 @@ bool buildEdges ( MeshType& mesh,
     // Dump exisitng edges
     ID point1Id;
     ID point2Id;
+    existingEdges.reserve ( mesh.edgeList.size() );
     for (Edges_Iterator it = mesh.edgeList.begin(); it < mesh.edgeList.end(); ++it)
     {
         point1Id = it->point (0).localId();
         point2Id = it->point (1).localId();
-        existingEdges.insert (std::make_pair ( makeBareEdge ( point1Id, point2Id ).first, it->localId() ) );
+        existingEdges.add ( makeBareEdge ( point1Id, point2Id ).first, it->localId() );
     }
+    // the first of identical edges is kept, as with a std::map
+    existingEdges.sort();
 
 
     if ( !buildBoundaryEdges && buildInternalEdges )
@@ -2065,10 +2187,10 @@ bool buildEdges ( MeshType& mesh,
             jEdgeLocalId = faceIdToLocalEdgeIdPair.second;       // The local ID of edge on face
             point1Id = facePtr->point ( faceShape_Type::edgeToPoint ( jEdgeLocalId, 0) ).localId();
             point2Id = facePtr->point ( faceShape_Type::edgeToPoint ( jEdgeLocalId, 1) ).localId();
-            existingEdges_It = existingEdges.find ( ( makeBareEdge ( point1Id, point2Id ) ).first);
-            if (existingEdges_It != existingEdges.end() )
+            existingEdgePosition = existingEdges.find ( ( makeBareEdge ( point1Id, point2Id ) ).first);
+            if ( existingEdgePosition != NotAnId )
             {
-                edge = mesh.edge (existingEdges_It->second);
+                edge = mesh.edge (existingEdges[existingEdgePosition].second);
                 edgeExists = true;
 
             }
@@ -2142,10 +2264,10 @@ bool buildEdges ( MeshType& mesh,
         jEdgeLocalId = faceIdToLocalEdgeIdPair.second;       // The local ID of edge on volume
         point1Id = volumePtr->point ( volumeShape_Type::edgeToPoint ( jEdgeLocalId, 0) ).localId();
         point2Id = volumePtr->point ( volumeShape_Type::edgeToPoint ( jEdgeLocalId, 1) ).localId();
-        existingEdges_It = existingEdges.find ( ( makeBareEdge ( point1Id, point2Id ) ).first);
-        if (existingEdges_It != existingEdges.end() )
+        existingEdgePosition = existingEdges.find ( ( makeBareEdge ( point1Id, point2Id ) ).first);
+        if ( existingEdgePosition != NotAnId )
         {
-            edge = mesh.edge (existingEdges_It->second);
+            edge = mesh.edge (existingEdges[existingEdgePosition].second);
             edgeExists = true;
 
         }
@@ -41,6 +41,7 @@
 #define _REGIONMESH_HH_
 
 #include <fstream>
+#include <map>
 
 
 #include <Epetra_ConfigDefs.h>
@@ -1876,6 +1877,78 @@ public:
         return isBoundaryFacet ( M_geoDim, id );
     }
 
+    //! Indices of the elements with the given marker.
+    /**
+     *  The lists of all the markers are built with a single loop on the elements
+     *  at the first call and are cached. They are rebuilt if the number of elements
+     *  changes or if any marker ID has been changed since (see MarkerIDRevision).
+     *
+     *  @param marker Marker of the elements.
+     *  @return Indices of the elements with the marker, in increasing order.
+     */
+    const std::vector<UInt>& elementsWithMarker ( markerID_Type const& marker ) const
+    {
+        if ( M_elementsWithMarker.isOutdated ( numElements() ) )
+        {
+            M_elementsWithMarker.clear();
+            for ( UInt i = 0; i < numElements(); ++i )
+            {
+                M_elementsWithMarker.add ( element ( i ).markerID(), i );
+            }
+        }
+        return M_elementsWithMarker.list ( marker );
+    }
+
+    //! Indices of the boundary facets with the given marker.
+    /**
+     *  @param marker Marker of the boundary facets.
+     *  @return Indices of the boundary facets with the marker, in increasing order.
+     *  @sa elementsWithMarker
+     */
+    const std::vector<UInt>& boundaryFacetsWithMarker ( markerID_Type const& marker ) const
+    {
+        if ( M_boundaryFacetsWithMarker.isOutdated ( numBoundaryFacets() ) )
+        {
+            M_boundaryFacetsWithMarker.clear();
+            for ( UInt i = 0; i < numBoundaryFacets(); ++i )
+            {
+                M_boundaryFacetsWithMarker.add ( boundaryFacet ( i ).markerID(), i );
+            }
+        }
+        return M_boundaryFacetsWithMarker.list ( marker );
+    }
+
+    //! Indices of the points with the given marker.
+    /**
+     *  @param marker Marker of the points.
+     *  @return Indices of the points with the marker, in increasing order.
+     *  @sa elementsWithMarker
+     */
+    const std::vector<UInt>& pointsWithMarker ( markerID_Type const& marker ) const
+    {
+        if ( M_pointsWithMarker.isOutdated ( storedPoints() ) )
+        {
+            M_pointsWithMarker.clear();
+            for ( UInt i = 0; i < storedPoints(); ++i )
+            {
+                M_pointsWithMarker.add ( point ( i ).markerID(), i );
+            }
+        }
+        return M_pointsWithMarker.list ( marker );
+    }
+
+    //! Invalidate the lists of entities by marker.
+    /**
+     *  The lists are already invalidated by any change of a marker ID, this
+     *  only forces them to be built again at the next query.
+     */
+    void resetMarkerIndexLists() const
+    {
+        M_elementsWithMarker.clear();
+        M_boundaryFacetsWithMarker.clear();
+        M_pointsWithMarker.clear();
+    }
+
     //! Number of Ridges.
     /**
      *  Returns number of Ridges in the mesh
@@ -2157,6 +2230,49 @@ public:
 
 private:
 
+    //! Indices of the entities of a container, grouped by marker
+    class MarkerIndexLists
+    {
+    public:
+        MarkerIndexLists() : M_numEntities ( 0 ), M_revision ( 0 ) {}
+
+        //! True if the lists have not been built for numEntities entities and the current marker IDs
+        bool isOutdated ( const UInt numEntities ) const
+        {
+            return M_lists.empty() || M_numEntities != numEntities || M_revision != MarkerIDRevision::current();
+        }
+
+        void clear()
+        {
+            M_lists.clear();
+            M_numEntities = 0;
+            M_revision = MarkerIDRevision::current();
+        }
+
+        void add ( const markerID_Type& marker, const UInt index )
+        {
+            M_lists[ marker ].push_back ( index );
+            ++M_numEntities;
+        }
+
+        const std::vector<UInt>& list ( const markerID_Type& marker ) const
+        {
+            typename std::map<markerID_Type, std::vector<UInt> >::const_iterator it = M_lists.find ( marker );
+            return it == M_lists.end() ? M_emptyList : it->second;
+        }
+
+    private:
+        std::map<markerID_Type, std::vector<UInt> > M_lists;
+        std::vector<UInt> M_emptyList;
+        UInt M_numEntities;
+        MarkerIDRevision::revision_Type M_revision;
+    };
+
+    // Entities by marker, built on demand (see elementsWithMarker)
+    mutable MarkerIndexLists M_elementsWithMarker;
+    mutable MarkerIndexLists M_boundaryFacetsWithMarker;
+    mutable MarkerIndexLists M_pointsWithMarker;
+
     /*! Arrays containing the ids of Edges and Faces of each element
       I use a Define to use localto global array or directly the
       bareedges */
@@ -53,15 +53,12 @@ AztecooOperator::doApplyInverse ( const vector_Type& X, vector_Type& Y ) const
 {
     M_numIterations = 0;
 
-    vector_Type Xcopy ( X );
     Y.PutScalar ( 0.0 );
     if ( M_tolerance > 0 )
     {
         M_pList->sublist ( "Trilinos: AztecOO List" ).set ( "tol", M_tolerance );
     }
     M_linSolver->SetParameters ( M_pList->sublist ( "Trilinos: AztecOO List" ) );
-    M_linSolver->SetRHS ( &Xcopy );
-    M_linSolver->SetLHS ( &Y );
 
     M_linSolver->SetUserOperator ( M_oper.get() );
 
@@ -73,44 +70,54 @@ AztecooOperator::doApplyInverse ( const vector_Type& X, vector_Type& Y ) const
     int maxIter ( M_pList->sublist ( "Trilinos: AztecOO List" ).get<int> ( "max_iter" ) );
     double tol (  M_pList->sublist ( "Trilinos: AztecOO List" ).get<double> ( "tol" ) );
 
-    // Solving the system
-    int retValue = M_linSolver->Iterate (maxIter, tol);
-
-    /* try to solve again (reason may be:
-      -2 "Aztec status AZ_breakdown: numerical breakdown"
-      -3 "Aztec status AZ_loss: loss of precision"
-      -4 "Aztec status AZ_ill_cond: GMRES hessenberg ill-conditioned"
-      This method was used in the old AztecOO solver.
-    */
-    if ( retValue <= -2 )
+    // AztecOO has no block Krylov method: the columns are solved one after the other,
+    // all with the same operator and preconditioner
+    int retValue ( 0 );
+    M_converged      = yes;
+    M_lossOfAccuracy = no;
+    for ( int column ( 0 ); column < X.NumVectors(); ++column )
     {
+        vector_Type Xcopy ( Copy, X, column, 1 );
+        vector_Type Ycolumn ( View, Y, column, 1 );
+        M_linSolver->SetRHS ( &Xcopy );
+        M_linSolver->SetLHS ( &Ycolumn );
+
+        // Solving the system
+        int columnRetValue = M_linSolver->Iterate (maxIter, tol);
+
+        /* try to solve again (reason may be:
+          -2 "Aztec status AZ_breakdown: numerical breakdown"
+          -3 "Aztec status AZ_loss: loss of precision"
+          -4 "Aztec status AZ_ill_cond: GMRES hessenberg ill-conditioned"
+          This method was used in the old AztecOO solver.
+        */
+        if ( columnRetValue <= -2 )
+        {
+            M_numIterations += M_linSolver->NumIters();
+            columnRetValue = M_linSolver->Iterate (maxIter, tol);
+        }
+
+        // Update the number of performed iterations
         M_numIterations += M_linSolver->NumIters();
-        retValue = M_linSolver->Iterate (maxIter, tol);
-    }
 
-    // Update the number of performed iterations
-    M_numIterations += M_linSolver->NumIters();
+        // Update of the status: the solve has converged only if all the columns have converged
+        Real status[AZ_STATUS_SIZE];
+        M_linSolver->GetAllAztecStatus ( status );
 
-    // Update of the status
-    Real status[AZ_STATUS_SIZE];
-    M_linSolver->GetAllAztecStatus ( status );
+        if ( status[AZ_why] != AZ_normal )
+        {
+            M_converged = no;
+        }
 
-    if ( status[AZ_why] == AZ_normal )
-    {
-        M_converged = yes;
-    }
-    else
-    {
-        M_converged = no;
-    }
+        if ( status[AZ_why] == AZ_loss )
+        {
+            M_lossOfAccuracy = yes;
+        }
 
-    if ( status[AZ_why] == AZ_loss )
-    {
-        M_lossOfAccuracy = yes;
-    }
-    else
-    {
-        M_lossOfAccuracy = no;
+        if ( retValue == 0 )
+        {
+            retValue = columnRetValue;
+        }
     }
 
     return retValue;
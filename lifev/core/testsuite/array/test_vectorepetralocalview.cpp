@@ -0,0 +1,168 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/* ========================================================
+
+Micro-benchmark of the access to the entries of a VectorEpetra:
+global index access (operator[]) against local views.
+
+*/
+
+
+/**
+   @file test_vectorepetralocalview.cpp
+   @date 10-2026
+*/
+
+
+// ===================================================
+//! Includes
+// ===================================================
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/util/LifeChrono.hpp>
+#include <lifev/core/array/MapEpetra.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+
+using namespace LifeV;
+
+// ===================================================
+//! Main
+// ===================================================
+int main ( int argc, char* argv[] )
+{
+#ifdef HAVE_MPI
+    MPI_Init (&argc, &argv);
+#endif
+
+    bool success ( true );
+
+    // this brace is important to destroy the Epetra_Comm object before calling MPI_Finalize
+    {
+#ifdef EPETRA_MPI
+        boost::shared_ptr<Epetra_Comm> comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+#else
+        boost::shared_ptr<Epetra_Comm> comm ( new Epetra_SerialComm() );
+#endif
+        const bool isLeader ( comm->MyPID() == 0 );
+
+        const Int numberOfNodes ( 200000 );
+        const UInt numberOfSweeps ( 20 );
+
+        // Scalar map and vectorial map, built as in FESpace::createMap
+        MapEpetra scalarMap ( numberOfNodes, 0, comm );
+        MapEpetra vectorialMap;
+        for ( UInt iComponent (0); iComponent < 3; ++iComponent )
+        {
+            vectorialMap += scalarMap;
+        }
+
+        VectorEpetra field ( vectorialMap, Unique );
+        for ( Int i (0); i < field.epetraVector().MyLength(); ++i )
+        {
+            field.epetraVector() [0][i] = 1.0 + 1.e-3 * field.blockMap().GID (i);
+        }
+        VectorEpetra resultGlobal ( scalarMap, Unique );
+        VectorEpetra resultLocal ( scalarMap, Unique );
+
+        const Int nLocalDof ( resultGlobal.epetraVector().MyLength() );
+
+        // Access through the global indices
+        LifeChrono chronoGlobal;
+        chronoGlobal.start();
+        for ( UInt sweep (0); sweep < numberOfSweeps; ++sweep )
+        {
+            for ( Int k (0); k < nLocalDof; ++k )
+            {
+                const UInt iGID = field.blockMap().GID (k);
+                const UInt jGID = field.blockMap().GID (k + nLocalDof);
+                const UInt kGID = field.blockMap().GID (k + 2 * nLocalDof);
+
+                resultGlobal[iGID] += field[iGID] * field[iGID] + field[jGID] * field[jGID] + field[kGID] * field[kGID];
+            }
+        }
+        chronoGlobal.stop();
+
+        // Access through the local views
+        LifeChrono chronoLocal;
+        chronoLocal.start();
+        for ( UInt sweep (0); sweep < numberOfSweeps; ++sweep )
+        {
+            VectorEpetra::localView_Type result ( resultLocal.localView() );
+            const VectorEpetra::constLocalView_Type fieldView ( field.localView() );
+            const VectorEpetra::constLocalView_Type x ( fieldView.component (0, 3) );
+            const VectorEpetra::constLocalView_Type y ( fieldView.component (1, 3) );
+            const VectorEpetra::constLocalView_Type z ( fieldView.component (2, 3) );
+
+            for ( UInt k (0); k < result.size(); ++k )
+            {
+                result[k] += x[k] * x[k] + y[k] * y[k] + z[k] * z[k];
+            }
+        }
+        chronoLocal.stop();
+
+        // The two access paths must give the same result
+        VectorEpetra difference ( resultGlobal );
+        difference -= resultLocal;
+        const Real error ( difference.normInf() );
+        success = ( error == 0.0 );
+
+        // The global index of a component view must match the map
+        const VectorEpetra::constLocalView_Type yView ( field.componentView (1, 3) );
+        for ( UInt k (0); k < yView.size(); ++k )
+        {
+            if ( yView.globalId (k) != field.blockMap().GID (k + nLocalDof) )
+            {
+                success = false;
+            }
+        }
+
+        if ( isLeader )
+        {
+            std::cout << "Global index access: " << chronoGlobal.diff() << " s" << std::endl;
+            std::cout << "Local view access:   " << chronoLocal.diff() << " s" << std::endl;
+            std::cout << "Difference (inf norm): " << error << std::endl;
+        }
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    if ( success )
+    {
+        return ( EXIT_SUCCESS );
+    }
+    return ( EXIT_FAILURE );
+}
@@ -0,0 +1,182 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Gradient recovery test
+
+    @date 10-2026
+
+    The program checks GradientRecovery::ZZRecovery on a P1 and on a P2 vector
+    space built on the same mesh, with one recovery object for each space:
+    the gradient of a linear field, for which the ZZ recovery is exact, must be
+    recovered exactly, and the gradient of a nonlinear field must match the one
+    given by ZZGradient direction by direction.
+ */
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+#include <lifev/core/mesh/RegionMesh.hpp>
+#include <lifev/core/mesh/RegionMesh3DStructured.hpp>
+#include <lifev/core/mesh/MeshPartitioner.hpp>
+#include <lifev/core/fem/FESpace.hpp>
+#include <lifev/core/fem/GradientRecovery.hpp>
+
+#include <boost/bind.hpp>
+
+using namespace LifeV;
+
+namespace
+{
+
+typedef RegionMesh<LinearTetra>                     mesh_Type;
+typedef FESpace<mesh_Type, MapEpetra>               feSpace_Type;
+typedef boost::shared_ptr<feSpace_Type>             feSpacePtr_Type;
+typedef VectorEpetra                                vector_Type;
+typedef GradientRecovery::ZZRecovery<feSpace_Type, vector_Type> recovery_Type;
+
+// Gradient of the linear field: linearGradient[i][d] = d u_i / d x_d
+const Real linearGradient[3][3] = { {  1.0, 2.0, -0.5 },
+                                    { -3.0, 0.5,  1.5 },
+                                    {  0.2, -1.0, 4.0 }
+                                  };
+
+Real linearField ( const Real& /*t*/, const Real& x, const Real& y, const Real& z, const ID& i )
+{
+    return linearGradient[i][0] * x + linearGradient[i][1] * y + linearGradient[i][2] * z + 0.1 * i;
+}
+
+Real linearFieldDerivative ( const Real& /*t*/, const Real& /*x*/, const Real& /*y*/, const Real& /*z*/, const ID& i,
+                             const UInt direction )
+{
+    return linearGradient[i][direction];
+}
+
+Real nonlinearField ( const Real& /*t*/, const Real& x, const Real& y, const Real& z, const ID& i )
+{
+    return std::sin ( ( i + 1 ) * x ) * std::cos ( y - z ) + x * y * z;
+}
+
+// Largest errors of the recovery on the space: against the exact gradient of the linear
+// field, and against ZZGradient for the nonlinear field
+void recoveryErrors ( const feSpacePtr_Type& feSpace, Real& exactError, Real& zzGradientError )
+{
+    recovery_Type recovery ( feSpace );
+
+    vector_Type field ( feSpace->map(), Unique );
+    std::vector<vector_Type> gradient;
+
+    exactError = 0.;
+    feSpace->interpolate ( static_cast<feSpace_Type::function_Type> ( linearField ), field, 0.0 );
+    recovery.gradient ( field, gradient );
+    for ( UInt d (0); d < recovery.numberOfDirections(); ++d )
+    {
+        vector_Type exact ( feSpace->map(), Unique );
+        feSpace->interpolate ( boost::bind ( &linearFieldDerivative, _1, _2, _3, _4, _5, d ), exact, 0.0 );
+        exact -= gradient[d];
+        exactError = std::max ( exactError, exact.normInf() );
+    }
+
+    zzGradientError = 0.;
+    feSpace->interpolate ( static_cast<feSpace_Type::function_Type> ( nonlinearField ), field, 0.0 );
+    recovery.gradient ( field, gradient );
+    for ( UInt d (0); d < recovery.numberOfDirections(); ++d )
+    {
+        vector_Type reference ( GradientRecovery::ZZGradient ( feSpace, field, d ) );
+        const Real referenceNorm ( reference.normInf() );
+        reference -= gradient[d];
+        zzGradientError = std::max ( zzGradientError, reference.normInf() / referenceNorm );
+    }
+}
+
+}
+
+int main ( int argc, char** argv )
+{
+#ifdef HAVE_MPI
+    MPI_Init ( &argc, &argv );
+    boost::shared_ptr<Epetra_Comm> Comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+#else
+    boost::shared_ptr<Epetra_Comm> Comm ( new Epetra_SerialComm );
+#endif
+
+    const bool verbose ( Comm->MyPID() == 0 );
+
+    boost::shared_ptr<mesh_Type> fullMeshPtr ( new mesh_Type ( Comm ) );
+    regularMesh3D ( *fullMeshPtr, 1, 5, 5, 5, false,
+                    1.0, 1.0, 1.0,
+                    0.0, 0.0, 0.0 );
+
+    boost::shared_ptr<mesh_Type> localMeshPtr;
+    {
+        MeshPartitioner<mesh_Type> meshPart ( fullMeshPtr, Comm );
+        localMeshPtr = meshPart.meshPartition();
+    }
+    fullMeshPtr.reset();
+
+    // One recovery for each space: the cached patch weights are rebuilt for the new space
+    std::vector<std::string> orders;
+    orders.push_back ( "P1" );
+    orders.push_back ( "P2" );
+
+    bool check (true);
+    for ( UInt k (0); k < orders.size(); ++k )
+    {
+        feSpacePtr_Type feSpace ( new feSpace_Type ( localMeshPtr, orders[k], 3, Comm ) );
+
+        Real exactError (0.), zzGradientError (0.);
+        recoveryErrors ( feSpace, exactError, zzGradientError );
+
+        if ( verbose )
+        {
+            std::cout << orders[k] << ": error on the linear field " << exactError
+                      << ", relative difference with ZZGradient " << zzGradientError << std::endl;
+        }
+        check = check && exactError < 1e-10 && zzGradientError < 1e-12;
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    if ( !check )
+    {
+        if ( verbose )
+        {
+            std::cout << "Test Failed!" << std::endl;
+        }
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,250 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/* ========================================================
+
+Two ExporterHDF5 writing asynchronously at the same time: the snapshots of
+both exporters are written by the shared background thread. The files are
+read back and the values compared with the exported ones, for all the steps.
+Halfway, the pressure is moved to a linear map with the same number of dofs:
+the snapshots staged on the former map must not be reused.
+
+If MPI does not provide MPI_THREAD_MULTIPLE or HDF5 is not thread-safe, the
+exporters write synchronously and the test checks the synchronous writing.
+
+*/
+
+
+/**
+   @file main.cpp
+   @date 10-2026
+*/
+
+
+// ===================================================
+//! Includes
+// ===================================================
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <EpetraExt_HDF5.h>
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/filter/GetPot.hpp>
+#include <lifev/core/array/MapEpetra.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+#include <lifev/core/mesh/RegionMesh.hpp>
+#include <lifev/core/mesh/RegionMesh3DStructured.hpp>
+#include <lifev/core/mesh/MeshPartitioner.hpp>
+#include <lifev/core/fem/FESpace.hpp>
+#include <lifev/core/filter/ExporterHDF5.hpp>
+
+using namespace LifeV;
+
+typedef RegionMesh<LinearTetra>           mesh_Type;
+typedef FESpace<mesh_Type, MapEpetra>     feSpace_Type;
+typedef boost::shared_ptr<feSpace_Type>   feSpacePtr_Type;
+typedef VectorEpetra                      vector_Type;
+typedef boost::shared_ptr<vector_Type>    vectorPtr_Type;
+
+namespace
+{
+
+// Value exported at a step for the dof gid of a field
+Real fieldValue ( const UInt& step, const Real& sign, const Int& gid )
+{
+    return step + sign * 1.e-3 * gid;
+}
+
+// Largest difference between a dataset and the exported values: the column d
+// of the dataset is the component d of the field, see ExporterHDF5::writeVector
+Real datasetDifference ( EpetraExt::HDF5& file, const std::string& name, const Epetra_Map& map,
+                         const UInt& step, const Real& sign, const UInt& size )
+{
+    Epetra_MultiVector* data (0);
+    file.Read ( name, map, data, true );
+
+    Real difference (0.);
+    for ( Int d (0); d < data->NumVectors(); ++d )
+    {
+        for ( Int i (0); i < data->MyLength(); ++i )
+        {
+            const Real value ( fieldValue ( step, sign, map.GID (i) + d * size ) );
+            difference = std::max ( difference, std::abs ( (*data) [d][i] - value ) );
+        }
+    }
+
+    delete data;
+
+    Real globalDifference (0.);
+    map.Comm().MaxAll ( &difference, &globalDifference, 1 );
+    return globalDifference;
+}
+
+}
+
+// ===================================================
+//! Main
+// ===================================================
+int main ( int argc, char* argv[] )
+{
+#ifdef HAVE_MPI
+    // the background thread of the exporters calls MPI
+    Int provided (0);
+    MPI_Init_thread (&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    bool success ( true );
+
+    // this brace is important to destroy the Epetra_Comm object before calling MPI_Finalize
+    {
+#ifdef EPETRA_MPI
+        boost::shared_ptr<Epetra_Comm> comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+#else
+        boost::shared_ptr<Epetra_Comm> comm ( new Epetra_SerialComm() );
+#endif
+        const bool isLeader ( comm->MyPID() == 0 );
+
+        GetPot command_line ( argc, argv );
+        const std::string dataFileName = command_line.follow ( "data", 2, "-f", "--file" );
+        GetPot dataFile ( dataFileName );
+
+        const UInt numberOfElements ( dataFile ( "mesh/nelements", 10 ) );
+        const UInt numberOfSteps ( dataFile ( "test/steps", 10 ) );
+
+        // Build and partition the mesh
+        boost::shared_ptr<mesh_Type> fullMeshPtr ( new mesh_Type ( comm ) );
+        regularMesh3D ( *fullMeshPtr, 1, numberOfElements, numberOfElements, numberOfElements, false,
+                        1.0, 1.0, 1.0,
+                        0.0, 0.0, 0.0 );
+
+        boost::shared_ptr<mesh_Type> meshPtr;
+        {
+            MeshPartitioner<mesh_Type> meshPart ( fullMeshPtr, comm );
+            meshPtr = meshPart.meshPartition();
+        }
+        fullMeshPtr.reset();
+
+        // A vector and a scalar field, stored on the repeated maps as in the solvers
+        feSpacePtr_Type vectorFESpace ( new feSpace_Type ( meshPtr, "P1", 3, comm ) );
+        feSpacePtr_Type scalarFESpace ( new feSpace_Type ( meshPtr, "P1", 1, comm ) );
+
+        vectorPtr_Type velocity ( new vector_Type ( vectorFESpace->map(), Repeated ) );
+        vectorPtr_Type pressure ( new vector_Type ( scalarFESpace->map(), Repeated ) );
+
+        const UInt vectorSize ( vectorFESpace->dof().numTotalDof() );
+        const UInt scalarSize ( scalarFESpace->dof().numTotalDof() );
+
+        // Two exporters writing in the background, in two files
+        std::vector<std::string> postfixes ( numberOfSteps );
+        {
+            ExporterHDF5<mesh_Type> velocityExporter ( dataFile, meshPtr, "velocityAsync", comm->MyPID() );
+            velocityExporter.addVariable ( ExporterData<mesh_Type>::VectorField, "velocity", vectorFESpace, velocity, UInt (0) );
+
+            ExporterHDF5<mesh_Type> pressureExporter ( dataFile, meshPtr, "pressureAsync", comm->MyPID() );
+            pressureExporter.addVariable ( ExporterData<mesh_Type>::ScalarField, "pressure", scalarFESpace, pressure, UInt (0) );
+
+            for ( UInt step (0); step < numberOfSteps; ++step )
+            {
+                if ( step == numberOfSteps / 2 )
+                {
+                    pressure->setMapType ( Unique );
+                    pressure->setMap ( MapEpetra ( static_cast<Int> ( scalarSize ), comm ) );
+                }
+
+                for ( Int i (0); i < velocity->epetraVector().MyLength(); ++i )
+                {
+                    velocity->epetraVector() [0][i] = fieldValue ( step, 1., velocity->blockMap().GID (i) );
+                }
+                for ( Int i (0); i < pressure->epetraVector().MyLength(); ++i )
+                {
+                    pressure->epetraVector() [0][i] = fieldValue ( step, -1., pressure->blockMap().GID (i) );
+                }
+
+                // see Exporter::computePostfix
+                std::ostringstream index;
+                index.fill ( '0' );
+                index << std::setw (5) << velocityExporter.timeIndex();
+                postfixes[step] = "." + index.str();
+
+                velocityExporter.postProcess ( static_cast<Real> ( step ) );
+                pressureExporter.postProcess ( static_cast<Real> ( step ) );
+
+                // the staged snapshots do not depend on the fields any more
+                velocity->epetraVector().PutScalar ( -1. );
+                pressure->epetraVector().PutScalar ( -1. );
+            }
+
+            velocityExporter.closeFile();
+            pressureExporter.closeFile();
+        }
+
+        // Read the files back
+        EpetraExt::HDF5 velocityFile ( *comm );
+        EpetraExt::HDF5 pressureFile ( *comm );
+        velocityFile.Open ( "./velocityAsync.h5" );
+        pressureFile.Open ( "./pressureAsync.h5" );
+
+        MapEpetra vectorSubMap ( velocity->blockMap(), 0, vectorSize );
+        MapEpetra scalarSubMap ( pressure->blockMap(), 0, scalarSize );
+
+        Real error (0.);
+        for ( UInt step (0); step < numberOfSteps; ++step )
+        {
+            error = std::max ( error, datasetDifference ( velocityFile, "velocity" + postfixes[step],
+                                                          *vectorSubMap.map (Unique), step, 1., vectorSize ) );
+            error = std::max ( error, datasetDifference ( pressureFile, "pressure" + postfixes[step],
+                                                          *scalarSubMap.map (Unique), step, -1., scalarSize ) );
+        }
+        success = ( error < 1.e-12 );
+
+        velocityFile.Close();
+        pressureFile.Close();
+
+        if ( isLeader )
+        {
+            std::cout << "Number of processes:   " << comm->NumProc() << std::endl;
+            std::cout << "Number of steps:       " << numberOfSteps << std::endl;
+            std::cout << "Difference (inf norm): " << error << std::endl;
+        }
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    if ( success )
+    {
+        return ( EXIT_SUCCESS );
+    }
+    return ( EXIT_FAILURE );
+}
@@ -0,0 +1,279 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/* ========================================================
+
+Benchmark of the per-step cost of the HDF5 export of a vector and a
+scalar field on a partitioned tetrahedral mesh: the sub-maps and the
+staging vectors built at each step (as ExporterHDF5 did before) against
+the ones cached by ExporterHDF5.
+
+The values written by the two paths are read back and compared.
+
+*/
+
+
+/**
+   @file main.cpp
+   @date 10-2026
+*/
+
+
+// ===================================================
+//! Includes
+// ===================================================
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <EpetraExt_HDF5.h>
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/util/LifeChrono.hpp>
+#include <lifev/core/filter/GetPot.hpp>
+#include <lifev/core/array/MapEpetra.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+#include <lifev/core/mesh/RegionMesh.hpp>
+#include <lifev/core/mesh/RegionMesh3DStructured.hpp>
+#include <lifev/core/mesh/MeshPartitioner.hpp>
+#include <lifev/core/fem/FESpace.hpp>
+#include <lifev/core/filter/ExporterHDF5.hpp>
+
+using namespace LifeV;
+
+typedef RegionMesh<LinearTetra>           mesh_Type;
+typedef FESpace<mesh_Type, MapEpetra>     feSpace_Type;
+typedef boost::shared_ptr<feSpace_Type>   feSpacePtr_Type;
+typedef VectorEpetra                      vector_Type;
+typedef boost::shared_ptr<vector_Type>    vectorPtr_Type;
+
+namespace
+{
+
+// Write a field as ExporterHDF5 did before the staging buffers were cached:
+// one sub-map and one subset vector for each component, at each step
+void writeUncached ( EpetraExt::HDF5& hdf5, const std::string& name, const vector_Type& field,
+                     const UInt& size, const UInt& fieldDim, const UInt& numComponents )
+{
+    std::vector<Real*> arrayOfPointers ( numComponents );
+    std::vector<vectorPtr_Type> arrayOfVectors ( numComponents );
+    Int myLDA;
+
+    for ( UInt d (0); d < numComponents; ++d )
+    {
+        const UInt offset ( d < fieldDim ? d * size : 0 );
+        MapEpetra subMap ( field.blockMap(), offset, size );
+        arrayOfVectors[d].reset ( new vector_Type ( subMap ) );
+        if ( d < fieldDim )
+        {
+            arrayOfVectors[d]->subset ( field, offset );
+        }
+        arrayOfVectors[d]->epetraVector().ExtractView ( &arrayOfPointers[d], &myLDA );
+    }
+
+    MapEpetra subMap ( field.blockMap(), 0, size );
+    Epetra_MultiVector multiVector ( View, *subMap.map (Unique), &arrayOfPointers[0], numComponents );
+    hdf5.Write ( name, multiVector, true );
+}
+
+// Largest difference between the datasets with the same name in two files
+Real datasetDifference ( EpetraExt::HDF5& first, EpetraExt::HDF5& second,
+                         const std::string& name, const Epetra_Map& map )
+{
+    Epetra_MultiVector* firstData (0);
+    Epetra_MultiVector* secondData (0);
+    first.Read ( name, map, firstData, true );
+    second.Read ( name, map, secondData, true );
+
+    firstData->Update ( -1., *secondData, 1. );
+    std::vector<Real> norms ( firstData->NumVectors() );
+    firstData->NormInf ( &norms[0] );
+
+    delete firstData;
+    delete secondData;
+
+    return *std::max_element ( norms.begin(), norms.end() );
+}
+
+}
+
+// ===================================================
+//! Main
+// ===================================================
+int main ( int argc, char* argv[] )
+{
+#ifdef HAVE_MPI
+    MPI_Init (&argc, &argv);
+#endif
+
+    bool success ( true );
+
+    // this brace is important to destroy the Epetra_Comm object before calling MPI_Finalize
+    {
+#ifdef EPETRA_MPI
+        boost::shared_ptr<Epetra_Comm> comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+#else
+        boost::shared_ptr<Epetra_Comm> comm ( new Epetra_SerialComm() );
+#endif
+        const bool isLeader ( comm->MyPID() == 0 );
+
+        GetPot command_line ( argc, argv );
+        const std::string dataFileName = command_line.follow ( "data", 2, "-f", "--file" );
+        GetPot dataFile ( dataFileName );
+
+        const UInt numberOfElements ( dataFile ( "mesh/nelements", 20 ) );
+        const UInt numberOfSteps ( dataFile ( "benchmark/steps", 20 ) );
+
+        // Build and partition the mesh
+        boost::shared_ptr<mesh_Type> fullMeshPtr ( new mesh_Type ( comm ) );
+        regularMesh3D ( *fullMeshPtr, 1, numberOfElements, numberOfElements, numberOfElements, false,
+                        1.0, 1.0, 1.0,
+                        0.0, 0.0, 0.0 );
+
+        boost::shared_ptr<mesh_Type> meshPtr;
+        {
+            MeshPartitioner<mesh_Type> meshPart ( fullMeshPtr, comm );
+            meshPtr = meshPart.meshPartition();
+        }
+        fullMeshPtr.reset();
+
+        // A vector and a scalar field, stored on the repeated maps as in the solvers
+        feSpacePtr_Type vectorFESpace ( new feSpace_Type ( meshPtr, "P1", 3, comm ) );
+        feSpacePtr_Type scalarFESpace ( new feSpace_Type ( meshPtr, "P1", 1, comm ) );
+
+        vectorPtr_Type velocity ( new vector_Type ( vectorFESpace->map(), Repeated ) );
+        vectorPtr_Type pressure ( new vector_Type ( scalarFESpace->map(), Repeated ) );
+
+        const UInt vectorSize ( vectorFESpace->dof().numTotalDof() );
+        const UInt scalarSize ( scalarFESpace->dof().numTotalDof() );
+
+        // Exporter with cached staging buffers
+        ExporterHDF5<mesh_Type> exporter ( dataFile, meshPtr, "cached", comm->MyPID() );
+        exporter.addVariable ( ExporterData<mesh_Type>::VectorField, "velocity", vectorFESpace, velocity, UInt (0) );
+        exporter.addVariable ( ExporterData<mesh_Type>::ScalarField, "pressure", scalarFESpace, pressure, UInt (0) );
+
+        // Uncached writing in a separate file
+        EpetraExt::HDF5 uncached ( *comm );
+        uncached.Create ( "./uncached.h5" );
+
+        std::string lastPostfix;
+        Real uncachedTime (0.);
+        Real cachedTime (0.);
+        Real uncachedFirstTime (0.);
+        Real cachedFirstTime (0.);
+
+        for ( UInt step (0); step < numberOfSteps; ++step )
+        {
+            for ( Int i (0); i < velocity->epetraVector().MyLength(); ++i )
+            {
+                velocity->epetraVector() [0][i] = step + 1.e-3 * velocity->blockMap().GID (i);
+            }
+            for ( Int i (0); i < pressure->epetraVector().MyLength(); ++i )
+            {
+                pressure->epetraVector() [0][i] = step - 1.e-3 * pressure->blockMap().GID (i);
+            }
+
+            // see Exporter::computePostfix
+            std::ostringstream index;
+            index.fill ( '0' );
+            index << std::setw (5) << exporter.timeIndex();
+            lastPostfix = "." + index.str();
+
+            LifeChrono chronoUncached;
+            comm->Barrier();
+            chronoUncached.start();
+            writeUncached ( uncached, "velocity" + lastPostfix, *velocity, vectorSize, 3, nDimensions );
+            writeUncached ( uncached, "pressure" + lastPostfix, *pressure, scalarSize, 1, 1 );
+            uncached.Flush();
+            comm->Barrier();
+            chronoUncached.stop();
+
+            LifeChrono chronoCached;
+            comm->Barrier();
+            chronoCached.start();
+            exporter.postProcess ( static_cast<Real> ( step ) );
+            comm->Barrier();
+            chronoCached.stop();
+
+            // the first step builds the buffers (and, for the exporter, writes the geometry)
+            if ( step == 0 )
+            {
+                uncachedFirstTime = chronoUncached.diff();
+                cachedFirstTime = chronoCached.diff();
+            }
+            else
+            {
+                uncachedTime += chronoUncached.diff();
+                cachedTime += chronoCached.diff();
+            }
+        }
+
+        exporter.closeFile();
+        uncached.Close();
+
+        // The two paths must write the same values
+        EpetraExt::HDF5 cachedFile ( *comm );
+        EpetraExt::HDF5 uncachedFile ( *comm );
+        cachedFile.Open ( "./cached.h5" );
+        uncachedFile.Open ( "./uncached.h5" );
+
+        MapEpetra vectorSubMap ( velocity->blockMap(), 0, vectorSize );
+        MapEpetra scalarSubMap ( pressure->blockMap(), 0, scalarSize );
+        const Real error ( std::max ( datasetDifference ( cachedFile, uncachedFile, "velocity" + lastPostfix, *vectorSubMap.map (Unique) ),
+                                      datasetDifference ( cachedFile, uncachedFile, "pressure" + lastPostfix, *scalarSubMap.map (Unique) ) ) );
+        success = ( error == 0.0 );
+
+        cachedFile.Close();
+        uncachedFile.Close();
+
+        if ( isLeader )
+        {
+            const UInt numberOfTimedSteps ( std::max ( numberOfSteps, static_cast<UInt> (2) ) - 1 );
+            std::cout << "Number of processes:   " << comm->NumProc() << std::endl;
+            std::cout << "Vector field dofs:     " << vectorSize << " x " << nDimensions << std::endl;
+            std::cout << "First step, uncached:  " << uncachedFirstTime << " s" << std::endl;
+            std::cout << "First step, cached:    " << cachedFirstTime << " s (includes the geometry)" << std::endl;
+            std::cout << "Per step, uncached:    " << uncachedTime / numberOfTimedSteps << " s" << std::endl;
+            std::cout << "Per step, cached:      " << cachedTime / numberOfTimedSteps << " s (includes the XDMF file)" << std::endl;
+            std::cout << "Difference (inf norm): " << error << std::endl;
+        }
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    if ( success )
+    {
+        return ( EXIT_SUCCESS );
+    }
+    return ( EXIT_FAILURE );
+}
@@ -63,6 +63,7 @@
 
 
 #define TEST_TOLERANCE 1e-13
+#define MULTIPLE_RHS_TOLERANCE 1e-8
 
 using namespace LifeV;
 
@@ -150,6 +151,40 @@ void printErrors ( const vector_Type& solution, fespacePtr_Type uFESpace,
 }
 
 
+// Largest relative difference between the solutions of several right hand sides
+// solved at once and the ones solved column by column
+Real multipleRhsDifference ( LinearSolver& linearSolver, const vector_Type& rhs )
+{
+    const Int numberOfRhs ( 3 );
+    const Epetra_MultiVector& rhsVector ( rhs.epetraVector() );
+
+    Epetra_MultiVector rhsBlock ( rhsVector.Map(), numberOfRhs );
+    rhsBlock ( 0 )->Update ( 1., *rhsVector ( 0 ), 0. );
+    rhsBlock ( 1 )->Update ( -2., *rhsVector ( 0 ), 0. );
+    rhsBlock ( 2 )->PutScalar ( 1. );
+    rhsBlock ( 2 )->Update ( 1., *rhsVector ( 0 ), 1. );
+
+    Epetra_MultiVector solutionBlock ( rhsVector.Map(), numberOfRhs );
+    linearSolver.solve ( rhsBlock, solutionBlock );
+
+    Real difference ( 0. );
+    for ( Int j ( 0 ); j < numberOfRhs; ++j )
+    {
+        const Epetra_MultiVector rhsColumn ( View, rhsBlock, j, 1 );
+        Epetra_MultiVector solutionColumn ( rhsVector.Map(), 1 );
+        linearSolver.solve ( rhsColumn, solutionColumn );
+
+        Real solutionNorm, differenceNorm;
+        solutionBlock ( j )->Norm2 ( &solutionNorm );
+        solutionColumn ( 0 )->Update ( -1., *solutionBlock ( j ), 1. );
+        solutionColumn ( 0 )->Norm2 ( &differenceNorm );
+        difference = std::max ( difference, differenceNorm / solutionNorm );
+    }
+
+    return difference;
+}
+
+
 int
 main ( int argc, char** argv )
 {
@@ -479,6 +514,13 @@ main ( int argc, char** argv )
         linearSolver3.setRightHandSide ( rhsBC );
         linearSolver3.solve ( solution3 );
 
+        if ( verbose )
+        {
+            std::cout << std::endl << "Solving several right hand sides at once (Belos and AztecOO)... " << std::endl;
+        }
+        const Real multipleRhsDiffBelos = multipleRhsDifference ( linearSolver2, *rhsBC );
+        const Real multipleRhsDiffAztecOO = multipleRhsDifference ( linearSolver3, *rhsBC );
+
         // +-----------------------------------------------+
         // |             Computing the error               |
         // +-----------------------------------------------+
@@ -572,6 +614,24 @@ main ( int argc, char** argv )
             return ( EXIT_FAILURE );
         }
 
+        if ( verbose )
+        {
+            std::cout << "Difference between the multiple and the single right hand side solutions (Belos): " << multipleRhsDiffBelos << std::endl;
+            std::cout << "Difference between the multiple and the single right hand side solutions (AztecOO): " << multipleRhsDiffAztecOO << std::endl;
+        }
+        if ( multipleRhsDiffBelos > MULTIPLE_RHS_TOLERANCE || multipleRhsDiffAztecOO > MULTIPLE_RHS_TOLERANCE )
+        {
+            if ( verbose )
+            {
+                std::cout << "The difference between the two solutions is too large." << std::endl;
+            }
+            if ( verbose )
+            {
+                std::cout << "Test status: FAILED" << std::endl;
+            }
+            return ( EXIT_FAILURE );
+        }
+
         if (   uL2AztecOO > 4.602e-03 || uH1AztecOO > 3.855e-01
                 || uL2Belos > 4.602e-03 || uH1Belos > 3.855e-01
                 || uL2AztecOO3 > 4.602e-03 || uH1AztecOO3 > 3.855e-01)
@@ -0,0 +1,222 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Startup benchmark of the face and edge builders of MeshUtility
+
+    @date 10-2026
+
+    A structured tetrahedral mesh is generated, then the faces and the edges
+    are discovered and built. The sort-based findFaces() is compared with
+    the former search in a std::map (time and result), and the numbers of
+    faces and edges are checked against the Euler formula.
+
+    Usage: test_meshbuilders [-n numberOfSubdivisions]
+ */
+
+// ===================================================
+//! Includes
+// ===================================================
+
+#include <Epetra_ConfigDefs.h>
+#ifdef HAVE_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/util/LifeChrono.hpp>
+#include <lifev/core/filter/GetPot.hpp>
+#include <lifev/core/mesh/RegionMesh.hpp>
+#include <lifev/core/mesh/RegionMesh3DStructured.hpp>
+#include <lifev/core/mesh/MeshUtility.hpp>
+
+using namespace LifeV;
+
+typedef RegionMesh<LinearTetra> mesh_Type;
+
+namespace
+{
+
+// The search of the faces in a std::map, as done by MeshUtility::findFaces before
+UInt findFacesWithMap ( const mesh_Type& mesh, MeshUtility::temporaryFaceContainer_Type& boundaryFaceContainer,
+                        MeshUtility::temporaryFaceContainer_Type& internalFaces )
+{
+    mesh_Type::elementShape_Type volumeShape;
+    MeshUtility::temporaryFaceContainer_Type::iterator faceContainerIterator;
+
+    boundaryFaceContainer.clear();
+    internalFaces.clear();
+
+    for ( mesh_Type::volumes_Type::const_iterator volumeContainerIterator = mesh.volumeList.begin();
+            volumeContainerIterator != mesh.volumeList.end(); ++volumeContainerIterator )
+    {
+        for ( ID jFaceLocalId = 0; jFaceLocalId < mesh.numLocalFaces(); ++jFaceLocalId )
+        {
+            const UInt point1Id ( volumeContainerIterator->point ( volumeShape.faceToPoint ( jFaceLocalId, 0 ) ).localId() );
+            const UInt point2Id ( volumeContainerIterator->point ( volumeShape.faceToPoint ( jFaceLocalId, 1 ) ).localId() );
+            const UInt point3Id ( volumeContainerIterator->point ( volumeShape.faceToPoint ( jFaceLocalId, 2 ) ).localId() );
+            const BareFace bareFace ( makeBareFace ( point1Id, point2Id, point3Id ).first );
+
+            if ( ( faceContainerIterator = boundaryFaceContainer.find ( bareFace ) ) == boundaryFaceContainer.end() )
+            {
+                boundaryFaceContainer.insert (
+                    std::make_pair ( bareFace, std::make_pair ( volumeContainerIterator->localId(), jFaceLocalId ) ) );
+            }
+            else
+            {
+                if ( point1Id > point2Id )
+                {
+                    internalFaces.insert (
+                        std::make_pair ( bareFace, std::make_pair ( volumeContainerIterator->localId(), jFaceLocalId ) ) );
+                }
+                boundaryFaceContainer.erase ( faceContainerIterator );
+            }
+        }
+    }
+    return boundaryFaceContainer.size();
+}
+
+// Two face containers hold the same faces, in the same order, with the same data
+bool sameFaceContainers ( const MeshUtility::temporaryFaceContainer_Type& container1,
+                          const MeshUtility::temporaryFaceContainer_Type& container2 )
+{
+    if ( container1.size() != container2.size() )
+    {
+        return false;
+    }
+    MeshUtility::temporaryFaceContainer_Type::const_iterator iterator2 ( container2.begin() );
+    for ( MeshUtility::temporaryFaceContainer_Type::const_iterator iterator1 ( container1.begin() );
+            iterator1 != container1.end(); ++iterator1, ++iterator2 )
+    {
+        if ( !sameBareItem ( iterator1->first, iterator2->first ) || iterator1->second != iterator2->second )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+// ===================================================
+//! Main
+// ===================================================
+int main ( int argc, char* argv[] )
+{
+#ifdef HAVE_MPI
+    MPI_Init (&argc, &argv);
+#endif
+
+    bool success ( true );
+
+    // this brace is important to destroy the Epetra_Comm object before calling MPI_Finalize
+    {
+#ifdef HAVE_MPI
+        boost::shared_ptr<Epetra_Comm> comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+#else
+        boost::shared_ptr<Epetra_Comm> comm ( new Epetra_SerialComm() );
+#endif
+
+        GetPot command_line ( argc, argv );
+        const UInt n ( command_line.follow ( 24, "-n" ) );
+
+        boost::shared_ptr<mesh_Type> meshPtr ( new mesh_Type ( comm ) );
+        regularMesh3D ( *meshPtr, 1, n, n, n );
+
+        const UInt numVolumes ( meshPtr->numVolumes() );
+        const UInt numPoints ( meshPtr->numPoints() );
+
+        // Discovery of the faces: former std::map search against the sorted occurrences
+        MeshUtility::temporaryFaceContainer_Type mapBoundaryFaces, mapInternalFaces;
+        LifeChrono chronoMap;
+        chronoMap.start();
+        findFacesWithMap ( *meshPtr, mapBoundaryFaces, mapInternalFaces );
+        chronoMap.stop();
+
+        MeshUtility::temporaryFaceContainer_Type boundaryFaces, internalFaces;
+        UInt numInternalFaces ( 0 );
+        LifeChrono chronoFind;
+        chronoFind.start();
+        const UInt numBoundaryFaces ( MeshUtility::findFaces ( *meshPtr, boundaryFaces, numInternalFaces, internalFaces, true ) );
+        chronoFind.stop();
+
+        success = success && sameFaceContainers ( boundaryFaces, mapBoundaryFaces );
+        success = success && sameFaceContainers ( internalFaces, mapInternalFaces );
+
+        // Construction of all the faces and all the edges
+        UInt numBoundaryFacesBuilt ( 0 ), numInternalFacesBuilt ( 0 );
+        LifeChrono chronoFaces;
+        chronoFaces.start();
+        success = success && MeshUtility::buildFaces ( *meshPtr, std::cout, std::cerr, numBoundaryFacesBuilt,
+                                                       numInternalFacesBuilt, true, true );
+        chronoFaces.stop();
+
+        UInt numBoundaryEdges ( 0 ), numInternalEdges ( 0 );
+        LifeChrono chronoEdges;
+        chronoEdges.start();
+        success = success && MeshUtility::buildEdges ( *meshPtr, std::cout, std::cerr, numBoundaryEdges,
+                                                       numInternalEdges, true, true );
+        chronoEdges.stop();
+
+        // Structured mesh of a cube: 12 n^2 boundary triangles, each tetrahedron has 4 faces
+        // and the Euler formula V - E + F - T = 1 holds
+        const UInt numFaces ( numBoundaryFaces + numInternalFaces );
+        success = success && ( numBoundaryFaces == 12 * n * n );
+        success = success && ( 2 * numFaces == 4 * numVolumes + numBoundaryFaces );
+        success = success && ( meshPtr->numFaces() == numFaces );
+        success = success && ( numBoundaryEdges == 3 * numBoundaryFaces / 2 );
+        success = success && ( numPoints + numFaces == numBoundaryEdges + numInternalEdges + numVolumes + 1 );
+
+        // Every internal face has two adjacent elements
+        for ( UInt iFace ( meshPtr->numBFaces() ); iFace < meshPtr->numFaces(); ++iFace )
+        {
+            success = success && ( meshPtr->face ( iFace ).secondAdjacentElementIdentity() != NotAnId );
+        }
+
+        std::cout << "Tetrahedra:                      " << numVolumes << std::endl;
+        std::cout << "Faces (boundary):                " << numFaces << " (" << numBoundaryFaces << ")" << std::endl;
+        std::cout << "Edges (boundary):                " << numBoundaryEdges + numInternalEdges
+                  << " (" << numBoundaryEdges << ")" << std::endl;
+        std::cout << "findFaces, std::map search:      " << chronoMap.diff() << " s" << std::endl;
+        std::cout << "findFaces, sorted occurrences:   " << chronoFind.diff() << " s" << std::endl;
+        std::cout << "buildFaces (all faces):          " << chronoFaces.diff() << " s" << std::endl;
+        std::cout << "buildEdges (all edges):          " << chronoEdges.diff() << " s" << std::endl;
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    if ( success )
+    {
+        return ( EXIT_SUCCESS );
+    }
+    return ( EXIT_FAILURE );
+}
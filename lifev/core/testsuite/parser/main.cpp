@@ -191,6 +191,30 @@ main ( Int argc, char** argv )
               << parser.evaluate (1) << ", "
               << parser.evaluate (2) << "]" << std::endl;
 
+    // TEST 11:
+    expression = "a=2; [a*x*y*sin(t), z]"; // a*x*y*sin(t) on a set of points
+    parser.setString (expression);
+    std::vector<Real> x (3), y (3), z (3), results;
+    for ( UInt i (0); i < x.size(); ++i )
+    {
+        x[i] = i;
+        y[i] = 2. * i;
+        z[i] = -1. * i;
+    }
+    parser.evaluate ( x, y, z, 0.5, results, 0 );
+    bool batchFailed ( results.size() != x.size() );
+    for ( UInt i (0); i < results.size(); ++i )
+    {
+        batchFailed = batchFailed || std::abs ( results[i] - 2. * x[i] * y[i] * std::sin (0.5) ) > tolerance;
+    }
+    parser.evaluate ( x, y, z, 0.5, results, 1 );
+    for ( UInt i (0); i < results.size(); ++i )
+    {
+        batchFailed = batchFailed || std::abs ( results[i] - z[i] ) > tolerance;
+    }
+    std::cout << "TEST 11:  " << check ( batchFailed )
+              << "t = 0.5, (x, y, z) = (i, 2i, -i) ==> " << expression << " = [" << results[2] << ", ...]" << std::endl;
+
     std::cout << std::endl << "TEST ENDS SUCCESFULLY" << std::endl;
 
     // PERFORMANCE TEST
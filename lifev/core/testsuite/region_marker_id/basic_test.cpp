@@ -35,7 +35,9 @@
     @date 2012-09-14
 
     Colour a mesh with two different colours, count the number
-    of elements equal of one of the two.
+    of elements equal of one of the two. Check that the lists of
+    elements by marker cached by the mesh follow the changes of
+    the markers.
 
  */
 
@@ -72,6 +74,27 @@ UInt colour_fun ( const Vector3D& barycentre )
     return 3;
 }
 
+// Check the cached list of the elements with a marker against the markers of the elements
+template <typename MeshType>
+bool checkElementsWithMarker ( const MeshType& mesh, const markerID_Type& marker )
+{
+    const std::vector<UInt>& list = mesh.elementsWithMarker ( marker );
+
+    UInt count = 0;
+    for ( UInt i = 0; i < mesh.numElements(); ++i )
+    {
+        if ( mesh.element ( i ).markerID() == marker )
+        {
+            if ( count >= list.size() || list[ count ] != i )
+            {
+                return false;
+            }
+            ++count;
+        }
+    }
+    return count == list.size();
+}
+
 int main (int argc, char* argv[])
 {
 #ifdef HAVE_MPI
@@ -90,6 +113,9 @@ int main (int argc, char* argv[])
     // Fill the mesh with a structured mesh.
     regularMesh2D ( *mesh, 0, 8, 11 );
 
+    // Build the lists of elements by marker before the colouring.
+    bool listsAreConsistent = checkElementsWithMarker ( *mesh, 2 );
+
     // Colour the mesh according to a function.
     MeshUtility::assignRegionMarkerID ( *mesh, colour_fun );
 
@@ -99,6 +125,26 @@ int main (int argc, char* argv[])
     // Number of elements with colour 2
     const UInt exactNumber = 44;
 
+    // The lists must follow the new colours.
+    listsAreConsistent = listsAreConsistent && checkElementsWithMarker ( *mesh, 2 )
+                         && checkElementsWithMarker ( *mesh, 3 )
+                         && mesh->elementsWithMarker ( 2 ).size() == exactNumber;
+
+    // Change the colour of a single element.
+    mesh->element ( 0 ).setMarkerID ( 5 );
+    listsAreConsistent = listsAreConsistent && checkElementsWithMarker ( *mesh, 2 )
+                         && checkElementsWithMarker ( *mesh, 3 )
+                         && mesh->elementsWithMarker ( 5 ).size() == 1;
+
+    // Same for a boundary facet.
+    const markerID_Type facetMarker = mesh->boundaryFacet ( 0 ).markerID();
+    const UInt facetsWithMarker = mesh->boundaryFacetsWithMarker ( facetMarker ).size();
+    mesh->boundaryFacet ( 0 ).setMarkerID ( 100 );
+    listsAreConsistent = listsAreConsistent
+                         && mesh->boundaryFacetsWithMarker ( facetMarker ).size() == facetsWithMarker - 1
+                         && mesh->boundaryFacetsWithMarker ( 100 ).size() == 1
+                         && mesh->boundaryFacetsWithMarker ( 100 ) [0] == 0;
+
     {
         // Needed to correctly destroy the exporterHDF5
 
@@ -124,7 +170,7 @@ int main (int argc, char* argv[])
     MPI_Finalize();
 #endif
 
-    if ( colourElements == exactNumber )
+    if ( colourElements == exactNumber && listsAreConsistent )
     {
         return ( EXIT_SUCCESS );
     }
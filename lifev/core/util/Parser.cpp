@@ -47,7 +47,8 @@ Parser::Parser() :
     M_strings       (),
     M_results       (),
     M_calculator    (),
-    M_evaluate      ( true )
+    M_evaluate      ( true ),
+    M_compile       ( true )
 {
 
 #ifdef HAVE_LIFEV_DEBUG
@@ -61,7 +62,8 @@ Parser::Parser ( const std::string& string ) :
     M_strings       (),
     M_results       (),
     M_calculator    (),
-    M_evaluate      ( true )
+    M_evaluate      ( true ),
+    M_compile       ( true )
 {
 
 #ifdef HAVE_LIFEV_DEBUG
@@ -76,7 +78,8 @@ Parser::Parser ( const Parser& parser ) :
     M_strings       ( parser.M_strings ),
     M_results       ( parser.M_results ),
     M_calculator    ( parser.M_calculator ),
-    M_evaluate      ( parser.M_evaluate )
+    M_evaluate      ( parser.M_evaluate ),
+    M_compile       ( parser.M_compile )
 {
 }
 
@@ -88,13 +91,11 @@ Parser::operator= ( const Parser& parser )
 {
     if ( this != &parser )
     {
-        std::cerr << "!!! ERROR: Operator= not working !!!" << std::endl;
-        std::exit ( EXIT_FAILURE );
-
         M_strings    = parser.M_strings;
         M_results    = parser.M_results;
-        //M_calculator = parser.M_calculator; //NOT WORKING!!!
+        M_calculator = parser.M_calculator;
         M_evaluate   = parser.M_evaluate;
+        M_compile    = parser.M_compile;
     }
 
     return *this;
@@ -106,27 +107,11 @@ Parser::operator= ( const Parser& parser )
 const Real&
 Parser::evaluate ( const ID& id )
 {
+    compile();
+
     if ( M_evaluate )
     {
-        M_results.clear();
-        stringIterator_Type start, end;
-
-        for ( UInt i (0); i < M_strings.size(); ++i )
-        {
-            start = M_strings[i].begin();
-            end   = M_strings[i].end();
-#ifdef HAVE_BOOST_SPIRIT_QI
-#ifdef ENABLE_SPIRIT_PARSER
-            qi::phrase_parse ( start, end, M_calculator, ascii::space, M_results );
-#else
-            std::cerr << "!!! ERROR: The Boost Spirit parser has been disabled !!!" << std::endl;
-            std::exit ( EXIT_FAILURE );
-#endif /* ENABLE_SPIRIT_PARSER */
-#else
-            std::cerr << "!!! ERROR: Boost version < 1.41 !!!" << std::endl;
-            std::exit ( EXIT_FAILURE );
-#endif
-        }
+        M_calculator.evaluate ( M_results );
         M_evaluate = false;
     }
 
@@ -137,6 +122,36 @@ Parser::evaluate ( const ID& id )
     return M_results[id];
 }
 
+void
+Parser::evaluate ( const std::vector< Real >& x, const std::vector< Real >& y, const std::vector< Real >& z,
+                   const Real& t, std::vector< Real >& results, const ID& id )
+{
+    ASSERT ( y.size() == x.size() && z.size() == x.size(), "Parser::evaluate: the coordinate vectors have different sizes" );
+
+    compile();
+
+    ASSERT ( id < M_calculator.numberOfResults(), "Parser::evaluate: the expression does not exist" );
+
+    const UInt xID ( M_calculator.variableID ( "x" ) );
+    const UInt yID ( M_calculator.variableID ( "y" ) );
+    const UInt zID ( M_calculator.variableID ( "z" ) );
+    M_calculator.setVariable ( "t", t );
+
+    results.resize ( x.size() );
+    for ( UInt i (0); i < x.size(); ++i )
+    {
+        M_calculator.setVariable ( xID, x[i] );
+        M_calculator.setVariable ( yID, y[i] );
+        M_calculator.setVariable ( zID, z[i] );
+
+        M_calculator.evaluate ( M_results );
+        results[i] = M_results[id];
+    }
+
+    // The stored results are the ones of the last point
+    M_evaluate = x.empty();
+}
+
 UInt
 Parser::countSubstring ( const std::string& substring ) const
 {
@@ -163,6 +178,7 @@ void
 Parser::clearVariables()
 {
     M_calculator.clearVariables();
+    M_compile  = true;
     M_evaluate = true;
 }
 
@@ -186,10 +202,8 @@ Parser::setString ( const std::string& string, const std::string& stringSeparato
         boost::replace_all ( M_strings[i], " ", "" );
     }
 
-    //Reserve the space for results
-    M_results.clear();
-    M_results.reserve ( countSubstring ( "," ) + 1 );
-
+    //The strings are compiled at the first evaluation, when all the variables are set
+    M_compile  = true;
     M_evaluate = true;
 }
 
@@ -220,4 +234,18 @@ Parser::variable ( const std::string& name )
     return M_calculator.variable ( name );
 }
 
+// ===================================================
+// Private Methods
+// ===================================================
+void
+Parser::compile()
+{
+    if ( M_compile )
+    {
+        M_calculator.compile ( M_strings );
+        M_compile  = false;
+        M_evaluate = true;
+    }
+}
+
 } // Namespace LifeV
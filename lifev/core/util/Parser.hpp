@@ -39,7 +39,7 @@
 #define Parser_H 1
 
 #include <lifev/core/util/LifeDebug.hpp>
-#include <lifev/core/util/ParserSpiritGrammar.hpp>
+#include <lifev/core/util/ParserBytecode.hpp>
 
 namespace LifeV
 {
@@ -49,7 +49,8 @@ namespace LifeV
  *  @author Cristiano Malossi
  *
  *  \c Parser is a general interface class for \c LifeV algebraic parsers.
- *  At the present time it works only with \c boost::spirit::qi.
+ *  The strings are compiled once (by \c ParserBytecode) the first time they are evaluated;
+ *  then, each evaluation only runs the compiled instructions with the current values of the variables.
  *
  *  <b>EXAMPLE - HOW TO USE</b>
  *
@@ -71,7 +72,14 @@ namespace LifeV
  *  Real result3 = parser.evaluate(3); // c*c*c<BR>
  *  </CODE>
  *
- *  See \c ParserSpiritGrammar class for more details on the expression syntax.
+ *  To evaluate an expression of the space coordinates on a set of points (e.g., boundary DOFs):
+ *
+ *  <CODE>
+ *  parser.setString( "[x*y*sin(t), 0, 0]" );<BR>
+ *  parser.evaluate( x, y, z, t, results, 0 ); // results[i] = x[i]*y[i]*sin(t)<BR>
+ *  </CODE>
+ *
+ *  See \c ParserBytecode class for more details on the expression syntax.
  */
 class Parser
 {
@@ -90,7 +98,7 @@ public:
 
     /*! @typedef calculator_Type */
     //!Type definition for the parser interpreter
-    typedef ParserSpiritGrammar< stringIterator_Type >       calculator_Type;
+    typedef ParserBytecode                                   calculator_Type;
 
     /*! @typedef results_Type */
     //! Type definition for the results
@@ -128,8 +136,6 @@ public:
 
     //! Operator =
     /*!
-     * <b> Important note: this method is not working right now. </b>
-     *
      * @param parser Parser
      * @return reference to a copy of the class
      */
@@ -148,6 +154,20 @@ public:
      */
     const Real& evaluate ( const ID& id = 0 );
 
+    //! Evaluate the expression on a set of points
+    /*!
+     * The variables "x", "y", "z" are set to the coordinates of each point and "t" to the time.
+     * The expression is compiled only once for all the points.
+     * @param x x coordinates of the points
+     * @param y y coordinates of the points
+     * @param z z coordinates of the points
+     * @param t time
+     * @param results computed values (resized to the number of points)
+     * @param id expression index (starting from 0)
+     */
+    void evaluate ( const std::vector< Real >& x, const std::vector< Real >& y, const std::vector< Real >& z,
+                    const Real& t, std::vector< Real >& results, const ID& id = 0 );
+
     //! Count how many substrings are present in the string (utility for BCInterfaceFunctionParser)
     /*!
      * @param substring string to find
@@ -195,6 +215,14 @@ public:
 
 private:
 
+    //! @name Private Methods
+    //@{
+
+    //! Compile the strings (if they have changed)
+    void compile();
+
+    //@}
+
     stringsVector_Type  M_strings;
 
     results_Type        M_results;
@@ -202,6 +230,7 @@ private:
     calculator_Type     M_calculator;
 
     bool                M_evaluate;
+    bool                M_compile;
 };
 
 } // Namespace LifeV
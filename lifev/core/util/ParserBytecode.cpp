@@ -0,0 +1,665 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+ *  @file
+ *  @brief File containing the compiler and interpreter of the Parser expressions
+ *
+ *  @date 10-2026
+ */
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+#include <lifev/core/util/ParserBytecode.hpp>
+
+namespace LifeV
+{
+
+// ===================================================
+// Constructors & Destructor
+// ===================================================
+ParserBytecode::ParserBytecode() :
+    M_program           (),
+    M_numberOfResults   ( 0 ),
+    M_stack             (),
+    M_stackSize         ( 0 ),
+    M_variablesID       (),
+    M_variables         (),
+    M_string            (),
+    M_position          ( 0 )
+{
+}
+
+// ===================================================
+// Methods
+// ===================================================
+void
+ParserBytecode::compile ( const stringsVector_Type& strings )
+{
+    M_program.clear();
+    M_numberOfResults = 0;
+    M_stack.clear();
+    M_stackSize = 0;
+
+    for ( UInt i (0); i < strings.size(); ++i )
+    {
+        compileString ( strings[i] );
+    }
+
+    M_string.clear();
+    M_position = 0;
+}
+
+void
+ParserBytecode::evaluate ( results_Type& results )
+{
+    results.resize ( M_numberOfResults );
+
+    Real* stack ( M_stack.empty() ? 0 : &M_stack[0] );
+    Int   top ( -1 );
+    UInt  result ( 0 );
+
+    for ( std::vector< instruction_Type >::const_iterator i = M_program.begin(); i != M_program.end(); ++i )
+    {
+        switch ( i->operation )
+        {
+            case Constant:
+                stack[++top] = i->value;
+                break;
+            case Variable:
+                stack[++top] = M_variables[i->index];
+                break;
+            case Assignment:
+                M_variables[i->index] = stack[top--];
+                break;
+            case Result:
+                results[result++] = stack[top--];
+                break;
+            case Replace:
+                stack[top - 1] = stack[top];
+                --top;
+                break;
+            case Negation:
+                stack[top] = -stack[top];
+                break;
+            case Addition:
+                stack[top - 1] += stack[top];
+                --top;
+                break;
+            case Subtraction:
+                stack[top - 1] -= stack[top];
+                --top;
+                break;
+            case Multiplication:
+                stack[top - 1] *= stack[top];
+                --top;
+                break;
+            case Division:
+                stack[top - 1] /= stack[top];
+                --top;
+                break;
+            case Power:
+                stack[top - 1] = std::pow ( stack[top - 1], stack[top] );
+                --top;
+                break;
+            case Greater:
+                stack[top - 1] = stack[top - 1] > stack[top];
+                --top;
+                break;
+            case Less:
+                stack[top - 1] = stack[top - 1] < stack[top];
+                --top;
+                break;
+            case GreaterEqual:
+                stack[top - 1] = stack[top - 1] >= stack[top];
+                --top;
+                break;
+            case LessEqual:
+                stack[top - 1] = stack[top - 1] <= stack[top];
+                --top;
+                break;
+            case Sin:
+                stack[top] = std::sin ( stack[top] );
+                break;
+            case Cos:
+                stack[top] = std::cos ( stack[top] );
+                break;
+            case Tan:
+                stack[top] = std::tan ( stack[top] );
+                break;
+            case Sqrt:
+                stack[top] = std::sqrt ( stack[top] );
+                break;
+            case Exp:
+                stack[top] = std::exp ( stack[top] );
+                break;
+            case Log:
+                stack[top] = std::log ( stack[top] );
+                break;
+            case Log10:
+                stack[top] = std::log10 ( stack[top] );
+                break;
+        }
+    }
+}
+
+void
+ParserBytecode::clearVariables()
+{
+    M_variablesID.clear();
+    M_variables.clear();
+
+    // The compiled program refers to the old variables
+    M_program.clear();
+    M_numberOfResults = 0;
+}
+
+// ===================================================
+// Set Methods
+// ===================================================
+void
+ParserBytecode::setDefaultVariables()
+{
+    setVariable ( "pi", M_PI );
+    setVariable ( "e", M_E );
+}
+
+// ===================================================
+// Get Methods
+// ===================================================
+UInt
+ParserBytecode::variableID ( const std::string& name )
+{
+    std::map< std::string, UInt >::const_iterator i = M_variablesID.find ( name );
+    if ( i != M_variablesID.end() )
+    {
+        return i->second;
+    }
+
+    M_variables.push_back ( 0. );
+    M_variablesID[name] = M_variables.size() - 1;
+
+    return M_variables.size() - 1;
+}
+
+// ===================================================
+// Private Methods
+// ===================================================
+void
+ParserBytecode::compileString ( const std::string& string )
+{
+    // Remove white spaces
+    M_string.clear();
+    for ( std::string::const_iterator i = string.begin(); i != string.end(); ++i )
+        if ( !std::isspace ( *i ) )
+        {
+            M_string.push_back ( *i );
+        }
+    M_position = 0;
+
+    // Assignment: name = expression
+    std::string name;
+    if ( readIdentifier ( name ) && accept ( "=" ) )
+    {
+        compileExpression();
+        addInstruction ( Assignment, variableID ( name ) );
+    }
+    else
+    {
+        // List of expressions: [expression, expression, ...]
+        M_position = 0;
+        accept ( "[" );
+
+        compileExpression();
+        addInstruction ( Result );
+        while ( accept ( "," ) )
+        {
+            compileExpression();
+            addInstruction ( Result );
+        }
+
+        accept ( "]" );
+    }
+
+    if ( M_position < M_string.size() )
+    {
+        std::cerr << "!!! WARNING: Parser cannot compile \"" << M_string.substr ( M_position )
+                  << "\" in \"" << M_string << "\" (ignored) !!!" << std::endl;
+    }
+}
+
+bool
+ParserBytecode::compileExpression()
+{
+    // An empty expression is zero; in a sequence of comparisons only the last one is kept
+    if ( !compileCompare() )
+    {
+        addInstruction ( Constant, 0, 0. );
+        return true;
+    }
+
+    while ( compileCompare() )
+    {
+        addInstruction ( Replace );
+    }
+
+    return true;
+}
+
+bool
+ParserBytecode::compileCompare()
+{
+    if ( !compilePlusMinus() )
+    {
+        return false;
+    }
+
+    for ( ;; )
+    {
+        const compilerState_Type state ( compilerState() );
+        operation_Type operation;
+
+        if ( accept ( ">=" ) )
+        {
+            operation = GreaterEqual;
+        }
+        else if ( accept ( "<=" ) )
+        {
+            operation = LessEqual;
+        }
+        else if ( accept ( ">" ) )
+        {
+            operation = Greater;
+        }
+        else if ( accept ( "<" ) )
+        {
+            operation = Less;
+        }
+        else
+        {
+            return true;
+        }
+
+        if ( !compilePlusMinus() )
+        {
+            restoreCompilerState ( state );
+            return true;
+        }
+        addInstruction ( operation );
+    }
+}
+
+bool
+ParserBytecode::compilePlusMinus()
+{
+    if ( !compileMultiplyDivide() )
+    {
+        return false;
+    }
+
+    for ( ;; )
+    {
+        const compilerState_Type state ( compilerState() );
+        operation_Type operation;
+
+        if ( accept ( "+" ) )
+        {
+            operation = Addition;
+        }
+        else if ( accept ( "-" ) )
+        {
+            operation = Subtraction;
+        }
+        else
+        {
+            return true;
+        }
+
+        if ( !compileMultiplyDivide() )
+        {
+            restoreCompilerState ( state );
+            return true;
+        }
+        addInstruction ( operation );
+    }
+}
+
+bool
+ParserBytecode::compileMultiplyDivide()
+{
+    if ( !compileElevate() )
+    {
+        return false;
+    }
+
+    for ( ;; )
+    {
+        const compilerState_Type state ( compilerState() );
+        operation_Type operation;
+
+        if ( accept ( "*" ) )
+        {
+            operation = Multiplication;
+        }
+        else if ( accept ( "/" ) )
+        {
+            operation = Division;
+        }
+        else
+        {
+            return true;
+        }
+
+        if ( !compileElevate() )
+        {
+            restoreCompilerState ( state );
+            return true;
+        }
+        addInstruction ( operation );
+    }
+}
+
+bool
+ParserBytecode::compileElevate()
+{
+    const compilerState_Type state ( compilerState() );
+
+    // -a^b^c = ( -(a^b) )^c
+    bool negation ( false );
+    if ( accept ( "-" ) && compileElement() )
+    {
+        const compilerState_Type powerState ( compilerState() );
+        if ( accept ( "^" ) && compileElement() )
+        {
+            addInstruction ( Power );
+            addInstruction ( Negation );
+            negation = true;
+        }
+        else
+        {
+            restoreCompilerState ( powerState );
+        }
+    }
+
+    // otherwise: element [^ element]*
+    if ( !negation )
+    {
+        restoreCompilerState ( state );
+        if ( !compileElement() )
+        {
+            return false;
+        }
+    }
+
+    for ( ;; )
+    {
+        const compilerState_Type powerState ( compilerState() );
+        if ( !accept ( "^" ) || !compileElement() )
+        {
+            restoreCompilerState ( powerState );
+            return true;
+        }
+        addInstruction ( Power );
+    }
+}
+
+bool
+ParserBytecode::compileElement()
+{
+    const compilerState_Type state ( compilerState() );
+
+    // Negation
+    if ( accept ( "-" ) )
+    {
+        if ( compileElement() )
+        {
+            addInstruction ( Negation );
+            return true;
+        }
+        restoreCompilerState ( state );
+    }
+
+    // Number
+    Real number;
+    if ( readNumber ( number ) )
+    {
+        addInstruction ( Constant, 0, number );
+        return true;
+    }
+
+    std::string identifier;
+    if ( readIdentifier ( identifier ) )
+    {
+        // Function
+        operation_Type function ( Constant );
+        if ( identifier == "sin" )
+        {
+            function = Sin;
+        }
+        else if ( identifier == "cos" )
+        {
+            function = Cos;
+        }
+        else if ( identifier == "tan" )
+        {
+            function = Tan;
+        }
+        else if ( identifier == "sqrt" )
+        {
+            function = Sqrt;
+        }
+        else if ( identifier == "exp" )
+        {
+            function = Exp;
+        }
+        else if ( identifier == "log" )
+        {
+            function = Log;
+        }
+        else if ( identifier == "log10" )
+        {
+            function = Log10;
+        }
+
+        if ( function != Constant )
+        {
+            const compilerState_Type groupState ( compilerState() );
+            if ( compileGroup() )
+            {
+                addInstruction ( function );
+                return true;
+            }
+            restoreCompilerState ( groupState );
+        }
+
+        // Variable
+        addInstruction ( Variable, variableID ( identifier ) );
+        return true;
+    }
+
+    // Group
+    return compileGroup();
+}
+
+bool
+ParserBytecode::compileGroup()
+{
+    const compilerState_Type state ( compilerState() );
+
+    if ( accept ( "(" ) && compileExpression() && accept ( ")" ) )
+    {
+        return true;
+    }
+
+    restoreCompilerState ( state );
+    return false;
+}
+
+bool
+ParserBytecode::readNumber ( Real& number )
+{
+    std::string::size_type position ( M_position );
+    const std::string::size_type size ( M_string.size() );
+
+    if ( position < size && M_string[position] == '+' )
+    {
+        ++position;
+    }
+
+    // Mantissa
+    UInt digits ( 0 );
+    for ( ; position < size && std::isdigit ( M_string[position] ); ++position )
+    {
+        ++digits;
+    }
+    if ( position < size && M_string[position] == '.' )
+    {
+        for ( ++position; position < size && std::isdigit ( M_string[position] ); ++position )
+        {
+            ++digits;
+        }
+    }
+    if ( digits == 0 )
+    {
+        return false;
+    }
+
+    // Exponent (only if followed by digits)
+    if ( position < size && ( M_string[position] == 'e' || M_string[position] == 'E' ) )
+    {
+        std::string::size_type exponent ( position + 1 );
+        if ( exponent < size && ( M_string[exponent] == '+' || M_string[exponent] == '-' ) )
+        {
+            ++exponent;
+        }
+        if ( exponent < size && std::isdigit ( M_string[exponent] ) )
+        {
+            for ( position = exponent; position < size && std::isdigit ( M_string[position] ); ++position )
+            {}
+        }
+    }
+
+    number = std::strtod ( M_string.substr ( M_position, position - M_position ).c_str(), 0 );
+    M_position = position;
+
+    return true;
+}
+
+bool
+ParserBytecode::readIdentifier ( std::string& identifier )
+{
+    const std::string::size_type size ( M_string.size() );
+    if ( M_position >= size || !( std::isalpha ( M_string[M_position] ) || M_string[M_position] == '_' ) )
+    {
+        return false;
+    }
+
+    std::string::size_type position ( M_position + 1 );
+    while ( position < size && ( std::isalnum ( M_string[position] ) || M_string[position] == '_' ) )
+    {
+        ++position;
+    }
+
+    identifier = M_string.substr ( M_position, position - M_position );
+    M_position = position;
+
+    return true;
+}
+
+bool
+ParserBytecode::accept ( const char* token )
+{
+    const std::string::size_type length ( std::strlen ( token ) );
+    if ( M_string.compare ( M_position, length, token ) == 0 )
+    {
+        M_position += length;
+        return true;
+    }
+
+    return false;
+}
+
+ParserBytecode::compilerState_Type
+ParserBytecode::compilerState() const
+{
+    compilerState_Type state;
+    state.programSize = M_program.size();
+    state.stackSize   = M_stackSize;
+    state.position    = M_position;
+
+    return state;
+}
+
+void
+ParserBytecode::restoreCompilerState ( const compilerState_Type& state )
+{
+    M_program.resize ( state.programSize );
+    M_stackSize = state.stackSize;
+    M_position  = state.position;
+}
+
+void
+ParserBytecode::addInstruction ( const operation_Type& operation, const UInt& index, const Real& value )
+{
+    instruction_Type instruction;
+    instruction.operation = operation;
+    instruction.index     = index;
+    instruction.value     = value;
+    M_program.push_back ( instruction );
+
+    switch ( operation )
+    {
+        case Constant:
+        case Variable:
+            ++M_stackSize;
+            break;
+        case Result:
+            ++M_numberOfResults;
+            --M_stackSize;
+            break;
+        case Negation:
+        case Sin:
+        case Cos:
+        case Tan:
+        case Sqrt:
+        case Exp:
+        case Log:
+        case Log10:
+            break;
+        default:
+            --M_stackSize;
+            break;
+    }
+
+    if ( M_stackSize > M_stack.size() )
+    {
+        M_stack.resize ( M_stackSize );
+    }
+}
+
+} // Namespace LifeV
@@ -0,0 +1,290 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+ *  @file
+ *  @brief File containing the compiler and interpreter of the Parser expressions
+ *
+ *  @date 10-2026
+ */
+
+#ifndef Parser_Bytecode_H
+#define Parser_Bytecode_H 1
+
+#include <lifev/core/util/ParserDefinitions.hpp>
+
+namespace LifeV
+{
+
+//! ParserBytecode - Compiler and interpreter for the algebraic expressions of the \c Parser
+/*!
+ *  The expressions are compiled once into a sequence of stack-machine instructions,
+ *  where each variable is bound to a slot of a contiguous array of values.
+ *  The evaluation is then a loop over the instructions, which does not parse
+ *  any string and does not allocate memory.
+ *
+ *  The grammar is:
+ *
+ *  - each string is either an assignment ("name = expression") or a list of
+ *    expressions separated by commas and optionally enclosed in square brackets;
+ *  - the operators are (by increasing precedence) >, <, >=, <=; +, -; *, /; ^ (left associative);
+ *    unary -; functions sqrt(), sin(), cos(), tan(), exp(), log(), log10(); groups ().
+ *    Note that "-a^b" is "-(a^b)", while "-a^b^c" is "(-(a^b))^c".
+ *
+ *  A syntax error stops the compilation of the string: the expressions compiled before
+ *  the error are kept (a warning is displayed).
+ *
+ *  The variables which are not defined when the expressions are compiled are created with a zero value,
+ *  so that they can be set later on.
+ */
+class ParserBytecode
+{
+public:
+
+    //! @name Public Types
+    //@{
+
+    /*! @typedef stringsVector_Type */
+    //! Type definition for the vector containing the string segments
+    typedef std::vector< std::string >                       stringsVector_Type;
+
+    /*! @typedef results_Type */
+    //! Type definition for the results
+    typedef std::vector< Real >                              results_Type;
+
+    //@}
+
+
+    //! @name Constructors & Destructor
+    //@{
+
+    //! Constructor
+    explicit ParserBytecode();
+
+    //! Destructor
+    virtual ~ParserBytecode() {}
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! Compile the strings
+    /*!
+     * @param strings the strings to compile (evaluated in this order)
+     */
+    void compile ( const stringsVector_Type& strings );
+
+    //! Evaluate the compiled strings
+    /*!
+     * The assignments are executed and the results of the expressions are stored.
+     * @param results the results of the expressions (resized to numberOfResults())
+     */
+    void evaluate ( results_Type& results );
+
+    //! Clear all the variables and the compiled strings
+    void clearVariables();
+
+    //@}
+
+
+    //! @name Set Methods
+    //@{
+
+    //! Set default variables
+    void setDefaultVariables();
+
+    //! Set/replace a variable
+    /*!
+     * @param name name of the variable
+     * @param value value of the variable
+     */
+    void setVariable ( const std::string& name, const Real& value )
+    {
+        M_variables[ variableID ( name ) ] = value;
+    }
+
+    //! Set/replace a variable
+    /*!
+     * @param id ID of the variable (see variableID())
+     * @param value value of the variable
+     */
+    void setVariable ( const UInt& id, const Real& value )
+    {
+        M_variables[id] = value;
+    }
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! Get the ID of a variable (the variable is created if it does not exist)
+    /*!
+     * @param name name of the variable
+     * @return ID of the variable
+     */
+    UInt variableID ( const std::string& name );
+
+    //! Get variable (the variable is created if it does not exist)
+    /*!
+     * The reference is valid until a new variable is created.
+     * @param name name of the variable
+     * @return value of the variable
+     */
+    Real& variable ( const std::string& name )
+    {
+        return M_variables[ variableID ( name ) ];
+    }
+
+    //! Get the number of results of the compiled strings
+    /*!
+     * @return number of results
+     */
+    const UInt& numberOfResults() const
+    {
+        return M_numberOfResults;
+    }
+
+    //@}
+
+private:
+
+    //! @name Private Types
+    //@{
+
+    enum operation_Type
+    {
+        Constant,
+        Variable,
+        Assignment,
+        Result,
+        Replace,
+        Negation,
+        Addition,
+        Subtraction,
+        Multiplication,
+        Division,
+        Power,
+        Greater,
+        Less,
+        GreaterEqual,
+        LessEqual,
+        Sin,
+        Cos,
+        Tan,
+        Sqrt,
+        Exp,
+        Log,
+        Log10
+    };
+
+    struct instruction_Type
+    {
+        operation_Type operation;
+        UInt           index;
+        Real           value;
+    };
+
+    struct compilerState_Type
+    {
+        UInt                   programSize;
+        UInt                   stackSize;
+        std::string::size_type position;
+    };
+
+    //@}
+
+
+    //! @name Private Methods
+    //@{
+
+    //! Compile one string
+    void compileString ( const std::string& string );
+
+    //! Compile an expression (a sequence of comparisons, whose value is the last one)
+    bool compileExpression();
+
+    //! Compile a comparison: sum [(>|<|>=|<=) sum]*
+    bool compileCompare();
+
+    //! Compile a sum: product [(+|-) product]*
+    bool compilePlusMinus();
+
+    //! Compile a product: power [(*|/) power]*
+    bool compileMultiplyDivide();
+
+    //! Compile a power: [-] element [^ element]*
+    bool compileElevate();
+
+    //! Compile an element: -element | number | function | variable | group
+    bool compileElement();
+
+    //! Compile a group: ( expression )
+    bool compileGroup();
+
+    //! Read a number at the current position
+    bool readNumber ( Real& number );
+
+    //! Read an identifier at the current position
+    bool readIdentifier ( std::string& identifier );
+
+    //! Consume a token if it is at the current position
+    bool accept ( const char* token );
+
+    //! Save the state of the compiler (to go back if an alternative fails)
+    compilerState_Type compilerState() const;
+
+    //! Restore a previous state of the compiler
+    void restoreCompilerState ( const compilerState_Type& state );
+
+    //! Add an instruction to the program
+    void addInstruction ( const operation_Type& operation, const UInt& index = 0, const Real& value = 0. );
+
+    //@}
+
+    // Compiled program
+    std::vector< instruction_Type >  M_program;
+    UInt                             M_numberOfResults;
+
+    // Stack of the interpreter
+    std::vector< Real >              M_stack;
+    UInt                             M_stackSize;
+
+    // Variables
+    std::map< std::string, UInt >    M_variablesID;
+    std::vector< Real >              M_variables;
+
+    // Compilation state
+    std::string                      M_string;
+    std::string::size_type           M_position;
+};
+
+} // Namespace LifeV
+
+#endif /* Parser_Bytecode_H */
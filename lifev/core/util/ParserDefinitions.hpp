@@ -45,23 +45,6 @@
 // BOOST Classes
 #include <boost/algorithm/string.hpp>
 
-#ifdef HAVE_BOOST_SPIRIT_QI
-#ifdef ENABLE_SPIRIT_PARSER
-
-// BOOST Spirit Classes
-#include <boost/spirit/include/qi.hpp>
-#include <boost/spirit/include/phoenix_bind.hpp>
-#include <boost/spirit/include/phoenix_operator.hpp>
-
-// BOOST Spirit Namespaces
-namespace spirit  = boost::spirit;
-namespace qi      = spirit::qi;
-namespace ascii   = spirit::ascii;
-namespace phoenix = boost::phoenix;
-
-#endif /* ENABLE_SPIRIT_PARSER */
-#endif /* HAVE_BOOST_SPIRIT_QI */
-
 
 // LifeV classes
 #include <lifev/core/LifeV.hpp>
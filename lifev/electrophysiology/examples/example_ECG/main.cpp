@@ -95,7 +95,7 @@
 //--------------------------------------------------------
 // For the pseudo- ECG
 //--------------------------------------------------------
-#include <lifev/electrophysiology/examples/example_ECG/Norm.hpp>
+#include <lifev/electrophysiology/util/PseudoECG.hpp>
 #include <lifev/core/solver/ADRAssembler.hpp>
 #include <lifev/core/algorithm/LinearSolver.hpp>
 #include <lifev/core/algorithm/PreconditionerML.hpp>
@@ -539,15 +539,13 @@ Int main ( Int argc, char** argv )
         Real ecg_position_X = monodomainList.get ("ecg_position_X", 1.);
         Real ecg_position_Y = monodomainList.get ("ecg_position_Y", 1.);
         Real ecg_position_Z = monodomainList.get ("ecg_position_Z", 0.5);
-        vector_Type ecgDistance = (* (splitting->globalSolution().at (0) ) ) ;
-        ecgDistance *= 0.;
-        FESpacePtr->interpolate ( static_cast<function_Type> ( Norm::f ), ecgDistance, 0.0 );
-        Norm::setPosition ( ecg_position_X , ecg_position_Y , ecg_position_Z ); // Set electrode position
+        VectorSmall<3> ecgPosition;
+        ecgPosition[0] = ecg_position_X;
+        ecgPosition[1] = ecg_position_Y;
+        ecgPosition[2] = ecg_position_Z;
 
-        Real pseudoEcgReal (0.);
-        Real Global_pseudoEcgReal (0.);
-        vector_Type solutionLaplacian = ( (* (splitting->globalSolution().at (0) ) ) );
-        vector_Type pseudoEcgVec = ( (* (splitting->globalSolution().at (0) ) ) );
+        PseudoECG<mesh_Type> pseudoECG ( FESpacePtr );
+        pseudoECG.addElectrode ( ecgPosition ); // Set electrode position
 
         // Discrete Laplacian matrix
         // setting up the assembler
@@ -556,8 +554,6 @@ Int main ( Int argc, char** argv )
         // define the matrices
         boost::shared_ptr<matrix_Type> systemMatrixL ( new matrix_Type ( FESpacePtr->map() ) );
         boost::shared_ptr<matrix_Type> systemMatrixM ( new matrix_Type ( FESpacePtr->map() ) );
-        boost::shared_ptr<vector_Type> rhs_Laplacian ( new vector_Type ( FESpacePtr->map() ) );
-        boost::shared_ptr<vector_Type> pseudoEcgVec_ptr ( new vector_Type ( FESpacePtr->map() ) );
 
         // fill the matrix
         adrAssembler.addDiffusion ( systemMatrixL, -1.0 );
@@ -647,6 +643,13 @@ Int main ( Int argc, char** argv )
         }
         linearSolver2.showMe();
 
+        // The lead fields are computed once: no linear solve at each time step
+        pseudoECG.setup ( systemMatrixL, systemMatrixM, linearSolver2 );
+        if (  Comm->MyPID() == 0 )
+        {
+            pseudoECG.showMe();
+        }
+
         //********************************************//
         // Solving the system                         //
         //********************************************//
@@ -674,12 +677,6 @@ Int main ( Int argc, char** argv )
 
                 // APD calculation
                 previouspotential = (* (splitting->globalSolution().at (0) ) );
-                //--------------------------------------
-                // ECG initialization
-                pseudoEcgReal = 0.;
-                pseudoEcgVec_ptr.reset ( new vector_Type ( FESpacePtr->map(), Unique ) );
-                rhs_Laplacian.reset ( new vector_Type ( FESpacePtr->map(), Unique ) );
-                //-----------------------------------------------------------------
 
                 control = 0;
 
@@ -729,14 +726,8 @@ Int main ( Int argc, char** argv )
                 }
                 nbTimeStep++;
 
-                // ECG : discrete laplacian of the solution
-                (*rhs_Laplacian) = (*systemMatrixL) * (* (splitting->globalSolution().at (0) ) );
-
-                linearSolver2.setOperator ( systemMatrixM );
-                linearSolver2.setRightHandSide ( rhs_Laplacian );
-                linearSolver2.solve ( pseudoEcgVec_ptr );
-
-                pseudoEcgVec = (*pseudoEcgVec_ptr) / ecgDistance;
+                // ECG : lead fields times the solution
+                const std::vector<Real>& pseudoEcg = pseudoECG.compute ( * (splitting->globalSolution().at (0) ) );
 
                 //      // APD calculation
                 for (int i = 0; i <= sz - 1; i++)
@@ -754,19 +745,17 @@ Int main ( Int argc, char** argv )
                             delta_apd[i] = (trep - tact[i]) - apd[i];
                             apd[i] = trep - tact[i];
                         }
-
-                        //          // Pseudo-ECG summation
-                        pseudoEcgReal += pseudoEcgVec[i];
                     }
                 }
                 *APDptr = apd;
                 *DELTA_APDptr = delta_apd;
 
-                MPI_Allreduce (&pseudoEcgReal, &Global_pseudoEcgReal, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD); // rapporte a une variable connue de tous les procs
-
                 if (  Comm->MyPID() == 0 )
                 {
-                    output << Global_pseudoEcgReal << "\n";
+                    for ( UInt electrode (0); electrode < pseudoEcg.size(); ++electrode )
+                    {
+                        output << pseudoEcg[electrode] << ( electrode + 1 < pseudoEcg.size() ? " " : "\n" );
+                    }
                 }
             }
         }
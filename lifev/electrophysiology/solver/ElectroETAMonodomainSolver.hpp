@@ -503,6 +503,18 @@ public:
         (* (M_ionicModelPtr) ) = ionicModel;
     }
 
+    //! set the OpenMP parameters used in the reaction step
+    /*!
+     * The pointwise evaluations of the ionic model (reaction steps, gating variables,
+     * ICI and SVI right hand sides) are shared among the threads for the ionic models
+     * supporting it. The ionic model must be set before calling this method.
+     @param ompParams OpenMP parameters (number of threads, schedule and chunk size)
+     */
+    inline void setOpenMPParameters (const OpenMPParameters& ompParams)
+    {
+        M_ionicModelPtr->setOpenMPParameters (ompParams);
+    }
+
 
     //! set the pointer to the Epetra communicator
     /*!
@@ -1031,6 +1043,19 @@ public:
      */
     void solveOneReactionStepRL (int subiterations = 1);
 
+    //! Solves one reaction step with an adaptive number of substeps in each node
+    /*!
+     * Resting nodes take a single Heun step while the stiff nodes are refined until
+     * the local error estimate satisfies the tolerances of the ionic model
+     * (see ElectroIonicModel::solveOneStepAdaptive). In verbose mode the average
+     * work per node over all the processes is printed. The nodes which did not meet
+     * the tolerances with the maximum number of substeps are always reported.
+     */
+    /*!
+     @return number of nodes (over all the processes) that did not meet the tolerances
+     */
+    UInt solveOneReactionStepAdaptive();
+
     //! Update the rhs
     /*!
      * \f[
@@ -1938,6 +1963,42 @@ void ElectroETAMonodomainSolver<Mesh>::solveOneReactionStepRL (
 
 }
 
+template<typename Mesh>
+UInt ElectroETAMonodomainSolver<Mesh>::solveOneReactionStepAdaptive()
+{
+    int localUnconverged = M_ionicModelPtr->superIonicModel::solveOneStepAdaptive (M_globalSolution, M_timeStep);
+    int globalUnconverged (0);
+    M_commPtr->SumAll (&localUnconverged, &globalUnconverged, 1);
+
+    if (globalUnconverged > 0 && M_commPtr->MyPID() == 0)
+    {
+        std::cout << "\nETA Monodomain Solver: WARNING, adaptive reaction step: "
+                  << globalUnconverged << " nodes did not meet the tolerances with the maximum number of substeps";
+    }
+
+    if (M_verbose)
+    {
+        const typename superIonicModel::AdaptiveStepReport& report = M_ionicModelPtr->adaptiveStepReport();
+
+        Real localWork[2] = { static_cast<Real> (report.rhsEvaluations), static_cast<Real> (report.nodes) };
+        Real globalWork[2] = { 0.0, 0.0 };
+        M_commPtr->SumAll (localWork, globalWork, 2);
+
+        int localMaxSubsteps = report.maxSubsteps;
+        int globalMaxSubsteps (0);
+        M_commPtr->MaxAll (&localMaxSubsteps, &globalMaxSubsteps, 1);
+
+        if (M_commPtr->MyPID() == 0)
+        {
+            std::cout << "\nETA Monodomain Solver: adaptive reaction step, "
+                      << globalWork[0] / globalWork[1] << " rhs evaluations per node, "
+                      << globalMaxSubsteps << " maximum substeps";
+        }
+    }
+
+    return globalUnconverged;
+}
+
 template<typename Mesh>
 void ElectroETAMonodomainSolver<Mesh>::solveOneDiffusionStepBDF2 (
     vectorPtr_Type previousPotentialPtr)
@@ -38,6 +38,9 @@
 
 #include <lifev/electrophysiology/solver/IonicModels/ElectroIonicModel.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 
 namespace LifeV
 {
@@ -51,7 +54,12 @@ ElectroIonicModel::ElectroIonicModel() :
     M_membraneCapacitance (1.),
     M_appliedCurrent    (0.),
     M_appliedCurrentPtr(),
-    M_pacingProtocol ()
+    M_pacingProtocol (),
+    M_ompParams (),
+    M_adaptiveAbsoluteTolerance (1.0e-6),
+    M_adaptiveRelativeTolerance (1.0e-3),
+    M_adaptiveMaxSubsteps (64),
+    M_adaptiveStepReport ()
 {
 }
 
@@ -62,7 +70,12 @@ ElectroIonicModel::ElectroIonicModel ( int n ) :
     M_membraneCapacitance (1.),
     M_appliedCurrent    (0.),
     M_appliedCurrentPtr(),
-    M_pacingProtocol ()
+    M_pacingProtocol (),
+    M_ompParams (),
+    M_adaptiveAbsoluteTolerance (1.0e-6),
+    M_adaptiveRelativeTolerance (1.0e-3),
+    M_adaptiveMaxSubsteps (64),
+    M_adaptiveStepReport ()
 {
 }
 
@@ -73,7 +86,12 @@ ElectroIonicModel::ElectroIonicModel ( int n, int g ) :
     M_membraneCapacitance (1.),
     M_appliedCurrent    (0.),
     M_appliedCurrentPtr(),
-    M_pacingProtocol ()
+    M_pacingProtocol (),
+    M_ompParams (),
+    M_adaptiveAbsoluteTolerance (1.0e-6),
+    M_adaptiveRelativeTolerance (1.0e-3),
+    M_adaptiveMaxSubsteps (64),
+    M_adaptiveStepReport ()
 {
 }
 
@@ -83,7 +101,12 @@ ElectroIonicModel::ElectroIonicModel ( const ElectroIonicModel& Ionic ) :
     M_restingConditions ( Ionic.restingConditions() ),
     M_membraneCapacitance ( Ionic.M_membraneCapacitance ),
     M_appliedCurrent    ( Ionic.M_appliedCurrent ),
-    M_pacingProtocol (Ionic.M_pacingProtocol)
+    M_pacingProtocol (Ionic.M_pacingProtocol),
+    M_ompParams (Ionic.M_ompParams),
+    M_adaptiveAbsoluteTolerance (Ionic.M_adaptiveAbsoluteTolerance),
+    M_adaptiveRelativeTolerance (Ionic.M_adaptiveRelativeTolerance),
+    M_adaptiveMaxSubsteps (Ionic.M_adaptiveMaxSubsteps),
+    M_adaptiveStepReport ()
 {
     if (Ionic.M_appliedCurrentPtr)
     {
@@ -106,6 +129,10 @@ ElectroIonicModel& ElectroIonicModel::operator = ( const ElectroIonicModel& Ioni
         M_appliedCurrentPtr = Ionic.M_appliedCurrentPtr;
     }
     M_pacingProtocol = Ionic.M_pacingProtocol;
+    M_ompParams = Ionic.M_ompParams;
+    M_adaptiveAbsoluteTolerance = Ionic.M_adaptiveAbsoluteTolerance;
+    M_adaptiveRelativeTolerance = Ionic.M_adaptiveRelativeTolerance;
+    M_adaptiveMaxSubsteps = Ionic.M_adaptiveMaxSubsteps;
 
     return      *this;
 }
@@ -188,166 +215,420 @@ MatrixEpetra<Real> ElectroIonicModel::getJac (const vector_Type& v, Real /*h*/)
 void ElectroIonicModel::computeGatingRhs (   const std::vector<vectorPtr_Type>& v,
                                              std::vector<vectorPtr_Type>& rhs )
 {
+    runBatchKernel ( GatingRhsKernel, v, rhs );
+}
 
-    int nodes = ( * (v.at (1) ) ).epetraVector().MyLength();
+void ElectroIonicModel::computeNonGatingRhs (   const std::vector<vectorPtr_Type>& v,
+                                                std::vector<vectorPtr_Type>& rhs )
+{
+    runBatchKernel ( NonGatingRhsKernel, v, rhs );
+}
 
 
-    std::vector<Real>   localVec ( M_numberOfEquations, 0.0 );
-    std::vector<Real>   localRhs ( M_numberOfEquations - 1, 0.0 );
+void ElectroIonicModel::computeRhs (   const std::vector<vectorPtr_Type>& v,
+                                       std::vector<vectorPtr_Type>& rhs )
+{
+    runBatchKernel ( RhsKernel, v, rhs );
+}
 
-    int j (0);
+void ElectroIonicModel::runBatchKernel ( const BatchKernel kernel,
+                                         const std::vector<vectorPtr_Type>& v,
+                                         std::vector<vectorPtr_Type>& rhs )
+{
+    std::vector<Real*> stateViews;
+    std::vector<Real*> rhsViews;
+    extractLocalViews ( v, stateViews );
+    extractLocalViews ( rhs, rhsViews );
 
-    for ( int k = 0; k < nodes; k++ )
-    {
+    const Real* appliedCurrent = appliedCurrentLocalView ( * ( v.at (1) ) );
 
-        j = ( * (v.at (1) ) ).blockMap().GID (k);
+    const Int nodes = ( * (v.at (1) ) ).epetraVector().MyLength();
+    const Int nbBlocks = ( nodes + S_batchBlockSize - 1 ) / S_batchBlockSize;
 
-        for ( int i = 0; i < M_numberOfEquations; i++ )
-        {
-            localVec.at (i) = ( * ( v.at (i) ) ) [j];
-        }
+    // OpenMP setup and pragmas around the loop
+    M_ompParams.apply();
+
+    #pragma omp parallel if ( isThreadSafe() )
+    {
+        // Views shifted to the first node of the current block
+        std::vector<const Real*> blockState ( stateViews.size(), static_cast<const Real*> (0) );
+        std::vector<Real*> blockRhs ( rhsViews.size(), static_cast<Real*> (0) );
 
-        if (M_appliedCurrentPtr)
+        #pragma omp for schedule(runtime)
+        for ( Int iBlock = 0; iBlock < nbBlocks; ++iBlock )
         {
-            M_appliedCurrent = (*M_appliedCurrentPtr) [j];
+            const Int first = iBlock * S_batchBlockSize;
+            const UInt blockSize = ( nodes - first < S_batchBlockSize ) ? nodes - first : S_batchBlockSize;
+
+            for ( UInt i = 0; i < stateViews.size(); i++ )
+            {
+                blockState[i] = stateViews[i] ? stateViews[i] + first : 0;
+            }
+            for ( UInt i = 0; i < rhsViews.size(); i++ )
+            {
+                blockRhs[i] = rhsViews[i] ? rhsViews[i] + first : 0;
+            }
+            const Real* blockAppliedCurrent = appliedCurrent ? appliedCurrent + first : 0;
+
+            switch ( kernel )
+            {
+                case RhsKernel:
+                    computeRhsBatch ( blockState, blockAppliedCurrent, blockRhs, blockSize );
+                    break;
+                case GatingRhsKernel:
+                    computeGatingRhsBatch ( blockState, blockAppliedCurrent, blockRhs, blockSize );
+                    break;
+                case NonGatingRhsKernel:
+                    computeNonGatingRhsBatch ( blockState, blockAppliedCurrent, blockRhs, blockSize );
+                    break;
+            }
         }
-        else
+    }
+
+    M_ompParams.restorePreviousNumThreads();
+}
+
+void ElectroIonicModel::computeGatingRhsBatch ( const std::vector<const Real*>& v,
+                                                const Real*                     appliedCurrent,
+                                                const std::vector<Real*>&       rhs,
+                                                const UInt                      nodes )
+{
+    std::vector<Real>   localVec ( M_numberOfEquations, 0.0 );
+    std::vector<Real>   localRhs ( M_numberOfEquations - 1, 0.0 );
+
+    for ( UInt k = 0; k < nodes; k++ )
+    {
+        for ( int i = 0; i < M_numberOfEquations; i++ )
         {
-            M_appliedCurrent = 0.0;
+            localVec[i] = v[i][k];
         }
 
+        M_appliedCurrent = appliedCurrent ? appliedCurrent[k] : 0.0;
+
         computeGatingRhs ( localVec, localRhs );
 
         for ( int i = 1; i < M_numberOfEquations; i++ )
         {
-            ( * ( rhs.at (i) ) ) [j] =  localRhs.at (i - 1);
+            rhs[i][k] = localRhs[i - 1];
         }
-
     }
-
 }
 
-void ElectroIonicModel::computeNonGatingRhs (   const std::vector<vectorPtr_Type>& v,
-                                                std::vector<vectorPtr_Type>& rhs )
+void ElectroIonicModel::computeNonGatingRhsBatch ( const std::vector<const Real*>& v,
+                                                   const Real*                     appliedCurrent,
+                                                   const std::vector<Real*>&       rhs,
+                                                   const UInt                      nodes )
 {
-
-    int nodes = ( * (v.at (1) ) ).epetraVector().MyLength();
-
-
     std::vector<Real>   localVec ( M_numberOfEquations, 0.0 );
     int offset = 1 + M_numberOfGatingVariables;
     std::vector<Real>   localRhs ( M_numberOfEquations - offset, 0.0 );
 
-    int j (0);
-
-    for ( int k = 0; k < nodes; k++ )
+    for ( UInt k = 0; k < nodes; k++ )
     {
+        for ( int i = 0; i < M_numberOfEquations; i++ )
+        {
+            localVec[i] = v[i][k];
+        }
 
-        j = ( * (v.at (1) ) ).blockMap().GID (k);
+        M_appliedCurrent = appliedCurrent ? appliedCurrent[k] : 0.0;
 
-        for ( int i = 0; i < M_numberOfEquations; i++ )
+        computeNonGatingRhs ( localVec, localRhs );
+
+        for ( int i = offset; i < M_numberOfEquations; i++ )
         {
-            localVec.at (i) = ( * ( v.at (i) ) ) [j];
+            rhs[i][k] = localRhs[i - offset];
         }
+    }
+}
+
+void ElectroIonicModel::computeRhsBatch ( const std::vector<const Real*>& v,
+                                          const Real*                     appliedCurrent,
+                                          const std::vector<Real*>&       rhs,
+                                          const UInt                      nodes )
+{
+    std::vector<Real>   localVec ( M_numberOfEquations, 0.0 );
+    std::vector<Real>   localRhs ( M_numberOfEquations, 0.0 );
 
-        if (M_appliedCurrentPtr)
+    for ( UInt k = 0; k < nodes; k++ )
+    {
+        for ( int i = 0; i < M_numberOfEquations; i++ )
         {
-            M_appliedCurrent = (*M_appliedCurrentPtr) [j];
+            localVec[i] = v[i][k];
         }
-        else
+
+        M_appliedCurrent = appliedCurrent ? appliedCurrent[k] : 0.0;
+
+        computeRhs ( localVec, localRhs );
+        addAppliedCurrent (localRhs);
+
+        for ( int i = 0; i < M_numberOfEquations; i++ )
         {
-            M_appliedCurrent = 0.0;
+            rhs[i][k] = localRhs[i];
         }
+    }
+}
 
-        computeNonGatingRhs ( localVec, localRhs );
+void ElectroIonicModel::extractLocalViews ( const std::vector<vectorPtr_Type>& v, std::vector<Real*>& views ) const
+{
+    views.assign ( v.size(), static_cast<Real*> (0) );
 
-        for ( int i = offset; i < M_numberOfEquations; i++ )
+    int leadingDimension (0);
+    for ( UInt i = 0; i < v.size(); i++ )
+    {
+        if ( v[i] )
         {
-            ( * ( rhs.at (i) ) ) [j] =  localRhs.at (i - offset);
+            v[i]->epetraVector().ExtractView ( &views[i], &leadingDimension );
         }
+    }
+}
 
+const Real* ElectroIonicModel::appliedCurrentLocalView ( const vector_Type& reference )
+{
+    if ( !M_appliedCurrentPtr )
+    {
+        return 0;
     }
 
-}
+    Real* view (0);
+    int leadingDimension (0);
 
+    if ( M_appliedCurrentPtr->blockMap().SameAs ( reference.blockMap() ) )
+    {
+        M_appliedCurrentPtr->epetraVector().ExtractView ( &view, &leadingDimension );
+        return view;
+    }
 
-void ElectroIonicModel::computeRhs (   const std::vector<vectorPtr_Type>& v,
-                                       std::vector<vectorPtr_Type>& rhs )
+    const Int nodes = reference.epetraVector().MyLength();
+    M_appliedCurrentBuffer.resize ( nodes );
+    for ( Int k = 0; k < nodes; k++ )
+    {
+        M_appliedCurrentBuffer[k] = (*M_appliedCurrentPtr) [ reference.blockMap().GID (k) ];
+    }
+    return nodes > 0 ? &M_appliedCurrentBuffer[0] : 0;
+}
+
+UInt ElectroIonicModel::solveOneStepAdaptive ( std::vector<vectorPtr_Type>& v, const Real dt )
 {
+    std::vector<Real*> stateViews;
+    extractLocalViews ( v, stateViews );
 
-    int nodes = ( * (v.at (1) ) ).epetraVector().MyLength();
+    const Real* appliedCurrent = appliedCurrentLocalView ( * ( v.at (0) ) );
 
+    const Int nodes = ( * (v.at (0) ) ).epetraVector().MyLength();
+    const Int nbBlocks = ( nodes + S_batchBlockSize - 1 ) / S_batchBlockSize;
 
-    std::vector<Real>   localVec ( M_numberOfEquations, 0.0 );
-    std::vector<Real>   localRhs ( M_numberOfEquations, 0.0 );
+    UInt nbLevels (1);
+    while ( ( 1u << (nbLevels - 1) ) < M_adaptiveMaxSubsteps )
+    {
+        nbLevels++;
+    }
 
-    int j (0);
+    M_adaptiveStepReport = AdaptiveStepReport();
+    M_adaptiveStepReport.nodes = nodes;
+    M_adaptiveStepReport.nodesPerLevel.assign ( nbLevels, 0 );
 
-    for ( int k = 0; k < nodes; k++ )
+    // OpenMP setup and pragmas around the loop
+    M_ompParams.apply();
+
+    #pragma omp parallel if ( isThreadSafe() )
     {
+        // Compact copies of the nodes of the block still to be accepted
+        std::vector<Real> state;
+        std::vector<Real> blockAppliedCurrent;
+        std::vector<Real> error;
+        std::vector<Int>  active;
+        std::vector<Int>  rejected;
+        HeunWorkspace     workspace;
+
+        AdaptiveStepReport threadReport;
+        threadReport.nodesPerLevel.assign ( nbLevels, 0 );
+
+        #pragma omp for schedule(runtime)
+        for ( Int iBlock = 0; iBlock < nbBlocks; ++iBlock )
+        {
+            const Int first = iBlock * S_batchBlockSize;
+            const Int last = ( nodes - first < S_batchBlockSize ) ? nodes : first + S_batchBlockSize;
 
-        j = ( * (v.at (1) ) ).blockMap().GID (k);
+            active.clear();
+            for ( Int k = first; k < last; k++ )
+            {
+                active.push_back ( k );
+            }
 
-        for ( int i = 0; i < M_numberOfEquations; i++ )
-        {
-            localVec.at (i) = ( * ( v.at (i) ) ) [j];
-        }
+            for ( UInt level = 0; !active.empty(); level++ )
+            {
+                const UInt m = active.size();
+                const UInt nbSubsteps = 1u << level;
+
+                state.resize ( M_numberOfEquations * m );
+                for ( int i = 0; i < M_numberOfEquations; i++ )
+                {
+                    for ( UInt j = 0; j < m; j++ )
+                    {
+                        state[i * m + j] = stateViews[i][active[j]];
+                    }
+                }
+                if ( appliedCurrent )
+                {
+                    blockAppliedCurrent.resize ( m );
+                    for ( UInt j = 0; j < m; j++ )
+                    {
+                        blockAppliedCurrent[j] = appliedCurrent[active[j]];
+                    }
+                }
 
+                integrateHeunSubsteps ( state, appliedCurrent ? &blockAppliedCurrent[0] : 0,
+                                        m, dt, nbSubsteps, error, workspace );
+                threadReport.rhsEvaluations += 2 * nbSubsteps * m;
 
-        if (M_appliedCurrentPtr)
-        {
-            M_appliedCurrent = (*M_appliedCurrentPtr) [j];
+                // Accept the converged nodes, the others restart with twice as many substeps
+                const bool lastLevel = ( level + 1 == nbLevels );
+                rejected.clear();
+                for ( UInt j = 0; j < m; j++ )
+                {
+                    if ( error[j] <= 1.0 || lastLevel )
+                    {
+                        for ( int i = 0; i < M_numberOfEquations; i++ )
+                        {
+                            stateViews[i][active[j]] = state[i * m + j];
+                        }
+                        threadReport.nodesPerLevel[level]++;
+                        threadReport.maxSubsteps = std::max ( threadReport.maxSubsteps, nbSubsteps );
+                        if ( error[j] > 1.0 )
+                        {
+                            threadReport.unconvergedNodes++;
+                        }
+                    }
+                    else
+                    {
+                        rejected.push_back ( active[j] );
+                    }
+                }
+                active.swap ( rejected );
+            }
         }
-        else
+
+        #pragma omp critical
         {
-            M_appliedCurrent = 0.0;
+            M_adaptiveStepReport.rhsEvaluations += threadReport.rhsEvaluations;
+            M_adaptiveStepReport.maxSubsteps = std::max ( M_adaptiveStepReport.maxSubsteps, threadReport.maxSubsteps );
+            M_adaptiveStepReport.unconvergedNodes += threadReport.unconvergedNodes;
+            for ( UInt level = 0; level < nbLevels; level++ )
+            {
+                M_adaptiveStepReport.nodesPerLevel[level] += threadReport.nodesPerLevel[level];
+            }
         }
-        computeRhs ( localVec, localRhs );
-        addAppliedCurrent (localRhs);
+    }
+
+    M_ompParams.restorePreviousNumThreads();
+
+    return M_adaptiveStepReport.unconvergedNodes;
+}
+
+void ElectroIonicModel::integrateHeunSubsteps ( std::vector<Real>& state,
+                                                const Real*        appliedCurrent,
+                                                const UInt         m,
+                                                const Real         dt,
+                                                const UInt         nbSubsteps,
+                                                std::vector<Real>& error,
+                                                HeunWorkspace&     workspace )
+{
+    const UInt size = M_numberOfEquations * m;
+    const Real h = dt / nbSubsteps;
+
+    // The work arrays only grow: no allocation once the largest block has been seen
+    std::vector<Real>& predictor = workspace.predictor;
+    std::vector<Real>& f0 = workspace.f0;
+    std::vector<Real>& f1 = workspace.f1;
+    predictor.resize ( std::max<std::size_t> ( predictor.size(), size ) );
+    f0.resize ( std::max<std::size_t> ( f0.size(), size ) );
+    f1.resize ( std::max<std::size_t> ( f1.size(), size ) );
+
+    std::vector<const Real*>& stateView = workspace.stateView;
+    std::vector<const Real*>& predictorView = workspace.predictorView;
+    std::vector<Real*>& f0View = workspace.f0View;
+    std::vector<Real*>& f1View = workspace.f1View;
+    stateView.resize ( M_numberOfEquations );
+    predictorView.resize ( M_numberOfEquations );
+    f0View.resize ( M_numberOfEquations );
+    f1View.resize ( M_numberOfEquations );
+    for ( int i = 0; i < M_numberOfEquations; i++ )
+    {
+        stateView[i] = &state[i * m];
+        predictorView[i] = &predictor[i * m];
+        f0View[i] = &f0[i * m];
+        f1View[i] = &f1[i * m];
+    }
 
+    error.assign ( m, 0.0 );
+
+    for ( UInt substep = 0; substep < nbSubsteps; substep++ )
+    {
+        // Forward Euler predictor
+        computeRhsBatch ( stateView, appliedCurrent, f0View, m );
         for ( int i = 0; i < M_numberOfEquations; i++ )
         {
-            ( * ( rhs.at (i) ) ) [j] =  localRhs.at (i);
+            const Real hi = ( i == 0 ) ? h / M_membraneCapacitance : h;
+            for ( UInt j = i * m; j < (i + 1) * m; j++ )
+            {
+                predictor[j] = state[j] + hi * f0[j];
+            }
         }
 
-    }
+        // Heun corrector, the difference with the predictor estimates the local error
+        computeRhsBatch ( predictorView, appliedCurrent, f1View, m );
+        for ( int i = 0; i < M_numberOfEquations; i++ )
+        {
+            const Real hi = ( i == 0 ) ? h / M_membraneCapacitance : h;
+            for ( UInt k = 0; k < m; k++ )
+            {
+                const UInt j = i * m + k;
+                state[j] += 0.5 * hi * ( f0[j] + f1[j] );
 
+                const Real scaledError = std::abs ( 0.5 * hi * ( f1[j] - f0[j] ) )
+                                         / ( M_adaptiveAbsoluteTolerance + M_adaptiveRelativeTolerance * std::abs ( state[j] ) );
+                error[k] = std::max ( error[k], scaledError );
+            }
+        }
+    }
 }
 
 void ElectroIonicModel::computePotentialRhsICI (   const std::vector<vectorPtr_Type>& v,
                                                    std::vector<vectorPtr_Type>& rhs,
                                                    matrix_Type&                    massMatrix  )
 {
-    int nodes = ( * (v.at (0) ) ).epetraVector().MyLength();
+    const Int nodes = ( * (v.at (0) ) ).epetraVector().MyLength();
 
-    ( * ( rhs.at (0) ) ) *= 0.0;
-    std::vector<Real>   localVec ( M_numberOfEquations, 0.0 );
+    std::vector<Real*> stateViews;
+    extractLocalViews ( v, stateViews );
 
-    int j (0);
+    Real* potentialRhs (0);
+    int leadingDimension (0);
+    ( * ( rhs.at (0) ) ).epetraVector().ExtractView ( &potentialRhs, &leadingDimension );
 
-    for ( int k = 0; k < nodes; k++ )
-    {
+    const Real* appliedCurrent = appliedCurrentLocalView ( * ( v.at (0) ) );
 
-        j = ( * (v.at (0) ) ).blockMap().GID (k);
+    // OpenMP setup and pragmas around the loop
+    M_ompParams.apply();
 
-        for ( int i = 0; i < M_numberOfEquations; i++ )
-        {
-            localVec.at (i) = ( * ( v.at (i) ) ) [j];
-        }
+    #pragma omp parallel if ( isThreadSafe() )
+    {
+        std::vector<Real>   localVec ( M_numberOfEquations, 0.0 );
 
-        if (M_appliedCurrentPtr)
+        #pragma omp for schedule(runtime)
+        for ( Int k = 0; k < nodes; k++ )
         {
-            M_appliedCurrent = (*M_appliedCurrentPtr) [j];
-        }
-        else
-        {
-            M_appliedCurrent = 0.0;
-        }
-
-        ( * ( rhs.at (0) ) ) [j] =  computeLocalPotentialRhs ( localVec ) + M_appliedCurrent;
+            for ( int i = 0; i < M_numberOfEquations; i++ )
+            {
+                localVec[i] = stateViews[i][k];
+            }
 
+            potentialRhs[k] = computeLocalPotentialRhs ( localVec ) + ( appliedCurrent ? appliedCurrent[k] : 0.0 );
+        }
     }
 
+    M_ompParams.restorePreviousNumThreads();
+
     ( * ( rhs.at (0) ) ) = massMatrix * ( * ( rhs.at (0) ) );
 
 }
@@ -357,9 +638,6 @@ void ElectroIonicModel::computePotentialRhsSVI (   const std::vector<vectorPtr_T
                                                    std::vector<vectorPtr_Type>& rhs,
                                                    FESpace<mesh_Type, MapEpetra>& uFESpace )
 {
-
-    std::vector<Real> U (M_numberOfEquations, 0.0);
-    Real I (0.0);
     ( * ( rhs.at (0) ) ) *= 0.0;
 
     std::vector<vectorPtr_Type>      URepPtr;
@@ -370,84 +648,105 @@ void ElectroIonicModel::computePotentialRhsSVI (   const std::vector<vectorPtr_T
 
     VectorEpetra    IappRep ( *M_appliedCurrentPtr, Repeated );
 
-    std::vector<elvecPtr_Type>      elvecPtr;
-    for ( int k = 0; k < M_numberOfEquations; k++ )
-    {
-        elvecPtr.push_back ( elvecPtr_Type ( new VectorElemental (  uFESpace.fe().nbFEDof(), 1  ) ) );
-    }
+    const UInt nbVolumes = uFESpace.mesh()->numVolumes();
 
-    VectorElemental elvec_Iapp ( uFESpace.fe().nbFEDof(), 1 );
-    VectorElemental elvec_Iion ( uFESpace.fe().nbFEDof(), 1 );
+    // OpenMP setup and pragmas around the loop
+    M_ompParams.apply();
 
-    for (UInt iVol = 0; iVol < uFESpace.mesh()->numVolumes(); ++iVol)
+    #pragma omp parallel if ( isThreadSafe() )
     {
+        // Each thread updates its own current finite element and elemental vectors
+        CurrentFE fe ( uFESpace.fe().refFE(), uFESpace.fe().geoMap(), uFESpace.fe().quadRule() );
 
-        uFESpace.fe().updateJacQuadPt ( uFESpace.mesh()->volumeList ( iVol ) );
-
+        std::vector<Real> U (M_numberOfEquations, 0.0);
+        Real I (0.0);
 
+        std::vector<elvecPtr_Type>      elvecPtr;
         for ( int k = 0; k < M_numberOfEquations; k++ )
         {
-            ( * ( elvecPtr.at (k) ) ).zero();
+            elvecPtr.push_back ( elvecPtr_Type ( new VectorElemental (  fe.nbFEDof(), 1  ) ) );
         }
-        elvec_Iapp.zero();
-        elvec_Iion.zero();
 
-        UInt eleIDu = uFESpace.fe().currentLocalId();
-        UInt nbNode = ( UInt ) uFESpace.fe().nbFEDof();
+        VectorElemental elvec_Iapp ( fe.nbFEDof(), 1 );
+        VectorElemental elvec_Iion ( fe.nbFEDof(), 1 );
 
-        //! Filling local elvec_u with potential values in the nodes
-        for ( UInt iNode = 0 ; iNode < nbNode ; iNode++ )
+        #pragma omp for schedule(runtime)
+        for (UInt iVol = 0; iVol < nbVolumes; ++iVol)
         {
 
-            Int  ig = uFESpace.dof().localToGlobalMap ( eleIDu, iNode );
+            fe.updateJacQuadPt ( uFESpace.mesh()->volumeList ( iVol ) );
+
 
             for ( int k = 0; k < M_numberOfEquations; k++ )
             {
-                ( * ( elvecPtr.at (k) ) ).vec() [iNode] = ( * ( URepPtr.at (k) ) ) [ig];
+                ( * ( elvecPtr.at (k) ) ).zero();
             }
+            elvec_Iapp.zero();
+            elvec_Iion.zero();
 
-            elvec_Iapp.vec() [ iNode ] = IappRep[ig];
+            UInt eleIDu = fe.currentLocalId();
+            UInt nbNode = ( UInt ) fe.nbFEDof();
 
-        }
+            //! Filling local elvec_u with potential values in the nodes
+            for ( UInt iNode = 0 ; iNode < nbNode ; iNode++ )
+            {
 
-        //compute the local vector
-        for ( UInt ig = 0; ig < uFESpace.fe().nbQuadPt(); ig++ )
-        {
+                Int  ig = uFESpace.dof().localToGlobalMap ( eleIDu, iNode );
+
+                for ( int k = 0; k < M_numberOfEquations; k++ )
+                {
+                    ( * ( elvecPtr.at (k) ) ).vec() [iNode] = ( * ( URepPtr.at (k) ) ) [ig];
+                }
+
+                elvec_Iapp.vec() [ iNode ] = IappRep[ig];
 
-            for ( int k = 0; k < M_numberOfEquations; k++ )
-            {
-                U.at (k) = 0;
             }
-            I = 0;
 
-            for ( UInt i = 0; i < uFESpace.fe().nbFEDof(); i++ )
+            //compute the local vector
+            for ( UInt ig = 0; ig < fe.nbQuadPt(); ig++ )
             {
 
                 for ( int k = 0; k < M_numberOfEquations; k++ )
                 {
-                    U.at (k) +=  ( * ( elvecPtr.at (k) ) ) (i) *  uFESpace.fe().phi ( i, ig );
+                    U.at (k) = 0;
                 }
+                I = 0;
 
-                I += elvec_Iapp (i) * uFESpace.fe().phi ( i, ig );
+                for ( UInt i = 0; i < fe.nbFEDof(); i++ )
+                {
 
-            }
+                    for ( int k = 0; k < M_numberOfEquations; k++ )
+                    {
+                        U.at (k) +=  ( * ( elvecPtr.at (k) ) ) (i) *  fe.phi ( i, ig );
+                    }
 
-            for ( UInt i = 0; i < uFESpace.fe().nbFEDof(); i++ )
-            {
+                    I += elvec_Iapp (i) * fe.phi ( i, ig );
 
-                elvec_Iion ( i ) += ( computeLocalPotentialRhs (U) + I ) * uFESpace.fe().phi ( i, ig ) * uFESpace.fe().weightDet ( ig );
+                }
 
-            }
+                for ( UInt i = 0; i < fe.nbFEDof(); i++ )
+                {
 
-        }
+                    elvec_Iion ( i ) += ( computeLocalPotentialRhs (U) + I ) * fe.phi ( i, ig ) * fe.weightDet ( ig );
 
-        //assembly
-        for ( UInt i = 0 ; i < uFESpace.fe().nbFEDof(); i++ )
-        {
-            Int  ig = uFESpace.dof().localToGlobalMap ( eleIDu, i );
-            ( * ( rhs.at (0) ) ).sumIntoGlobalValues (ig,  elvec_Iion.vec() [i] );
+                }
+
+            }
+
+            //assembly
+            #pragma omp critical
+            {
+                for ( UInt i = 0 ; i < fe.nbFEDof(); i++ )
+                {
+                    Int  ig = uFESpace.dof().localToGlobalMap ( eleIDu, i );
+                    ( * ( rhs.at (0) ) ).sumIntoGlobalValues (ig,  elvec_Iion.vec() [i] );
+                }
+            }
         }
     }
+
+    M_ompParams.restorePreviousNumThreads();
+
     rhs.at (0) -> globalAssemble();
 
 
@@ -470,31 +769,36 @@ void ElectroIonicModel::computePotentialRhsSVI (   const std::vector<vectorPtr_T
 
 void ElectroIonicModel::computeGatingVariablesWithRushLarsen ( std::vector<vectorPtr_Type>& v, const Real dt )
 {
-    int nodes = ( * (v.at (0) ) ).epetraVector().MyLength();
+    const Int nodes = ( * (v.at (0) ) ).epetraVector().MyLength();
 
-    std::vector<Real>   localVec ( M_numberOfEquations, 0.0 );
+    std::vector<Real*> stateViews;
+    extractLocalViews ( v, stateViews );
 
-    int j (0);
+    // OpenMP setup and pragmas around the loop
+    M_ompParams.apply();
 
-    for ( int k = 0; k < nodes; k++ )
+    #pragma omp parallel if ( isThreadSafe() )
     {
+        std::vector<Real>   localVec ( M_numberOfEquations, 0.0 );
 
-        j = ( * (v.at (0) ) ).blockMap().GID (k);
-
-        for ( int i = 0; i < M_numberOfEquations; i++ )
+        #pragma omp for schedule(runtime)
+        for ( Int k = 0; k < nodes; k++ )
         {
-            localVec.at (i) = ( * ( v.at (i) ) ) [j];
-        }
+            for ( int i = 0; i < M_numberOfEquations; i++ )
+            {
+                localVec[i] = stateViews[i][k];
+            }
 
-        computeGatingVariablesWithRushLarsen (localVec, dt);
+            computeGatingVariablesWithRushLarsen (localVec, dt);
 
-        for ( int i = 0; i < M_numberOfEquations; i++ )
-        {
-            ( * ( v.at (i) ) ) [j] =  localVec.at (i);
+            for ( int i = 0; i < M_numberOfEquations; i++ )
+            {
+                stateViews[i][k] = localVec[i];
+            }
         }
-
     }
 
+    M_ompParams.restorePreviousNumThreads();
 }
 
 
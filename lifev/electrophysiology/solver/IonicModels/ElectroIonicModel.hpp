@@ -80,6 +80,7 @@
 
 #include <lifev/core/util/Factory.hpp>
 #include <lifev/core/util/FactorySingleton.hpp>
+#include <lifev/core/util/OpenMPParameters.hpp>
 
 
 #include <lifev/electrophysiology/stimulus/ElectroStimulus.hpp>
@@ -124,6 +125,35 @@ public:
 
     typedef FactorySingleton<Factory<ElectroIonicModel, std::string> >  IonicModelFactory;
 
+    //! Work statistics of one adaptive reaction step on the local nodes
+    struct AdaptiveStepReport
+    {
+        AdaptiveStepReport() :
+            nodes (0),
+            rhsEvaluations (0),
+            maxSubsteps (0),
+            unconvergedNodes (0),
+            nodesPerLevel ()
+        {}
+
+        //! average number of right hand side evaluations per node
+        Real workPerNode() const
+        {
+            return nodes > 0 ? static_cast<Real> (rhsEvaluations) / nodes : 0.0;
+        }
+
+        //number of local nodes advanced
+        UInt nodes;
+        //number of pointwise right hand side evaluations, rejected substeps included
+        UInt rhsEvaluations;
+        //largest number of substeps used by a node
+        UInt maxSubsteps;
+        //number of nodes accepted with the maximum number of substeps without meeting the tolerances
+        UInt unconvergedNodes;
+        //number of nodes accepted with 2^l substeps, for each level l
+        std::vector<UInt> nodesPerLevel;
+    };
+
     //@}
 
     //! @name Constructors & Destructor
@@ -233,6 +263,26 @@ public:
         return M_pacingProtocol;
     }
 
+    //! returns the OpenMP parameters used in the 3D pointwise evaluations
+    /*!
+     * @param
+     */
+    inline const OpenMPParameters& openMPParameters() const
+    {
+        return M_ompParams;
+    }
+
+    //! returns true if the pointwise evaluations can run concurrently on different nodes
+    /*!
+     *  The 3D evaluations use the OpenMP threads only for the models returning true here.
+     *  This requires the batched kernels and the 0D methods not to write member data
+     *  (the default batched kernels write M_appliedCurrent, hence the default is false).
+     */
+    virtual bool isThreadSafe() const
+    {
+        return false;
+    }
+
     //! set the membrane capacitance in the ionic model
     /*!
      * @param p membrane capacitance
@@ -242,6 +292,41 @@ public:
         M_membraneCapacitance = p;
     }
 
+    //! set the OpenMP parameters (threads, schedule and chunk size) for the 3D pointwise evaluations
+    /*!
+     * @param ompParams OpenMP parameters
+     */
+    inline void setOpenMPParameters ( const OpenMPParameters& ompParams )
+    {
+        M_ompParams = ompParams;
+    }
+
+    //! set the parameters of the adaptive (multirate) time stepping
+    /*!
+     * @param absoluteTolerance absolute tolerance on the local error of each state variable
+     * @param relativeTolerance relative tolerance on the local error of each state variable
+     * @param maxSubsteps largest number of substeps per node within one time step (a power of two)
+     */
+    inline void setAdaptiveTimeStepParameters ( const Real absoluteTolerance,
+                                                const Real relativeTolerance,
+                                                const UInt maxSubsteps )
+    {
+        ASSERT ( maxSubsteps > 0 && ( maxSubsteps & ( maxSubsteps - 1 ) ) == 0,
+                 "ElectroIonicModel::setAdaptiveTimeStepParameters: the maximum number of substeps must be a power of two" );
+        M_adaptiveAbsoluteTolerance = absoluteTolerance;
+        M_adaptiveRelativeTolerance = relativeTolerance;
+        M_adaptiveMaxSubsteps = maxSubsteps;
+    }
+
+    //! returns the work statistics of the last adaptive reaction step
+    /*!
+     * @param
+     */
+    inline const AdaptiveStepReport& adaptiveStepReport() const
+    {
+        return M_adaptiveStepReport;
+    }
+
     //! set the applied current in the ionic model/point
     /*!
      * @param p applied current magnitude
@@ -287,9 +372,10 @@ public:
             *M_appliedCurrentPtr, time);
     }
 
-    //! Interpolate the function of the electro stimulus
+    //! Set the applied current from the electro stimulus
     /*!
-     *  This method is a wrapper of the interpolation method from the FESpace class
+     *  This method is a wrapper of ElectroStimulus::setAppliedCurrent, which by default
+     *  interpolates the stimulus on the FESpace
      */
     /*!
      * @param stimulus pacing protocol defined as ElectroStimulus boost function f(t,x,y,x,ID)
@@ -298,13 +384,7 @@ public:
      */
     inline void setAppliedCurrentFromElectroStimulus ( ElectroStimulus& stimulus, feSpacePtr_Type feSpacePtr, Real time = 0.0)
     {
-
-        // boost::ref() is needed here because otherwise a copy of the base object is reinstantiated
-        function_Type f = boost::bind (&ElectroStimulus::appliedCurrent, boost::ref (stimulus), _1, _2, _3, _4, _5 );
-
-        feSpacePtr -> interpolate (
-            static_cast<FESpace<RegionMesh<LinearTetra>, MapEpetra>::function_Type> (f),
-            *M_appliedCurrentPtr, time);
+        stimulus.setAppliedCurrent ( *M_appliedCurrentPtr, feSpacePtr, time );
     }
 
     //! Set the pacing protocol as boost function
@@ -412,6 +492,76 @@ public:
      */
     virtual void computeRhs ( const std::vector<vectorPtr_Type>& v, std::vector<vectorPtr_Type>& rhs );
 
+    //! Compute the right hand side of the ionic model on contiguous local arrays
+    /*!
+     *  This is the batched kernel used by the 3D computeRhs: each state variable is given
+     *  as a contiguous array indexed by the local id of the node (structure of arrays).
+     *  The default implementation evaluates the 0D model node by node, so that models
+     *  which have not been ported still work. Models overloading this method should
+     *  loop over the nodes without virtual calls, so that the compiler can vectorize it.
+     */
+    /*!
+     * @param v local views of the state variables
+     * @param appliedCurrent local view of the applied current (NULL if there is none)
+     * @param rhs local views of the right hand side of each variable
+     * @param nodes number of local nodes
+     */
+    virtual void computeRhsBatch ( const std::vector<const Real*>& v,
+                                   const Real*                     appliedCurrent,
+                                   const std::vector<Real*>&       rhs,
+                                   const UInt                      nodes );
+
+    //! Compute the right hand side of the gating variables on contiguous local arrays
+    /*!
+     *  Batched version of computeGatingRhs ( const std::vector<Real>& v, std::vector<Real>& rhs ).
+     *  The entries 1,...,n-1 of rhs are filled.
+     */
+    /*!
+     * @param v local views of the state variables
+     * @param appliedCurrent local view of the applied current (NULL if there is none)
+     * @param rhs local views of the right hand side of each variable
+     * @param nodes number of local nodes
+     */
+    virtual void computeGatingRhsBatch ( const std::vector<const Real*>& v,
+                                         const Real*                     appliedCurrent,
+                                         const std::vector<Real*>&       rhs,
+                                         const UInt                      nodes );
+
+    //! Compute the right hand side of the non gating variables on contiguous local arrays
+    /*!
+     *  Batched version of computeNonGatingRhs ( const std::vector<Real>& v, std::vector<Real>& rhs ).
+     *  The entries g+1,...,n-1 of rhs are filled.
+     */
+    /*!
+     * @param v local views of the state variables
+     * @param appliedCurrent local view of the applied current (NULL if there is none)
+     * @param rhs local views of the right hand side of each variable
+     * @param nodes number of local nodes
+     */
+    virtual void computeNonGatingRhsBatch ( const std::vector<const Real*>& v,
+                                            const Real*                     appliedCurrent,
+                                            const std::vector<Real*>&       rhs,
+                                            const UInt                      nodes );
+
+    //! Advance all the state variables of one time step with an adaptive number of substeps per node
+    /*!
+     *  Each node is first advanced with one Heun step. The difference with the embedded
+     *  forward Euler step gives a local error estimate: the nodes where it exceeds the
+     *  tolerances are advanced again from the initial state with twice as many substeps,
+     *  until the estimate is satisfied or the maximum number of substeps is reached.
+     *  Hence nodes at rest take one cheap step, while the stiff nodes on the upstroke
+     *  are refined. The nodes are processed in blocks through the batched kernels, and
+     *  the work done is stored in the report returned by adaptiveStepReport().
+     *  The nodes still above the tolerances with the maximum number of substeps are
+     *  accepted anyway, and counted as unconverged.
+     */
+    /*!
+     * @param v vector of pointers to the  state variables vectors
+     * @param dt time step
+     * @return number of local nodes that did not meet the tolerances
+     */
+    virtual UInt solveOneStepAdaptive ( std::vector<vectorPtr_Type>& v, const Real dt );
+
     //! Compute the right hand side of the voltage equation linearly interpolating the ionic currents
     /*!
      * @param v vector of pointers to the  state variables vectors
@@ -537,6 +687,75 @@ public:
 
 protected:
 
+    //! Batched kernels which can be run on the local nodes
+    enum BatchKernel
+    {
+        RhsKernel, GatingRhsKernel, NonGatingRhsKernel
+    };
+
+    //! Run one of the batched kernels on all the local nodes
+    /*!
+     *  The local nodes are split in blocks of S_batchBlockSize nodes which are distributed
+     *  among the OpenMP threads, each working on its own shifted views of the arrays.
+     */
+    /*!
+     * @param kernel batched kernel to be evaluated
+     * @param v vector of pointers to the  state variables vectors
+     * @param rhs vector of pointers to the right hand side vectors of each variable
+     */
+    void runBatchKernel ( const BatchKernel kernel,
+                          const std::vector<vectorPtr_Type>& v,
+                          std::vector<vectorPtr_Type>& rhs );
+
+    //! Work arrays of the Heun substeps, allocated once and reused for all the blocks of nodes
+    struct HeunWorkspace
+    {
+        std::vector<Real> predictor;
+        std::vector<Real> f0;
+        std::vector<Real> f1;
+
+        std::vector<const Real*> stateView;
+        std::vector<const Real*> predictorView;
+        std::vector<Real*> f0View;
+        std::vector<Real*> f1View;
+    };
+
+    //! Advance m compact nodes of nbSubsteps Heun substeps and return the largest scaled error estimate
+    /*!
+     * @param state compact state variables, one array of m entries per variable, updated in place
+     * @param appliedCurrent compact applied current (NULL if there is none)
+     * @param m number of nodes
+     * @param dt time step
+     * @param nbSubsteps number of substeps
+     * @param error largest scaled error estimate of each node over the substeps
+     * @param workspace work arrays (not shared among the threads)
+     */
+    void integrateHeunSubsteps ( std::vector<Real>& state,
+                                 const Real*        appliedCurrent,
+                                 const UInt         m,
+                                 const Real         dt,
+                                 const UInt         nbSubsteps,
+                                 std::vector<Real>& error,
+                                 HeunWorkspace&     workspace );
+
+    //! Local views (structure of arrays) of a list of state variable vectors
+    /*!
+     * @param v vector of pointers to the state variables vectors
+     * @param views array pointers indexed by the local id of the nodes
+     */
+    void extractLocalViews ( const std::vector<vectorPtr_Type>& v, std::vector<Real*>& views ) const;
+
+    //! Local view of the applied current ordered as the local nodes of the given vector
+    /*!
+     *  If the applied current shares the map of the state variables its data is returned directly,
+     *  otherwise it is gathered (through the global ids) in an internal buffer.
+     *  NULL is returned if no applied current vector has been set.
+     */
+    /*!
+     * @param reference state variable vector defining the local ordering
+     */
+    const Real* appliedCurrentLocalView ( const vector_Type& reference );
+
     //Number of equations in the model
     short int  M_numberOfEquations;
 
@@ -558,6 +777,23 @@ protected:
     //Function describing the pacing protocol of the model - NEEDS TO BE CONFIRMED
     function_Type M_pacingProtocol;
 
+    //Buffer for the applied current when its map differs from the one of the state variables
+    std::vector<Real> M_appliedCurrentBuffer;
+
+    //OpenMP parameters for the 3D pointwise evaluations
+    OpenMPParameters M_ompParams;
+
+    //Number of nodes handed to a batched kernel at once
+    static const Int S_batchBlockSize = 256;
+
+    //Parameters of the adaptive time stepping
+    Real M_adaptiveAbsoluteTolerance;
+    Real M_adaptiveRelativeTolerance;
+    UInt M_adaptiveMaxSubsteps;
+
+    //Work statistics of the last adaptive step
+    AdaptiveStepReport M_adaptiveStepReport;
+
 
 };
 
@@ -134,6 +134,50 @@ void IonicAlievPanfilov::computeRhs (    const   std::vector<Real>&  v,
 
 }
 
+void IonicAlievPanfilov::computeGatingRhsBatch ( const std::vector<const Real*>& v,
+                                                 const Real*                     /*appliedCurrent*/,
+                                                 const std::vector<Real*>&       rhs,
+                                                 const UInt                      nodes )
+{
+    const Real mu1 ( M_mu1 ), mu2 ( M_mu2 ), k ( M_k ), a ( M_a ), epsilon ( M_epsilon );
+
+    const Real* V = v[0];
+    const Real* r = v[1];
+    Real* dr = rhs[1];
+
+    for ( UInt i = 0; i < nodes; i++ )
+    {
+        dr[i] = - ( epsilon + mu1 * r[i] / ( mu2 + V[i] ) ) * ( r[i] + k * V[i] * ( V[i] - a  - 1.0 ) );
+    }
+}
+
+void IonicAlievPanfilov::computeRhsBatch ( const std::vector<const Real*>& v,
+                                           const Real*                     appliedCurrent,
+                                           const std::vector<Real*>&       rhs,
+                                           const UInt                      nodes )
+{
+    const Real mu1 ( M_mu1 ), mu2 ( M_mu2 ), k ( M_k ), a ( M_a ), epsilon ( M_epsilon );
+
+    const Real* V = v[0];
+    const Real* r = v[1];
+    Real* dV = rhs[0];
+    Real* dr = rhs[1];
+
+    for ( UInt i = 0; i < nodes; i++ )
+    {
+        dV[i] = - k * V[i] * ( V[i] - a ) * ( V[i] - 1.0) - V[i] * r[i];
+        dr[i] = - ( epsilon + mu1 * r[i] / ( mu2 + V[i] ) ) * ( r[i] + k * V[i] * ( V[i] - a  - 1.0 ) );
+    }
+
+    if ( appliedCurrent )
+    {
+        for ( UInt i = 0; i < nodes; i++ )
+        {
+            dV[i] += appliedCurrent[i];
+        }
+    }
+}
+
 
 Real IonicAlievPanfilov::computeLocalPotentialRhs ( const std::vector<Real>& v )
 {
@@ -154,6 +154,23 @@ public:
 
     void computeRhs ( const std::vector<Real>& v, std::vector<Real>& rhs);
 
+    //Compute the rhs on contiguous local arrays (3D case)
+    void computeGatingRhsBatch ( const std::vector<const Real*>& v,
+                                 const Real*                     appliedCurrent,
+                                 const std::vector<Real*>&       rhs,
+                                 const UInt                      nodes );
+
+    void computeRhsBatch ( const std::vector<const Real*>& v,
+                           const Real*                     appliedCurrent,
+                           const std::vector<Real*>&       rhs,
+                           const UInt                      nodes );
+
+    //The batched kernels and the 0D methods do not write member data
+    bool isThreadSafe() const
+    {
+        return true;
+    }
+
     //Compute the rhs on a mesh/ 3D case
     //    void computeRhs( const std::vector<vectorPtr_Type>& v, std::vector<vectorPtr_Type>& rhs );
     //
@@ -149,6 +149,50 @@ void IonicFitzHughNagumo::computeRhs ( const VectorSmall<2>& v, VectorSmall<2>&
 
 }
 
+void IonicFitzHughNagumo::computeGatingRhsBatch ( const std::vector<const Real*>& v,
+                                                  const Real*                     /*appliedCurrent*/,
+                                                  const std::vector<Real*>&       rhs,
+                                                  const UInt                      nodes )
+{
+    const Real eta ( M_Eta ), gamma ( M_Gamma );
+
+    const Real* V = v[0];
+    const Real* r = v[1];
+    Real* dr = rhs[1];
+
+    for ( UInt k = 0; k < nodes; k++ )
+    {
+        dr[k] = eta * V[k] - gamma * r[k];
+    }
+}
+
+void IonicFitzHughNagumo::computeRhsBatch ( const std::vector<const Real*>& v,
+                                            const Real*                     appliedCurrent,
+                                            const std::vector<Real*>&       rhs,
+                                            const UInt                      nodes )
+{
+    const Real G ( M_G ), Vth ( M_Vth ), Vp ( M_Vp ), eta1 ( M_Eta1 ), eta ( M_Eta ), gamma ( M_Gamma );
+
+    const Real* V = v[0];
+    const Real* r = v[1];
+    Real* dV = rhs[0];
+    Real* dr = rhs[1];
+
+    for ( UInt k = 0; k < nodes; k++ )
+    {
+        dV[k] = - ( G * V[k] * ( 1.0 - V[k] / Vth ) * ( 1.0 - V[k] / Vp ) + eta1 * V[k] * r[k] );
+        dr[k] = eta * V[k] - gamma * r[k];
+    }
+
+    if ( appliedCurrent )
+    {
+        for ( UInt k = 0; k < nodes; k++ )
+        {
+            dV[k] += appliedCurrent[k];
+        }
+    }
+}
+
 Real IonicFitzHughNagumo::computeLocalPotentialRhs ( const std::vector<Real>& v)
 {
     return ( - ( M_G * v[0] * ( 1.0 - v[0] / M_Vth ) * ( 1.0 - v[0] / M_Vp ) + M_Eta1 * v[0] * v[1] ) );
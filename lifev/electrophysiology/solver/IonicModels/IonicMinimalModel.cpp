@@ -293,6 +293,71 @@ void IonicMinimalModel::computeRhs ( const   std::vector<Real>&  v,
 
 }
 
+void IonicMinimalModel::computeGatingRhsBatch ( const std::vector<const Real*>& v,
+                                                const Real*                     /*appliedCurrent*/,
+                                                const std::vector<Real*>&       rhs,
+                                                const UInt                      nodes )
+{
+    for ( UInt k = 0; k < nodes; k++ )
+    {
+        const Real U = v[0][k];
+        const Real V = v[1][k];
+        const Real W = v[2][k];
+        const Real S = v[3][k];
+
+        const Real tauvm = ( 1.0 - Heaviside ( U - M_tetavm ) ) * M_tauv1 + Heaviside ( U - M_tetavm ) * M_tauv2;
+        const Real tauwm = M_tauw1 + ( M_tauw2  - M_tauw1  ) * ( 1.0 + std::tanh ( M_kw  * ( U - M_uw  ) ) ) / 2.0;
+        const Real taus  = ( 1.0 - Heaviside ( U - M_tetaw ) ) * M_taus1 + Heaviside ( U - M_tetaw ) * M_taus2;
+
+        const Real vinf  = Heaviside ( M_tetavm - U );
+        const Real winf  = ( 1.0 - Heaviside ( U - M_tetao ) ) * ( 1.0 - U / M_tauwinf ) + Heaviside ( U - M_tetao ) * M_winfstar;
+
+        rhs[1][k] = ( 1.0 - Heaviside ( U - M_tetav ) ) * ( vinf - V ) / tauvm - Heaviside ( U - M_tetav ) * V / M_tauvp;
+        rhs[2][k] = ( 1.0 - Heaviside ( U - M_tetaw ) ) * ( winf - W ) / tauwm - Heaviside ( U - M_tetaw ) * W / M_tauwp;
+        rhs[3][k] = ( ( 1.0 + std::tanh ( M_ks * ( U - M_us ) ) ) / 2.0 - S ) / taus;
+    }
+}
+
+void IonicMinimalModel::computeRhsBatch ( const std::vector<const Real*>& v,
+                                          const Real*                     appliedCurrent,
+                                          const std::vector<Real*>&       rhs,
+                                          const UInt                      nodes )
+{
+    for ( UInt k = 0; k < nodes; k++ )
+    {
+        const Real U = v[0][k];
+        const Real V = v[1][k];
+        const Real W = v[2][k];
+        const Real S = v[3][k];
+
+        const Real tauvm = ( 1.0 - Heaviside ( U - M_tetavm ) ) * M_tauv1 + Heaviside ( U - M_tetavm ) * M_tauv2;
+        const Real tauwm = M_tauw1 + ( M_tauw2  - M_tauw1  ) * ( 1.0 + std::tanh ( M_kw  * ( U - M_uw  ) ) ) / 2.0;
+        const Real tauso = M_tauso1 + ( M_tauso2 - M_tauso1 ) * ( 1.0 + std::tanh ( M_kso * ( U - M_uso ) ) ) / 2.0;
+        const Real taus  = ( 1.0 - Heaviside ( U - M_tetaw ) ) * M_taus1 + Heaviside ( U - M_tetaw ) * M_taus2;
+        const Real tauo  = ( 1.0 - Heaviside ( U - M_tetao ) ) * M_tauo1 + Heaviside ( U - M_tetao ) * M_tauo2;
+
+        const Real vinf  = Heaviside ( M_tetavm - U );
+        const Real winf  = ( 1.0 - Heaviside ( U - M_tetao ) ) * ( 1.0 - U / M_tauwinf ) + Heaviside ( U - M_tetao ) * M_winfstar;
+
+        const Real Jfi   = - V * Heaviside ( U - M_tetav ) * ( U - M_tetav ) * ( M_uu - U ) / M_taufi;
+        const Real Jso   = ( U - M_uo ) * ( 1.0 - Heaviside ( U - M_tetaw )  ) / tauo + Heaviside ( U - M_tetaw ) / tauso;
+        const Real Jsi   = - Heaviside ( U - M_tetaw ) * W * S / M_tausi;
+
+        rhs[0][k] = - ( Jfi + Jso + Jsi );
+        rhs[1][k] = ( 1.0 - Heaviside ( U - M_tetav ) ) * ( vinf - V ) / tauvm - Heaviside ( U - M_tetav ) * V / M_tauvp;
+        rhs[2][k] = ( 1.0 - Heaviside ( U - M_tetaw ) ) * ( winf - W ) / tauwm - Heaviside ( U - M_tetaw ) * W / M_tauwp;
+        rhs[3][k] = ( ( 1.0 + std::tanh ( M_ks * ( U - M_us ) ) ) / 2.0 - S ) / taus;
+    }
+
+    if ( appliedCurrent )
+    {
+        for ( UInt k = 0; k < nodes; k++ )
+        {
+            rhs[0][k] += appliedCurrent[k];
+        }
+    }
+}
+
 
 void IonicMinimalModel::computeGatingVariablesWithRushLarsen ( std::vector<Real>& v, const Real dt )
 {
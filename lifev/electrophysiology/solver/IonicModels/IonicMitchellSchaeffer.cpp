@@ -117,6 +117,51 @@ void IonicMitchellSchaeffer::computeRhs (const   std::vector<Real>&  v,
     rhs[1] = computeLocalGatingRhs ( v );
 }
 
+void IonicMitchellSchaeffer::computeGatingRhsBatch ( const std::vector<const Real*>& v,
+                                                     const Real*                     /*appliedCurrent*/,
+                                                     const std::vector<Real*>&       rhs,
+                                                     const UInt                      nodes )
+{
+    const Real vGate ( M_vGate ), tauOpen ( M_tauOpen ), tauClose ( M_tauClose );
+
+    const Real* V = v[0];
+    const Real* h = v[1];
+    Real* dh = rhs[1];
+
+    for ( UInt k = 0; k < nodes; k++ )
+    {
+        dh[k] = ( V[k] <= vGate ) ? ( 1 - h[k] ) / tauOpen : - h[k] / tauClose;
+    }
+}
+
+void IonicMitchellSchaeffer::computeRhsBatch ( const std::vector<const Real*>& v,
+                                               const Real*                     appliedCurrent,
+                                               const std::vector<Real*>&       rhs,
+                                               const UInt                      nodes )
+{
+    const Real vGate ( M_vGate ), tauOpen ( M_tauOpen ), tauClose ( M_tauClose );
+    const Real tauIn ( M_tauIn ), tauOut ( M_tauOut );
+
+    const Real* V = v[0];
+    const Real* h = v[1];
+    Real* dV = rhs[0];
+    Real* dh = rhs[1];
+
+    for ( UInt k = 0; k < nodes; k++ )
+    {
+        dV[k] = - ( h[k] / tauIn ) * V[k] * V[k] * ( V[k] - 1 ) - V[k] / tauOut;
+        dh[k] = ( V[k] <= vGate ) ? ( 1 - h[k] ) / tauOpen : - h[k] / tauClose;
+    }
+
+    if ( appliedCurrent )
+    {
+        for ( UInt k = 0; k < nodes; k++ )
+        {
+            dV[k] += appliedCurrent[k];
+        }
+    }
+}
+
 
 
 Real IonicMitchellSchaeffer::computeLocalPotentialRhs ( const std::vector<Real>& v )
@@ -161,6 +161,23 @@ public:
 
     void computeRhs ( const std::vector<Real>& v, std::vector<Real>& rhs );
 
+    //Compute the rhs on contiguous local arrays (3D case)
+    void computeGatingRhsBatch ( const std::vector<const Real*>& v,
+                                 const Real*                     appliedCurrent,
+                                 const std::vector<Real*>&       rhs,
+                                 const UInt                      nodes );
+
+    void computeRhsBatch ( const std::vector<const Real*>& v,
+                           const Real*                     appliedCurrent,
+                           const std::vector<Real*>&       rhs,
+                           const UInt                      nodes );
+
+    //The batched kernels and the 0D methods do not write member data
+    bool isThreadSafe() const
+    {
+        return true;
+    }
+
 
     // compute the rhs with state variable interpolation
     Real computeLocalPotentialRhs ( const std::vector<Real>& v);
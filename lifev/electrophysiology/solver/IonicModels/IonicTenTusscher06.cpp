@@ -634,6 +634,111 @@ void IonicTenTusscher06::computeRhs ( const   std::vector<Real>&  v,
 
 }
 
+void IonicTenTusscher06::computeGatingRhsBatch ( const std::vector<const Real*>& v,
+                                                 const Real*                     appliedCurrent,
+                                                 const std::vector<Real*>&       rhs,
+                                                 const UInt                      nodes )
+{
+    for ( UInt k = 0; k < nodes; k++ )
+    {
+        const Real V = v[0][k];
+        const Real m = v[1][k];
+        const Real h = v[2][k];
+        const Real j = v[3][k];
+        const Real d = v[4][k];
+        const Real f = v[5][k];
+        const Real f2 = v[6][k];
+        const Real fcass = v[7][k];
+        const Real r = v[8][k];
+        const Real s = v[9][k];
+        const Real xr1 = v[10][k];
+        const Real xr2 = v[11][k];
+        const Real xs = v[12][k];
+        const Real Nai = v[13][k];
+        const Real Ki = v[14][k];
+        const Real Cai = v[15][k];
+        const Real CaSS = v[16][k];
+        const Real CaSR = v[17][k];
+        const Real RR = v[18][k];
+
+        rhs[1][k] = dM (V, m);
+        rhs[2][k] = dH (V, h);
+        rhs[3][k] = dJ (V, j);
+        rhs[4][k] = dD (V, d);
+        rhs[5][k] = dF (V, f);
+        rhs[6][k] = dF2 (V, f2);
+        rhs[7][k] = dFCaSS (V, fcass);
+        rhs[8][k] = dR (V, r);
+        rhs[9][k] = dS (V, s);
+        rhs[10][k] = dXr1 (V, xr1);
+        rhs[11][k] = dXr2 (V, xr2);
+        rhs[12][k] = dXs (V, xs);
+        rhs[13][k] = dNai (V, m, h, j, Nai, Cai);
+        rhs[14][k] = dKi (V, r, s, xr1, xr2, xs, Ki, Nai, appliedCurrent ? appliedCurrent[k] : 0.0);
+        rhs[15][k] = dCai (V, Nai, Cai, CaSR, CaSS);
+        rhs[16][k] = dCaSS (Cai, CaSR, CaSS, RR, V, d, f, f2, fcass);
+        rhs[17][k] = dCaSR (Cai, CaSR, CaSS, RR);
+        rhs[18][k] = dRR (CaSR, CaSS, RR);
+    }
+}
+
+void IonicTenTusscher06::computeRhsBatch ( const std::vector<const Real*>& v,
+                                           const Real*                     appliedCurrent,
+                                           const std::vector<Real*>&       rhs,
+                                           const UInt                      nodes )
+{
+    for ( UInt k = 0; k < nodes; k++ )
+    {
+        const Real V = v[0][k];
+        const Real m = v[1][k];
+        const Real h = v[2][k];
+        const Real j = v[3][k];
+        const Real d = v[4][k];
+        const Real f = v[5][k];
+        const Real f2 = v[6][k];
+        const Real fcass = v[7][k];
+        const Real r = v[8][k];
+        const Real s = v[9][k];
+        const Real xr1 = v[10][k];
+        const Real xr2 = v[11][k];
+        const Real xs = v[12][k];
+        const Real Nai = v[13][k];
+        const Real Ki = v[14][k];
+        const Real Cai = v[15][k];
+        const Real CaSS = v[16][k];
+        const Real CaSR = v[17][k];
+        const Real RR = v[18][k];
+
+        rhs[0][k] = - Itot (V, m, h, j, d, f, f2, fcass, r, s, xr1, xr2, xs, Nai, Ki, Cai, CaSS );
+        rhs[1][k] = dM (V, m);
+        rhs[2][k] = dH (V, h);
+        rhs[3][k] = dJ (V, j);
+        rhs[4][k] = dD (V, d);
+        rhs[5][k] = dF (V, f);
+        rhs[6][k] = dF2 (V, f2);
+        rhs[7][k] = dFCaSS (V, fcass);
+        rhs[8][k] = dR (V, r);
+        rhs[9][k] = dS (V, s);
+        rhs[10][k] = dXr1 (V, xr1);
+        rhs[11][k] = dXr2 (V, xr2);
+        rhs[12][k] = dXs (V, xs);
+        rhs[13][k] = dNai (V, m, h, j, Nai, Cai);
+        rhs[14][k] = dKi (V, r, s, xr1, xr2, xs, Ki, Nai, appliedCurrent ? appliedCurrent[k] : 0.0);
+        rhs[15][k] = dCai (V, Nai, Cai, CaSR, CaSS);
+        rhs[16][k] = dCaSS (Cai, CaSR, CaSS, RR, V, d, f, f2, fcass);
+        rhs[17][k] = dCaSR (Cai, CaSR, CaSS, RR);
+        rhs[18][k] = dRR (CaSR, CaSS, RR);
+    }
+
+    if ( appliedCurrent )
+    {
+        for ( UInt k = 0; k < nodes; k++ )
+        {
+            rhs[0][k] += appliedCurrent[k];
+        }
+    }
+}
+
 
 Real IonicTenTusscher06::computeLocalPotentialRhs ( const std::vector<Real>& v)
 {
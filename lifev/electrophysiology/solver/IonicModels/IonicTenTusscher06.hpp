@@ -808,7 +808,11 @@ public:
 
     inline Real dKi (Real V, Real r, Real s, Real xr1, Real xr2, Real xs, Real Nai, Real Ki)
     {
-        return - (- M_appliedCurrent
+        return dKi (V, r, s, xr1, xr2, xs, Nai, Ki, M_appliedCurrent);
+    }
+    inline Real dKi (Real V, Real r, Real s, Real xr1, Real xr2, Real xs, Real Nai, Real Ki, Real Iapp)
+    {
+        return - (- Iapp
                   + IK1 (V, Ki)
                   + Ito (V, r, s, Ki)
                   + IKr (V, xr1, xr2, Ki)
@@ -1177,6 +1181,23 @@ public:
 
     void computeRhs ( const std::vector<Real>& v, std::vector<Real>& rhs);
 
+    //Compute the rhs on contiguous local arrays (3D case)
+    void computeGatingRhsBatch ( const std::vector<const Real*>& v,
+                                 const Real*                     appliedCurrent,
+                                 const std::vector<Real*>&       rhs,
+                                 const UInt                      nodes );
+
+    void computeRhsBatch ( const std::vector<const Real*>& v,
+                           const Real*                     appliedCurrent,
+                           const std::vector<Real*>&       rhs,
+                           const UInt                      nodes );
+
+    //The batched kernels and the 0D methods do not write member data
+    bool isThreadSafe() const
+    {
+        return true;
+    }
+
     // compute the rhs with state variable interpolation
     Real computeLocalPotentialRhs ( const std::vector<Real>& v );
 
@@ -35,10 +35,20 @@
 
 #include <lifev/electrophysiology/stimulus/ElectroStimulus.hpp>
 
+#include <boost/bind.hpp>
+
 namespace LifeV
 {
 
 ElectroStimulus::ElectroStimulus( ) { }
 
+void ElectroStimulus::setAppliedCurrent ( vector_Type& appliedCurrent, const feSpacePtr_Type& feSpacePtr, const Real& time )
+{
+    // boost::ref() is needed here because otherwise a copy of the base object is reinstantiated
+    feSpace_Type::function_Type f = boost::bind (&ElectroStimulus::appliedCurrent, boost::ref (*this), _1, _2, _3, _4, _5 );
+
+    feSpacePtr -> interpolate ( f, appliedCurrent, time );
+}
+
 
 }
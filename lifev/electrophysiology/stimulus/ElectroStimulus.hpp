@@ -38,6 +38,9 @@
 #define ELECTROSTIMULUS_HPP_
 
 #include <lifev/core/array/VectorEpetra.hpp>
+#include <lifev/core/array/MapEpetra.hpp>
+#include <lifev/core/mesh/RegionMesh.hpp>
+#include <lifev/core/fem/FESpace.hpp>
 #include <Teuchos_RCP.hpp>
 #include <Teuchos_ParameterList.hpp>
 #include "Teuchos_XMLParameterListHelpers.hpp"
@@ -54,6 +57,9 @@ public:
     typedef VectorEpetra                    vector_Type;
     typedef boost::shared_ptr<VectorEpetra> vectorPtr_Type;
     typedef Teuchos::ParameterList          list_Type;
+    typedef RegionMesh<LinearTetra>         mesh_Type;
+    typedef FESpace<mesh_Type, MapEpetra>   feSpace_Type;
+    typedef boost::shared_ptr<feSpace_Type> feSpacePtr_Type;
 
     //@}
 
@@ -93,6 +99,16 @@ public:
         return 0.0;
     }
 
+    //! Set the applied current at the dofs of a finite element space
+    /*!
+     *  The default implementation interpolates appliedCurrent() at all the dofs;
+     *  stimuli with a localized support can override it to update only the dofs they touch.
+     *  @param appliedCurrent vector of the applied current
+     *  @param feSpacePtr pointer to the finite element space of the applied current
+     *  @param time time at which the stimulus is evaluated
+     */
+    virtual void setAppliedCurrent ( vector_Type& appliedCurrent, const feSpacePtr_Type& feSpacePtr, const Real& time );
+
     virtual void setParameters (list_Type&  list)
     {
 
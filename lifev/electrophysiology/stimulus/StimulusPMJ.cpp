@@ -36,16 +36,77 @@
 
 #include <lifev/electrophysiology/stimulus/StimulusPMJ.hpp>
 
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+#include <boost/bind.hpp>
+
 namespace LifeV
 {
 
+namespace
+{
+
+// Coordinate of the dofs, to be interpolated on the finite element space
+Real dofCoordinate ( const Real& /*t*/, const Real& x, const Real& y, const Real& z, const ID& /*i*/, const UInt& component )
+{
+    return component == 0 ? x : ( component == 1 ? y : z );
+}
+
+// Range of the cells of the bucket grid intersecting [value - radius, value + radius] in one direction
+bool cellRange ( const Real& value, const Real& radius, const Real& minimum, const Real& cellSize,
+                 const UInt& numberOfCells, UInt& first, UInt& last )
+{
+    const Real firstCell ( std::floor ( ( value - radius - minimum ) / cellSize ) );
+    const Real lastCell ( std::floor ( ( value + radius - minimum ) / cellSize ) );
+
+    if ( lastCell < 0 || firstCell > numberOfCells - 1. )
+    {
+        return false;
+    }
+
+    first = static_cast<UInt> ( std::max ( firstCell, 0. ) );
+    last = static_cast<UInt> ( std::min ( lastCell, numberOfCells - 1. ) );
+    return true;
+}
+
+// Ordering of the junctions by activation time
+class ActivationTimeLess
+{
+public:
+    explicit ActivationTimeLess ( const StimulusPMJ::activationData_type& activationData ) :
+        M_activationData ( activationData )
+    {}
+
+    bool operator() ( const UInt& first, const UInt& second ) const
+    {
+        return M_activationData[first].time < M_activationData[second].time;
+    }
+
+private:
+    const StimulusPMJ::activationData_type& M_activationData;
+};
+
+}
+
 // ===================================================
 //! Constructors
 // ===================================================
 StimulusPMJ::StimulusPMJ() :
+    M_activationData ( ),
     M_radius ( 0 ),
-    M_activationData ( * (new activationData_type() ) ),
-    M_problemFolder ( "./" )
+    M_totalCurrent ( 0 ),
+    M_problemFolder ( "./" ),
+    M_footprintOffsets ( ),
+    M_footprintDofs ( ),
+    M_footprintFESpace ( ),
+    M_footprintMapType ( Unique ),
+    M_footprintLocalLength ( 0 ),
+    M_activationOrder ( ),
+    M_nextActivation ( 0 ),
+    M_activeJunctions ( ),
+    M_lastTime ( 0 )
 {
 
 }
@@ -58,17 +119,14 @@ void StimulusPMJ::setPMJFromFile ( std::string fileName )
     std::ifstream fin;
 
     fin.open ( fileName.c_str() );
-    while ( !fin.fail() )
-    {
-        StimulusPMJ_Activation junction;
-        fin >> junction.x;
-        fin >> junction.y;
-        fin >> junction.z;
-        fin >> junction.time;
-        fin >> junction.duration;
+    StimulusPMJ_Activation junction;
+    while ( fin >> junction.x >> junction.y >> junction.z >> junction.time >> junction.duration )
+    {
         M_activationData.push_back ( junction );
     }
     fin.close();
+
+    resetFootprints();
 }
 
 void StimulusPMJ::setPMJAddJunction ( Real x, Real y, Real z, Real time, Real duration )
@@ -80,6 +138,8 @@ void StimulusPMJ::setPMJAddJunction ( Real x, Real y, Real z, Real time, Real du
     junction.time = time;
     junction.duration = duration;
     M_activationData.push_back ( junction );
+
+    resetFootprints();
 }
 
 // ===================================================
@@ -104,6 +164,165 @@ Real StimulusPMJ::appliedCurrent ( const Real& t, const Real& x, const Real& y,
     return current;
 }
 
+void StimulusPMJ::setAppliedCurrent ( vector_Type& appliedCurrent, const feSpacePtr_Type& feSpacePtr, const Real& time )
+{
+    if ( M_footprintOffsets.empty() || M_footprintFESpace != feSpacePtr || M_footprintMapType != appliedCurrent.mapType()
+            || M_footprintLocalLength != static_cast<UInt> ( appliedCurrent.epetraVector().MyLength() ) )
+    {
+        setupFootprints ( appliedCurrent, feSpacePtr );
+    }
+
+    updateActiveJunctions ( time );
+
+    const Real volumeOfBall = (4. / 3.) * M_PI * M_radius * M_radius * M_radius;
+    const Real current ( M_totalCurrent / volumeOfBall );
+
+    appliedCurrent.epetraVector().PutScalar ( 0. );
+    Real* values ( appliedCurrent.epetraVector() [0] );
+
+    for ( idContainer_type::const_iterator it = M_activeJunctions.begin(); it != M_activeJunctions.end(); ++it )
+    {
+        for ( UInt k ( M_footprintOffsets[*it] ); k < M_footprintOffsets[*it + 1]; ++k )
+        {
+            values[M_footprintDofs[k]] += current;
+        }
+    }
+}
+
+void StimulusPMJ::setupFootprints ( const vector_Type& appliedCurrent, const feSpacePtr_Type& feSpacePtr )
+{
+    const UInt numberOfJunctions ( M_activationData.size() );
+    const UInt localLength ( appliedCurrent.epetraVector().MyLength() );
+
+    // Coordinates of the local dofs; the dofs which are not reached by the interpolation keep NaN and are never stimulated
+    std::vector<Real> coordinates ( 3 * localLength );
+    vector_Type dofCoordinates ( appliedCurrent.map(), appliedCurrent.mapType() );
+    for ( UInt component (0); component < 3; ++component )
+    {
+        dofCoordinates.epetraVector().PutScalar ( std::numeric_limits<Real>::quiet_NaN() );
+        feSpacePtr->interpolate ( feSpace_Type::function_Type ( boost::bind ( &dofCoordinate, _1, _2, _3, _4, _5, component ) ),
+                                  dofCoordinates, 0. );
+        const Real* values ( dofCoordinates.epetraVector() [0] );
+        for ( UInt i (0); i < localLength; ++i )
+        {
+            coordinates[3 * i + component] = values[i];
+        }
+    }
+
+    // Bounding box of the local dofs
+    std::vector<Real> minimum ( 3, std::numeric_limits<Real>::max() );
+    std::vector<Real> maximum ( 3, -std::numeric_limits<Real>::max() );
+    std::vector<UInt> localDofs;
+    localDofs.reserve ( localLength );
+    for ( UInt i (0); i < localLength; ++i )
+    {
+        if ( coordinates[3 * i] == coordinates[3 * i] )
+        {
+            localDofs.push_back ( i );
+            for ( UInt component (0); component < 3; ++component )
+            {
+                minimum[component] = std::min ( minimum[component], coordinates[3 * i + component] );
+                maximum[component] = std::max ( maximum[component], coordinates[3 * i + component] );
+            }
+        }
+    }
+
+    // Bucket grid with cells of the size of the radius (at most 1000 cells in each direction)
+    Real cellSize ( M_radius );
+    for ( UInt component (0); component < 3 && !localDofs.empty(); ++component )
+    {
+        cellSize = std::max ( cellSize, ( maximum[component] - minimum[component] ) / 1000. );
+    }
+    if ( cellSize <= 0. )
+    {
+        cellSize = 1.;
+    }
+
+    std::vector<UInt> numberOfCells ( 3, 1 );
+    for ( UInt component (0); component < 3 && !localDofs.empty(); ++component )
+    {
+        numberOfCells[component] = static_cast<UInt> ( ( maximum[component] - minimum[component] ) / cellSize ) + 1;
+    }
+
+    // Local dofs sorted by cell: the cell (ix, iy, iz) has the key (ix * ny + iy) * nz + iz
+    std::vector< std::pair<UInt, UInt> > cellDofs;
+    cellDofs.reserve ( localDofs.size() );
+    for ( std::vector<UInt>::const_iterator it = localDofs.begin(); it != localDofs.end(); ++it )
+    {
+        UInt key (0);
+        for ( UInt component (0); component < 3; ++component )
+        {
+            const UInt cell ( std::min ( static_cast<UInt> ( ( coordinates[3 * *it + component] - minimum[component] ) / cellSize ),
+                                         numberOfCells[component] - 1 ) );
+            key = key * numberOfCells[component] + cell;
+        }
+        cellDofs.push_back ( std::make_pair ( key, *it ) );
+    }
+    std::sort ( cellDofs.begin(), cellDofs.end() );
+
+    // Footprints: local dofs within the radius of each junction (same test as appliedCurrent)
+    M_footprintOffsets.assign ( numberOfJunctions + 1, 0 );
+    M_footprintDofs.clear();
+    for ( UInt j (0); j < numberOfJunctions; ++j )
+    {
+        M_footprintOffsets[j] = M_footprintDofs.size();
+
+        const StimulusPMJ_Activation& junction ( M_activationData[j] );
+        UInt firstX, lastX, firstY, lastY, firstZ, lastZ;
+        if ( localDofs.empty()
+                || !cellRange ( junction.x, M_radius, minimum[0], cellSize, numberOfCells[0], firstX, lastX )
+                || !cellRange ( junction.y, M_radius, minimum[1], cellSize, numberOfCells[1], firstY, lastY )
+                || !cellRange ( junction.z, M_radius, minimum[2], cellSize, numberOfCells[2], firstZ, lastZ ) )
+        {
+            continue;
+        }
+
+        for ( UInt ix ( firstX ); ix <= lastX; ++ix )
+        {
+            for ( UInt iy ( firstY ); iy <= lastY; ++iy )
+            {
+                // The cells with iz in [firstZ, lastZ] have consecutive keys
+                const UInt firstKey ( ( ix * numberOfCells[1] + iy ) * numberOfCells[2] + firstZ );
+                const UInt lastKey ( ( ix * numberOfCells[1] + iy ) * numberOfCells[2] + lastZ );
+
+                for ( std::vector< std::pair<UInt, UInt> >::const_iterator it =
+                            std::lower_bound ( cellDofs.begin(), cellDofs.end(), std::make_pair ( firstKey, static_cast<UInt> (0) ) );
+                        it != cellDofs.end() && it->first <= lastKey; ++it )
+                {
+                    const Real x ( coordinates[3 * it->second] );
+                    const Real y ( coordinates[3 * it->second + 1] );
+                    const Real z ( coordinates[3 * it->second + 2] );
+                    Real distance = std::sqrt ( (x - junction.x) * (x - junction.x) + (y - junction.y) * (y - junction.y) + (z - junction.z) * (z - junction.z) );
+
+                    if ( distance <= M_radius )
+                    {
+                        M_footprintDofs.push_back ( it->second );
+                    }
+                }
+            }
+        }
+
+        std::sort ( M_footprintDofs.begin() + M_footprintOffsets[j], M_footprintDofs.end() );
+    }
+    M_footprintOffsets[numberOfJunctions] = M_footprintDofs.size();
+
+    M_footprintFESpace = feSpacePtr;
+    M_footprintMapType = appliedCurrent.mapType();
+    M_footprintLocalLength = localLength;
+
+    // Timeline of the activations
+    M_activationOrder.resize ( numberOfJunctions );
+    for ( UInt j (0); j < numberOfJunctions; ++j )
+    {
+        M_activationOrder[j] = j;
+    }
+    std::stable_sort ( M_activationOrder.begin(), M_activationOrder.end(), ActivationTimeLess ( M_activationData ) );
+
+    M_nextActivation = 0;
+    M_activeJunctions.clear();
+    M_lastTime = -std::numeric_limits<Real>::max();
+}
+
 void StimulusPMJ::showMe()
 {
     std::cout << "\n\n\t\tPMJ activation Informations\n\n";
@@ -113,7 +332,60 @@ void StimulusPMJ::showMe()
     std::cout << "Radius current application: " << M_radius << std::endl;
     std::cout << "Total current: " << M_totalCurrent << std::endl;
     std::cout << "Problem folder: " << M_problemFolder << std::endl;
+    if ( !M_footprintOffsets.empty() )
+    {
+        std::cout << "Local dofs in the footprints: " << M_footprintDofs.size() << std::endl;
+    }
     std::cout << "\n\t\t End of PMJ activation Informations\n\n\n";
 }
 
+// ===================================================
+//! Private Methods
+// ===================================================
+void StimulusPMJ::resetFootprints()
+{
+    M_footprintOffsets.clear();
+    M_footprintDofs.clear();
+    M_footprintFESpace.reset();
+    M_footprintLocalLength = 0;
+
+    M_activationOrder.clear();
+    M_nextActivation = 0;
+    M_activeJunctions.clear();
+}
+
+void StimulusPMJ::updateActiveJunctions ( const Real& time )
+{
+    // The timeline is followed forward: start again from the beginning if the time goes back
+    if ( time < M_lastTime )
+    {
+        M_nextActivation = 0;
+        M_activeJunctions.clear();
+    }
+    M_lastTime = time;
+
+    // Remove the junctions whose activation is over
+    UInt numberOfActiveJunctions (0);
+    for ( UInt k (0); k < M_activeJunctions.size(); ++k )
+    {
+        const StimulusPMJ_Activation& junction ( M_activationData[M_activeJunctions[k]] );
+        if ( time <= junction.time + junction.duration )
+        {
+            M_activeJunctions[numberOfActiveJunctions++] = M_activeJunctions[k];
+        }
+    }
+    M_activeJunctions.resize ( numberOfActiveJunctions );
+
+    // Add the junctions activated since the last call
+    for ( ; M_nextActivation < M_activationOrder.size()
+            && M_activationData[M_activationOrder[M_nextActivation]].time <= time; ++M_nextActivation )
+    {
+        const StimulusPMJ_Activation& junction ( M_activationData[M_activationOrder[M_nextActivation]] );
+        if ( time <= junction.time + junction.duration )
+        {
+            M_activeJunctions.push_back ( M_activationOrder[M_nextActivation] );
+        }
+    }
+}
+
 }
@@ -62,6 +62,8 @@ public:
 
     typedef std::vector<StimulusPMJ_Activation >  activationData_type;
 
+    typedef std::vector<UInt>                     idContainer_type;
+
     //@}
 
     //! @name Constructors & Destructor
@@ -99,6 +101,7 @@ public:
     {
         ASSERT (r > 0, "Invalid radius value.");
         M_radius = r;
+        resetFootprints();
     }
 
     inline void setTotalCurrent ( Real I )
@@ -125,16 +128,56 @@ public:
     //! @name Methods
     //@{
     Real appliedCurrent ( const Real& t, const Real& x, const Real& y, const Real& z, const ID& i );
+
+    //! Set the applied current at the dofs of a finite element space
+    /*!
+     *  The first call (and the first one after a change of the junctions, of the radius or of the map)
+     *  computes the footprints of the junctions, i.e. the local dofs within the radius of each junction,
+     *  with a bucket grid over the local dofs.
+     *  Then only the footprints of the active junctions are written: the active junctions are
+     *  followed along the timeline of the activations, sorted by activation time.
+     *  @param appliedCurrent vector of the applied current
+     *  @param feSpacePtr pointer to the finite element space of the applied current
+     *  @param time time at which the stimulus is evaluated
+     */
+    void setAppliedCurrent ( vector_Type& appliedCurrent, const feSpacePtr_Type& feSpacePtr, const Real& time );
+
+    //! Compute the footprints of the junctions on the local dofs of a vector
+    /*!
+     * @param appliedCurrent vector of the applied current (only its map is used)
+     * @param feSpacePtr pointer to the finite element space of the applied current
+     */
+    void setupFootprints ( const vector_Type& appliedCurrent, const feSpacePtr_Type& feSpacePtr );
+
     void showMe ();
     //@}
 
 private:
 
+    //! Invalidate the footprints and the timeline
+    void resetFootprints();
+
+    //! Update the list of the active junctions at a given time
+    void updateActiveJunctions ( const Real& time );
+
     activationData_type  M_activationData;
     Real                 M_radius;
     Real                 M_totalCurrent;
     std::string          M_problemFolder;
 
+    //! Footprints of the junctions (CSR): local dofs M_footprintDofs[M_footprintOffsets[j]], ..., M_footprintDofs[M_footprintOffsets[j+1] - 1]
+    idContainer_type     M_footprintOffsets;
+    idContainer_type     M_footprintDofs;
+    feSpacePtr_Type      M_footprintFESpace;
+    MapEpetraType        M_footprintMapType;
+    UInt                 M_footprintLocalLength;
+
+    //! Timeline: junctions sorted by activation time, next junction to activate and active junctions
+    idContainer_type     M_activationOrder;
+    UInt                 M_nextActivation;
+    idContainer_type     M_activeJunctions;
+    Real                 M_lastTime;
+
 };
 
 } // namespace LifeV
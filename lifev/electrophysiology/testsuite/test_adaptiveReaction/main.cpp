@@ -0,0 +1,250 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Adaptive reaction step against fixed forward Euler substeps
+
+    @date 10-2026
+
+    The Ten Tusscher et al. 2006 model is advanced on a set of uncoupled nodes,
+    half of them stimulated and the other half at rest, through one upstroke.
+    The adaptive step (ElectroIonicModel::solveOneStepAdaptive) is compared with
+    forward Euler with a fixed, large number of substeps: the activation times and
+    the final potentials must agree, the work report must account for all the nodes
+    and the resting nodes must be accepted with a single substep.
+ */
+
+// Tell the compiler to ignore specific kind of warnings:
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+//Tell the compiler to restore the warning previously silented
+#pragma GCC diagnostic warning "-Wunused-variable"
+#pragma GCC diagnostic warning "-Wunused-parameter"
+
+#include <lifev/electrophysiology/solver/IonicModels/IonicTenTusscher06.hpp>
+#include <lifev/core/LifeV.hpp>
+
+using namespace LifeV;
+
+#define ACTIVATION_THRESHOLD     -20.0
+#define ACTIVATION_TOLERANCE     0.05
+#define POTENTIAL_TOLERANCE      2.0
+
+namespace
+{
+
+typedef ElectroIonicModel::vector_Type      vector_Type;
+typedef ElectroIonicModel::vectorPtr_Type   vectorPtr_Type;
+
+// Update the activation times of the local nodes crossing the threshold between t - dt and t
+void updateActivationTimes ( const vector_Type& potential, std::vector<Real>& previousPotential,
+                             std::vector<Real>& activationTimes, const Real t, const Real dt )
+{
+    const Real* values ( potential.epetraVector() [0] );
+    for ( UInt k (0); k < activationTimes.size(); ++k )
+    {
+        if ( activationTimes[k] < 0. && previousPotential[k] < ACTIVATION_THRESHOLD && values[k] >= ACTIVATION_THRESHOLD )
+        {
+            activationTimes[k] = t - dt + dt * ( ACTIVATION_THRESHOLD - previousPotential[k] ) / ( values[k] - previousPotential[k] );
+        }
+        previousPotential[k] = values[k];
+    }
+}
+
+}
+
+Int main ( Int argc, char** argv )
+{
+    MPI_Init ( &argc, &argv );
+    boost::shared_ptr<Epetra_Comm> Comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+    const bool verbose ( Comm->MyPID() == 0 );
+
+    IonicTenTusscher06 adaptiveModel;
+    IonicTenTusscher06 referenceModel;
+    adaptiveModel.setAdaptiveTimeStepParameters ( 1.0e-6, 1.0e-3, 64 );
+
+    //********************************************//
+    // Uncoupled nodes: the first half is         //
+    // stimulated, the second half stays at rest  //
+    //********************************************//
+    const Int numberOfNodes (64);
+    MapEpetra map ( numberOfNodes, Comm );
+
+    const UInt numberOfEquations ( adaptiveModel.Size() );
+    std::vector<vectorPtr_Type> adaptiveStates ( numberOfEquations );
+    std::vector<vectorPtr_Type> referenceStates ( numberOfEquations );
+    std::vector<vectorPtr_Type> referenceRhs ( numberOfEquations );
+    for ( UInt i (0); i < numberOfEquations; ++i )
+    {
+        adaptiveStates[i].reset ( new vector_Type ( map, Unique ) );
+        referenceStates[i].reset ( new vector_Type ( map, Unique ) );
+        referenceRhs[i].reset ( new vector_Type ( map, Unique ) );
+    }
+    adaptiveModel.initialize ( adaptiveStates );
+    referenceModel.initialize ( referenceStates );
+
+    const UInt localNodes ( map.map ( Unique )->NumMyElements() );
+    vectorPtr_Type stimulus ( new vector_Type ( map, Unique ) );
+    UInt localRestingNodes (0);
+    for ( UInt k (0); k < localNodes; ++k )
+    {
+        if ( map.map ( Unique )->GID ( k ) >= numberOfNodes / 2 )
+        {
+            localRestingNodes++;
+        }
+    }
+    adaptiveModel.setAppliedCurrentPtr ( stimulus );
+    referenceModel.setAppliedCurrentPtr ( stimulus );
+
+    //********************************************//
+    // One upstroke: stimulus on [0, 1] ms        //
+    //********************************************//
+    const Real dt (0.05);
+    const Real TF (10.0);
+    const Real stimulusDuration (1.0);
+    const Int referenceSubsteps (64);
+    const Real capacitance ( referenceModel.membraneCapacitance() );
+
+    std::vector<Real> adaptiveActivation ( localNodes, -1. );
+    std::vector<Real> referenceActivation ( localNodes, -1. );
+    std::vector<Real> adaptivePrevious ( localNodes, referenceModel.restingConditions() [0] );
+    std::vector<Real> referencePrevious ( localNodes, referenceModel.restingConditions() [0] );
+
+    bool reportOk (true);
+    UInt adaptiveEvaluations (0);
+    UInt unconvergedNodes (0);
+
+    for ( Int n (1); n * dt <= TF + 0.5 * dt; ++n )
+    {
+        const Real t ( n * dt );
+
+        Real* stimulusValues ( stimulus->epetraVector() [0] );
+        for ( UInt k (0); k < localNodes; ++k )
+        {
+            const bool stimulated ( map.map ( Unique )->GID ( k ) < numberOfNodes / 2 && t - dt < stimulusDuration );
+            stimulusValues[k] = stimulated ? 100. : 0.;
+        }
+
+        // Adaptive step
+        unconvergedNodes += adaptiveModel.solveOneStepAdaptive ( adaptiveStates, dt );
+
+        const ElectroIonicModel::AdaptiveStepReport& report ( adaptiveModel.adaptiveStepReport() );
+        UInt acceptedNodes (0);
+        for ( UInt level (0); level < report.nodesPerLevel.size(); ++level )
+        {
+            acceptedNodes += report.nodesPerLevel[level];
+        }
+        reportOk = reportOk && report.nodes == localNodes && acceptedNodes == localNodes
+                   && !report.nodesPerLevel.empty() && report.nodesPerLevel[0] >= localRestingNodes
+                   && report.maxSubsteps <= 64;
+        adaptiveEvaluations += report.rhsEvaluations;
+
+        // Fixed forward Euler substeps
+        const Real h ( dt / referenceSubsteps );
+        for ( Int s (0); s < referenceSubsteps; ++s )
+        {
+            referenceModel.ElectroIonicModel::computeRhs ( referenceStates, referenceRhs );
+            for ( UInt i (0); i < numberOfEquations; ++i )
+            {
+                *referenceStates[i] += ( i == 0 ? h / capacitance : h ) * ( *referenceRhs[i] );
+            }
+        }
+
+        updateActivationTimes ( *adaptiveStates[0], adaptivePrevious, adaptiveActivation, t, dt );
+        updateActivationTimes ( *referenceStates[0], referencePrevious, referenceActivation, t, dt );
+    }
+
+    //********************************************//
+    // Comparison                                 //
+    //********************************************//
+    Real localActivationError (0.);
+    Int localActivationMismatch (0);
+    for ( UInt k (0); k < localNodes; ++k )
+    {
+        const bool stimulated ( map.map ( Unique )->GID ( k ) < numberOfNodes / 2 );
+        if ( stimulated != ( referenceActivation[k] >= 0. ) || stimulated != ( adaptiveActivation[k] >= 0. ) )
+        {
+            localActivationMismatch++;
+        }
+        else if ( stimulated )
+        {
+            localActivationError = std::max ( localActivationError, std::abs ( adaptiveActivation[k] - referenceActivation[k] ) );
+        }
+    }
+
+    vector_Type potentialDifference ( *adaptiveStates[0] );
+    potentialDifference -= *referenceStates[0];
+    const Real potentialError ( potentialDifference.normInf() );
+
+    Real activationError (0.);
+    Int activationMismatch (0);
+    Int localReportOk ( reportOk ), globalReportOk (0);
+    Int localUnconverged ( unconvergedNodes ), globalUnconverged (0);
+    Int localEvaluations ( adaptiveEvaluations ), globalEvaluations (0);
+    Comm->MaxAll ( &localActivationError, &activationError, 1 );
+    Comm->SumAll ( &localActivationMismatch, &activationMismatch, 1 );
+    Comm->MinAll ( &localReportOk, &globalReportOk, 1 );
+    Comm->SumAll ( &localUnconverged, &globalUnconverged, 1 );
+    Comm->SumAll ( &localEvaluations, &globalEvaluations, 1 );
+
+    const Real steps ( TF / dt );
+    if ( verbose )
+    {
+        std::cout << "Activation time error: " << activationError
+                  << ", nodes activated differently: " << activationMismatch
+                  << ", final potential error: " << potentialError << std::endl;
+        std::cout << "Right hand side evaluations per node and step: adaptive "
+                  << globalEvaluations / ( steps * numberOfNodes ) << ", fixed " << referenceSubsteps
+                  << "; unconverged nodes: " << globalUnconverged << std::endl;
+    }
+
+    MPI_Finalize();
+
+    if ( activationMismatch > 0 || activationError > ACTIVATION_TOLERANCE
+            || potentialError > POTENTIAL_TOLERANCE || !globalReportOk )
+    {
+        if ( verbose )
+        {
+            std::cout << "\nTest Failed!\n";
+        }
+        return ( EXIT_FAILURE );
+    }
+    return ( EXIT_SUCCESS );
+}
+
+#undef ACTIVATION_THRESHOLD
+#undef ACTIVATION_TOLERANCE
+#undef POTENTIAL_TOLERANCE
@@ -0,0 +1,250 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Pseudo-ECG from the lead fields against the direct formula
+
+    @date 10-2026
+
+    The pseudo-ECG of three electrodes around the unit cube is computed with
+    PseudoECG (lead fields computed once, one reduction for all the electrodes)
+    for a few potentials, and compared with the direct formula: solve
+    M x = L u, then sum x_i / | x_i - x_e | over the dofs of each process and
+    over the processes.
+ */
+
+// Tell the compiler to ignore specific kind of warnings:
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <Teuchos_ParameterList.hpp>
+
+//Tell the compiler to restore the warning previously silented
+#pragma GCC diagnostic warning "-Wunused-variable"
+#pragma GCC diagnostic warning "-Wunused-parameter"
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/mesh/RegionMesh.hpp>
+#include <lifev/core/mesh/RegionMesh3DStructured.hpp>
+#include <lifev/core/mesh/MeshPartitioner.hpp>
+#include <lifev/core/solver/ADRAssembler.hpp>
+#include <lifev/core/algorithm/LinearSolver.hpp>
+#include <lifev/electrophysiology/util/PseudoECG.hpp>
+
+using namespace LifeV;
+
+#define TEST_TOLERANCE      1e-8
+#define SOLVER_TOLERANCE    1e-12
+
+namespace
+{
+
+typedef RegionMesh<LinearTetra>                 mesh_Type;
+typedef boost::shared_ptr<mesh_Type>            meshPtr_Type;
+typedef PseudoECG<mesh_Type>                    pseudoECG_Type;
+typedef pseudoECG_Type::feSpace_Type            feSpace_Type;
+typedef pseudoECG_Type::feSpacePtr_Type         feSpacePtr_Type;
+typedef pseudoECG_Type::matrix_Type             matrix_Type;
+typedef pseudoECG_Type::matrixPtr_Type          matrixPtr_Type;
+typedef pseudoECG_Type::vector_Type             vector_Type;
+typedef boost::shared_ptr<vector_Type>          vectorPtr_Type;
+typedef pseudoECG_Type::position_Type           position_Type;
+typedef pseudoECG_Type::signalContainer_Type    signalContainer_Type;
+
+Real linearPotential ( const Real& /*t*/, const Real& x, const Real& y, const Real& z, const ID& /*i*/ )
+{
+    return 2. * x - y + 0.5 * z;
+}
+
+Real bilinearPotential ( const Real& /*t*/, const Real& x, const Real& y, const Real& z, const ID& /*i*/ )
+{
+    return x * y + z;
+}
+
+Real wavePotential ( const Real& /*t*/, const Real& x, const Real& y, const Real& z, const ID& /*i*/ )
+{
+    return std::exp ( - 10. * ( ( x - 0.3 ) * ( x - 0.3 ) + ( y - 0.6 ) * ( y - 0.6 ) + ( z - 0.5 ) * ( z - 0.5 ) ) );
+}
+
+// Direct formula: x = M^{-1} L u, then phi_e = sum_i x_i / | x_i - x_e | on the unique dofs of the P1 space
+signalContainer_Type directSignals ( const mesh_Type& mesh, const std::vector<position_Type>& electrodes,
+                                     const matrixPtr_Type& stiffnessMatrix, const matrixPtr_Type& massMatrix,
+                                     LinearSolver& solver, const vector_Type& potential )
+{
+    vectorPtr_Type rhs ( new vector_Type ( potential.map(), Unique ) );
+    stiffnessMatrix->multiply ( false, potential, *rhs );
+
+    vectorPtr_Type solution ( new vector_Type ( potential.map(), Unique ) );
+    solver.setOperator ( massMatrix );
+    solver.setRightHandSide ( rhs );
+    solver.solve ( solution );
+
+    signalContainer_Type localSignals ( electrodes.size(), 0. );
+    for ( UInt k (0); k < mesh.numPoints(); ++k )
+    {
+        const UInt dof ( mesh.point ( k ).id() );
+        if ( !solution->isGlobalIDPresent ( dof ) )
+        {
+            continue;
+        }
+        for ( UInt e (0); e < electrodes.size(); ++e )
+        {
+            const Real dx ( mesh.point ( k ).x() - electrodes[e][0] );
+            const Real dy ( mesh.point ( k ).y() - electrodes[e][1] );
+            const Real dz ( mesh.point ( k ).z() - electrodes[e][2] );
+            localSignals[e] += ( *solution ) [dof] / std::sqrt ( dx * dx + dy * dy + dz * dz );
+        }
+    }
+
+    signalContainer_Type signals ( electrodes.size(), 0. );
+    potential.epetraVector().Comm().SumAll ( &localSignals[0], &signals[0], electrodes.size() );
+    return signals;
+}
+
+}
+
+Int main ( Int argc, char** argv )
+{
+    MPI_Init ( &argc, &argv );
+    boost::shared_ptr<Epetra_Comm> Comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+    const bool verbose ( Comm->MyPID() == 0 );
+
+    //********************************************//
+    // Mesh, FE space and matrices                //
+    //********************************************//
+    meshPtr_Type fullMeshPtr ( new mesh_Type ( Comm ) );
+    regularMesh3D ( *fullMeshPtr, 1, 6, 6, 6, false, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0 );
+
+    meshPtr_Type meshPtr;
+    {
+        MeshPartitioner<mesh_Type> meshPart ( fullMeshPtr, Comm );
+        meshPtr = meshPart.meshPartition();
+    }
+    fullMeshPtr.reset();
+
+    feSpacePtr_Type feSpace ( new feSpace_Type ( meshPtr, "P1", 1, Comm ) );
+
+    ADRAssembler<mesh_Type, matrix_Type, vector_Type> adrAssembler;
+    adrAssembler.setup ( feSpace, feSpace );
+    matrixPtr_Type stiffnessMatrix ( new matrix_Type ( feSpace->map() ) );
+    matrixPtr_Type massMatrix ( new matrix_Type ( feSpace->map() ) );
+    adrAssembler.addDiffusion ( stiffnessMatrix, -1.0 );
+    adrAssembler.addMass ( massMatrix, 1.0 );
+    stiffnessMatrix->globalAssemble();
+    massMatrix->globalAssemble();
+
+    Teuchos::ParameterList solverList ( defaultParameterLists::belosParameterList() );
+    solverList.set ( "Silent", true );
+    solverList.sublist ( "Solver: Operator List" ).sublist ( "Trilinos: Belos List" ).set ( "Verbosity", 0 );
+    LinearSolver solver;
+    solver.setCommunicator ( Comm );
+    solver.setParameters ( solverList );
+    solver.setTolerance ( SOLVER_TOLERANCE );
+
+    //********************************************//
+    // Electrodes outside the cube                //
+    //********************************************//
+    std::vector<position_Type> electrodes ( 3 );
+    electrodes[0][0] = 2.0;
+    electrodes[0][1] = 0.5;
+    electrodes[0][2] = 0.5;
+    electrodes[1][0] = -1.0;
+    electrodes[1][1] = -1.0;
+    electrodes[1][2] = 2.0;
+    electrodes[2][0] = 0.5;
+    electrodes[2][1] = 0.5;
+    electrodes[2][2] = -1.5;
+
+    pseudoECG_Type pseudoECG ( feSpace );
+    for ( UInt e (0); e < electrodes.size(); ++e )
+    {
+        pseudoECG.addElectrode ( electrodes[e] );
+    }
+    pseudoECG.setup ( stiffnessMatrix, massMatrix, solver );
+
+    //********************************************//
+    // Comparison for a few potentials            //
+    //********************************************//
+    std::vector<feSpace_Type::function_Type> potentials;
+    potentials.push_back ( &linearPotential );
+    potentials.push_back ( &bilinearPotential );
+    potentials.push_back ( &wavePotential );
+
+    Real error (0.);
+    for ( UInt p (0); p < potentials.size(); ++p )
+    {
+        vector_Type potential ( feSpace->map(), Unique );
+        feSpace->interpolate ( potentials[p], potential, 0. );
+
+        const signalContainer_Type& signals ( pseudoECG.compute ( potential ) );
+        const signalContainer_Type reference ( directSignals ( *meshPtr, electrodes, stiffnessMatrix, massMatrix,
+                                                               solver, potential ) );
+
+        Real referenceNorm (0.);
+        for ( UInt e (0); e < electrodes.size(); ++e )
+        {
+            referenceNorm = std::max ( referenceNorm, std::abs ( reference[e] ) );
+        }
+        for ( UInt e (0); e < electrodes.size(); ++e )
+        {
+            error = std::max ( error, std::abs ( signals[e] - reference[e] ) / referenceNorm );
+            if ( verbose )
+            {
+                std::cout << "Potential " << p << ", electrode " << e << ": lead field " << signals[e]
+                          << ", direct " << reference[e] << std::endl;
+            }
+        }
+    }
+
+    if ( verbose )
+    {
+        std::cout << "Largest relative difference: " << error << std::endl;
+    }
+
+    MPI_Finalize();
+
+    if ( error > TEST_TOLERANCE || pseudoECG.signals().size() != electrodes.size() )
+    {
+        if ( verbose )
+        {
+            std::cout << "\nTest Failed!\n";
+        }
+        return ( EXIT_FAILURE );
+    }
+    return ( EXIT_SUCCESS );
+}
+
+#undef TEST_TOLERANCE
+#undef SOLVER_TOLERANCE
@@ -59,6 +59,13 @@
 
 #include <lifev/electrophysiology/stimulus/StimulusPMJ.hpp>
 #include <lifev/core/LifeV.hpp>
+#include <lifev/core/mesh/RegionMesh3DStructured.hpp>
+#include <lifev/core/mesh/MeshPartitioner.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/bind.hpp>
 
 #include <Teuchos_RCP.hpp>
 #include <Teuchos_ParameterList.hpp>
@@ -70,6 +77,38 @@
 
 using namespace LifeV;
 
+namespace
+{
+
+// Largest difference between the applied current set on the dofs by the footprints
+// of the junctions and the one interpolated from appliedCurrent, at the given times
+Real footprintDifference ( StimulusPMJ& stimulus, const StimulusPMJ::feSpacePtr_Type& feSpace,
+                           const std::vector<Real>& times, Real& maximumCurrent )
+{
+    StimulusPMJ::vector_Type footprintCurrent ( feSpace->map(), Unique );
+    StimulusPMJ::vector_Type interpolatedCurrent ( feSpace->map(), Unique );
+
+    Real difference (0.);
+    maximumCurrent = 0.;
+    for ( UInt n (0); n < times.size(); ++n )
+    {
+        stimulus.setAppliedCurrent ( footprintCurrent, feSpace, times[n] );
+
+        interpolatedCurrent *= 0.;
+        feSpace->interpolate ( boost::bind ( &StimulusPMJ::appliedCurrent, &stimulus, _1, _2, _3, _4, _5 ),
+                               interpolatedCurrent, times[n] );
+
+        maximumCurrent = std::max ( maximumCurrent, interpolatedCurrent.normInf() );
+
+        interpolatedCurrent -= footprintCurrent;
+        difference = std::max ( difference, interpolatedCurrent.normInf() );
+    }
+
+    return difference;
+}
+
+}
+
 Int main ( Int argc, char** argv )
 {
 
@@ -121,8 +160,64 @@ Int main ( Int argc, char** argv )
         std::cerr << "Ending test" << std::endl;
     }
 
+    //*********************************************//
+    // Applied current on a mesh: the footprints of
+    // the junctions against the interpolation
+    //*********************************************//
+    typedef StimulusPMJ::mesh_Type mesh_Type;
+
+    boost::shared_ptr<mesh_Type> fullMeshPtr ( new mesh_Type ( Comm ) );
+    regularMesh3D ( *fullMeshPtr, 1, 10, 10, 10, false,
+                    1.0, 1.0, 1.0,
+                    0.0, 0.0, 0.0 );
+
+    boost::shared_ptr<mesh_Type> meshPtr;
+    {
+        MeshPartitioner<mesh_Type> meshPart ( fullMeshPtr, Comm );
+        meshPtr = meshPart.meshPartition();
+    }
+    fullMeshPtr.reset();
+
+    StimulusPMJ::feSpacePtr_Type feSpace ( new StimulusPMJ::feSpace_Type ( meshPtr, "P1", 1, Comm ) );
+
+    // Overlapping activations, junctions not listed by activation time and one junction out of the mesh
+    StimulusPMJ meshStimulus;
+    meshStimulus.setRadius ( 0.25 );
+    meshStimulus.setTotalCurrent ( 1.0 );
+    meshStimulus.setPMJAddJunction ( 0.7, 0.5, 0.5, 1.0, 2.0 );
+    meshStimulus.setPMJAddJunction ( 0.2, 0.3, 0.4, 0.0, 2.0 );
+    meshStimulus.setPMJAddJunction ( 0.5, 0.8, 0.2, 1.5, 0.3 );
+    meshStimulus.setPMJAddJunction ( 0.9, 0.1, 0.9, 4.0, 1.0 );
+    meshStimulus.setPMJAddJunction ( 3.0, 3.0, 3.0, 0.5, 5.0 );
+
+    // The time goes forward, then back (as when a time step is repeated), then forward again
+    std::vector<Real> times;
+    times.push_back ( 0.5 );
+    times.push_back ( 1.2 );
+    times.push_back ( 1.6 );
+    times.push_back ( 2.5 );
+    times.push_back ( 4.5 );
+    times.push_back ( 1.0 );
+    times.push_back ( 1.7 );
+    times.push_back ( 6.0 );
+
+    Real maximumCurrent (0.);
+    const Real difference ( footprintDifference ( meshStimulus, feSpace, times, maximumCurrent ) );
+
+    if ( Comm->MyPID() == 0 )
+    {
+        std::cout << "Applied current on the mesh, maximum: " << maximumCurrent
+                  << ", difference with the interpolation: " << difference << std::endl;
+    }
+
+    const bool success ( maximumCurrent > 0. && difference <= 1.e-12 * maximumCurrent );
+
     MPI_Barrier (MPI_COMM_WORLD);
     MPI_Finalize();
 
+    if ( !success )
+    {
+        return ( EXIT_FAILURE );
+    }
     return ( EXIT_SUCCESS );
 }
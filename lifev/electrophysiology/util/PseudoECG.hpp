@@ -0,0 +1,305 @@
+//@HEADER
+/*
+ *******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+ *******************************************************************************
+ */
+//@HEADER
+
+/*!
+    @file
+    @brief Pseudo-ECG on a set of electrodes
+
+    @date 10-2026
+
+    This file contains a class computing the pseudo-ECG signals on several
+    electrodes from precomputed lead fields.
+ */
+
+#ifndef PSEUDOECG_H
+#define PSEUDOECG_H 1
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/array/VectorSmall.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+#include <lifev/core/array/MatrixEpetra.hpp>
+#include <lifev/core/array/MapEpetra.hpp>
+#include <lifev/core/fem/FESpace.hpp>
+#include <lifev/core/algorithm/LinearSolver.hpp>
+
+#include <boost/bind.hpp>
+
+namespace LifeV
+{
+
+//! PseudoECG - Pseudo-ECG signals on a set of electrodes
+/*!
+ *  The pseudo-ECG of the electrode \f$e\f$ placed in \f$\mathbf{x}_e\f$ is
+ *  \f[
+ *  \phi_e = \sum_i \frac{ ( M^{-1} L u )_i }{ | \mathbf{x}_i - \mathbf{x}_e | } = w_e^T M^{-1} L u,
+ *  \f]
+ *  where \f$u\f$ is the transmembrane potential, \f$L\f$ the discrete Laplacian (stiffness) matrix,
+ *  \f$M\f$ the mass matrix and \f$w_e\f$ the inverse distance of the dofs from the electrode.
+ *
+ *  The lead field \f$z_e = L^T M^{-1} w_e\f$ (\f$M\f$ is symmetric) depends only on the geometry,
+ *  so it is computed once by \c setup(), with a single solve for all the electrodes.
+ *  Then \c compute() evaluates all the signals \f$\phi_e = z_e^T u\f$ with one pass on the
+ *  potential and one reduction over the processes, without any linear solve.
+ *
+ *  The electrodes must lie outside the domain (or at least not on a dof).
+ */
+template <typename Mesh>
+class PseudoECG
+{
+public:
+
+    //! @name Type definitions
+    //@{
+
+    typedef Mesh                                        mesh_Type;
+    typedef FESpace<mesh_Type, MapEpetra>               feSpace_Type;
+    typedef boost::shared_ptr<feSpace_Type>             feSpacePtr_Type;
+
+    typedef VectorEpetra                                vector_Type;
+    typedef MatrixEpetra<Real>                          matrix_Type;
+    typedef boost::shared_ptr<matrix_Type>              matrixPtr_Type;
+    typedef LinearSolver                                linearSolver_Type;
+    typedef Epetra_MultiVector                          multiVector_Type;
+
+    typedef VectorSmall<3>                              position_Type;
+    typedef std::vector<position_Type>                  positionContainer_Type;
+    typedef std::vector<Real>                           signalContainer_Type;
+
+    //@}
+
+
+    //! @name Constructors & Destructor
+    //@{
+
+    //! Constructor
+    /*!
+     * @param feSpace FE space of the potential
+     */
+    explicit PseudoECG ( const feSpacePtr_Type& feSpace ) :
+        M_feSpace                   ( feSpace ),
+        M_electrodes                (),
+        M_leadFields                (),
+        M_numberOfLocalDofs         ( 0 ),
+        M_localSignals              (),
+        M_signals                   ()
+    {}
+
+    //! Destructor
+    virtual ~PseudoECG() {}
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! Add an electrode
+    /*!
+     * The lead fields must be computed again with \c setup().
+     * @param position coordinates of the electrode
+     */
+    void addElectrode ( const position_Type& position )
+    {
+        M_electrodes.push_back ( position );
+        M_leadFields.clear();
+    }
+
+    //! Compute the lead fields of all the electrodes
+    /*!
+     * @param stiffnessMatrix discrete Laplacian matrix \f$L\f$
+     * @param massMatrix mass matrix \f$M\f$
+     * @param solver linear solver (with its parameters and preconditioner already set) used for \f$M\f$
+     */
+    void setup ( const matrixPtr_Type& stiffnessMatrix, const matrixPtr_Type& massMatrix, linearSolver_Type& solver );
+
+    //! Compute the signals of all the electrodes
+    /*!
+     * @param potential transmembrane potential (on the unique map)
+     * @return the signals, one for each electrode, on all the processes
+     */
+    const signalContainer_Type& compute ( const vector_Type& potential );
+
+    //! Display general information about the content of the class
+    /*!
+     * @param output specify the output format (std::cout by default)
+     */
+    void showMe ( std::ostream& output = std::cout ) const;
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! Get the number of electrodes
+    UInt numberOfElectrodes() const
+    {
+        return M_electrodes.size();
+    }
+
+    //! Get the positions of the electrodes
+    const positionContainer_Type& electrodes() const
+    {
+        return M_electrodes;
+    }
+
+    //! Get the signals computed by the last call of \c compute()
+    const signalContainer_Type& signals() const
+    {
+        return M_signals;
+    }
+
+    //@}
+
+private:
+
+    //! @name Private Methods
+    //@{
+
+    //! No empty constructor
+    PseudoECG();
+
+    //! No copy constructor
+    PseudoECG ( const PseudoECG& );
+
+    //! Inverse of the distance from the electrode
+    static Real inverseDistance ( const Real& /*t*/, const Real& x, const Real& y, const Real& z, const ID& /*i*/,
+                                  const position_Type& position )
+    {
+        return 1. / std::sqrt ( ( x - position[0] ) * ( x - position[0] )
+                                + ( y - position[1] ) * ( y - position[1] )
+                                + ( z - position[2] ) * ( z - position[2] ) );
+    }
+
+    //@}
+
+    feSpacePtr_Type                     M_feSpace;
+    positionContainer_Type              M_electrodes;
+
+    //! Local rows of the lead fields, stored dof by dof: M_leadFields[i * numberOfElectrodes + e]
+    std::vector<Real>                   M_leadFields;
+    UInt                                M_numberOfLocalDofs;
+
+    signalContainer_Type                M_localSignals;
+    signalContainer_Type                M_signals;
+};
+
+// ===================================================
+// Methods
+// ===================================================
+
+template <typename Mesh>
+void
+PseudoECG<Mesh>::setup ( const matrixPtr_Type& stiffnessMatrix, const matrixPtr_Type& massMatrix, linearSolver_Type& solver )
+{
+    const UInt numberOfElectrodes ( M_electrodes.size() );
+    ASSERT ( numberOfElectrodes > 0, "PseudoECG::setup: no electrode" );
+
+    const Epetra_Map& map ( *M_feSpace->map().map ( Unique ) );
+
+    // Inverse distances of the dofs from the electrodes, one column for each electrode
+    multiVector_Type weights ( map, numberOfElectrodes );
+    for ( UInt e (0); e < numberOfElectrodes; ++e )
+    {
+        vector_Type weight ( M_feSpace->map(), Unique );
+        M_feSpace->interpolate ( boost::bind ( &PseudoECG<Mesh>::inverseDistance, _1, _2, _3, _4, _5, M_electrodes[e] ),
+                                 weight, 0. );
+        weights ( e )->Update ( 1., weight.epetraVector(), 0. );
+    }
+
+    // z_e = L^T M^{-1} w_e: one solve with all the electrodes as right hand sides
+    multiVector_Type massInverseWeights ( map, numberOfElectrodes );
+    solver.setOperator ( massMatrix );
+    solver.solve ( weights, massInverseWeights );
+
+    multiVector_Type leadFields ( map, numberOfElectrodes );
+    stiffnessMatrix->matrixPtr()->Multiply ( true, massInverseWeights, leadFields );
+
+    // Store the local rows contiguously, for the product with the potential
+    M_numberOfLocalDofs = leadFields.MyLength();
+    M_leadFields.resize ( M_numberOfLocalDofs * numberOfElectrodes );
+    for ( UInt e (0); e < numberOfElectrodes; ++e )
+    {
+        const Real* leadField ( leadFields[e] );
+        for ( UInt i (0); i < M_numberOfLocalDofs; ++i )
+        {
+            M_leadFields[i * numberOfElectrodes + e] = leadField[i];
+        }
+    }
+
+    M_localSignals.assign ( numberOfElectrodes, 0. );
+    M_signals.assign ( numberOfElectrodes, 0. );
+}
+
+template <typename Mesh>
+const typename PseudoECG<Mesh>::signalContainer_Type&
+PseudoECG<Mesh>::compute ( const vector_Type& potential )
+{
+    ASSERT ( !M_leadFields.empty(), "PseudoECG::compute: the lead fields are not computed, call setup() first" );
+    ASSERT ( potential.mapType() == Unique, "PseudoECG::compute: the potential must be on the unique map" );
+    ASSERT ( static_cast<UInt> ( potential.epetraVector().MyLength() ) == M_numberOfLocalDofs,
+             "PseudoECG::compute: the potential is not on the map of the lead fields" );
+
+    const UInt numberOfElectrodes ( M_electrodes.size() );
+    const Real* values ( potential.epetraVector() [0] );
+
+    std::fill ( M_localSignals.begin(), M_localSignals.end(), 0. );
+    for ( UInt i (0); i < M_numberOfLocalDofs; ++i )
+    {
+        const Real  value ( values[i] );
+        const Real* leadField ( &M_leadFields[i * numberOfElectrodes] );
+        for ( UInt e (0); e < numberOfElectrodes; ++e )
+        {
+            M_localSignals[e] += leadField[e] * value;
+        }
+    }
+
+    potential.epetraVector().Comm().SumAll ( &M_localSignals[0], &M_signals[0], numberOfElectrodes );
+
+    return M_signals;
+}
+
+template <typename Mesh>
+void
+PseudoECG<Mesh>::showMe ( std::ostream& output ) const
+{
+    output << "PseudoECG" << std::endl;
+    output << "  number of electrodes: " << M_electrodes.size() << std::endl;
+    for ( UInt e (0); e < M_electrodes.size(); ++e )
+    {
+        output << "  electrode " << e << ": ("
+               << M_electrodes[e][0] << ", " << M_electrodes[e][1] << ", " << M_electrodes[e][2] << ")" << std::endl;
+    }
+    output << "  lead fields computed: " << ( M_leadFields.empty() ? "no" : "yes" ) << std::endl;
+}
+
+} // namespace LifeV
+
+#endif // PSEUDOECG_H
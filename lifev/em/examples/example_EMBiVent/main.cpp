@@ -325,6 +325,7 @@ int main (int argc, char** argv)
     
     // Flow rate between two vertices
     auto Q = [&circulationSolver] (const std::string& N1, const std::string& N2) { return circulationSolver.solution ( std::vector<std::string> {N1, N2} ); };
+    auto QPert = [&circulationSolver] (const std::vector<double>& u, const std::string& N1, const std::string& N2) { return circulationSolver.solution ( std::vector<std::string> {N1, N2}, u ); };
     auto p = [&circulationSolver] (const std::string& N1) { return circulationSolver.solution ( N1 ); };
     
     
@@ -753,21 +754,17 @@ int main (int argc, char** argv)
                 // Jacobian circulation
                 //============================================//
                 
-                // Left ventricle
-                circulationSolver.iterate(dt_circulation, bcNames, perturbedPressureComp(bcValues, pPerturbationCirc, 0), iter);
-                VCircPert[0] = VCirc[0] + dt_circulation * ( Q("la", "lv") - Q("lv", "sa") );
-                VCircPert[1] = VCirc[1] + dt_circulation * ( Q("ra", "rv") - Q("rv", "pa") );
+                // Both ventricles at once
+                const auto uCircPert = circulationSolver.iterateBatch(dt_circulation, bcNames, circulationSolver.coupling().perturbedValues(bcValues, {pPerturbationCirc, pPerturbationCirc}), iter);
 
-                JCirc(0,0) = ( VCircPert[0] - VCircNew[0] ) / pPerturbationCirc;
-                JCirc(1,0) = ( VCircPert[1] - VCircNew[1] ) / pPerturbationCirc;
-                
-                // Right ventricle
-                circulationSolver.iterate(dt_circulation, bcNames, perturbedPressureComp(bcValues, pPerturbationCirc, 1), iter);
-                VCircPert[0] = VCirc[0] + dt_circulation * ( Q("la", "lv") - Q("lv", "sa") );
-                VCircPert[1] = VCirc[1] + dt_circulation * ( Q("ra", "rv") - Q("rv", "pa") );
-                
-                JCirc(0,1) = ( VCircPert[0] - VCircNew[0] ) / pPerturbationCirc;
-                JCirc(1,1) = ( VCircPert[1] - VCircNew[1] ) / pPerturbationCirc;
+                for ( unsigned int j (0) ; j < uCircPert.size() ; ++j )
+                {
+                    VCircPert[0] = VCirc[0] + dt_circulation * ( QPert(uCircPert[j], "la", "lv") - QPert(uCircPert[j], "lv", "sa") );
+                    VCircPert[1] = VCirc[1] + dt_circulation * ( QPert(uCircPert[j], "ra", "rv") - QPert(uCircPert[j], "rv", "pa") );
+
+                    JCirc(0,j) = ( VCircPert[0] - VCircNew[0] ) / pPerturbationCirc;
+                    JCirc(1,j) = ( VCircPert[1] - VCircNew[1] ) / pPerturbationCirc;
+                }
                 
                 //============================================//
                 // Jacobian fe
@@ -340,6 +340,7 @@ int main (int argc, char** argv)
     
     // Flow rate between two vertices
     auto Q = [] (Circulation& c, const std::string& N1, const std::string& N2) { return c.solution ( std::vector<std::string> {N1, N2} ); };
+    auto QPert = [] (Circulation& c, const std::vector<double>& u, const std::string& N1, const std::string& N2) { return c.solution ( std::vector<std::string> {N1, N2}, u ); };
     auto p = [] (Circulation& c, const std::string& N1) { return c.solution ( N1 ); };
 
     //============================================//
@@ -522,8 +523,8 @@ int main (int argc, char** argv)
                     //============================================//
                     std::vector<double> bcValuesPert { bcValues.at(0) * (1.0 + dpFactor) , bcValues.at(1) };
                     std::vector<double> VCircPert (1);
-                    circulationSolver.iterate(dt_mechanics/1000, bcNames, bcValuesPert, iter);
-                    VCircPert.at(0) = VCirc.at(0) + dt_mechanics/1000 * ( Q(circulationSolver, "la", "lv") - Q(circulationSolver, "lv", "sa") );
+                    const auto uCircPert = circulationSolver.iterateBatch(dt_mechanics/1000, bcNames, { bcValuesPert }, iter);
+                    VCircPert.at(0) = VCirc.at(0) + dt_mechanics/1000 * ( QPert(circulationSolver, uCircPert[0], "la", "lv") - QPert(circulationSolver, uCircPert[0], "lv", "sa") );
 
                     const double Jcirc = ( VCircPert.at(0) - VCircNew.at(0) ) / ( bcValues.at(0) * dpFactor );
                     
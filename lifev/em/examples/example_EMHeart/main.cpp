@@ -129,6 +129,7 @@ int main (int argc, char** argv)
     
     // Flow rate between two vertices
     auto Q = [&circulationSolver] (const std::string& N1, const std::string& N2) { return circulationSolver.solution ( std::vector<std::string> {N1, N2} ); };
+    auto QPert = [&circulationSolver] (const std::vector<double>& u, const std::string& N1, const std::string& N2) { return circulationSolver.solution ( std::vector<std::string> {N1, N2}, u ); };
     auto p = [&circulationSolver] (const std::string& N1) { return circulationSolver.solution ( N1 ); };
     
     
@@ -364,6 +365,7 @@ int main (int argc, char** argv)
     const Real couplingError = dataFile ( "solid/coupling/couplingError", 1e-6 );
     const UInt couplingJFeSubIter = dataFile ( "solid/coupling/couplingJFeSubIter", 1 );
     const UInt couplingJFeSubStart = dataFile ( "solid/coupling/couplingJFeSubStart", 1 );
+    const bool couplingJFeAnalytic = dataFile ( "solid/coupling/couplingJFeAnalytic", false );
     
     const Real dpMax = dataFile ( "solid/coupling/dpMax", 0.1 );
     
@@ -758,21 +760,17 @@ int main (int argc, char** argv)
                 // Jacobian circulation
                 //============================================
 
-                // Left ventricle
-                circulationSolver.iterate(dt_circulation, bcNames, perturbedPressureComp(bcValues, pPerturbationCirc, 0), iter);
-                VCircPert[0] = VCirc[0] + dt_circulation * ( Q("la", "lv") - Q("lv", "sa") );
-                VCircPert[1] = VCirc[1] + dt_circulation * ( Q("ra", "rv") - Q("rv", "pa") );
+                // Both ventricles at once
+                const auto uCircPert = circulationSolver.iterateBatch(dt_circulation, bcNames, circulationSolver.coupling().perturbedValues(bcValues, {pPerturbationCirc, pPerturbationCirc}), iter);
 
-                JCirc(0,0) = ( VCircPert[0] - VCircNew[0] ) / pPerturbationCirc;
-                JCirc(1,0) = ( VCircPert[1] - VCircNew[1] ) / pPerturbationCirc;
-
-                // Right ventricle
-                circulationSolver.iterate(dt_circulation, bcNames, perturbedPressureComp(bcValues, pPerturbationCirc, 1), iter);
-                VCircPert[0] = VCirc[0] + dt_circulation * ( Q("la", "lv") - Q("lv", "sa") );
-                VCircPert[1] = VCirc[1] + dt_circulation * ( Q("ra", "rv") - Q("rv", "pa") );
+                for ( unsigned int j (0) ; j < uCircPert.size() ; ++j )
+                {
+                    VCircPert[0] = VCirc[0] + dt_circulation * ( QPert(uCircPert[j], "la", "lv") - QPert(uCircPert[j], "lv", "sa") );
+                    VCircPert[1] = VCirc[1] + dt_circulation * ( QPert(uCircPert[j], "ra", "rv") - QPert(uCircPert[j], "rv", "pa") );
 
-                JCirc(0,1) = ( VCircPert[0] - VCircNew[0] ) / pPerturbationCirc;
-                JCirc(1,1) = ( VCircPert[1] - VCircNew[1] ) / pPerturbationCirc;
+                    JCirc(0,j) = ( VCircPert[0] - VCircNew[0] ) / pPerturbationCirc;
+                    JCirc(1,j) = ( VCircPert[1] - VCircNew[1] ) / pPerturbationCirc;
+                }
 
 
                 //============================================
@@ -782,7 +780,23 @@ int main (int argc, char** argv)
                 const bool jacobianFeSubIter ( ! ( (iter - couplingJFeSubStart) % couplingJFeSubIter) && iter >= couplingJFeSubStart );
                 const bool jacobianFeEmpty ( JFe.norm() == 0 );
 
-                if ( jacobianFeSubIter || jacobianFeEmpty )
+                if ( ( jacobianFeSubIter || jacobianFeEmpty ) && couplingJFeAnalytic )
+                {
+                    // dV/dp from the tangent of the mechanics: one solve for both ventricles
+                    std::vector<vectorPtr_Type> volumeGradients { vectorPtr_Type ( new vector_Type ( disp.map() ) ),
+                                                                  vectorPtr_Type ( new vector_Type ( disp.map() ) ) };
+                    LV.volumeGradient(disp, dETFESpace, volumeGradients[0]);
+                    RV.volumeGradient(disp, dETFESpace, volumeGradients[1]);
+
+                    // The pressure is applied on the reference configuration (see modifyPressureBC)
+                    auto dVdp = solver.structuralOperatorPtr() -> volumePressureSensitivity(volumeGradients, { LVFlags, RVFlags }, false);
+
+                    JFe(0,0) = dVdp[0][0] mmHg;
+                    JFe(1,0) = dVdp[1][0] mmHg;
+                    JFe(0,1) = dVdp[0][1] mmHg;
+                    JFe(1,1) = dVdp[1][1] mmHg;
+                }
+                else if ( jacobianFeSubIter || jacobianFeEmpty )
                 {
                     JFe *= 0.0;
                     dispCurrent = disp;
@@ -370,6 +370,7 @@ int main (int argc, char** argv)
     
     // Flow rate between two vertices
     auto Q = [&circulationSolver] (const std::string& N1, const std::string& N2) { return circulationSolver.solution ( std::vector<std::string> {N1, N2} ); };
+    auto QPert = [&circulationSolver] (const std::vector<double>& u, const std::string& N1, const std::string& N2) { return circulationSolver.solution ( std::vector<std::string> {N1, N2}, u ); };
     auto p = [&circulationSolver] (const std::string& N1) { return circulationSolver.solution ( N1 ); };
     
     
@@ -723,8 +724,8 @@ int main (int argc, char** argv)
                 //============================================//
                 
                 // Left ventricle
-                circulationSolver.iterate(dt_circulation, bcNames, perturbedPressureComp(bcValues, pPerturbationCirc, 0), iter);
-                VCircPert[0] = VCirc[0] + dt_circulation * ( Q("la", "lv") - Q("lv", "sa") );
+                const auto uCircPert = circulationSolver.iterateBatch(dt_circulation, bcNames, { perturbedPressureComp(bcValues, pPerturbationCirc, 0) }, iter);
+                VCircPert[0] = VCirc[0] + dt_circulation * ( QPert(uCircPert[0], "la", "lv") - QPert(uCircPert[0], "lv", "sa") );
                 JCirc(0,0) = ( VCircPert[0] - VCircNew[0] ) / pPerturbationCirc;
 
                 //============================================//
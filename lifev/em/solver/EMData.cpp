@@ -26,6 +26,9 @@ EMData::setupSolidParameters(GetPot& dataFile, const std::string& section)
     std::string EMpassiveMaterialType = dataFile ( ( section + "/physics/EMPassiveMaterialType" ).data(), "NO_DEFAULT_PASSIVE_TYPE" );
     M_solidParametersList.set ("EMPassiveMaterialType", EMpassiveMaterialType);
 
+    bool fusedAssembly = dataFile ( ( section + "/physics/FusedAssembly" ).data(), false );
+    M_solidParametersList.set ("FusedAssembly", fusedAssembly);
+
     double bulkModulus = dataFile ( ( section + "/physics/BulkModulus" ).data(), 35000.0 );
     M_solidParametersList.set ("BulkModulus", bulkModulus);
 
@@ -116,6 +116,10 @@ public:
 
     typedef boost::shared_ptr<solidETFESpace_Type>              solidETFESpacePtr_Type;
 
+    typedef GradientRecovery::ZZRecovery<solidFESpace_Type, VectorEpetra> gradientRecovery_Type;
+
+    typedef boost::shared_ptr<gradientRecovery_Type>            gradientRecoveryPtr_Type;
+
     typedef boost::function < Real (const Real& t,
                                     const Real&    x,
                                     const Real&    y,
@@ -426,6 +430,9 @@ public:
     void computeI4f (VectorEpetra& i4f, VectorEpetra& f0_, VectorEpetra& disp, solidFESpacePtr_Type feSpacePtr);
 
     void computeDeformedFiberDirection (VectorEpetra& f, VectorEpetra& f0_, VectorEpetra& disp, solidFESpacePtr_Type feSpacePtr);
+
+    //! Gradient recovery on the given space: the patch weights are computed at the first call only
+    gradientRecovery_Type& gradientRecovery (solidFESpacePtr_Type feSpacePtr);
     
     vectorPtr_Type getElectroFibers()
     {
@@ -505,6 +512,8 @@ public:
     vectorPtr_Type                       M_activationTimePtr;
 
     bool                                 M_oneWayCoupling;
+
+    gradientRecoveryPtr_Type             M_gradientRecoveryPtr;
     
     WallTensionEstimator<RegionMesh<LinearTetra> > M_wteTotal;
 //    WallTensionEstimator<RegionMesh<LinearTetra> > M_wtePassive;
@@ -533,6 +542,7 @@ EMSolver<Mesh, ElectroSolver>::EMSolver(commPtr_Type comm) :
     M_fullMeshPtr      ( ),
     M_activationTimePtr     ( ),
     M_oneWayCoupling     (true),
+    M_gradientRecoveryPtr ( ),
     M_wteTotal ( ),
 //    M_wtePassive ( ),
 //    M_wteActive ( ),
@@ -557,6 +567,7 @@ EMSolver<Mesh, ElectroSolver>::EMSolver (const EMSolver& solver) :
     M_fullMeshPtr      ( solver.M_fullMeshPtr),
     M_activationTimePtr     ( solver.M_activationTimePtr),
     M_oneWayCoupling     ( solver.M_oneWayCoupling),
+    M_gradientRecoveryPtr ( solver.M_gradientRecoveryPtr),
     M_wteTotal                   (solver.M_wteTotal),
 //    M_wtePassive                   (solver.M_wtePassive),
 //    M_wteActive                   (solver.M_wteActive),
@@ -1009,42 +1020,37 @@ template<typename Mesh , typename ElectroSolver>
 void
 EMSolver<Mesh, ElectroSolver>::computeI4f (VectorEpetra& i4f, VectorEpetra& f0_, VectorEpetra& disp, solidFESpacePtr_Type feSpacePtr)
 {
-    VectorEpetra dUdx (disp);
-    VectorEpetra dUdy (disp);
-    VectorEpetra dUdz (disp);
-    
-    dUdx = GradientRecovery::ZZGradient (feSpacePtr, disp, 0);
-    dUdy = GradientRecovery::ZZGradient (feSpacePtr, disp, 1);
-    dUdz = GradientRecovery::ZZGradient (feSpacePtr, disp, 2);
-    
+    // Gradient in the three directions, from a single traversal of the mesh
+    std::vector<VectorEpetra> gradient;
+    gradientRecovery (feSpacePtr).gradient (disp, gradient);
+
     int n = i4f.epetraVector().MyLength();
-    int i (0); int j (0); int k (0);
     MatrixSmall<3,3> F; VectorSmall<3> f0;
-    
+
+    VectorEpetra::localView_Type i4fView = i4f.localView();
+    std::vector<VectorEpetra::constLocalView_Type> dU (3);
+    std::vector<VectorEpetra::constLocalView_Type> f0View (3);
+    for (UInt iComp (0); iComp < 3; ++iComp)
+    {
+        dU[iComp] = gradient[iComp].localView();
+        f0View[iComp] = f0_.componentView (iComp, 3);
+    }
+
     for (int p (0); p < n; p++)
     {
-        i = dUdx.blockMap().GID (p);
-        j = dUdx.blockMap().GID (p + n);
-        k = dUdx.blockMap().GID (p + 2 * n);
-        
-        F(0,0) = 1.0 + dUdx[i];
-        F(0,1) =       dUdy[i];
-        F(0,2) =       dUdz[i];
-        F(1,0) =       dUdx[j];
-        F(1,1) = 1.0 + dUdy[j];
-        F(1,2) =       dUdz[j];
-        F(2,0) =       dUdx[k];
-        F(2,1) =       dUdy[k];
-        F(2,2) = 1.0 + dUdz[k];
-        
-        f0(0) = f0_[i];
-        f0(1) = f0_[j];
-        f0(2) = f0_[k];
-        
+        for (UInt iComp (0); iComp < 3; ++iComp)
+        {
+            for (UInt jComp (0); jComp < 3; ++jComp)
+            {
+                F(iComp,jComp) = ( iComp == jComp ? 1.0 : 0.0 ) + dU[jComp][p + iComp * n];
+            }
+            f0(iComp) = f0View[iComp][p];
+        }
+
         f0.normalize();
         
         auto f = F * f0;
-        i4f[i] = f.dot(f);
+        i4fView[p] = f.dot(f);
     }
 }
 
@@ -1053,48 +1059,56 @@ template<typename Mesh , typename ElectroSolver>
 void
 EMSolver<Mesh, ElectroSolver>::computeDeformedFiberDirection (VectorEpetra& f_, VectorEpetra& f0_, VectorEpetra& disp, solidFESpacePtr_Type feSpacePtr)
 {
-    VectorEpetra dUdx (disp);
-    VectorEpetra dUdy (disp);
-    VectorEpetra dUdz (disp);
-    
-    dUdx = GradientRecovery::ZZGradient (feSpacePtr, disp, 0);
-    dUdy = GradientRecovery::ZZGradient (feSpacePtr, disp, 1);
-    dUdz = GradientRecovery::ZZGradient (feSpacePtr, disp, 2);
-    
+    // Gradient in the three directions, from a single traversal of the mesh
+    std::vector<VectorEpetra> gradient;
+    gradientRecovery (feSpacePtr).gradient (disp, gradient);
+
     int n = f_.epetraVector().MyLength() / 3;
-    int i (0); int j (0); int k (0);
     MatrixSmall<3,3> F; VectorSmall<3> f0;
-    
+
+    std::vector<VectorEpetra::localView_Type> fView (3);
+    std::vector<VectorEpetra::constLocalView_Type> dU (3);
+    std::vector<VectorEpetra::constLocalView_Type> f0View (3);
+    for (UInt iComp (0); iComp < 3; ++iComp)
+    {
+        dU[iComp] = gradient[iComp].localView();
+        fView[iComp] = f_.componentView (iComp, 3);
+        f0View[iComp] = f0_.componentView (iComp, 3);
+    }
+
     for (int p (0); p < n; p++)
     {
-        i = dUdx.blockMap().GID (p);
-        j = dUdx.blockMap().GID (p + n);
-        k = dUdx.blockMap().GID (p + 2 * n);
-        
-        F(0,0) = 1.0 + dUdx[i];
-        F(0,1) =       dUdy[i];
-        F(0,2) =       dUdz[i];
-        F(1,0) =       dUdx[j];
-        F(1,1) = 1.0 + dUdy[j];
-        F(1,2) =       dUdz[j];
-        F(2,0) =       dUdx[k];
-        F(2,1) =       dUdy[k];
-        F(2,2) = 1.0 + dUdz[k];
-        
-        f0(0) = f0_[i];
-        f0(1) = f0_[j];
-        f0(2) = f0_[k];
-        
+        for (UInt iComp (0); iComp < 3; ++iComp)
+        {
+            for (UInt jComp (0); jComp < 3; ++jComp)
+            {
+                F(iComp,jComp) = ( iComp == jComp ? 1.0 : 0.0 ) + dU[jComp][p + iComp * n];
+            }
+            f0(iComp) = f0View[iComp][p];
+        }
+
         f0.normalize();
         
         auto f = F * f0;
-        f_[i] = f(0);
-        f_[j] = f(1);
-        f_[k] = f(2);
+        for (UInt iComp (0); iComp < 3; ++iComp)
+        {
+            fView[iComp][p] = f(iComp);
+        }
     }
 }
 
 
+template<typename Mesh , typename ElectroSolver>
+typename EMSolver<Mesh, ElectroSolver>::gradientRecovery_Type&
+EMSolver<Mesh, ElectroSolver>::gradientRecovery (solidFESpacePtr_Type feSpacePtr)
+{
+    if ( !M_gradientRecoveryPtr || M_gradientRecoveryPtr->fespacePtr() != feSpacePtr )
+    {
+        M_gradientRecoveryPtr.reset ( new gradientRecovery_Type (feSpacePtr) );
+    }
+    return *M_gradientRecoveryPtr;
+}
+
 } // namespace LifeV
 
 
@@ -14,10 +14,12 @@
 #include <fstream>
 #include <Eigen/Dense>
 #include <Eigen/LU>
+#include <Eigen/Sparse>
 #include <Eigen/Eigenvalues>
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <memory>
 
 #include "CirculationIO.hpp"
 #include "CirculationGridView.hpp"
@@ -35,17 +37,22 @@ public:
     typedef std::vector<std::string> VectorStdString;
     typedef std::vector<VectorStdString> MatrixStdString;
     typedef std::vector<double> VectorStdDouble;
+    typedef std::vector<VectorStdDouble> MatrixStdDouble;
     typedef Eigen::MatrixXd MatrixEigen;
     typedef Eigen::VectorXd VectorEigen;
+    typedef Eigen::SparseMatrix<double> SparseMatrixEigen;
     
-    Circulation(){}
+    Circulation() :
+        M_timeIntegrator ( new ImplicitTimeIntegrator )
+    {}
 
     //Circulation(const Circulation&) = delete;
 
     virtual ~Circulation(){}
     
     Circulation(const std::string& filename) :
-        M_time ( 0.0 )
+        M_time ( 0.0 ),
+        M_timeIntegrator ( new ImplicitTimeIntegrator )
     {
         // Read Grid and initial conditions
         readGrid( filename );
@@ -86,8 +93,8 @@ public:
 
         // assemble mass- & stiffness matrix and source vector
         CirculationAssembler ca;
-        auto A = ca.assembleStiffnessMatrix(M_gv, M_time, M_u);
-        auto M = ca.assembleMassMatrix(M_gv, M_time, M_u);
+        auto A = ca.assembleStiffnessMatrixSparse(M_gv, M_time, M_u);
+        auto M = ca.assembleMassMatrixSparse(M_gv, M_time, M_u);
         auto f = ca.assembleSourceVector(M_gv, M_time, M_u);
         
 //        Eigen::GeneralizedEigenSolver<Eigen::MatrixXd> eigV;
@@ -98,19 +105,121 @@ public:
         DofHandler dofh(M_gv);
         CirculationBCHandler bcHandler(dofh, bcNames, bcValues);
 
-        // time integration
-        ImplicitTimeIntegrator timeIntegrator;
-        auto K = timeIntegrator.assembleOperator(dt, M, A, f);
-        auto rhs = timeIntegrator.assembleRhs(dt, M, A, f, M_uPrev0);
-        M_u = timeIntegrator.solve(K, rhs, bcHandler);
+        // time integration (the factorization is reused as long as the operator does not change)
+        SparseMatrixEigen K = M_timeIntegrator->assembleOperator(dt, M, A, f);
+        VectorEigen rhs = M_timeIntegrator->assembleRhs(dt, M, A, f, M_uPrev0);
+        M_u = M_timeIntegrator->solve(K, rhs, bcHandler);
 
         // Plot linear sytem
-        if ( plotSystem ) plotLinSys(K, M_u, rhs);
+        if ( plotSystem ) plotLinSys(MatrixEigen(K), M_u, rhs);
 
         // Plot relative error
         if ( plotError ) plotErrorNorm(K, M_u, rhs);
     }
     
+    // Fixed point iterations of iterate() for several sets of b.c. values at once (e.g. the
+    // perturbed pressures of a finite difference jacobian). All the sets start from the current
+    // solution, which is not modified, and stop with the same criteria as iterate(). At each sweep
+    // the sets whose operator (with b.c.) is the same share one factorization and one multi-column
+    // solve. The b.c. names must be the same for all the sets. Read the returned solutions with
+    // solution(bc, u).
+    MatrixStdDouble iterateBatch(const double& dt, const MatrixStdString& bcNames, const MatrixStdDouble& bcValuesSet, const unsigned int& iter = 0, const double& error = 1e-6)
+    {
+        int rank;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        
+        DofHandler dofh(M_gv);
+        const unsigned int nSets ( bcValuesSet.size() );
+        MatrixEigen u ( dofh.size() , nSets );
+        
+        if ( rank == 0 && nSets > 0 )
+        {
+            // Update time variable and solution vectors of previous timesteps
+            if ( iter == 0 )
+            {
+                updateTimeVar(dt);
+                updatePrevSolVectors();
+            }
+            
+            for ( unsigned int i (0) ; i < nSets ; ++i ) u.col(i) = M_u;
+            
+            std::cout << "\n\n=============================================================\n";
+            std::cout << "Compute circulation (" << nSets << " b.c. sets)\n";
+            
+            CirculationAssembler ca;
+            std::vector<bool> converged ( nSets, false );
+            unsigned int subiter (0);
+            
+            while ( std::find( converged.begin(), converged.end(), false ) != converged.end() )
+            {
+                // Operator and rhs of each set, assembled around its own state
+                std::vector<unsigned int> active;
+                std::vector<SparseMatrixEigen> K;
+                std::vector<VectorEigen> rhs;
+                
+                for ( unsigned int i (0) ; i < nSets ; ++i )
+                {
+                    if ( converged[i] ) continue;
+                    
+                    VectorEigen ui ( u.col(i) );
+                    auto A = ca.assembleStiffnessMatrixSparse(M_gv, M_time, ui);
+                    auto M = ca.assembleMassMatrixSparse(M_gv, M_time, ui);
+                    auto f = ca.assembleSourceVector(M_gv, M_time, ui);
+                    
+                    K.push_back( M_timeIntegrator->assembleOperator(dt, M, A, f) );
+                    rhs.push_back( M_timeIntegrator->assembleRhs(dt, M, A, f, M_uPrev0) );
+                    CirculationBCHandler(dofh, bcNames, bcValuesSet[i]).addBC(K.back(), rhs.back());
+                    K.back().makeCompressed();
+                    active.push_back(i);
+                }
+                
+                // Group the sets with the same operator
+                std::vector<std::vector<unsigned int> > groups;
+                for ( unsigned int k (0) ; k < active.size() ; ++k )
+                {
+                    unsigned int g (0);
+                    while ( g < groups.size() && ! sameOperator( K[ groups[g][0] ], K[k] ) ) ++g;
+                    if ( g == groups.size() ) groups.push_back( std::vector<unsigned int> (0) );
+                    groups[g].push_back(k);
+                }
+                
+                // One factorization and one multi-column solve per group
+                double residuumMax (0);
+                for ( auto& group : groups )
+                {
+                    MatrixEigen rhsBatch ( dofh.size() , group.size() );
+                    for ( unsigned int j (0) ; j < group.size() ; ++j ) rhsBatch.col(j) = rhs[ group[j] ];
+                    
+                    const MatrixEigen uBatch = M_timeIntegrator->solve(K[ group[0] ], rhsBatch);
+                    
+                    for ( unsigned int j (0) ; j < group.size() ; ++j )
+                    {
+                        const unsigned int i ( active[ group[j] ] );
+                        const double residuum ( ( uBatch.col(j) - u.col(i) ).norm() );
+                        u.col(i) = uBatch.col(j);
+                        converged[i] = ( residuum <= error || subiter >= 200 );
+                        residuumMax = std::max( residuumMax, residuum );
+                    }
+                }
+                
+                std::cout << "t = " << M_time << "\titer = " << subiter << "\tsets = " << active.size() << "\tfactorizations = " << groups.size() << "\tmax L2-Norm = " << residuumMax << std::endl;
+                ++subiter;
+            }
+            
+            // The elements keep internal variables of the last assembled state: bring them back to the current solution
+            ca.assembleStiffnessMatrixSparse(M_gv, M_time, M_u);
+            
+            std::cout << "=============================================================\n\n";
+        }
+        
+        MPI_Barrier(MPI_COMM_WORLD);
+        MPI_Bcast(u.data(), u.size(), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+        
+        MatrixStdDouble solutions ( nSets );
+        for ( unsigned int i (0) ; i < nSets ; ++i ) solutions[i] = eigenToStd( u.col(i) );
+        return solutions;
+    }
+    
     void iterate(const double& dt, const MatrixStdString& bcNames = MatrixStdString(0), const VectorStdDouble& bcValues = VectorStdDouble(0), const unsigned int& iter = 0, const bool plotError = false, const bool plotSystem = false, const double& error = 1e-6)
     {
         int rank;
@@ -197,6 +306,15 @@ public:
         return M_u[ idx ];
     }
     
+    // Solution of a b.c. set returned by iterateBatch()
+    template<class type>
+    const double solution(const type& bc, const VectorStdDouble& u)
+    {
+        DofHandler dofh(M_gv);
+        const unsigned int idx = dofh( bc );
+        return u[ idx ];
+    }
+    
     template<class type>
     const double solutionPrev0(const type& bc)
     {
@@ -221,7 +339,8 @@ public:
         std::cout << "t = " << M_time << ":" << std::endl << ls << std::endl;
     }
     
-    void plotErrorNorm(const MatrixEigen& A, const VectorEigen& u, const VectorEigen& rhs) const
+    template<class MatrixType>
+    void plotErrorNorm(const MatrixType& A, const VectorEigen& u, const VectorEigen& rhs) const
     {
         double relative_error = (A * u - rhs).norm() / rhs.norm();
         std::cout << "t = " << M_time << ":\t\t" << "rel. error = " << relative_error << std::endl;
@@ -284,6 +403,14 @@ public:
 
 private:
     
+    bool sameOperator(const SparseMatrixEigen& A, const SparseMatrixEigen& B) const
+    {
+        return A.rows() == B.rows() && A.nonZeros() == B.nonZeros()
+               && std::equal( A.outerIndexPtr(), A.outerIndexPtr() + A.outerSize() + 1, B.outerIndexPtr() )
+               && std::equal( A.innerIndexPtr(), A.innerIndexPtr() + A.nonZeros(), B.innerIndexPtr() )
+               && std::equal( A.valuePtr(), A.valuePtr() + A.nonZeros(), B.valuePtr() );
+    }
+    
     // Simulation time
     double M_time;
     
@@ -296,6 +423,9 @@ private:
     // Previous solution vectors
     Eigen::VectorXd M_uPrev0;
     Eigen::VectorXd M_uPrev1;
+    
+    // Time integrator, which keeps the factorization of the operator
+    std::shared_ptr<TimeIntegrator> M_timeIntegrator;
 
 };
 
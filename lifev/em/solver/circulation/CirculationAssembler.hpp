@@ -12,6 +12,7 @@
 #include <stdio.h>
 #include <iostream>
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
 #include <vector>
 #include <string>
 
@@ -27,6 +28,9 @@ public:
     
     enum M_var { Q , dQ , p1 , dp1 , p2 , dp2 };
     
+    typedef Eigen::SparseMatrix<double> SparseMatrixEigen;
+    typedef Eigen::Triplet<double> TripletEigen;
+    
     
     template<class T>
     Eigen::MatrixXd assembleMassMatrix(GridView& gv, const double& time, const T& U) const
@@ -94,6 +98,79 @@ public:
     }
 
     
+    // The sparse matrices always contain the same entries, independently of their values:
+    // the diagonal is stored explicitly (also where it is zero) such that the sparsity pattern
+    // of the time integration operator does not change, not even after the b.c. are imposed.
+    template<class T>
+    SparseMatrixEigen assembleMassMatrixSparse(GridView& gv, const double& time, const T& U) const
+    {
+        DofHandler dofh(gv);
+        
+        std::vector<TripletEigen> triplets;
+        triplets.reserve( dofh.size() + 3 * dofh.sizeElements() );
+        for ( unsigned int i (0) ; i < dofh.size() ; ++i ) triplets.push_back( TripletEigen( i , i , 0.0 ) );
+        
+        for ( auto& element : gv.elements() )
+        {
+            // Determine global indices of element and vertices
+            const unsigned int elementIdx = dofh( element );
+            const unsigned int vertex1Idx = dofh( element->node(0) );
+            const unsigned int vertex2Idx = dofh( element->node(1) );
+            
+            // Current solution of Q and p
+            std::vector<double> u { U[elementIdx] , 0.0, 0.0 };
+            if ( vertex1Idx < dofh.size() ) u[1] = U[vertex1Idx];
+            if ( vertex2Idx < dofh.size() ) u[2] = U[vertex2Idx];
+            
+            // Add entries for element
+            triplets.push_back( TripletEigen( elementIdx , elementIdx , element->lhs( dQ , u , time ) ) );
+            if ( vertex1Idx < dofh.size() ) triplets.push_back( TripletEigen( elementIdx , vertex1Idx , element->lhs( dp1 , u , time ) ) );
+            if ( vertex2Idx < dofh.size() ) triplets.push_back( TripletEigen( elementIdx , vertex2Idx , element->lhs( dp2 , u , time ) ) );
+        }
+        
+        SparseMatrixEigen M ( dofh.size() , dofh.size() );
+        M.setFromTriplets( triplets.begin() , triplets.end() );
+        return M;
+    }
+    
+    
+    template<class T>
+    SparseMatrixEigen assembleStiffnessMatrixSparse(GridView& gv, const double& time, const T& U) const
+    {
+        DofHandler dofh(gv);
+        
+        std::vector<TripletEigen> triplets;
+        triplets.reserve( dofh.size() + 5 * dofh.sizeElements() );
+        for ( unsigned int i (0) ; i < dofh.size() ; ++i ) triplets.push_back( TripletEigen( i , i , 0.0 ) );
+        
+        for ( auto& element : gv.elements() )
+        {
+            // Determine global indices of element and vertices
+            const unsigned int elementIdx = dofh( element );
+            const unsigned int vertex1Idx = dofh( element->node(0) );
+            const unsigned int vertex2Idx = dofh( element->node(1) );
+            
+            // Current solution of Q and p
+            std::vector<double> u { U[elementIdx] , 0.0, 0.0 };
+            if ( vertex1Idx < dofh.size() ) u[1] = U[vertex1Idx];
+            if ( vertex2Idx < dofh.size() ) u[2] = U[vertex2Idx];
+            
+            // Add entries for continuity at node
+            if ( vertex1Idx < dofh.size() ) triplets.push_back( TripletEigen( vertex1Idx , elementIdx , - 1.0 ) );
+            if ( vertex2Idx < dofh.size() ) triplets.push_back( TripletEigen( vertex2Idx , elementIdx ,   1.0 ) );
+            
+            // Add entries for element
+            triplets.push_back( TripletEigen( elementIdx , elementIdx , element->lhs( Q , u , time ) ) );
+            if ( vertex1Idx < dofh.size() ) triplets.push_back( TripletEigen( elementIdx , vertex1Idx , element->lhs( p1 , u , time ) ) );
+            if ( vertex2Idx < dofh.size() ) triplets.push_back( TripletEigen( elementIdx , vertex2Idx , element->lhs( p2 , u , time ) ) );
+        }
+        
+        SparseMatrixEigen A ( dofh.size() , dofh.size() );
+        A.setFromTriplets( triplets.begin() , triplets.end() );
+        return A;
+    }
+
+    
     template<class T>
     Eigen::VectorXd assembleSourceVector(GridView& gv, const double& time, T& U) const
     {
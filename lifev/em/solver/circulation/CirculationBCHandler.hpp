@@ -8,6 +8,7 @@
 
 #include <stdio.h>
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
 
 #include "CirculationDofHandler.hpp"
 
@@ -39,9 +40,60 @@ public:
         }
     }
     
+    void addBC(Eigen::SparseMatrix<double>& A, Eigen::VectorXd& rhs) const
+    {
+        for ( unsigned int bcIdx (0) ; bcIdx < M_bcNames.size() ; ++bcIdx )
+        {
+            const unsigned int vertexidx = M_dofh( M_bcNames[ bcIdx ][0] );
+            if ( M_bcNames[ bcIdx ][1] == "p" )
+            {
+                setPressureBC(A, rhs, vertexidx, M_bcValues[ bcIdx ]);
+            }
+            else if ( M_bcNames[ bcIdx ][1] == "Q" )
+            {
+                setFlowRateBC(rhs, vertexidx, M_bcValues[ bcIdx ]);
+            }
+        }
+    }
+    
+    // Impose the b.c. values on the rhs only. The operator is the same for all
+    // b.c. values and can be shared with the system on which addBC() was called.
+    void addBC(Eigen::VectorXd& rhs) const
+    {
+        for ( unsigned int bcIdx (0) ; bcIdx < M_bcNames.size() ; ++bcIdx )
+        {
+            const unsigned int vertexidx = M_dofh( M_bcNames[ bcIdx ][0] );
+            if ( M_bcNames[ bcIdx ][1] == "p" )
+            {
+                rhs ( vertexidx ) = M_bcValues[ bcIdx ];
+            }
+            else if ( M_bcNames[ bcIdx ][1] == "Q" )
+            {
+                setFlowRateBC(rhs, vertexidx, M_bcValues[ bcIdx ]);
+            }
+        }
+    }
+    
     
 private:
     
+    void setPressureBC(Eigen::SparseMatrix<double>& A, Eigen::VectorXd& rhs, const unsigned int& vertexIdx, const double& bcValue) const
+    {
+        // Entries are zeroed and not removed, so that the sparsity pattern is preserved
+        for ( int k (0) ; k < A.outerSize() ; ++k )
+        {
+            for ( Eigen::SparseMatrix<double>::InnerIterator it (A, k) ; it ; ++it )
+            {
+                if ( static_cast<unsigned int> ( it.row() ) == vertexIdx )
+                {
+                    it.valueRef() = ( static_cast<unsigned int> ( it.col() ) == vertexIdx ? 1.0 : 0.0 );
+                }
+            }
+        }
+        A.coeffRef ( vertexIdx , vertexIdx ) = 1.0;
+        rhs ( vertexIdx ) = bcValue;
+    }
+    
     void setPressureBC(Eigen::MatrixXd& A, Eigen::VectorXd& rhs, const unsigned int& vertexIdx, const double& bcValue) const
     {
         A.row(vertexIdx).setZero();
@@ -51,6 +103,11 @@ private:
 
     
     void setFlowRateBC(Eigen::MatrixXd& A, Eigen::VectorXd& rhs, const unsigned int& vertexIdx, const double& bcValue) const
+    {
+        setFlowRateBC(rhs, vertexIdx, bcValue);
+    }
+    
+    void setFlowRateBC(Eigen::VectorXd& rhs, const unsigned int& vertexIdx, const double& bcValue) const
     {
         rhs ( vertexIdx ) = - bcValue;
     }
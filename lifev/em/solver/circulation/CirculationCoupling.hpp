@@ -33,6 +33,15 @@ public:
         else return false;
     }
     
+    // B.c. values of a finite difference jacobian: the j-th set perturbs the j-th value of p by dp[j].
+    // All the sets are meant to be solved together by Circulation::iterateBatch.
+    const MatrixStdDouble perturbedValues(const VectorStdDouble& p, const VectorStdDouble& dp) const
+    {
+        MatrixStdDouble pPert ( dp.size() , p );
+        for (unsigned int j (0) ; j < dp.size() ; ++j) pPert[j][j] += dp[j];
+        return pPert;
+    }
+    
     void updatePressure(VectorStdDouble& p, const VectorStdDouble& V1, const MatrixStdDouble& Vp1, const VectorStdDouble& dp1, const VectorStdDouble& V2, const MatrixStdDouble& Vp2, const VectorStdDouble& dp2, const double& relaxationParam = 1, const VectorStdDouble& Rstd = VectorStdDouble (0)) const
     {
         // Compute Residual
@@ -10,8 +10,12 @@
 #include <iostream>
 #include <Eigen/Dense>
 #include <Eigen/LU>
+#include <Eigen/Sparse>
+#include <Eigen/SparseLU>
 #include <vector>
 #include <string>
+#include <algorithm>
+#include <stdexcept>
 
 #include "CirculationAssembler.hpp"
 
@@ -19,19 +23,87 @@
 class TimeIntegrator {
 public:
 
-    TimeIntegrator() {}
+    typedef Eigen::SparseMatrix<double> SparseMatrixEigen;
+    
+    TimeIntegrator() :
+        M_patternAnalyzed ( false ),
+        M_factorized ( false )
+    {}
     
     virtual ~TimeIntegrator() {}
     
     virtual Eigen::MatrixXd assembleOperator(const double& dt, Eigen::MatrixXd& M, Eigen::MatrixXd& A, Eigen::VectorXd& f) = 0;
     virtual Eigen::VectorXd assembleRhs(const double& dt, Eigen::MatrixXd& M, Eigen::MatrixXd& A, Eigen::VectorXd& f, Eigen::VectorXd& uPrev) = 0;
     
+    virtual SparseMatrixEigen assembleOperator(const double& dt, SparseMatrixEigen& M, SparseMatrixEigen& A, Eigen::VectorXd& f) = 0;
+    virtual Eigen::VectorXd assembleRhs(const double& dt, SparseMatrixEigen& M, SparseMatrixEigen& A, Eigen::VectorXd& f, Eigen::VectorXd& uPrev) = 0;
+    
     virtual Eigen::VectorXd solve(Eigen::MatrixXd& A, Eigen::VectorXd& rhs, const CirculationBCHandler& bcHandler)
     {
         bcHandler.addBC(A, rhs);
         return A.fullPivLu().solve(rhs);
     }
     
+    // Sparse solve: the symbolic factorization is computed once and the
+    // numerical one only when the values of the operator have changed.
+    virtual Eigen::VectorXd solve(SparseMatrixEigen& A, Eigen::VectorXd& rhs, const CirculationBCHandler& bcHandler)
+    {
+        bcHandler.addBC(A, rhs);
+        factorize(A);
+        return M_solver.solve(rhs);
+    }
+    
+    // Batched sparse solve: all the right hand sides (one per column) share the operator A,
+    // on which the b.c. have already been imposed, and hence its factorization.
+    virtual Eigen::MatrixXd solve(SparseMatrixEigen& A, Eigen::MatrixXd& rhs)
+    {
+        factorize(A);
+        return M_solver.solve(rhs);
+    }
+    
+    void factorize(SparseMatrixEigen& A)
+    {
+        A.makeCompressed();
+        
+        const bool samePattern ( M_patternAnalyzed
+                                 && A.rows() == M_rows
+                                 && A.nonZeros() == static_cast<SparseMatrixEigen::Index> ( M_innerIndices.size() )
+                                 && std::equal( A.outerIndexPtr(), A.outerIndexPtr() + A.outerSize() + 1, M_outerIndices.data() )
+                                 && std::equal( A.innerIndexPtr(), A.innerIndexPtr() + A.nonZeros(), M_innerIndices.data() ) );
+        
+        if ( ! samePattern )
+        {
+            M_solver.analyzePattern(A);
+            M_rows = A.rows();
+            M_outerIndices.assign( A.outerIndexPtr(), A.outerIndexPtr() + A.outerSize() + 1 );
+            M_innerIndices.assign( A.innerIndexPtr(), A.innerIndexPtr() + A.nonZeros() );
+            M_patternAnalyzed = true;
+            M_factorized = false;
+        }
+        
+        if ( M_factorized && std::equal( A.valuePtr(), A.valuePtr() + A.nonZeros(), M_values.data() ) ) return;
+        
+        M_solver.factorize(A);
+        if ( M_solver.info() != Eigen::Success )
+        {
+            throw std::runtime_error("Factorization of the circulation operator failed!");
+        }
+        M_values.assign( A.valuePtr(), A.valuePtr() + A.nonZeros() );
+        M_factorized = true;
+    }
+    
+protected:
+    
+    Eigen::SparseLU<SparseMatrixEigen, Eigen::COLAMDOrdering<int> > M_solver;
+    
+    bool M_patternAnalyzed;
+    bool M_factorized;
+    
+    SparseMatrixEigen::Index M_rows;
+    std::vector<int> M_outerIndices;
+    std::vector<int> M_innerIndices;
+    std::vector<double> M_values;
+    
 };
 
 
@@ -49,6 +121,16 @@ public:
     {
         return f + (M/dt - A/2) * uPrev;
     }
+    
+    virtual SparseMatrixEigen assembleOperator(const double& dt, SparseMatrixEigen& M, SparseMatrixEigen& A, Eigen::VectorXd& f)
+    {
+        return M/dt + A/2;
+    }
+    
+    virtual Eigen::VectorXd assembleRhs(const double& dt, SparseMatrixEigen& M, SparseMatrixEigen& A, Eigen::VectorXd& f, Eigen::VectorXd& uPrev)
+    {
+        return f + (M/dt - A/2) * uPrev;
+    }
 
 };
 
@@ -68,6 +150,16 @@ public:
         return f + M/dt * uPrev;
     }
     
+    virtual SparseMatrixEigen assembleOperator(const double& dt, SparseMatrixEigen& M, SparseMatrixEigen& A, Eigen::VectorXd& f)
+    {
+        return M/dt + A;
+    }
+    
+    virtual Eigen::VectorXd assembleRhs(const double& dt, SparseMatrixEigen& M, SparseMatrixEigen& A, Eigen::VectorXd& f, Eigen::VectorXd& uPrev)
+    {
+        return f + M/dt * uPrev;
+    }
+    
 };
 
 
@@ -86,4 +178,14 @@ public:
         return f + (M/dt - A) * uPrev;
     }
     
+    virtual SparseMatrixEigen assembleOperator(const double& dt, SparseMatrixEigen& M, SparseMatrixEigen& A, Eigen::VectorXd& f)
+    {
+        return M/dt;
+    }
+    
+    virtual Eigen::VectorXd assembleRhs(const double& dt, SparseMatrixEigen& M, SparseMatrixEigen& A, Eigen::VectorXd& f, Eigen::VectorXd& uPrev)
+    {
+        return f + (M/dt - A) * uPrev;
+    }
+    
 };
@@ -9,6 +9,11 @@
 #include <stdio.h>
 #include <vector>
 #include <string>
+#include <set>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
 
 
 namespace LifeV
@@ -52,36 +57,72 @@ public:
     }
     
     void findBoundaryPoints()
-    {	
-        std::set<unsigned int> vertexIds;
-        for (UInt iBFaceIn = 0; iBFaceIn < M_fullMesh.numBFaces(); ++iBFaceIn)
+    {
+        // The ring closing the cavity is made of the boundary edges shared by a flagged
+        // and an unflagged boundary face. The edges are hashed by their vertex IDs, so
+        // that each face of the local mesh is visited only once.
+        const RegionMesh<LinearTetra>& localMesh = *M_localMeshPtr;
+        const UInt numFaceVertices = RegionMesh<LinearTetra>::face_Type::S_numVertices;
+
+        std::unordered_set<edgeKey_Type> flaggedEdges;
+        std::unordered_set<edgeKey_Type> unflaggedEdges;
+        std::unordered_set<edgeKey_Type> interfaceEdges;
+        for (UInt iBFace = 0; iBFace < localMesh.numBFaces(); ++iBFace)
         {
-            UInt markerIdIn = M_fullMesh.boundaryFace(iBFaceIn).markerID();
-            if ( std::find(M_bdFlags.begin(), M_bdFlags.end(), markerIdIn) != M_bdFlags.end() )
+            const RegionMesh<LinearTetra>::face_Type& face = localMesh.boundaryFace(iBFace);
+            const bool flagged ( std::find(M_bdFlags.begin(), M_bdFlags.end(), face.markerID()) != M_bdFlags.end() );
+            std::unordered_set<edgeKey_Type>& edges = ( flagged ? flaggedEdges : unflaggedEdges );
+
+            for (UInt iVertex = 0; iVertex < numFaceVertices; ++iVertex)
             {
-                for (UInt iBFaceOut = 0; iBFaceOut < M_fullMesh.numBFaces(); ++iBFaceOut)
+                const RegionMesh<LinearTetra>::point_Type& point1 = face.point(iVertex);
+                const RegionMesh<LinearTetra>::point_Type& point2 = face.point( (iVertex + 1) % numFaceVertices );
+                const edgeKey_Type key ( edgeKey( point1.id(), point2.id() ) );
+                edges.insert(key);
+
+                if ( Flag::testOneSet( point1.flag(), EntityFlags::SUBDOMAIN_INTERFACE )
+                     && Flag::testOneSet( point2.flag(), EntityFlags::SUBDOMAIN_INTERFACE ) )
                 {
-                    UInt markerIdOut = M_fullMesh.boundaryFace(iBFaceOut).markerID();
-                    if ( std::find(M_bdFlags.begin(), M_bdFlags.end(), markerIdOut) == M_bdFlags.end() )
-                    {
-                        for (UInt iBPointIn = 0; iBPointIn < M_fullMesh.boundaryFace(iBFaceIn).S_numPoints; ++iBPointIn)
-                        {
-                            for (UInt iBPointOut = 0; iBPointOut < M_fullMesh.boundaryFace(iBFaceOut).S_numPoints; ++iBPointOut)
-                            {
-                                UInt pointIdIn = M_fullMesh.boundaryFace(iBFaceIn).point(iBPointIn).id();
-                                UInt pointIdOut = M_fullMesh.boundaryFace(iBFaceOut).point(iBPointOut).id();
-                                
-                                if ( pointIdIn == pointIdOut )
-                                {
-                                    vertexIds.insert(pointIdIn);
-                                }
-                            }
-                        }
-                    }
+                    interfaceEdges.insert(key);
                 }
             }
         }
 
+        // Edges whose faces live on the same process are found locally, while for the edges
+        // on the interface between subdomains the two sides are exchanged between the processes
+        std::vector<edgeKey_Type> ringEdges;
+        std::vector<edgeKey_Type> interfaceFlaggedEdges;
+        std::vector<edgeKey_Type> interfaceUnflaggedEdges;
+        for (auto it = flaggedEdges.begin(); it != flaggedEdges.end(); ++it)
+        {
+            if ( unflaggedEdges.count(*it) ) ringEdges.push_back(*it);
+            else if ( interfaceEdges.count(*it) ) interfaceFlaggedEdges.push_back(*it);
+        }
+        for (auto it = unflaggedEdges.begin(); it != unflaggedEdges.end(); ++it)
+        {
+            if ( !flaggedEdges.count(*it) && interfaceEdges.count(*it) ) interfaceUnflaggedEdges.push_back(*it);
+        }
+
+        allGather(interfaceFlaggedEdges);
+        allGather(interfaceUnflaggedEdges);
+        std::unordered_set<edgeKey_Type> unflaggedInterface (interfaceUnflaggedEdges.begin(), interfaceUnflaggedEdges.end());
+        for (auto it = interfaceFlaggedEdges.begin(); it != interfaceFlaggedEdges.end(); ++it)
+        {
+            if ( unflaggedInterface.count(*it) ) ringEdges.push_back(*it);
+        }
+
+        allGather(ringEdges);
+        std::sort(ringEdges.begin(), ringEdges.end());
+        ringEdges.erase(std::unique(ringEdges.begin(), ringEdges.end()), ringEdges.end());
+        M_boundaryEdges = ringEdges;
+
+        std::set<int> vertexIds;
+        for (auto it = ringEdges.begin(); it != ringEdges.end(); ++it)
+        {
+            vertexIds.insert( static_cast<int>(*it >> 32) );
+            vertexIds.insert( static_cast<int>(*it & 0xFFFFFFFF) );
+        }
+
         M_boundaryPoints.clear();
         for (auto it = vertexIds.begin(); it != vertexIds.end(); ++it) M_boundaryPoints.push_back(*it);
     }
@@ -89,43 +130,45 @@ public:
     
     void sortBoundaryPoints()
     {
+        if ( M_boundaryPoints.empty() ) return;
+
+        // Walk along the ring: every point has exactly two neighbours
+        std::unordered_map<int, std::vector<int> > neighbours;
+        for (auto it = M_boundaryEdges.begin(); it != M_boundaryEdges.end(); ++it)
+        {
+            const int idx1 ( static_cast<int>(*it >> 32) );
+            const int idx2 ( static_cast<int>(*it & 0xFFFFFFFF) );
+            neighbours[idx1].push_back(idx2);
+            neighbours[idx2].push_back(idx1);
+        }
+
         std::vector<int> pointsOrdered;
-        
-        unsigned int idx1 ( M_boundaryPoints[0] );
-        int idx ( - 1 );
-        Vector3D v1;
-        Vector3D v;
+        pointsOrdered.reserve(M_boundaryPoints.size());
 
-        while ( idx != M_boundaryPoints[0] )
+        bool closedRing ( true );
+        for (auto it = neighbours.begin(); it != neighbours.end(); ++it)
         {
-            double distMin ( - 1.0 );
-            for ( unsigned int i (0) ; i < M_boundaryPoints.size() ; ++i )
+            if ( it->second.size() != 2 ) closedRing = false;
+        }
+
+        if ( closedRing )
+        {
+            const int first ( M_boundaryPoints[0] );
+            int previous ( first );
+            int current ( std::min(neighbours[first][0], neighbours[first][1]) );
+            pointsOrdered.push_back(first);
+
+            while ( current != first && pointsOrdered.size() <= M_boundaryPoints.size() )
             {
-                const unsigned int idx2 ( M_boundaryPoints[i] );
-                if ( idx1 != idx2 && std::find(pointsOrdered.begin(), pointsOrdered.end(), idx2) == pointsOrdered.end() )
-                {
-                    Vector3D v2 = M_fullMesh.point(idx2).coordinates() - M_fullMesh.point(idx1).coordinates();
-                    const Vector3D v1N = ( v1.norm() > 0 ? v1.normalized() : v1 );
-                    const Vector3D v2N = ( v2.norm() > 0 ? v2.normalized() : v2 );
-                    
-                    const double sc = ( v1.norm() > 0.0 ? v1N.dot(v2N) : 1.0 );
-                    const double dist = v2.norm() / std::max( std::pow(sc + 1, 2) , 0.25 );
-
-                    if ( dist < distMin || distMin < 0.0 )
-                    {
-                        distMin = dist;
-                        idx = idx2;
-                        v = v2;
-                    }
-                }
+                pointsOrdered.push_back(current);
+                const std::vector<int>& next = neighbours[current];
+                const int following ( next[0] != previous ? next[0] : next[1] );
+                previous = current;
+                current = following;
             }
-
-            pointsOrdered.push_back(idx);
-            idx1 = idx;
-            v1 = v;
         }
-        
-        if ( pointsOrdered.size() != M_boundaryPoints.size() &&  M_fullMesh.comm()->MyPID() == 0 )
+
+        if ( pointsOrdered.size() != M_boundaryPoints.size() )
         {
             throw std::runtime_error( "Sorting boundary points in " + M_domain + " failed!" );
         }
@@ -181,6 +224,21 @@ public:
     Real computeBoundaryVolume (const VectorEpetra& disp,
                                 const boost::shared_ptr <space> dETFESpace,
                                 int bdFlag) const
+    {
+        return computeBoundaryVolume (disp, dETFESpace, std::vector<UInt> (1, bdFlag) );
+    }
+
+
+    //! Volume enclosed by the boundaries with the given flags
+    /*!
+      The volume is the boundary integral of -x1 J (E1 . F^{-T} N), x1 being the first
+      component of the current position. All the flags are integrated in a single loop
+      on the boundary faces, with a single reduction over the processes.
+     */
+    template<class space>
+    Real computeBoundaryVolume (const VectorEpetra& disp,
+                                const boost::shared_ptr <space> dETFESpace,
+                                const std::vector<UInt>& bdFlags) const
     {
         MatrixSmall<3, 3> Id;
         Id (0, 0) = 1.; Id (0, 1) = 0.; Id (0, 2) = 0.;
@@ -190,13 +248,14 @@ public:
         E1 (0) = 1.; E1 (1) = 0.; E1 (2) = 0.;
         
         const VectorEpetra positionVector ( currentPositionVector(disp) );
-        boost::shared_ptr<VectorEpetra> intergral ( new VectorEpetra ( positionVector.map() ) );
+        Real volume (0.0);
         
         {
             using namespace ExpressionAssembly;
 
             BOOST_AUTO_TPL (I, value (Id) );
             BOOST_AUTO_TPL (vE1, value (E1) );
+            BOOST_AUTO_TPL (x1, dot (vE1, value (dETFESpace, positionVector) ) );
             BOOST_AUTO_TPL (Grad_u, grad (dETFESpace, disp, 0) );
             BOOST_AUTO_TPL (F, (Grad_u + I) );
             BOOST_AUTO_TPL (FmT, minusT (F) );
@@ -204,24 +263,82 @@ public:
             
             QuadratureBoundary myBDQR (buildTetraBDQR (quadRuleTria7pt) );
 
-            *intergral *= 0.0;
-            integrate (boundary (M_localMeshPtr, bdFlag),
+            integrate (boundary (M_localMeshPtr, bdFlags),
                        myBDQR,
-                       M_ETFESpace,
-                       value(-1.0) * J * dot (vE1, FmT * Nface) * phi_i) >> intergral;
+                       value(-1.0) * x1 * J * dot (vE1, FmT * Nface) ) >> volume;
+        }
+
+        return volume;
+    }
+
+
+    //! Derivative of computeBoundaryVolume with respect to the displacement
+    /*!
+      The volume of the boundary is V = x1 . g(u), x1 being the first component of the
+      current position and g(u) the integral of -J (E1 . F^{-T} N) phi_i. Its derivative
+      in the direction phi_i (vectorial test function) is
+      -J (E1 . F^{-T} N) (E1 . phi_i) - x1 (dJ (E1 . F^{-T} N) + J (E1 . dF^{-T} N)),
+      with dF = grad(phi_i). The contribution is summed into gradient.
+     */
+    template<class space>
+    void computeBoundaryVolumeGradient (const VectorEpetra& disp,
+                                        const boost::shared_ptr <space> dETFESpace,
+                                        int bdFlag,
+                                        boost::shared_ptr<VectorEpetra> gradient) const
+    {
+        MatrixSmall<3, 3> Id;
+        Id (0, 0) = 1.; Id (0, 1) = 0.; Id (0, 2) = 0.;
+        Id (1, 0) = 0.; Id (1, 1) = 1.; Id (1, 2) = 0.;
+        Id (2, 0) = 0.; Id (2, 1) = 0.; Id (2, 2) = 1.;
+        VectorSmall<3> E1;
+        E1 (0) = 1.; E1 (1) = 0.; E1 (2) = 0.;
+
+        const VectorEpetra positionVector ( currentPositionVector(disp) );
 
-            intergral->globalAssemble();
+        {
+            using namespace ExpressionAssembly;
 
+            BOOST_AUTO_TPL (I, value (Id) );
+            BOOST_AUTO_TPL (vE1, value (E1) );
+            BOOST_AUTO_TPL (x1, dot (vE1, value (dETFESpace, positionVector) ) );
+            BOOST_AUTO_TPL (Grad_u, grad (dETFESpace, disp, 0) );
+            BOOST_AUTO_TPL (F, (Grad_u + I) );
+            BOOST_AUTO_TPL (FmT, minusT (F) );
+            BOOST_AUTO_TPL (J, det (F) );
+            BOOST_AUTO_TPL (dJ, J * dot (FmT, grad (phi_i) ) );
+            BOOST_AUTO_TPL (dFmT, value(-1.0) * FmT * transpose (grad (phi_i) ) * FmT );
+
+            QuadratureBoundary myBDQR (buildTetraBDQR (quadRuleTria7pt) );
+
+            integrate (boundary (M_localMeshPtr, bdFlag),
+                       myBDQR,
+                       dETFESpace,
+                       value(-1.0) * J * dot (vE1, FmT * Nface) * dot (vE1, phi_i)
+                       + value(-1.0) * x1 * ( dJ * dot (vE1, FmT * Nface) + J * dot (vE1, dFmT * Nface) ) ) >> gradient;
         }
+    }
 
-//        std::cout << "bdFlag: " << bdFlag << std::endl;
-//        std::cout << "\n Length: " << positionVector.epetraVector().MyLength() << "  " << (*intergral).epetraVector().MyLength() << std::endl;
-//        std::cout << "\n Norm: " << positionVector.norm2() << "  " << (*intergral).norm2() << std::endl;
 
-        return positionVector.dot (*intergral);
+    //! Derivative of the volume with respect to the displacement
+    /*!
+      @param disp Displacement
+      @param dETFESpace ETFESpace of the displacement
+      @param gradient Vector on the map of the displacement, filled with dV/du
+     */
+    template<class space>
+    void volumeGradient(const VectorEpetra& disp,
+                        const boost::shared_ptr <space> dETFESpace,
+                        boost::shared_ptr<VectorEpetra> gradient) const
+    {
+        *gradient *= 0.0;
+        for ( auto& bdFlag : M_bdFlags )
+        {
+            computeBoundaryVolumeGradient(disp, dETFESpace, bdFlag, gradient);
+        }
+        gradient->globalAssemble();
     }
-    
-    
+
+
     template<class space>
     const Real volume(const VectorEpetra& disp,
                       const boost::shared_ptr <space> dETFESpace,
@@ -231,11 +348,8 @@ public:
         const boost::shared_ptr<Epetra_Comm> comm = M_fullMesh.comm();
         
         // Compute volume over boundary
-        Real volumeBoundary (0);
-        for ( auto& bdFlag : M_bdFlags )
-        {
-            volumeBoundary += computeBoundaryVolume(disp, dETFESpace, bdFlag);
-        }
+        const std::vector<UInt> bdFlags ( M_bdFlags.begin(), M_bdFlags.end() );
+        Real volumeBoundary = computeBoundaryVolume(disp, dETFESpace, bdFlags);
         
         // Compute volume over open-end-boundary
         //Real volumeOpenEnd = computeOpenEndVolume(disp, direction, component);
@@ -257,6 +371,37 @@ public:
     
     
 protected:
+
+    typedef unsigned long long edgeKey_Type;
+
+    //! Key of the edge between two points, independent of their order
+    static edgeKey_Type edgeKey(const UInt idx1, const UInt idx2)
+    {
+        const edgeKey_Type a ( std::min(idx1, idx2) );
+        const edgeKey_Type b ( std::max(idx1, idx2) );
+        return ( a << 32 ) | b;
+    }
+
+    //! Gather the edges of all the processes on every process
+    static void allGather(std::vector<edgeKey_Type>& edges)
+    {
+        int nProcs (1);
+        MPI_Comm_size(MPI_COMM_WORLD, &nProcs);
+        if ( nProcs == 1 ) return;
+
+        int localSize ( edges.size() );
+        std::vector<int> sizes (nProcs);
+        MPI_Allgather(&localSize, 1, MPI_INT, &sizes[0], 1, MPI_INT, MPI_COMM_WORLD);
+
+        std::vector<int> offsets (nProcs, 0);
+        for (int i (1); i < nProcs; ++i) offsets[i] = offsets[i - 1] + sizes[i - 1];
+
+        std::vector<edgeKey_Type> gathered ( offsets[nProcs - 1] + sizes[nProcs - 1] );
+        MPI_Allgatherv( ( edges.empty() ? NULL : &edges[0] ), localSize, MPI_UNSIGNED_LONG_LONG,
+                        ( gathered.empty() ? NULL : &gathered[0] ), &sizes[0], &offsets[0], MPI_UNSIGNED_LONG_LONG,
+                        MPI_COMM_WORLD);
+        edges.swap(gathered);
+    }
     
     const std::vector<Vector3D> currentPosition(const VectorEpetra& disp) const
     {
@@ -377,6 +522,7 @@ protected:
     const std::vector<int> M_bdFlags;
     const std::string M_domain;
     std::vector<int> M_boundaryPoints;
+    std::vector<edgeKey_Type> M_boundaryEdges;
     
 };
 
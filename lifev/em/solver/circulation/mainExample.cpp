@@ -8,6 +8,8 @@
 
 #include <iostream>
 #include <math.h>
+#include <cmath>
+#include <cstdlib>
 
 #include "Circulation.hpp"
 
@@ -24,6 +26,7 @@ int main(int argc, const char * argv[]) {
     
     // Flow rate between two vertices
     auto Q = [] (Circulation& c, const std::string& N1, const std::string& N2) { return c.solution ( std::vector<std::string> {N1, N2} ); };
+    auto QPert = [] (Circulation& c, const std::vector<double>& u, const std::string& N1, const std::string& N2) { return c.solution ( std::vector<std::string> {N1, N2}, u ); };
     
     // Heart activation
     auto phi = [] (const double& t, const double& TPhi, const double& TBeat, const double& TStart) { return pow(std::sin(std::fmod(t - TStart, TBeat) * pi / TPhi), 2) * (std::fmod(t - TStart, TBeat) < TPhi ? 1.0 : 0.0) * (t > TStart ? 1.0 : 0.0); };
@@ -55,6 +58,7 @@ int main(int argc, const char * argv[]) {
     const int nBeats = (argc > 1 ? atof(argv[1]) : 1);
     const double dt = (argc > 2 ? atof(argv[2]) : 0.0025);
     const double tEnd = nBeats * TBeat;
+    const bool checkBatch = (argc > 3 ? atoi(argv[3]) : 0);
 
     
     //==========================================//
@@ -138,7 +142,8 @@ int main(int argc, const char * argv[]) {
             ++iter;
             
             // Initialize vectors for pressure perturbation
-            std::vector<std::vector<double> > pPert { { bcValues[0] + dp , bcValues[1] } , { bcValues[0] , bcValues[1] + dp } };
+            std::vector<double> dpPert (2, dp);
+            std::vector<std::vector<double> > pPert ( bc.coupling().perturbedValues(bcValues, dpPert) );
             std::vector<std::vector<double> > VCircPert (2, std::vector<double> (2));
             
             
@@ -146,20 +151,37 @@ int main(int argc, const char * argv[]) {
             // Perturb circulation                      //
             //==========================================//
 
-            bc.iterate(dt, bcNames, pPert[0], iter);
-            VCircPert[0][0] = VCirc[0] + dt * ( Q(bc, "la", "lv") - Q(bc, "lv", "sa") );
-            VCircPert[1][0] = VCirc[1] + dt * ( Q(bc, "ra", "rv") - Q(bc, "rv", "pa") );
+            // All the perturbations at once
+            const std::vector<std::vector<double> > uPert ( bc.iterateBatch(dt, bcNames, pPert, iter) );
+            
+            for ( unsigned int j (0) ; j < pPert.size() ; ++j )
+            {
+                VCircPert[0][j] = VCirc[0] + dt * ( QPert(bc, uPert[j], "la", "lv") - QPert(bc, uPert[j], "lv", "sa") );
+                VCircPert[1][j] = VCirc[1] + dt * ( QPert(bc, uPert[j], "ra", "rv") - QPert(bc, uPert[j], "rv", "pa") );
+            }
             
-            bc.iterate(dt, bcNames, pPert[1], iter);
-            VCircPert[0][1] = VCirc[0] + dt * ( Q(bc, "la", "lv") - Q(bc, "lv", "sa") );
-            VCircPert[1][1] = VCirc[1] + dt * ( Q(bc, "ra", "rv") - Q(bc, "rv", "pa") );
+            // Check the batched solutions against the sequential iterations from the same state
+            if ( checkBatch )
+            {
+                for ( unsigned int j (0) ; j < pPert.size() ; ++j )
+                {
+                    Circulation bcSequential ( bc );
+                    bcSequential.iterate(dt, bcNames, pPert[j], iter);
+                    
+                    const std::vector<double> u ( bcSequential.solution() );
+                    double difference (0);
+                    for ( unsigned int k (0) ; k < u.size() ; ++k ) difference = std::max( difference, std::abs( u[k] - uPert[j][k] ) );
+                    
+                    std::cout << "Perturbation " << j << ": max difference batched / sequential = " << difference << std::endl;
+                    if ( difference > 1e-6 ) return EXIT_FAILURE;
+                }
+            }
 
             
             //==========================================//
             // Update pressure                          //
             //==========================================//
             
-            std::vector<double> dpPert (2, dp);
             std::vector<double> R (2);
             for ( unsigned int k (0) ; k < R.size() ; ++k ) R[k] = VFeNew[k] - VCircNew[k];
             bc.coupling().updatePressure(bcValues, VFeNew0, VFEPert, dpPert, VCircNew, VCircPert, dpPert, 1.0, R);
@@ -257,13 +257,7 @@ public:
      */
     inline void setAppliedCurrentFromElectroStimulus ( ElectroStimulus& stimulus, feSpacePtr_Type feSpacePtr, Real time = 0.0)
     {
-
-        // boost::ref() is needed here because otherwise a copy of the base object is reinstantiated
-        function_Type f = boost::bind (&ElectroStimulus::appliedCurrent, boost::ref (stimulus), _1, _2, _3, _4, _5 );
-
-        feSpacePtr -> interpolate (
-            static_cast<FESpace<RegionMesh<LinearTetra>, MapEpetra>::function_Type> (f),
-            *M_appliedCurrentPtr, time);
+        stimulus.setAppliedCurrent ( *M_appliedCurrentPtr, feSpacePtr, time );
     }
 
     //! TO BE CHECKED - SR
@@ -514,6 +514,45 @@ computeI8JacobianTermsSecondDerivative ( const vector_Type& disp,
 }
 
 
+template< typename Mesh, typename FunctorPtr >
+void
+computeFusedJacobianTerms ( const vector_Type& disp,
+                            boost::shared_ptr<ETFESpace<Mesh, MapEpetra, 3, 3 > >  dispETFESpace,
+                            const vector_Type& fibers,
+                            const vector_Type& sheets,
+                            matrixPtr_Type     jacobianPtr,
+                            FunctorPtr         fusedFunctions)
+{
+    using namespace ExpressionAssembly;
+    //
+	//if(disp.comm().MyPID() == 0)
+    //std::cout << "EMETA - Computing fused jacobian terms ... \n";
+
+    auto f_0 = _v0 (dispETFESpace, fibers);
+    auto s_0 = _v0 (dispETFESpace, sheets);
+
+    boost::shared_ptr<orthonormalizeFibers> normalize0 (new orthonormalizeFibers);
+    boost::shared_ptr<orthonormalizeFibers> normalize1 (new orthonormalizeFibers (1) );
+    auto f0 = eval (normalize0, f_0);
+
+    auto s_00 = s_0 - dot (f0, s_0) * f0;
+
+    auto s0 = eval (normalize1, s_00);
+
+	auto F = _F (dispETFESpace, disp, 0);
+
+    // All the material functions are evaluated in the same loop over the elements
+    auto dP = eval (fusedFunctions, F, f0, s0, _dF);
+
+    integrate ( elements ( dispETFESpace->mesh() ) ,
+                quadRule(),
+                dispETFESpace,
+                dispETFESpace,
+                dot ( dP , grad (phi_i) )
+              ) >> jacobianPtr;
+}
+
+
 }//EMAssembler
 
 }//LifeV
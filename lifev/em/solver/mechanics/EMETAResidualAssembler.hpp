@@ -530,6 +530,44 @@ computeI8ResidualTermsFung ( const vector_Type& disp,
 }
 
 
+template< typename Mesh, typename FunctorPtr >
+void
+computeFusedResidualTerms ( const vector_Type& disp,
+                            boost::shared_ptr<ETFESpace<Mesh, MapEpetra, 3, 3 > >  dispETFESpace,
+                            const vector_Type& fibers,
+                            const vector_Type& sheets,
+                            vectorPtr_Type     residualVectorPtr,
+                            FunctorPtr         fusedFunctions)
+{
+    using namespace ExpressionAssembly;
+    //
+	//if(disp.comm().MyPID() == 0)
+    //std::cout << "EMETA - Computing fused residual terms ... \n";
+
+    auto f_0 = _v0 (dispETFESpace, fibers);
+    auto s_0 = _v0 (dispETFESpace, sheets);
+
+    boost::shared_ptr<orthonormalizeFibers> normalize0 (new orthonormalizeFibers);
+    boost::shared_ptr<orthonormalizeFibers> normalize1 (new orthonormalizeFibers (1) );
+    auto f0 = eval (normalize0, f_0);
+
+    auto s_00 = s_0 - dot (f0, s_0) * f0;
+
+    auto s0 = eval (normalize1, s_00);
+
+	auto F = _F (dispETFESpace, disp, 0);
+
+    // All the material functions are evaluated in the same loop over the elements
+    auto P = eval (fusedFunctions, F, f0, s0);
+
+    integrate ( elements ( dispETFESpace->mesh() ) ,
+                quadRule(),
+                dispETFESpace,
+                dot ( P , grad (phi_i) )
+              ) >> residualVectorPtr;
+}
+
+
 
 
 }//EMAssembler
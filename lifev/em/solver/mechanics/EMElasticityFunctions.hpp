@@ -123,6 +123,104 @@ VectorSmall<3> crossProduct (const VectorSmall<3>& v1, const VectorSmall<3>& v2)
 }
 
 
+///////////////////////////////////////////////////////////////////////////
+// POINTWISE KERNELS
+// These functions are the pointwise counterparts of the expressions
+// in EMMechanicalExpressions.hpp and are used by the fused assembly
+// of the material functions.
+///////////////////////////////////////////////////////////////////////////
+
+// Kinematic quantities at a quadrature point.
+// f0 and s0 are expected to be already orthonormalized.
+struct Kinematics
+{
+    Kinematics (const LifeV::MatrixSmall<3, 3>& F_,
+                const LifeV::VectorSmall<3>& f0_,
+                const LifeV::VectorSmall<3>& s0_) :
+        F (F_),
+        FmT (F_.minusTransposed() ),
+        J (F_.determinant() ),
+        Jm23 (std::pow (J, -2.0 / 3.0) ),
+        I1 (F_.dot (F_) ),
+        f0 (f0_),
+        s0 (s0_),
+        f (F_ * f0_),
+        s (F_ * s0_)
+    {}
+
+    LifeV::MatrixSmall<3, 3> F;
+    LifeV::MatrixSmall<3, 3> FmT;
+    Real J;
+    Real Jm23;
+    Real I1;
+    LifeV::VectorSmall<3> f0;
+    LifeV::VectorSmall<3> s0;
+    LifeV::VectorSmall<3> f;
+    LifeV::VectorSmall<3> s;
+};
+
+// dFmTdF = Derivative of F^{-T} in direction dF
+LifeV::MatrixSmall<3, 3> dFmTdF (const Kinematics& k, const LifeV::MatrixSmall<3, 3>& dF)
+{
+    return -1.0 * k.FmT * dF.transpose() * k.FmT;
+}
+
+// dJ = Derivative of J with respect to F = J F^{-T}
+LifeV::MatrixSmall<3, 3> dJ (const Kinematics& k)
+{
+    return k.J * k.FmT;
+}
+
+// d2JdF = Second derivative of J in direction dF
+LifeV::MatrixSmall<3, 3> d2JdF (const Kinematics& k, const LifeV::MatrixSmall<3, 3>& dF)
+{
+    return dJ (k).dot (dF) * k.FmT + k.J * dFmTdF (k, dF);
+}
+
+// dI1bar = Derivative of \bar{I}_1 with respect to F
+LifeV::MatrixSmall<3, 3> dI1bar (const Kinematics& k)
+{
+    return 2.0 * k.Jm23 * ( k.F - ( k.I1 / 3.0 ) * k.FmT );
+}
+
+// d2I1bardF = Second derivative of \bar{I}_1 in direction dF
+LifeV::MatrixSmall<3, 3> d2I1bardF (const Kinematics& k, const LifeV::MatrixSmall<3, 3>& dF)
+{
+    LifeV::MatrixSmall<3, 3> dJm23 ( (-2.0 / 3.0) * k.Jm23 * k.FmT );
+    Real dJm23dF = dJm23.dot (dF);
+    LifeV::MatrixSmall<3, 3> d2Jm23dF ( (-2.0 / 3.0) * ( k.Jm23 * dFmTdF (k, dF) + dJm23dF * k.FmT ) );
+
+    return ( 2.0 * dJm23dF ) * k.F
+           + ( 2.0 * k.Jm23 ) * dF
+           + k.I1 * d2Jm23dF
+           + ( 2.0 * k.F.dot (dF) ) * dJm23;
+}
+
+// dI4 = Derivative of I_4 = (F v0) . (F v0) with respect to F, given v = F v0
+LifeV::MatrixSmall<3, 3> dI4 (const LifeV::VectorSmall<3>& v, const LifeV::VectorSmall<3>& v0)
+{
+    return 2.0 * v.outerProduct (v0);
+}
+
+// d2I4dF = Second derivative of I_4 in direction dF
+LifeV::MatrixSmall<3, 3> d2I4dF (const LifeV::VectorSmall<3>& v0, const LifeV::MatrixSmall<3, 3>& dF)
+{
+    return 2.0 * ( dF * v0 ).outerProduct (v0);
+}
+
+// dI8 = Derivative of I_8 = (F v0) . (F w0) with respect to F
+LifeV::MatrixSmall<3, 3> dI8 (const Kinematics& k)
+{
+    return k.F * ( k.f0.outerProduct (k.s0) + k.s0.outerProduct (k.f0) );
+}
+
+// d2I8dF = Second derivative of I_8 in direction dF
+LifeV::MatrixSmall<3, 3> d2I8dF (const Kinematics& k, const LifeV::MatrixSmall<3, 3>& dF)
+{
+    return dF * ( k.f0.outerProduct (k.s0) + k.s0.outerProduct (k.f0) );
+}
+
+
 
 }// Elasticity
 
@@ -39,6 +39,10 @@
 #include <boost/typeof/typeof.hpp>
 #include <lifev/core/array/MatrixSmall.hpp>
 
+#include <Epetra_FECrsGraph.h>
+
+#include <lifev/eta/expression/BuildGraph.hpp>
+
 #include <lifev/core/filter/ExporterHDF5.hpp>
 #include <lifev/structure/solver/StructuralConstitutiveLaw.hpp>
 //#include <lifev/em/solver/mechanics/materials/EMMaterial.hpp>
@@ -94,6 +98,9 @@ public:
     typedef MapEpetra map_Type;
     typedef boost::shared_ptr<map_Type>             mapPtr_Type;
 
+    typedef Epetra_FECrsGraph                       graph_Type;
+    typedef boost::shared_ptr<graph_Type>           graphPtr_Type;
+
     //    typedef EMMaterial<MeshType>                              material_Type;
 
     typedef StructuralConstitutiveLawData          data_Type;
@@ -429,6 +436,9 @@ protected:
 
     vectorPtr_Type                                 M_residualVectorPtr;
 
+    //! Static graph of the jacobian, built once in the setup
+    graphPtr_Type                                  M_jacobianGraph;
+
     //    MatrixSmall<3,3>                               M_identity;
 
     //    std::vector<materialPtr_Type>                M_materialPtrs;
@@ -455,6 +465,7 @@ EMStructuralConstitutiveLaw<MeshType>::EMStructuralConstitutiveLaw() :
     M_passiveMaterialPtr            ( ),
     M_activeStressMaterialPtr       ( ),
     M_residualVectorPtr             ( ),
+    M_jacobianGraph                 ( ),
     M_fiberActivationPtr                 ( )
 {}
 
@@ -482,6 +493,23 @@ EMStructuralConstitutiveLaw<MeshType>::setup ( const FESpacePtr_Type&
     M_residualVectorPtr.reset ( new vector_Type (*this->M_localMap, Repeated) );
     //   M_identity = EMUtility::identity();
 
+    // The sparsity pattern of the jacobian only depends on the mesh and on the
+    // finite element space: we build it once, so that at each Newton iteration
+    // the jacobian is zeroed in place and assembled as a closed matrix
+    {
+        using namespace ExpressionAssembly;
+
+        M_jacobianGraph.reset (new graph_Type (Copy, * (this->M_localMap->map (Unique) ), 0) );
+        buildGraph ( elements ( dETFESpace->mesh() ),
+                     quadRuleTetra4pt,
+                     dETFESpace,
+                     dETFESpace,
+                     dot ( grad (phi_i) , grad (phi_j) )
+                   ) >> M_jacobianGraph;
+        M_jacobianGraph->GlobalAssemble();
+    }
+    this->M_jacobian.reset (new matrix_Type (*this->M_localMap, *M_jacobianGraph) );
+
 //    M_fiberVectorPtr.reset             ( new vector_Type (*this->M_localMap, Repeated) );
 //    M_sheetVectorPtr.reset             ( new vector_Type (*this->M_localMap, Repeated) );
     M_fiberVectorPtr.reset             ( new vector_Type (*this->M_localMap, Unique) );
@@ -538,13 +566,18 @@ void EMStructuralConstitutiveLaw<MeshType>::updateJacobianMatrix ( const vector_
                                                                    const mapMarkerIndexesPtr_Type mapsMarkerIndexes,
                                                                    const displayerPtr_Type& displayer )
 {
-    this->M_jacobian.reset (new matrix_Type (*this->M_localMap) );
+    // The matrix built on the static graph is reused: its values are zeroed
+    // in place and the assembly goes through pushToClosedGlobal
+    if ( !this->M_jacobian || !this->M_jacobian->filled() )
+    {
+        this->M_jacobian.reset (new matrix_Type (*this->M_localMap, *M_jacobianGraph) );
+    }
     //    matrixPtr_Type jac(new matrix_Type(*this->M_localMap));
 
     //displayer->leaderPrint (" \n*********************************\n  ");
     //displayer->leaderPrint (" Non-Linear S-  Computing the EM material  Jacobian"     );
     //displayer->leaderPrint (" \n*********************************\n  ");
-    * (this->M_jacobian) *= 0.0;
+    this->M_jacobian->zero();
     if (M_passiveMaterialPtr)
     {
 
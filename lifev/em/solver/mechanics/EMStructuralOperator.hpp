@@ -165,6 +165,38 @@ public:
 			const ETFESpacePtr_Type dETFESpace,
 			Real pressure, int bdFlag);
 
+    //! Derivative of the residual with respect to a pressure acting on the boundary bdFlag
+    /*!
+      The pressure p gives the traction -p n on the boundary, so that the derivative is
+      J F^{-T} N . phi_i (followerLoad = true) or N . phi_i (followerLoad = false,
+      pressure given on the reference configuration, as a BCVector of type 1).
+     */
+    void computePressureLoadSensitivity(vector_Type& loadSensitivity, int bdFlag, bool followerLoad = true);
+
+    //! Solve the tangent problem for several right hand sides
+    /*!
+      The system is solved with the last assembled jacobian, reusing its preconditioner,
+      in a single block solve for all the right hand sides.
+      The essential b.c. are homogeneous on the solution.
+      @param rhs right hand sides
+      @param solution solutions (same size as rhs)
+     */
+    void solveTangent(const std::vector<vectorPtr_Type>& rhs, std::vector<vectorPtr_Type>& solution);
+
+    //! Sensitivity of the cavity volumes with respect to the cavity pressures
+    /*!
+      Computes dV_i/dp_j = - dV_i/du . K^{-1} dR/dp_j, K being the last assembled jacobian,
+      with a single tangent solve for all the cavities. It replaces the finite difference
+      of the volumes obtained with a linearized mechanics solve for each perturbed pressure.
+      @param volumeGradients dV_i/du for each cavity (see VolumeIntegrator::volumeGradient)
+      @param bdFlags boundary flags of the pressure of each cavity
+      @param followerLoad see computePressureLoadSensitivity
+      @return the matrix dV/dp, stored by rows
+     */
+    std::vector<std::vector<Real> > volumePressureSensitivity(const std::vector<vectorPtr_Type>& volumeGradients,
+                                                              const std::vector<std::vector<int> >& bdFlags,
+                                                              bool followerLoad = true);
+
 
     void evalResidual ( vector_Type& residual, const vector_Type& solution, Int iter);
 
@@ -390,7 +422,105 @@ solveLin ()
     
     *this->M_disp -= step;
 }
-    
+
+template <typename Mesh>
+void EMStructuralOperator<Mesh>::
+computePressureLoadSensitivity (vector_Type& loadSensitivity, int bdFlag, bool followerLoad)
+{
+    vectorPtr_Type loadPtr ( new vector_Type ( this->M_disp->map() ) );
+
+    if ( followerLoad )
+    {
+        computePressureBC ( *this->M_disp, loadPtr, this->M_dispETFESpace, 1.0, bdFlag );
+    }
+    else
+    {
+        vector_Type zeroDisp ( this->M_disp->map() );
+        zeroDisp *= 0.0;
+        computePressureBC ( zeroDisp, loadPtr, this->M_dispETFESpace, 1.0, bdFlag );
+    }
+
+    loadSensitivity = *loadPtr;
+}
+
+template <typename Mesh>
+void EMStructuralOperator<Mesh>::
+solveTangent (const std::vector<vectorPtr_Type>& rhs, std::vector<vectorPtr_Type>& solution)
+{
+    ASSERT ( rhs.size() == solution.size(), "EMStructuralOperator::solveTangent: rhs and solution sizes differ" );
+
+    matrixPtr_Type matrFull ( new matrix_Type (*this->M_localMap) );
+    *matrFull += *this->M_jacobian;
+
+    if ( !this->M_BCh->bcUpdateDone() )
+    {
+        this->M_BCh->bcUpdate ( *this->M_dispFESpace->mesh(), this->M_dispFESpace->feBd(), this->M_dispFESpace->dof() );
+    }
+    bcManageMatrix ( *matrFull, *this->M_dispFESpace->mesh(), this->M_dispFESpace->dof(), *this->M_BCh, this->M_dispFESpace->feBd(), 1.0 );
+
+    // The jacobian is the one of the last solve: its preconditioner is kept
+    const bool reusePreconditioner ( this->M_linearSolver->reusePreconditioner() );
+    this->M_linearSolver->setReusePreconditioner ( true );
+    this->M_linearSolver->setOperator ( matrFull );
+
+    // All the right hand sides in one block, solved together
+    const Epetra_Map& map ( *this->M_localMap->map ( Unique ) );
+    Epetra_MultiVector rhsBlock ( map, rhs.size() );
+    for ( UInt i (0); i < rhs.size(); ++i )
+    {
+        vector_Type rhsBC ( *rhs[i], Unique );
+        bcEssentialManageRhs ( rhsBC, this->M_dispFESpace->dof(), *this->M_BCh, 0.0, this->M_data->dataTime()->time() );
+        rhsBlock ( i )->Update ( 1., rhsBC.epetraVector(), 0. );
+    }
+
+    Epetra_MultiVector solutionBlock ( map, rhs.size() );
+    this->M_linearSolver->solve ( rhsBlock, solutionBlock );
+
+    for ( UInt i (0); i < rhs.size(); ++i )
+    {
+        solution[i].reset ( new vector_Type ( *this->M_localMap, Unique ) );
+        solution[i]->epetraVector().Update ( 1., *solutionBlock ( i ), 0. );
+    }
+
+    this->M_linearSolver->setReusePreconditioner ( reusePreconditioner );
+}
+
+template <typename Mesh>
+std::vector<std::vector<Real> > EMStructuralOperator<Mesh>::
+volumePressureSensitivity (const std::vector<vectorPtr_Type>& volumeGradients, const std::vector<std::vector<int> >& bdFlags, bool followerLoad)
+{
+    const UInt nCavities ( bdFlags.size() );
+
+    // du/dp_j = - K^{-1} dR/dp_j
+    std::vector<vectorPtr_Type> loadSensitivities ( nCavities );
+    vector_Type flagLoadSensitivity ( this->M_disp->map() );
+    for ( UInt j (0); j < nCavities; ++j )
+    {
+        loadSensitivities[j].reset ( new vector_Type ( this->M_disp->map() ) );
+        *loadSensitivities[j] *= 0.0;
+        for ( auto& bdFlag : bdFlags[j] )
+        {
+            computePressureLoadSensitivity ( flagLoadSensitivity, bdFlag, followerLoad );
+            *loadSensitivities[j] -= flagLoadSensitivity;
+        }
+    }
+
+    std::vector<vectorPtr_Type> dispSensitivities ( nCavities );
+    solveTangent ( loadSensitivities, dispSensitivities );
+
+    // dV_i/dp_j = dV_i/du . du/dp_j
+    std::vector<std::vector<Real> > sensitivity ( volumeGradients.size(), std::vector<Real> ( nCavities, 0.0 ) );
+    for ( UInt i (0); i < volumeGradients.size(); ++i )
+    {
+        for ( UInt j (0); j < nCavities; ++j )
+        {
+            sensitivity[i][j] = volumeGradients[i]->dot ( *dispSensitivities[j] );
+        }
+    }
+
+    return sensitivity;
+}
+
 template <typename Mesh>
 void EMStructuralOperator<Mesh>::computePressureBCJacobian(const VectorEpetra& disp,
 		matrixPtr_Type& jacobian,
@@ -50,6 +50,9 @@ public:
     typedef EMData          data_Type;
     typedef typename boost::shared_ptr<data_Type>  dataPtr_Type;
 
+    typedef MaterialFunctions::EMFusedMaterialFunctions<Mesh> fusedFunctions_Type;
+    typedef boost::shared_ptr<fusedFunctions_Type> fusedFunctionsPtr_Type;
+
     EMMaterialType (std::string materialName, UInt n);
     virtual ~EMMaterialType()   {}
 
@@ -63,6 +66,17 @@ public:
         return M_materialFunctionList;
     }
 
+    //! Assemble all the functions with pointwise stress kernels in a single loop over the elements
+    inline void setFusedAssembly (bool fusedAssembly)
+    {
+        M_fusedAssembly = fusedAssembly;
+    }
+
+    inline bool fusedAssembly() const
+    {
+        return M_fusedAssembly;
+    }
+
     virtual void
     computeJacobian ( const vector_Type& disp,
                       ETFESpacePtr_Type dispETFESpace,
@@ -137,11 +151,29 @@ public:
         {
             M_materialFunctionList[j]->setParameters(data);
         }
+        M_fusedAssembly = data.solidParameter<bool>("FusedAssembly");
     }
 
 protected:
+
+    //! Collect the functions providing pointwise stress kernels in a single functor
+    fusedFunctionsPtr_Type fusedFunctions() const
+    {
+        fusedFunctionsPtr_Type fused (new fusedFunctions_Type);
+        int n = M_materialFunctionList.size();
+        for (int j (0); j < n; j++)
+        {
+            if (M_materialFunctionList[j]->hasPointwiseStress() )
+            {
+                fused->add (M_materialFunctionList[j]);
+            }
+        }
+        return fused;
+    }
+
     std::string M_materialName;
     vectorMaterialsPtr_Type M_materialFunctionList;
+    bool M_fusedAssembly;
 
 };
 
@@ -149,7 +181,8 @@ protected:
 template<typename Mesh>
 EMMaterialType<Mesh>::EMMaterialType (std::string materialName, UInt n ) :
     M_materialName (materialName),
-    M_materialFunctionList (n)
+    M_materialFunctionList (n),
+    M_fusedAssembly (false)
 {
 	std::cout << "\nCreating: " << materialName << " with " << n << " functions.\n";
 }
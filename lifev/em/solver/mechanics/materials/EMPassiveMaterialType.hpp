@@ -103,6 +103,25 @@ EMPassiveMaterialType<Mesh>::computeJacobian ( const vector_Type& disp,
                                         matrixPtr_Type           jacobianPtr)
 {
     int n = this->M_materialFunctionList.size();
+    if (this->M_fusedAssembly)
+    {
+        // Single loop over the elements for the functions with pointwise kernels,
+        // one loop per function for the others
+        typename super::fusedFunctionsPtr_Type fused (this->fusedFunctions() );
+        for (int j (0); j < n; j++)
+        {
+            if (!this->M_materialFunctionList[j]->hasPointwiseStress() )
+            {
+                this->M_materialFunctionList[j]->computeJacobian (disp, dispETFESpace, fibers, sheets, jacobianPtr);
+            }
+        }
+        if (fused->size() > 0)
+        {
+            EMAssembler::computeFusedJacobianTerms (disp, dispETFESpace, fibers, sheets, jacobianPtr, fused);
+        }
+        return;
+    }
+
     for (int j (0); j < n; j++)
     {
     	this->M_materialFunctionList[j]->computeJacobian (disp, dispETFESpace, fibers, sheets, jacobianPtr);
@@ -148,6 +167,23 @@ EMPassiveMaterialType<Mesh>::computeResidual ( const vector_Type& disp,
         //std::cout << "EM Material Type: dispETFESpace available\n";
     }
     int n = this->M_materialFunctionList.size();
+    if (this->M_fusedAssembly)
+    {
+        typename super::fusedFunctionsPtr_Type fused (this->fusedFunctions() );
+        for (int j (0); j < n; j++)
+        {
+            if (!this->M_materialFunctionList[j]->hasPointwiseStress() )
+            {
+                this->M_materialFunctionList[j]->computeResidual (disp, dispETFESpace, fibers, sheets, residualVectorPtr);
+            }
+        }
+        if (fused->size() > 0)
+        {
+            EMAssembler::computeFusedResidualTerms (disp, dispETFESpace, fibers, sheets, residualVectorPtr, fused);
+        }
+        return;
+    }
+
     for (int j (0); j < n; j++)
     {
     	//std::cout << "Passive residual function " << j << " = " << residualVectorPtr->norm2() << "\n";
@@ -187,12 +187,85 @@ public:
                                           vectorPtr_Type           residualVectorPtr) {}
 
 
+    //! Tell if the function provides the pointwise stress kernels used by the fused assembly
+    virtual bool hasPointwiseStress() const
+    {
+        return false;
+    }
+
+    //! Add the contribution of the function to the first Piola-Kirchhoff stress tensor
+    virtual void addPointwiseStress (const Elasticity::Kinematics& k, MatrixSmall<3, 3>& P) {}
+
+    //! Add the contribution of the function to the derivative of the stress tensor in direction dF
+    virtual void addPointwiseStressDerivative (const Elasticity::Kinematics& k,
+                                               const MatrixSmall<3, 3>& dF,
+                                               MatrixSmall<3, 3>& dP) {}
+
     virtual void showMe() { std::cout << "\nYuo should implement the showMe() method for your constitutive law!\n"; }
 
     virtual void setParameters (data_Type& data) = 0;
 
 };
 
+
+//! EMFusedMaterialFunctions
+/*!
+ *  Functor summing the pointwise stress kernels of a list of material functions.
+ *  It allows to assemble the residual (or the jacobian) of a material made of
+ *  several functions with a single loop over the elements and a single
+ *  communication of the elemental contributions, instead of one loop per function.
+ *  The fibers and the sheets given to the functor must be already orthonormalized.
+ */
+template <class Mesh>
+class EMFusedMaterialFunctions
+{
+public:
+    typedef MatrixSmall<3, 3> return_Type;
+    typedef boost::shared_ptr<EMMaterialFunctions<Mesh> > materialFunctionsPtr_Type;
+
+    EMFusedMaterialFunctions() {}
+    ~EMFusedMaterialFunctions() {}
+
+    //! Add a function to the list of fused functions
+    void add (const materialFunctionsPtr_Type& function)
+    {
+        M_functionList.push_back (function);
+    }
+
+    //! Number of fused functions
+    UInt size() const
+    {
+        return M_functionList.size();
+    }
+
+    //! Stress tensor
+    return_Type operator() (const MatrixSmall<3, 3>& F, const VectorSmall<3>& f0, const VectorSmall<3>& s0)
+    {
+        Elasticity::Kinematics k (F, f0, s0);
+        return_Type P;
+        for (UInt j (0); j < M_functionList.size(); j++)
+        {
+            M_functionList[j]->addPointwiseStress (k, P);
+        }
+        return P;
+    }
+
+    //! Derivative of the stress tensor in direction dF
+    return_Type operator() (const MatrixSmall<3, 3>& F, const VectorSmall<3>& f0, const VectorSmall<3>& s0, const MatrixSmall<3, 3>& dF)
+    {
+        Elasticity::Kinematics k (F, f0, s0);
+        return_Type dP;
+        for (UInt j (0); j < M_functionList.size(); j++)
+        {
+            M_functionList[j]->addPointwiseStressDerivative (k, dF, dP);
+        }
+        return dP;
+    }
+
+private:
+    std::vector<materialFunctionsPtr_Type> M_functionList;
+};
+
 } //EMMaterialFunctions
 
 } //LifeV
@@ -166,6 +166,25 @@ public:
         }
     }
 
+    virtual bool hasPointwiseStress() const
+    {
+        return true;
+    }
+
+    virtual void addPointwiseStress (const Elasticity::Kinematics& k, MatrixSmall<3, 3>& P)
+    {
+        const VectorSmall<3>& v0 = (M_anisotropyField == Fibers) ? k.f0 : k.s0;
+        const VectorSmall<3>& v  = (M_anisotropyField == Fibers) ? k.f  : k.s;
+        P += (*this) (v.dot (v) ) * Elasticity::dI4 (v, v0);
+    }
+
+    virtual void addPointwiseStressDerivative (const Elasticity::Kinematics& k, const MatrixSmall<3, 3>& dF, MatrixSmall<3, 3>& dP)
+    {
+        const VectorSmall<3>& v0 = (M_anisotropyField == Fibers) ? k.f0 : k.s0;
+        const VectorSmall<3>& v  = (M_anisotropyField == Fibers) ? k.f  : k.s;
+        dP += (*this) (v.dot (v) ) * Elasticity::d2I4dF (v0, dF);
+    }
+
     void showMe()
     {
         std::cout << "Anisotropic Exponential Function\n";
@@ -283,6 +302,18 @@ public:
         }
     }
 
+    virtual void addPointwiseStress (const Elasticity::Kinematics& k, MatrixSmall<3, 3>& P)
+    {
+    }
+
+    virtual void addPointwiseStressDerivative (const Elasticity::Kinematics& k, const MatrixSmall<3, 3>& dF, MatrixSmall<3, 3>& dP)
+    {
+        const VectorSmall<3>& v0 = (this->M_anisotropyField == super::Fibers) ? k.f0 : k.s0;
+        const VectorSmall<3>& v  = (this->M_anisotropyField == super::Fibers) ? k.f  : k.s;
+        MatrixSmall<3, 3> dI4 (Elasticity::dI4 (v, v0) );
+        dP += (*this) (v.dot (v) ) * dI4.dot (dF) * dI4;
+    }
+
     void showMe()
     {
         std::cout << "Derivative Anisotropic Exponential Function\n";
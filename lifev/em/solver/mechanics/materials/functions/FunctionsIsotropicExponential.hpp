@@ -73,6 +73,21 @@ public:
         EMAssembler::computeI1ResidualTerms (disp, dispETFESpace, residualVectorPtr, this->getMe() );
     }
 
+    virtual bool hasPointwiseStress() const
+    {
+        return true;
+    }
+
+    virtual void addPointwiseStress (const Elasticity::Kinematics& k, MatrixSmall<3, 3>& P)
+    {
+        P += (*this) (k.F) * Elasticity::dI1bar (k);
+    }
+
+    virtual void addPointwiseStressDerivative (const Elasticity::Kinematics& k, const MatrixSmall<3, 3>& dF, MatrixSmall<3, 3>& dP)
+    {
+        dP += (*this) (k.F) * Elasticity::d2I1bardF (k, dF);
+    }
+
     void showMe()
     {
         std::cout << "Isotropic Exponential Function\n";
@@ -122,6 +137,17 @@ public:
         EMAssembler::computeI1JacobianTermsSecondDerivative (disp, dispETFESpace, jacobianPtr, this->getMe() );
     }
 
+    virtual bool hasPointwiseStress() const
+    {
+        return true;
+    }
+
+    virtual void addPointwiseStressDerivative (const Elasticity::Kinematics& k, const MatrixSmall<3, 3>& dF, MatrixSmall<3, 3>& dP)
+    {
+        MatrixSmall<3, 3> dI1bar (Elasticity::dI1bar (k) );
+        dP += (*this) (k.F) * dI1bar.dot (dF) * dI1bar;
+    }
+
     void showMe()
     {
         std::cout << "Derivative Isotropic Exponential Function\n";
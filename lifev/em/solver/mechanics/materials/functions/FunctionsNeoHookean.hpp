@@ -98,6 +98,21 @@ public:
         EMAssembler::computeI1ResidualTerms ( disp, dispETFESpace, residualVectorPtr, M_W1 );
     }
 
+    virtual bool hasPointwiseStress() const
+    {
+        return true;
+    }
+
+    virtual void addPointwiseStress (const Elasticity::Kinematics& k, MatrixSmall<3, 3>& P)
+    {
+        P += (*M_W1) (k.F) * Elasticity::dI1bar (k);
+    }
+
+    virtual void addPointwiseStressDerivative (const Elasticity::Kinematics& k, const MatrixSmall<3, 3>& dF, MatrixSmall<3, 3>& dP)
+    {
+        dP += (*M_W1) (k.F) * Elasticity::d2I1bardF (k, dF);
+    }
+
     virtual void setParameters (data_Type& data)
     {
     	M_W1->setMu( data.solidParameter<Real>("mu") );
@@ -83,6 +83,21 @@ public:
         EMAssembler::computeI8ResidualTerms (disp, dispETFESpace, fibers, sheets, residualVectorPtr, this->getMe() );
     }
 
+    virtual bool hasPointwiseStress() const
+    {
+        return true;
+    }
+
+    virtual void addPointwiseStress (const Elasticity::Kinematics& k, MatrixSmall<3, 3>& P)
+    {
+        P += (*this) (k.f.dot (k.s) ) * Elasticity::dI8 (k);
+    }
+
+    virtual void addPointwiseStressDerivative (const Elasticity::Kinematics& k, const MatrixSmall<3, 3>& dF, MatrixSmall<3, 3>& dP)
+    {
+        dP += (*this) (k.f.dot (k.s) ) * Elasticity::d2I8dF (k, dF);
+    }
+
     void showMe()
     {
         std::cout << "Shear Exponential Function\n";
@@ -145,6 +160,17 @@ public:
         EMAssembler::computeI8JacobianTermsSecondDerivative (disp, dispETFESpace, fibers, sheets, jacobianPtr, this->getMe() );
     }
 
+    virtual bool hasPointwiseStress() const
+    {
+        return true;
+    }
+
+    virtual void addPointwiseStressDerivative (const Elasticity::Kinematics& k, const MatrixSmall<3, 3>& dF, MatrixSmall<3, 3>& dP)
+    {
+        MatrixSmall<3, 3> dI8 (Elasticity::dI8 (k) );
+        dP += (*this) (k.f.dot (k.s) ) * dI8.dot (dF) * dI8;
+    }
+
     void showMe()
     {
         std::cout << "Derivative Shear Exponential Function\n";
@@ -72,6 +72,21 @@ public:
         EMAssembler::computeVolumetricResidualTerms (disp, dispETFESpace, residualVectorPtr, this->getMe() );
     }
 
+    virtual bool hasPointwiseStress() const
+    {
+        return true;
+    }
+
+    virtual void addPointwiseStress (const Elasticity::Kinematics& k, MatrixSmall<3, 3>& P)
+    {
+        P += (*this) (k.F) * Elasticity::dJ (k);
+    }
+
+    virtual void addPointwiseStressDerivative (const Elasticity::Kinematics& k, const MatrixSmall<3, 3>& dF, MatrixSmall<3, 3>& dP)
+    {
+        dP += (*this) (k.F) * Elasticity::d2JdF (k, dF);
+    }
+
     typedef EMData          data_Type;
     void setParameters (data_Type& data)
     {
@@ -114,6 +129,17 @@ public:
         EMAssembler::computeVolumetricJacobianTermsSecondDerivative (disp, dispETFESpace, jacobianPtr, this->getMe() );
     }
 
+    virtual bool hasPointwiseStress() const
+    {
+        return true;
+    }
+
+    virtual void addPointwiseStressDerivative (const Elasticity::Kinematics& k, const MatrixSmall<3, 3>& dF, MatrixSmall<3, 3>& dP)
+    {
+        MatrixSmall<3, 3> dJ (Elasticity::dJ (k) );
+        dP += (*this) (k.F) * dJ.dot (dF) * dJ;
+    }
+
     typedef EMData          data_Type;
     void setParameters (data_Type& data)
     {
@@ -0,0 +1,215 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Fused assembly of the passive materials against the per-function assembly
+
+    @date 10-2026
+
+    The residual and the jacobian of the passive Holzapfel-Ogden material
+    (volumetric, isotropic exponential, anisotropic exponential on fibers and
+    sheets, shear exponential) and of the passive neo-Hookean material are
+    assembled on a deformed unit cube with the fused pointwise kernels and with
+    one ETA expression per material function. The two must agree to round-off.
+ */
+
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <cmath>
+
+#include <lifev/core/LifeV.hpp>
+
+#include <lifev/core/mesh/RegionMesh3DStructured.hpp>
+#include <lifev/core/mesh/MeshPartitioner.hpp>
+#include <lifev/core/fem/FESpace.hpp>
+#include <lifev/eta/fem/ETFESpace.hpp>
+
+#include <lifev/em/solver/mechanics/materials/MaterialsList.hpp>
+
+using namespace LifeV;
+
+#define FUSED_ASSEMBLY_TOLERANCE 1e-11
+
+namespace
+{
+
+typedef RegionMesh<LinearTetra>                                 mesh_Type;
+typedef EMPassiveMaterialType<mesh_Type>                        material_Type;
+typedef material_Type::vector_Type                              vector_Type;
+typedef material_Type::vectorPtr_Type                           vectorPtr_Type;
+typedef material_Type::matrix_Type                              matrix_Type;
+typedef material_Type::matrixPtr_Type                           matrixPtr_Type;
+typedef FESpace<mesh_Type, MapEpetra>                           solidFESpace_Type;
+typedef ETFESpace<mesh_Type, MapEpetra, 3, 3>                   solidETFESpace_Type;
+
+// Smooth displacement with stretch, shear and some torsion
+Real displacement ( const Real& /*t*/, const Real& x, const Real& y, const Real& z, const ID& i )
+{
+    switch ( i )
+    {
+        case 0:
+            return 0.08 * x + 0.05 * y * z - 0.03 * std::sin ( 2. * y );
+        case 1:
+            return -0.04 * y + 0.06 * x * z + 0.02 * std::cos ( 3. * z );
+        case 2:
+            return 0.03 * z * z - 0.05 * x * y;
+        default:
+            return 0.;
+    }
+}
+
+// Fibers rotating across the wall, sheets orthogonal to them
+Real fiber ( const Real& /*t*/, const Real& /*x*/, const Real& /*y*/, const Real& z, const ID& i )
+{
+    const Real angle ( M_PI / 3. * ( 2. * z - 1. ) );
+    return i == 0 ? std::cos ( angle ) : ( i == 1 ? std::sin ( angle ) : 0. );
+}
+
+Real sheet ( const Real& /*t*/, const Real& /*x*/, const Real& /*y*/, const Real& z, const ID& i )
+{
+    const Real angle ( M_PI / 3. * ( 2. * z - 1. ) );
+    return i == 0 ? -std::sin ( angle ) : ( i == 1 ? std::cos ( angle ) : 0. );
+}
+
+// Relative differences of the residual and of the jacobian assembled with and without the fused kernels
+void fusedAssemblyDifference ( const std::string& materialName,
+                               const boost::shared_ptr<solidFESpace_Type>& dFESpace,
+                               const boost::shared_ptr<solidETFESpace_Type>& dETFESpace,
+                               const vector_Type& disp, const vector_Type& fibers, const vector_Type& sheets,
+                               Real& residualDifference, Real& jacobianDifference )
+{
+    boost::shared_ptr<material_Type> material ( material_Type::EMPassiveMaterialFactory::instance().createObject ( materialName ) );
+
+    std::vector<vectorPtr_Type> residuals ( 2 );
+    std::vector<matrixPtr_Type> jacobians ( 2 );
+    for ( UInt fused (0); fused < 2; ++fused )
+    {
+        material->setFusedAssembly ( fused == 1 );
+
+        residuals[fused].reset ( new vector_Type ( dFESpace->map(), Repeated ) );
+        material->computeResidual ( disp, dETFESpace, fibers, sheets, residuals[fused] );
+        residuals[fused]->globalAssemble();
+
+        jacobians[fused].reset ( new matrix_Type ( dFESpace->map() ) );
+        material->computeJacobian ( disp, dETFESpace, fibers, sheets, jacobians[fused] );
+        jacobians[fused]->globalAssemble();
+    }
+
+    const Real residualNorm ( residuals[0]->normInf() );
+    const Real jacobianNorm ( jacobians[0]->normInf() );
+
+    *residuals[1] -= *residuals[0];
+    *jacobians[1] -= *jacobians[0];
+
+    residualDifference = residuals[1]->normInf() / residualNorm;
+    jacobianDifference = jacobians[1]->normInf() / jacobianNorm;
+}
+
+}
+
+int main ( int argc, char** argv )
+{
+
+#ifdef HAVE_MPI
+    MPI_Init ( &argc, &argv );
+#endif
+
+    boost::shared_ptr<Epetra_Comm> comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+    const bool verbose ( comm->MyPID() == 0 );
+
+    //===========================================================
+    //              MESH AND SPACES
+    //===========================================================
+    boost::shared_ptr<mesh_Type> fullMesh ( new mesh_Type ( comm ) );
+    regularMesh3D ( *fullMesh, 1, 4, 4, 4, false,
+                    1.0, 1.0, 1.0,
+                    0.0, 0.0, 0.0 );
+
+    boost::shared_ptr<mesh_Type> localMesh;
+    {
+        MeshPartitioner<mesh_Type> meshPart ( fullMesh, comm );
+        localMesh = meshPart.meshPartition();
+    }
+    fullMesh.reset();
+
+    boost::shared_ptr<solidFESpace_Type> dFESpace ( new solidFESpace_Type ( localMesh, "P1", 3, comm ) );
+    boost::shared_ptr<solidETFESpace_Type> dETFESpace ( new solidETFESpace_Type ( localMesh, & ( dFESpace->refFE() ), & ( dFESpace->fe().geoMap() ), comm ) );
+
+    vector_Type disp ( dFESpace->map(), Unique );
+    vector_Type fibers ( dFESpace->map(), Unique );
+    vector_Type sheets ( dFESpace->map(), Unique );
+    dFESpace->interpolate ( static_cast<solidFESpace_Type::function_Type> ( displacement ), disp, 0.0 );
+    dFESpace->interpolate ( static_cast<solidFESpace_Type::function_Type> ( fiber ), fibers, 0.0 );
+    dFESpace->interpolate ( static_cast<solidFESpace_Type::function_Type> ( sheet ), sheets, 0.0 );
+
+    const vector_Type dispRepeated ( disp, Repeated );
+    const vector_Type fibersRepeated ( fibers, Repeated );
+    const vector_Type sheetsRepeated ( sheets, Repeated );
+
+    //===========================================================
+    //              FUSED AGAINST PER-FUNCTION ASSEMBLY
+    //===========================================================
+    std::vector<std::string> materials;
+    materials.push_back ( "PHO" );
+    materials.push_back ( "PNH" );
+
+    bool success (true);
+    for ( UInt m (0); m < materials.size(); ++m )
+    {
+        Real residualDifference (0.), jacobianDifference (0.);
+        fusedAssemblyDifference ( materials[m], dFESpace, dETFESpace, dispRepeated, fibersRepeated, sheetsRepeated,
+                                  residualDifference, jacobianDifference );
+
+        if ( verbose )
+        {
+            std::cout << "\n" << materials[m] << ": relative difference of the residual " << residualDifference
+                      << ", of the jacobian " << jacobianDifference << std::endl;
+        }
+        success = success && residualDifference <= FUSED_ASSEMBLY_TOLERANCE && jacobianDifference <= FUSED_ASSEMBLY_TOLERANCE;
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    if ( !success )
+    {
+        if ( verbose )
+        {
+            std::cout << "\nTest Failed!\n";
+        }
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+#undef FUSED_ASSEMBLY_TOLERANCE
@@ -0,0 +1,225 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Analytic cavity volume sensitivity against finite differences
+
+    @date 10-2026
+
+    An ellipsoidal cavity, clamped at the base, is inflated by a pressure on its
+    endocardium given on the reference configuration. At the inflated state the
+    derivative of the cavity volume with respect to the pressure is computed with
+    EMStructuralOperator::volumePressureSensitivity (one tangent solve) and with
+    the central finite difference of the volumes obtained by linearized mechanics
+    solves at the perturbed pressures, as the coupling with the circulation does
+    when the analytic jacobian is not used. The two must agree.
+ */
+
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <cmath>
+
+#include <lifev/core/LifeV.hpp>
+
+#include <lifev/core/mesh/MeshLoadingUtility.hpp>
+#include <lifev/core/fem/BCVector.hpp>
+#include <lifev/eta/fem/ETFESpace.hpp>
+
+#include <lifev/structure/solver/StructuralConstitutiveLawData.hpp>
+#include <lifev/bc_interface/3D/bc/BCInterface3D.hpp>
+
+#include <lifev/em/solver/EMData.hpp>
+#include <lifev/em/solver/mechanics/EMStructuralOperator.hpp>
+#include <lifev/em/solver/mechanics/EMStructuralConstitutiveLaw.hpp>
+#include <lifev/em/solver/circulation/CirculationVolumeIntegrator.hpp>
+
+using namespace LifeV;
+
+int main ( int argc, char** argv )
+{
+#ifdef HAVE_MPI
+    MPI_Init ( &argc, &argv );
+    boost::shared_ptr<Epetra_Comm> comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+#else
+    boost::shared_ptr<Epetra_Comm> comm ( new Epetra_SerialComm );
+#endif
+
+    const bool verbose ( comm->MyPID() == 0 );
+
+    typedef RegionMesh<LinearTetra>                                 mesh_Type;
+    typedef boost::shared_ptr<mesh_Type>                            meshPtr_Type;
+    typedef VectorEpetra                                            vector_Type;
+    typedef boost::shared_ptr<vector_Type>                          vectorPtr_Type;
+    typedef FESpace<mesh_Type, MapEpetra>                           solidFESpace_Type;
+    typedef boost::shared_ptr<solidFESpace_Type>                    solidFESpacePtr_Type;
+    typedef ETFESpace<mesh_Type, MapEpetra, 3, 3>                   solidETFESpace_Type;
+    typedef boost::shared_ptr<solidETFESpace_Type>                  solidETFESpacePtr_Type;
+    typedef ETFESpace<mesh_Type, MapEpetra, 3, 1>                   scalarETFESpace_Type;
+    typedef boost::shared_ptr<scalarETFESpace_Type>                 scalarETFESpacePtr_Type;
+    typedef BCInterface3D<BCHandler, StructuralOperator<mesh_Type> > bcInterface_Type;
+    typedef boost::shared_ptr<bcInterface_Type>                     bcInterfacePtr_Type;
+    typedef boost::shared_ptr<BCVector>                             bcVectorPtr_Type;
+
+    //===========================================================
+    //              DATA AND MESH
+    //===========================================================
+    GetPot command_line ( argc, argv );
+    const std::string data_file_name = command_line.follow ( "data", 2, "-f", "--file" );
+    GetPot dataFile ( data_file_name );
+
+    EMData emdata;
+    emdata.setup ( dataFile );
+
+    const std::string meshName = dataFile ( "solid/space_discretization/mesh_file", "" );
+    const std::string meshPath = dataFile ( "solid/space_discretization/mesh_dir", "./" );
+
+    meshPtr_Type localMesh ( new mesh_Type ( comm ) );
+    meshPtr_Type fullMesh ( new mesh_Type ( comm ) );
+    MeshUtility::loadMesh ( localMesh, fullMesh, meshName, meshPath );
+
+    //===========================================================
+    //              SPACES
+    //===========================================================
+    const std::string dOrder = dataFile ( "solid/space_discretization/order", "P1" );
+    solidFESpacePtr_Type dFESpace ( new solidFESpace_Type ( localMesh, dOrder, 3, comm ) );
+    solidETFESpacePtr_Type dETFESpace ( new solidETFESpace_Type ( localMesh, & ( dFESpace->refFE() ), & ( dFESpace->fe().geoMap() ), comm ) );
+    scalarETFESpacePtr_Type scalarETFESpace ( new scalarETFESpace_Type ( localMesh, & ( dFESpace->refFE() ), & ( dFESpace->fe().geoMap() ), comm ) );
+
+    //===========================================================
+    //              BOUNDARY CONDITIONS
+    //===========================================================
+    bcInterfacePtr_Type solidBC ( new bcInterface_Type() );
+    solidBC->createHandler();
+    solidBC->fillHandler ( data_file_name, "solid" );
+
+    // Endocardial pressure on the reference configuration, as in the heart example
+    const ID endocardiumFlag = dataFile ( "solid/boundary_conditions/endocardium_flag", 100 );
+    vectorPtr_Type pVec ( new vector_Type ( dFESpace->map(), Repeated ) );
+    *pVec *= 0.0;
+    bcVectorPtr_Type pBCVec ( new BCVector ( *pVec, dFESpace->dof().numTotalDof(), 1 ) );
+    solidBC->handler()->addBC ( "Endocardium", endocardiumFlag, Natural, Full, *pBCVec, 3 );
+
+    auto modifyPressureBC = [&] ( const Real pressure )
+    {
+        *pVec = - pressure;
+        pBCVec.reset ( new BCVector ( *pVec, dFESpace->dof().numTotalDof(), 1 ) );
+        solidBC->handler()->modifyBC ( endocardiumFlag, *pBCVec );
+        solidBC->handler()->bcUpdate ( *dFESpace->mesh(), dFESpace->feBd(), dFESpace->dof() );
+    };
+
+    solidBC->handler()->bcUpdate ( *dFESpace->mesh(), dFESpace->feBd(), dFESpace->dof() );
+
+    //===========================================================
+    //              SOLID MECHANICS
+    //===========================================================
+    boost::shared_ptr<StructuralConstitutiveLawData> dataStructure ( new StructuralConstitutiveLawData() );
+    dataStructure->setup ( dataFile );
+
+    EMStructuralOperator<mesh_Type> solid;
+    solid.setup ( dataStructure, dFESpace, dETFESpace, solidBC->handler(), comm );
+    solid.setDataFromGetPot ( dataFile );
+    solid.EMMaterial()->setParameters ( emdata );
+    solid.EMMaterial()->setupFiberVector ( 1.0, 0.0, 0.0 );
+    solid.EMMaterial()->setupSheetVector ( 0.0, 1.0, 0.0 );
+    solid.setNewtonParameters ( dataFile );
+    solid.buildSystem ( 1.0 );
+
+    //===========================================================
+    //              INFLATION
+    //===========================================================
+    const Real pressure = dataFile ( "solid/boundary_conditions/pressure", 1000. );
+    const UInt loadSteps = dataFile ( "solid/boundary_conditions/load_steps", 4 );
+    for ( UInt step (1); step <= loadSteps; ++step )
+    {
+        modifyPressureBC ( pressure * step / loadSteps );
+        solid.iterate ( solidBC->handler() );
+    }
+
+    vector_Type& disp = solid.displacement();
+    const vector_Type dispInflated ( disp );
+
+    VolumeIntegrator cavity ( std::vector<int> ( 1, endocardiumFlag ), "Cavity", fullMesh, localMesh, scalarETFESpace, dFESpace );
+
+    //===========================================================
+    //              ANALYTIC SENSITIVITY
+    //===========================================================
+    std::vector<vectorPtr_Type> volumeGradients ( 1, vectorPtr_Type ( new vector_Type ( disp.map() ) ) );
+    cavity.volumeGradient ( disp, dETFESpace, volumeGradients[0] );
+
+    const std::vector<std::vector<Real> > dVdp =
+        solid.volumePressureSensitivity ( volumeGradients, std::vector<std::vector<int> > ( 1, std::vector<int> ( 1, endocardiumFlag ) ), false );
+
+    //===========================================================
+    //              FINITE DIFFERENCE SENSITIVITY
+    //===========================================================
+    // Linearized solves from the inflated state: the residual is linear in the
+    // pressure, so that the central difference is exact up to the curvature of the volume
+    const Real dp = dataFile ( "solid/boundary_conditions/pressure_increment", 10. );
+
+    modifyPressureBC ( pressure + dp );
+    solid.solveLin();
+    const Real volumePlus = cavity.volume ( disp, dETFESpace );
+    disp = dispInflated;
+
+    modifyPressureBC ( pressure - dp );
+    solid.solveLin();
+    const Real volumeMinus = cavity.volume ( disp, dETFESpace );
+    disp = dispInflated;
+
+    modifyPressureBC ( pressure );
+
+    const Real dVdpFD ( ( volumePlus - volumeMinus ) / ( 2. * dp ) );
+    const Real error ( std::abs ( dVdp[0][0] - dVdpFD ) / std::abs ( dVdpFD ) );
+
+    if ( verbose )
+    {
+        std::cout << "\ndV/dp analytic: " << dVdp[0][0] << ", finite difference: " << dVdpFD
+                  << ", relative difference: " << error << std::endl;
+    }
+
+    const Real tolerance = dataFile ( "solid/boundary_conditions/tolerance", 1.e-4 );
+    const bool success ( dVdpFD != 0. && error < tolerance );
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    if ( !success )
+    {
+        if ( verbose )
+        {
+            std::cout << "\nTest Failed!\n";
+        }
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
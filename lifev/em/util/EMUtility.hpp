@@ -117,16 +117,29 @@ Real FLRelationship(Real I4f);
 
 
 template<typename DispVectorPtr, typename FESpaceType>
-void computeZZGradient(VectorEpetra& displacement, std::vector<DispVectorPtr> gradientPtr, boost::shared_ptr<FESpaceType>  dFESpace)
+void computeZZGradient(VectorEpetra& displacement, std::vector<DispVectorPtr>& gradientPtr, GradientRecovery::ZZRecovery<FESpaceType, VectorEpetra>& recovery)
 {
-    gradientPtr[0].reset( &GradientRecovery::ZZGradient(dFESpace, displacement, 0) );
-    gradientPtr[1].reset( &GradientRecovery::ZZGradient(dFESpace, displacement, 1) );
-    gradientPtr[2].reset( &GradientRecovery::ZZGradient(dFESpace, displacement, 2) );
+    std::vector<VectorEpetra> gradient;
+    recovery.gradient (displacement, gradient);
+
+    gradientPtr.resize (gradient.size() );
+    for (UInt i (0); i < gradient.size(); i++)
+    {
+        gradientPtr[i].reset ( new VectorEpetra (gradient[i]) );
+    }
+}
+
+
+template<typename DispVectorPtr, typename FESpaceType>
+void computeZZGradient(VectorEpetra& displacement, std::vector<DispVectorPtr>& gradientPtr, boost::shared_ptr<FESpaceType>  dFESpace)
+{
+    GradientRecovery::ZZRecovery<FESpaceType, VectorEpetra> recovery (dFESpace);
+    computeZZGradient (displacement, gradientPtr, recovery);
 }
 
 
 template< typename FESpaceType >
-void computeI4 ( VectorEpetra& I4, VectorEpetra& displacement, VectorEpetra& fibers, boost::shared_ptr<FESpaceType> dFESpace )
+void computeI4 ( VectorEpetra& I4, VectorEpetra& displacement, VectorEpetra& fibers, GradientRecovery::ZZRecovery<FESpaceType, VectorEpetra>& recovery )
 {
 
 	if( 0 == I4.comm().MyPID() )
@@ -137,39 +150,58 @@ void computeI4 ( VectorEpetra& I4, VectorEpetra& displacement, VectorEpetra& fib
 //    VectorEpetra sy = GradientRecovery::ZZGradient (dFESpace, displacement, 1);
 //    VectorEpetra sz = GradientRecovery::ZZGradient (dFESpace, displacement, 2);
     std::vector<boost::shared_ptr<VectorEpetra> >gradientPtr(3);
-    EMUtility::computeZZGradient(displacement, gradientPtr, dFESpace);
+    EMUtility::computeZZGradient(displacement, gradientPtr, recovery);
 
     I4 *= 0.0;
     Int nLocalDof = I4.epetraVector().MyLength();
-    //Int nComponentLocalDof = nLocalDof / 3;
-    for (int k (0); k < nLocalDof; k++)
+
+    // Local views: the x, y and z components of the vectorial fields are
+    // contiguous blocks with the same local ordering of I4
+    ASSERT ( fibers.epetraVector().MyLength() == 3 * nLocalDof, "computeI4: fibers and I4 have incompatible maps" );
+    VectorEpetra::localView_Type I4View = I4.localView();
+    VectorEpetra::constLocalView_Type fibersView = fibers.localView();
+    VectorEpetra::constLocalView_Type fx0 = fibersView.component (0, 3);
+    VectorEpetra::constLocalView_Type fy0 = fibersView.component (1, 3);
+    VectorEpetra::constLocalView_Type fz0 = fibersView.component (2, 3);
+    std::vector<VectorEpetra::constLocalView_Type> gradientView (3);
+    for (UInt i (0); i < 3; i++)
     {
-        UInt iGID = ( *gradientPtr[0] ).blockMap().GID (k);
-        UInt jGID = ( *gradientPtr[0] ).blockMap().GID (k + nLocalDof);
-        UInt kGID = ( *gradientPtr[0] ).blockMap().GID (k + 2 * nLocalDof);
+        gradientView[i] = gradientPtr[i]->localView();
+    }
+    VectorEpetra::constLocalView_Type dxUx = gradientView[0].component (0, 3);
+    VectorEpetra::constLocalView_Type dxUy = gradientView[0].component (1, 3);
+    VectorEpetra::constLocalView_Type dxUz = gradientView[0].component (2, 3);
+    VectorEpetra::constLocalView_Type dyUx = gradientView[1].component (0, 3);
+    VectorEpetra::constLocalView_Type dyUy = gradientView[1].component (1, 3);
+    VectorEpetra::constLocalView_Type dyUz = gradientView[1].component (2, 3);
+    VectorEpetra::constLocalView_Type dzUx = gradientView[2].component (0, 3);
+    VectorEpetra::constLocalView_Type dzUy = gradientView[2].component (1, 3);
+    VectorEpetra::constLocalView_Type dzUz = gradientView[2].component (2, 3);
 
+    for (int k (0); k < nLocalDof; k++)
+    {
         Real fx, fy, fz;
-        Real F11 = ( *gradientPtr[0] ) [iGID] + 1.0;
-        Real F12 = ( *gradientPtr[1] ) [iGID];
-        Real F13 = ( *gradientPtr[2] ) [iGID];
-        Real F21 = ( *gradientPtr[0] ) [jGID];
-        Real F22 = ( *gradientPtr[1] ) [jGID] + 1.0;
-        Real F23 = ( *gradientPtr[2] ) [jGID];
-        Real F31 = ( *gradientPtr[0] ) [kGID];
-        Real F32 = ( *gradientPtr[1] ) [kGID];
-        Real F33 = ( *gradientPtr[2] ) [kGID] + 1.0;
-        fx = F11 * fibers[iGID];
-        fx += ( F12 * fibers[jGID] );
-        fx += ( F13 * fibers[kGID] );
-        fy = F21 * fibers[iGID];
-        fy += ( F22 * fibers[jGID] );
-        fy += ( F23 * fibers[kGID] );
-        fz = F31 * fibers[iGID];
-        fz += ( F32 * fibers[jGID] );
-        fz += ( F33 * fibers[kGID] );
+        Real F11 = dxUx[k] + 1.0;
+        Real F12 = dyUx[k];
+        Real F13 = dzUx[k];
+        Real F21 = dxUy[k];
+        Real F22 = dyUy[k] + 1.0;
+        Real F23 = dzUy[k];
+        Real F31 = dxUz[k];
+        Real F32 = dyUz[k];
+        Real F33 = dzUz[k] + 1.0;
+        fx = F11 * fx0[k];
+        fx += ( F12 * fy0[k] );
+        fx += ( F13 * fz0[k] );
+        fy = F21 * fx0[k];
+        fy += ( F22 * fy0[k] );
+        fy += ( F23 * fz0[k] );
+        fz = F31 * fx0[k];
+        fz += ( F32 * fy0[k] );
+        fz += ( F33 * fz0[k] );
         Real J = F11 * (F22 * F33 - F32 * F23) - F22 * (F21 * F33 - F31 * F23) + F33 * (F21 * F32 - F31 * F22);
 
-        I4[iGID] = fx * fx + fy * fy + fz * fz;
+        I4View[k] = fx * fx + fy * fy + fz * fz;
         //        I4[iGID] *= std::pow (J, -2.0 / 3.0);
 
     }
@@ -177,6 +209,13 @@ void computeI4 ( VectorEpetra& I4, VectorEpetra& displacement, VectorEpetra& fib
 }
 
 
+template< typename FESpaceType >
+void computeI4 ( VectorEpetra& I4, VectorEpetra& displacement, VectorEpetra& fibers, boost::shared_ptr<FESpaceType> dFESpace )
+{
+    GradientRecovery::ZZRecovery<FESpaceType, VectorEpetra> recovery (dFESpace);
+    computeI4 (I4, displacement, fibers, recovery);
+}
+
 
 } // namespace EMUtility
 
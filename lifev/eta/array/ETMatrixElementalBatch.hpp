@@ -0,0 +1,217 @@
+//@HEADER
+/*
+*******************************************************************************
+
+   Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+   Copyright (C) 2010 EPFL, Politecnico di Milano, Emory UNiversity
+
+   This file is part of the LifeV library
+
+   LifeV is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   LifeV is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, see <http://www.gnu.org/licenses/>
+
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+ *   @file
+     @brief This file contains the definition of the ETMatrixElementalBatch class
+
+     @date 10-2026
+*/
+
+#ifndef ET_MATRIX_ELEMENTAL_BATCH_HPP
+#define ET_MATRIX_ELEMENTAL_BATCH_HPP
+
+#include <vector>
+
+#include <lifev/core/LifeV.hpp>
+
+#include <lifev/eta/array/ETMatrixElemental.hpp>
+
+namespace LifeV
+{
+
+//! class ETMatrixElementalBatch  A class for describing the elemental matrices of a batch of elements
+/*!
+    This class stores the elemental matrices of Width elements (the lanes of the
+    batch) with the same sizes. The entries are stored as a structure of arrays:
+    the Width values of the entry (i,j) are contiguous, so that the lane-wise
+    operations (accumulate) are plain loops of fixed length over contiguous data,
+    which the compiler can vectorize.
+
+    The global indices are stored for each lane, and each lane is pushed
+    separately in the global matrix.
+*/
+template <UInt Width>
+class ETMatrixElementalBatch
+{
+
+public:
+
+    //! @name Public Types
+    //@{
+
+    //! Number of lanes
+    static const UInt S_width = Width;
+
+    //@}
+
+
+    //! @name Constructors & Destructor
+    //@{
+
+    //! Constructor with the sizes of the elemental matrices
+    ETMatrixElementalBatch (const UInt& nbRow, const UInt& nbCol )
+        :   M_rowIndices (Width, std::vector<Int> (nbRow, 0) ),
+            M_columnIndices (Width, std::vector<Int> (nbCol, 0) ),
+            M_nbRow (nbRow),
+            M_nbColumn (nbCol),
+            M_data (nbRow * nbCol * Width, 0.0),
+            M_laneMatrix (nbRow, nbCol)
+    {}
+
+    //! Destructor
+    ~ETMatrixElementalBatch() {}
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! Put zero all the data stored
+    void zero()
+    {
+        for (UInt i (0); i < M_data.size(); ++i)
+        {
+            M_data[i] = 0.0;
+        }
+    }
+
+    //! Add the lane-wise product of the values and of the weights to the entry (iloc,jloc)
+    /*!
+      Both arrays have Width entries.
+     */
+    void accumulate (const UInt& iloc, const UInt& jloc, const Real* values, const Real* weights)
+    {
+        ASSERT (iloc < M_nbRow, "Try to access an element out of the elemental matrix (row)");
+        ASSERT (jloc < M_nbColumn, "Try to access an element out of the elemental matrix (column)");
+
+        Real* entry (&M_data[ (iloc * M_nbColumn + jloc) * Width]);
+        for (UInt lane (0); lane < Width; ++lane)
+        {
+            entry[lane] += values[lane] * weights[lane];
+        }
+    }
+
+    //! Assembly procedure for the first nbLanes lanes of the batch
+    /*!
+    The lanes are pushed one after the other, in the order of the lanes, with
+    the global indices stored for each of them.
+    */
+    template <typename MatrixType>
+    void pushToGlobal (MatrixType& mat, const UInt& nbLanes)
+    {
+        ASSERT (nbLanes <= Width, "Try to push more lanes than the batch contains");
+
+        for (UInt lane (0); lane < nbLanes; ++lane)
+        {
+            for (UInt i (0); i < M_nbRow; ++i)
+            {
+                for (UInt j (0); j < M_nbColumn; ++j)
+                {
+                    M_laneMatrix.element (i, j) = M_data[ (i * M_nbColumn + j) * Width + lane];
+                }
+            }
+            M_laneMatrix.setRowIndex (M_rowIndices[lane]);
+            M_laneMatrix.setColumnIndex (M_columnIndices[lane]);
+            M_laneMatrix.pushToGlobal (mat);
+        }
+    }
+
+    //@}
+
+
+    //! @name Set Methods
+    //@{
+
+    //! Setter for the global index corresponding to the iloc row of the given lane
+    void setRowIndex (const UInt& lane, const UInt& iloc, const UInt& iglobal)
+    {
+        ASSERT (lane < Width, "Try to set an index out of the batch");
+        ASSERT (iloc < M_nbRow, "Try to set an index out of the elemental matrix (row)");
+        M_rowIndices[lane][iloc] = iglobal;
+    }
+
+    //! Setter for the global index corresponding to the jloc column of the given lane
+    void setColumnIndex (const UInt& lane, const UInt& jloc, const UInt& jglobal)
+    {
+        ASSERT (lane < Width, "Try to set an index out of the batch");
+        ASSERT (jloc < M_nbColumn, "Try to set an index out of the elemental matrix (column)");
+        M_columnIndices[lane][jloc] = jglobal;
+    }
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! Getter for the value stored in the given elemental position of the given lane
+    const Real& element (const UInt& lane, const UInt& iloc, const UInt& jloc) const
+    {
+        ASSERT (lane < Width, "Try to get an element out of the batch");
+        ASSERT (iloc < M_nbRow, "Try to get an element out of the elemental matrix (row)");
+        ASSERT (jloc < M_nbColumn, "Try to get an element out of the elemental matrix (column)");
+        return M_data[ (iloc * M_nbColumn + jloc) * Width + lane];
+    }
+
+    //@}
+
+private:
+
+    //! @name Private Methods
+    //@{
+
+    //! No empty constructor, as we want at least the sizes to be defined.
+    ETMatrixElementalBatch();
+
+    //! No need for an assignement operator
+    ETMatrixElementalBatch operator= (const ETMatrixElementalBatch&);
+
+    //@}
+
+    // Global indices of the rows and of the columns, for each lane
+    std::vector<std::vector<Int> > M_rowIndices;
+    std::vector<std::vector<Int> > M_columnIndices;
+
+    // Number of rows
+    UInt M_nbRow;
+    // Number of columns
+    UInt M_nbColumn;
+
+    // Entries, the lanes of each entry being contiguous
+    std::vector<Real> M_data;
+
+    // Buffer used to push one lane in the global matrix
+    ETMatrixElemental M_laneMatrix;
+};
+
+template <UInt Width>
+const UInt ETMatrixElementalBatch<Width>::S_width;
+
+}
+#endif
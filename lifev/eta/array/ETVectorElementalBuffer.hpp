@@ -0,0 +1,136 @@
+//@HEADER
+/*
+*******************************************************************************
+
+   Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+   Copyright (C) 2010 EPFL, Politecnico di Milano, Emory UNiversity
+
+   This file is part of the LifeV library
+
+   LifeV is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   LifeV is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, see <http://www.gnu.org/licenses/>
+
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+ *   @file
+     @brief This file contains the definition of the ETVectorElementalBuffer class
+
+     @date 10/2026
+ */
+
+#ifndef ET_VECTOR_ELEMENTAL_BUFFER_HPP
+#define ET_VECTOR_ELEMENTAL_BUFFER_HPP
+
+#include <vector>
+
+#include <lifev/core/LifeV.hpp>
+
+#include <lifev/eta/array/ETVectorElemental.hpp>
+
+namespace LifeV
+{
+
+//! class ETVectorElementalBuffer  A per-thread buffer of elemental vector contributions
+/*!
+    This class stores the (global index, value) pairs of several elemental
+    vectors, so that a thread can compute its elemental contributions without
+    touching the global vector. The content of the buffer is then summed into
+    the global vector in a single pass, which the caller protects with an
+    OpenMP critical section. This makes the threaded assembly of vectors free
+    of data races also when two elements share a degree of freedom.
+
+    With a single thread, the contributions are summed in the same order as
+    with a direct call to ETVectorElemental::pushToGlobal.
+*/
+class ETVectorElementalBuffer
+{
+public:
+
+    //! @name Constructors & Destructor
+    //@{
+
+    //! Constructor with the number of entries after which a flush is advised
+    explicit ETVectorElementalBuffer (const UInt& flushSize = 16384)
+        :   M_flushSize (flushSize)
+    {
+        M_indices.reserve (flushSize);
+        M_values.reserve (flushSize);
+    }
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! Append the content of an elemental vector to the buffer
+    void append (const ETVectorElemental& elementalVector)
+    {
+        const std::vector<Int>& rowIndices (elementalVector.rowIndices() );
+        const Real* rawData (elementalVector.rawData() );
+
+        M_indices.insert (M_indices.end(), rowIndices.begin(), rowIndices.end() );
+        M_values.insert (M_values.end(), rawData, rawData + rowIndices.size() );
+    }
+
+    //! Tell if the buffer has reached its flush size
+    bool isFull() const
+    {
+        return M_indices.size() >= M_flushSize;
+    }
+
+    //! Sum the buffered values into the global vector and empty the buffer
+    /*!
+      The method is not thread safe with respect to the global vector: when
+      called inside a parallel region, it must be protected by a critical section.
+     */
+    template <typename VectorType>
+    void pushToGlobal (VectorType& vec)
+    {
+        for (UInt i (0); i < M_indices.size(); ++i)
+        {
+            vec.sumIntoGlobalValues ( M_indices[i], M_values[i] );
+        }
+        M_indices.clear();
+        M_values.clear();
+    }
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! Number of buffered entries
+    UInt size() const
+    {
+        return M_indices.size();
+    }
+
+    //@}
+
+private:
+
+    std::vector<Int> M_indices;
+    std::vector<Real> M_values;
+
+    UInt M_flushSize;
+};
+
+} // namespace LifeV
+
+#endif
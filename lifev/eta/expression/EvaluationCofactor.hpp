@@ -42,6 +42,7 @@
 #include <lifev/eta/array/OperationSmallCofactor.hpp>
 
 #include <lifev/eta/expression/ExpressionCofactor.hpp>
+#include <lifev/eta/expression/EvaluationQuadratureCache.hpp>
 
 #include <lifev/core/fem/QuadratureRule.hpp>
 
@@ -62,6 +63,9 @@ namespace ExpressionAssembly
  */
 template <typename EvaluationType>
 class EvaluationCofactor
+    : public EvaluationCached< EvaluationCofactor<EvaluationType>,
+                              typename OperationSmallCofactor< typename EvaluationType::return_Type >::result_Type,
+                              !(EvaluationDependsOnDof<EvaluationType>::value) >
 {
 public:
 
@@ -98,7 +102,8 @@ public:
 
     //! Copy constructor
     EvaluationCofactor (const EvaluationCofactor& eval)
-        : M_evaluation (eval.M_evaluation)
+        : cached_Type (eval),
+          M_evaluation (eval.M_evaluation)
     {}
 
     //! Constructor from the corresponding expression
@@ -121,6 +126,7 @@ public:
     void update (const UInt& iElement)
     {
         M_evaluation.update (iElement);
+        this->resetCache();
     }
 
     //! Display method
@@ -162,6 +168,7 @@ public:
     void setQuadrature (const QuadratureRule& qr)
     {
         M_evaluation.setQuadrature (qr);
+        this->setCacheQuadrature (qr);
     }
 
     //@}
@@ -176,14 +183,14 @@ public:
         return M_evaluation.value_q (q).cofactor();
     }
 
-    //! Getter for the value for a vector
-    return_Type value_qi (const UInt& q, const UInt& i) const
+    //! Getter for the value for a vector, computed for each basis function (see EvaluationCached)
+    return_Type valueDirect_qi (const UInt& q, const UInt& i) const
     {
         return M_evaluation.value_qi (q, i).cofactor();
     }
 
-    //! Getter for the value for a matrix
-    return_Type value_qij (const UInt& q, const UInt& i, const UInt& j) const
+    //! Getter for the value for a matrix, computed for each pair of basis functions (see EvaluationCached)
+    return_Type valueDirect_qij (const UInt& q, const UInt& i, const UInt& j) const
     {
         return M_evaluation.value_qij (q, i, j).cofactor();
     }
@@ -200,6 +207,9 @@ private:
 
     //@}
 
+    //! Values are cached when the argument does not depend on the basis functions
+    typedef EvaluationCached<EvaluationCofactor<EvaluationType>, return_Type, !(EvaluationDependsOnDof<EvaluationType>::value) > cached_Type;
+
     // Internal storage
     EvaluationType M_evaluation;
 };
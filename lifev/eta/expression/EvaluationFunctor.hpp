@@ -40,6 +40,7 @@
 #include <lifev/core/LifeV.hpp>
 
 #include <lifev/eta/expression/ExpressionFunctor.hpp>
+#include <lifev/eta/expression/EvaluationQuadratureCache.hpp>
 
 #include <lifev/core/fem/QuadratureRule.hpp>
 
@@ -70,6 +71,9 @@ namespace ExpressionAssembly
  */
 template <typename FunctorType, typename ArgumentEvaluationType>
 class EvaluationFunctor1
+    : public EvaluationCached< EvaluationFunctor1<FunctorType, ArgumentEvaluationType>,
+                              typename FunctorType::return_Type,
+                              !(EvaluationDependsOnDof<ArgumentEvaluationType>::value) >
 {
 public:
 
@@ -102,7 +106,8 @@ public:
 
     //! Copy constructor
     EvaluationFunctor1 (const EvaluationFunctor1<FunctorType, ArgumentEvaluationType>& eval)
-        : M_functor (eval.M_functor),
+        : cached_Type (eval),
+          M_functor (eval.M_functor),
           M_evaluation (eval.M_evaluation)
     {}
 
@@ -127,6 +132,7 @@ public:
     void update (const UInt& iElement)
     {
         M_evaluation.update (iElement);
+        this->resetCache();
     }
 
     //! Display method
@@ -168,6 +174,7 @@ public:
     void setQuadrature (const QuadratureRule& qr)
     {
         M_evaluation.setQuadrature (qr);
+        this->setCacheQuadrature (qr);
     }
 
     //@}
@@ -182,14 +189,14 @@ public:
         return (*M_functor) (M_evaluation.value_q (q) );
     }
 
-    //! Getter for the value for a vector
-    return_Type value_qi (const UInt& q, const UInt& i) const
+    //! Getter for the value for a vector, computed for each basis function (see EvaluationCached)
+    return_Type valueDirect_qi (const UInt& q, const UInt& i) const
     {
         return (*M_functor) (M_evaluation.value_qi (q, i) );
     }
 
-    //! Getter for the value for a matrix
-    return_Type value_qij (const UInt& q, const UInt& i, const UInt& j) const
+    //! Getter for the value for a matrix, computed for each pair of basis functions (see EvaluationCached)
+    return_Type valueDirect_qij (const UInt& q, const UInt& i, const UInt& j) const
     {
         return (*M_functor) (M_evaluation.value_qij (q, i, j) );
     }
@@ -206,6 +213,9 @@ private:
 
     //@}
 
+    //! Values are cached when the argument does not depend on the basis functions
+    typedef EvaluationCached<EvaluationFunctor1<FunctorType, ArgumentEvaluationType>, return_Type, !(EvaluationDependsOnDof<ArgumentEvaluationType>::value) > cached_Type;
+
     // Internal storage
     boost::shared_ptr<FunctorType> M_functor;
     ArgumentEvaluationType M_evaluation;
@@ -249,6 +259,9 @@ const flag_Type EvaluationFunctor1<FunctorType, ArgumentEvaluationType>::S_solut
  */
 template <typename FunctorType, typename Argument1EvaluationType, typename Argument2EvaluationType>
 class EvaluationFunctor2
+    : public EvaluationCached< EvaluationFunctor2<FunctorType, Argument1EvaluationType, Argument2EvaluationType>,
+                              typename FunctorType::return_Type,
+                              !(EvaluationDependsOnDof<Argument1EvaluationType>::value || EvaluationDependsOnDof<Argument2EvaluationType>::value) >
 {
 public:
 
@@ -281,7 +294,8 @@ public:
 
     //! Copy constructor
     EvaluationFunctor2 (const EvaluationFunctor2<FunctorType, Argument1EvaluationType, Argument2EvaluationType>& eval)
-        : M_functor (eval.M_functor),
+        : cached_Type (eval),
+          M_functor (eval.M_functor),
           M_evaluation1 (eval.M_evaluation1),
           M_evaluation2 (eval.M_evaluation2)
     {}
@@ -291,7 +305,8 @@ public:
     explicit EvaluationFunctor2 (const ExpressionFunctor2<FunctorType, Argument1, Argument2>& expression)
         : M_functor (expression.functor() ),
           M_evaluation1 (expression.argument1() ),
-          M_evaluation2 (expression.argument2() ) {}
+          M_evaluation2 (expression.argument2() )
+    {}
 
     //! Destructor
     ~EvaluationFunctor2()
@@ -308,6 +323,7 @@ public:
     {
         M_evaluation1.update (iElement);
         M_evaluation2.update (iElement);
+        this->resetCache();
     }
 
     //! Display method
@@ -355,6 +371,7 @@ public:
     {
         M_evaluation1.setQuadrature (qr);
         M_evaluation2.setQuadrature (qr);
+        this->setCacheQuadrature (qr);
     }
 
     //@}
@@ -369,14 +386,14 @@ public:
         return (*M_functor) (M_evaluation1.value_q (q), M_evaluation2.value_q (q) );
     }
 
-    //! Getter for the value for a vector
-    return_Type value_qi (const UInt& q, const UInt& i) const
+    //! Getter for the value for a vector, computed for each basis function (see EvaluationCached)
+    return_Type valueDirect_qi (const UInt& q, const UInt& i) const
     {
         return (*M_functor) (M_evaluation1.value_qi (q, i), M_evaluation2.value_qi (q, i) );
     }
 
-    //! Getter for the value for a matrix
-    return_Type value_qij (const UInt& q, const UInt& i, const UInt& j) const
+    //! Getter for the value for a matrix, computed for each pair of basis functions (see EvaluationCached)
+    return_Type valueDirect_qij (const UInt& q, const UInt& i, const UInt& j) const
     {
         return (*M_functor) (M_evaluation1.value_qij (q, i, j), M_evaluation2.value_qij (q, i, j) );
     }
@@ -394,6 +411,9 @@ private:
 
     //@}
 
+    //! Values are cached when none of the arguments depends on the basis functions
+    typedef EvaluationCached<EvaluationFunctor2<FunctorType, Argument1EvaluationType, Argument2EvaluationType>, return_Type, !(EvaluationDependsOnDof<Argument1EvaluationType>::value || EvaluationDependsOnDof<Argument2EvaluationType>::value) > cached_Type;
+
     // Internal storage
     boost::shared_ptr<FunctorType> M_functor;
     Argument1EvaluationType M_evaluation1;
@@ -441,6 +461,9 @@ const flag_Type EvaluationFunctor2<FunctorType, Argument1EvaluationType, Argumen
  */
 template <typename FunctorType, typename Argument1EvaluationType, typename Argument2EvaluationType, typename Argument3EvaluationType>
 class EvaluationFunctor3
+    : public EvaluationCached< EvaluationFunctor3<FunctorType, Argument1EvaluationType, Argument2EvaluationType, Argument3EvaluationType>,
+                              typename FunctorType::return_Type,
+                              !(EvaluationDependsOnDof<Argument1EvaluationType>::value || EvaluationDependsOnDof<Argument2EvaluationType>::value || EvaluationDependsOnDof<Argument3EvaluationType>::value) >
 {
 public:
 
@@ -473,7 +496,8 @@ public:
 
     //! Copy constructor
     EvaluationFunctor3 (const EvaluationFunctor3<FunctorType, Argument1EvaluationType, Argument2EvaluationType, Argument3EvaluationType>& eval)
-        : M_functor (eval.M_functor),
+        : cached_Type (eval),
+          M_functor (eval.M_functor),
           M_evaluation1 (eval.M_evaluation1),
           M_evaluation2 (eval.M_evaluation2),
           M_evaluation3 (eval.M_evaluation3)
@@ -485,7 +509,8 @@ public:
         : M_functor (expression.functor() ),
           M_evaluation1 (expression.argument1() ),
           M_evaluation2 (expression.argument2() ),
-          M_evaluation3 (expression.argument3() ) {}
+          M_evaluation3 (expression.argument3() )
+    {}
 
     //! Destructor
     ~EvaluationFunctor3()
@@ -503,6 +528,7 @@ public:
         M_evaluation1.update (iElement);
         M_evaluation2.update (iElement);
         M_evaluation3.update (iElement);
+        this->resetCache();
     }
 
     //! Display method
@@ -556,6 +582,7 @@ public:
         M_evaluation1.setQuadrature (qr);
         M_evaluation2.setQuadrature (qr);
         M_evaluation3.setQuadrature (qr);
+        this->setCacheQuadrature (qr);
     }
 
     //@}
@@ -570,14 +597,14 @@ public:
         return (*M_functor) (M_evaluation1.value_q (q), M_evaluation2.value_q (q), M_evaluation3.value_q (q) );
     }
 
-    //! Getter for the value for a vector
-    return_Type value_qi (const UInt& q, const UInt& i) const
+    //! Getter for the value for a vector, computed for each basis function (see EvaluationCached)
+    return_Type valueDirect_qi (const UInt& q, const UInt& i) const
     {
         return (*M_functor) (M_evaluation1.value_qi (q, i), M_evaluation2.value_qi (q, i), M_evaluation3.value_qi (q, i) );
     }
 
-    //! Getter for the value for a matrix
-    return_Type value_qij (const UInt& q, const UInt& i, const UInt& j) const
+    //! Getter for the value for a matrix, computed for each pair of basis functions (see EvaluationCached)
+    return_Type valueDirect_qij (const UInt& q, const UInt& i, const UInt& j) const
     {
         return (*M_functor) (M_evaluation1.value_qij (q, i, j), M_evaluation2.value_qij (q, i, j), M_evaluation3.value_qij (q, i, j) );
     }
@@ -595,6 +622,9 @@ private:
 
     //@}
 
+    //! Values are cached when none of the arguments depends on the basis functions
+    typedef EvaluationCached<EvaluationFunctor3<FunctorType, Argument1EvaluationType, Argument2EvaluationType, Argument3EvaluationType>, return_Type, !(EvaluationDependsOnDof<Argument1EvaluationType>::value || EvaluationDependsOnDof<Argument2EvaluationType>::value || EvaluationDependsOnDof<Argument3EvaluationType>::value) > cached_Type;
+
     // Internal storage
     boost::shared_ptr<FunctorType> M_functor;
     Argument1EvaluationType M_evaluation1;
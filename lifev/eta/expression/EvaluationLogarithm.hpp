@@ -41,6 +41,7 @@
 #include <lifev/eta/array/OperationSmallLogarithm.hpp>
 
 #include <lifev/eta/expression/ExpressionLogarithm.hpp>
+#include <lifev/eta/expression/EvaluationQuadratureCache.hpp>
 
 #include <lifev/core/fem/QuadratureRule.hpp>
 
@@ -61,6 +62,9 @@ namespace ExpressionAssembly
  */
 template <typename EvaluationBaseType>
 class EvaluationLogarithm
+    : public EvaluationCached< EvaluationLogarithm<EvaluationBaseType>,
+                              typename OperationSmallLogarithm<typename EvaluationBaseType::return_Type>::result_Type,
+                              !(EvaluationDependsOnDof<EvaluationBaseType>::value) >
 {
 public:
 
@@ -97,7 +101,8 @@ public:
 
     //! Copy constructor
     EvaluationLogarithm (const EvaluationLogarithm& eval)
-        : M_evaluationBase (eval.M_evaluationBase)
+        : cached_Type (eval),
+          M_evaluationBase (eval.M_evaluationBase)
     {}
 
     //! Constructor from the corresponding expression
@@ -119,6 +124,7 @@ public:
     void update (const UInt& iElement)
     {
         M_evaluationBase.update (iElement);
+        this->resetCache();
     }
 
     //! Display method
@@ -160,6 +166,7 @@ public:
     void setQuadrature (const QuadratureRule& qr)
     {
         M_evaluationBase.setQuadrature (qr);
+        this->setCacheQuadrature (qr);
     }
 
     //@}
@@ -174,14 +181,14 @@ public:
         return std::log (M_evaluationBase.value_q (q) );
     }
 
-    //! Getter for the value for a vector
-    return_Type value_qi (const UInt& q, const UInt& i) const
+    //! Getter for the value for a vector, computed for each basis function (see EvaluationCached)
+    return_Type valueDirect_qi (const UInt& q, const UInt& i) const
     {
         return std::log (M_evaluationBase.value_qi (q, i) );
     }
 
-    //! Getter for the value for a matrix
-    return_Type value_qij (const UInt& q, const UInt& i, const UInt& j) const
+    //! Getter for the value for a matrix, computed for each pair of basis functions (see EvaluationCached)
+    return_Type valueDirect_qij (const UInt& q, const UInt& i, const UInt& j) const
     {
         return std::log (M_evaluationBase.value_qij (q, i, j) );
     }
@@ -198,6 +205,9 @@ private:
 
     //@}
 
+    //! Values are cached when the argument does not depend on the basis functions
+    typedef EvaluationCached<EvaluationLogarithm<EvaluationBaseType>, return_Type, !(EvaluationDependsOnDof<EvaluationBaseType>::value) > cached_Type;
+
     //! Internal storage
     EvaluationBaseType M_evaluationBase;
 };
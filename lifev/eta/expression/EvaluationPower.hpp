@@ -41,6 +41,7 @@
 #include <lifev/eta/array/OperationSmallPower.hpp>
 
 #include <lifev/eta/expression/ExpressionPower.hpp>
+#include <lifev/eta/expression/EvaluationQuadratureCache.hpp>
 
 #include <lifev/core/fem/QuadratureRule.hpp>
 
@@ -61,6 +62,9 @@ namespace ExpressionAssembly
  */
 template <typename EvaluationBaseType>
 class EvaluationPower
+    : public EvaluationCached< EvaluationPower<EvaluationBaseType>,
+                              typename OperationSmallPower<typename EvaluationBaseType::return_Type, Real>::result_Type,
+                              !(EvaluationDependsOnDof<EvaluationBaseType>::value) >
 {
 public:
 
@@ -97,7 +101,8 @@ public:
 
     //! Copy constructor
     EvaluationPower (const EvaluationPower& eval)
-        : M_evaluationBase (eval.M_evaluationBase),
+        : cached_Type (eval),
+          M_evaluationBase (eval.M_evaluationBase),
           M_exponent (eval.M_exponent)
     {}
 
@@ -121,6 +126,7 @@ public:
     void update (const UInt& iElement)
     {
         M_evaluationBase.update (iElement);
+        this->resetCache();
     }
 
     //! Display method
@@ -162,6 +168,7 @@ public:
     void setQuadrature (const QuadratureRule& qr)
     {
         M_evaluationBase.setQuadrature (qr);
+        this->setCacheQuadrature (qr);
     }
 
     //@}
@@ -176,14 +183,14 @@ public:
         return std::pow (M_evaluationBase.value_q (q), M_exponent);
     }
 
-    //! Getter for the value for a vector
-    return_Type value_qi (const UInt& q, const UInt& i) const
+    //! Getter for the value for a vector, computed for each basis function (see EvaluationCached)
+    return_Type valueDirect_qi (const UInt& q, const UInt& i) const
     {
         return std::pow (M_evaluationBase.value_qi (q, i), M_exponent);
     }
 
-    //! Getter for the value for a matrix
-    return_Type value_qij (const UInt& q, const UInt& i, const UInt& j) const
+    //! Getter for the value for a matrix, computed for each pair of basis functions (see EvaluationCached)
+    return_Type valueDirect_qij (const UInt& q, const UInt& i, const UInt& j) const
     {
         return std::pow (M_evaluationBase.value_qij (q, i, j), M_exponent);
     }
@@ -200,6 +207,9 @@ private:
 
     //@}
 
+    //! Values are cached when the argument does not depend on the basis functions
+    typedef EvaluationCached<EvaluationPower<EvaluationBaseType>, return_Type, !(EvaluationDependsOnDof<EvaluationBaseType>::value) > cached_Type;
+
     //! Internal storage
     EvaluationBaseType M_evaluationBase;
     Real M_exponent;
@@ -0,0 +1,548 @@
+//@HEADER
+/*
+*******************************************************************************
+
+   Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+   Copyright (C) 2010 EPFL, Politecnico di Milano, Emory UNiversity
+
+   This file is part of the LifeV library
+
+   LifeV is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   LifeV is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, see <http://www.gnu.org/licenses/>
+
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+ *   @file
+     @brief This file contains the definition of the EvaluationQuadratureCache and EvaluationCached classes.
+
+     @date 10-2026
+ */
+
+#ifndef EVALUATION_QUADRATURE_CACHE_HPP
+#define EVALUATION_QUADRATURE_CACHE_HPP
+
+#include <lifev/core/LifeV.hpp>
+
+#include <lifev/core/fem/QuadratureRule.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace LifeV
+{
+
+namespace ExpressionAssembly
+{
+
+/*
+   Predeclaration of the Evaluation classes used in the
+   specializations of EvaluationDependsOnDof.
+*/
+
+class EvaluationScalar;
+
+template <typename VectorType>
+class EvaluationExtractScalar;
+
+template <UInt VectorDim>
+class EvaluationVector;
+
+template <UInt MatrixDim1, UInt MatrixDim2>
+class EvaluationMatrix;
+
+template <UInt spaceDim>
+class EvaluationPosition;
+
+template <UInt spaceDim>
+class EvaluationHK;
+
+template <UInt spaceDim>
+class EvaluationMeas;
+
+template <UInt spaceDim>
+class EvaluationNormal;
+
+template <typename MeshType, typename MapType, UInt SpaceDim, UInt FieldDim>
+class EvaluationInterpolateValue;
+
+template <typename MeshType, typename MapType, UInt SpaceDim, UInt FieldDim>
+class EvaluationInterpolateGradient;
+
+template <typename EvaluationLType, typename EvaluationRType>
+class EvaluationAddition;
+
+template <typename EvaluationLType, typename EvaluationRType>
+class EvaluationSubstraction;
+
+template <typename EvaluationLType, typename EvaluationRType>
+class EvaluationProduct;
+
+template <typename EvaluationLType, typename EvaluationRType>
+class EvaluationDivision;
+
+template <typename EvaluationLType, typename EvaluationRType>
+class EvaluationDot;
+
+template <typename EvaluationLType, typename EvaluationRType>
+class EvaluationEmult;
+
+template <typename EvaluationLType, typename EvaluationRType>
+class EvaluationOuterProduct;
+
+template <typename EvaluationBaseType>
+class EvaluationPower;
+
+template <typename EvaluationBaseType>
+class EvaluationExponential;
+
+template <typename EvaluationBaseType>
+class EvaluationLogarithm;
+
+template <typename EvaluationBaseType>
+class EvaluationSquareRoot;
+
+template <typename EvaluationType>
+class EvaluationDeterminant;
+
+template <typename EvaluationType>
+class EvaluationMinusTransposed;
+
+template <typename EvaluationType>
+class EvaluationCofactor;
+
+template <typename EvaluationType>
+class EvaluationTranspose;
+
+template <typename EvaluationType>
+class EvaluationTrace;
+
+template <typename EvaluationType>
+class EvaluationSymmetricTensor;
+
+template <typename EvaluationType>
+class EvaluationExtract1;
+
+template <typename EvaluationType>
+class EvaluationExtract2;
+
+template <typename FunctorType, typename ArgumentEvaluationType>
+class EvaluationFunctor1;
+
+template <typename FunctorType, typename Argument1EvaluationType, typename Argument2EvaluationType>
+class EvaluationFunctor2;
+
+template <typename FunctorType, typename Argument1EvaluationType, typename Argument2EvaluationType, typename Argument3EvaluationType>
+class EvaluationFunctor3;
+
+
+//! Trait telling if the values of an Evaluation depend on the basis functions
+/*!
+  The value is false when value_qij(q, i, j) does not depend on i and j, i.e. when the
+  Evaluation involves only constants, interpolated fields and geometric quantities.
+  Such Evaluations can be computed once per quadrature node (with value_q) instead of
+  once per pair of basis functions.
+
+  Evaluations not listed here (basis functions, but also any Evaluation class added
+  later) are considered as depending on the basis functions, so that no value is cached.
+ */
+template <typename EvaluationType>
+struct EvaluationDependsOnDof
+{
+    static const bool value = true;
+};
+
+// Leaves that do not depend on the basis functions
+
+template <>
+struct EvaluationDependsOnDof<EvaluationScalar>
+{
+    static const bool value = false;
+};
+
+template <typename VectorType>
+struct EvaluationDependsOnDof<EvaluationExtractScalar<VectorType> >
+{
+    static const bool value = false;
+};
+
+template <UInt VectorDim>
+struct EvaluationDependsOnDof<EvaluationVector<VectorDim> >
+{
+    static const bool value = false;
+};
+
+template <UInt MatrixDim1, UInt MatrixDim2>
+struct EvaluationDependsOnDof<EvaluationMatrix<MatrixDim1, MatrixDim2> >
+{
+    static const bool value = false;
+};
+
+template <UInt spaceDim>
+struct EvaluationDependsOnDof<EvaluationPosition<spaceDim> >
+{
+    static const bool value = false;
+};
+
+template <UInt spaceDim>
+struct EvaluationDependsOnDof<EvaluationHK<spaceDim> >
+{
+    static const bool value = false;
+};
+
+template <UInt spaceDim>
+struct EvaluationDependsOnDof<EvaluationMeas<spaceDim> >
+{
+    static const bool value = false;
+};
+
+template <UInt spaceDim>
+struct EvaluationDependsOnDof<EvaluationNormal<spaceDim> >
+{
+    static const bool value = false;
+};
+
+template <typename MeshType, typename MapType, UInt SpaceDim, UInt FieldDim>
+struct EvaluationDependsOnDof<EvaluationInterpolateValue<MeshType, MapType, SpaceDim, FieldDim> >
+{
+    static const bool value = false;
+};
+
+template <typename MeshType, typename MapType, UInt SpaceDim, UInt FieldDim>
+struct EvaluationDependsOnDof<EvaluationInterpolateGradient<MeshType, MapType, SpaceDim, FieldDim> >
+{
+    static const bool value = false;
+};
+
+// Unary operations depend on the basis functions if their argument does
+
+template <typename EvaluationType>
+struct EvaluationDependsOnDofUnary
+{
+    static const bool value = EvaluationDependsOnDof<EvaluationType>::value;
+};
+
+template <typename EvaluationType>
+struct EvaluationDependsOnDof<EvaluationPower<EvaluationType> > : public EvaluationDependsOnDofUnary<EvaluationType> {};
+
+template <typename EvaluationType>
+struct EvaluationDependsOnDof<EvaluationExponential<EvaluationType> > : public EvaluationDependsOnDofUnary<EvaluationType> {};
+
+template <typename EvaluationType>
+struct EvaluationDependsOnDof<EvaluationLogarithm<EvaluationType> > : public EvaluationDependsOnDofUnary<EvaluationType> {};
+
+template <typename EvaluationType>
+struct EvaluationDependsOnDof<EvaluationSquareRoot<EvaluationType> > : public EvaluationDependsOnDofUnary<EvaluationType> {};
+
+template <typename EvaluationType>
+struct EvaluationDependsOnDof<EvaluationDeterminant<EvaluationType> > : public EvaluationDependsOnDofUnary<EvaluationType> {};
+
+template <typename EvaluationType>
+struct EvaluationDependsOnDof<EvaluationMinusTransposed<EvaluationType> > : public EvaluationDependsOnDofUnary<EvaluationType> {};
+
+template <typename EvaluationType>
+struct EvaluationDependsOnDof<EvaluationCofactor<EvaluationType> > : public EvaluationDependsOnDofUnary<EvaluationType> {};
+
+template <typename EvaluationType>
+struct EvaluationDependsOnDof<EvaluationTranspose<EvaluationType> > : public EvaluationDependsOnDofUnary<EvaluationType> {};
+
+template <typename EvaluationType>
+struct EvaluationDependsOnDof<EvaluationTrace<EvaluationType> > : public EvaluationDependsOnDofUnary<EvaluationType> {};
+
+template <typename EvaluationType>
+struct EvaluationDependsOnDof<EvaluationSymmetricTensor<EvaluationType> > : public EvaluationDependsOnDofUnary<EvaluationType> {};
+
+template <typename EvaluationType>
+struct EvaluationDependsOnDof<EvaluationExtract1<EvaluationType> > : public EvaluationDependsOnDofUnary<EvaluationType> {};
+
+template <typename EvaluationType>
+struct EvaluationDependsOnDof<EvaluationExtract2<EvaluationType> > : public EvaluationDependsOnDofUnary<EvaluationType> {};
+
+template <typename FunctorType, typename EvaluationType>
+struct EvaluationDependsOnDof<EvaluationFunctor1<FunctorType, EvaluationType> > : public EvaluationDependsOnDofUnary<EvaluationType> {};
+
+// Binary operations depend on the basis functions if one of their arguments does
+
+template <typename EvaluationLType, typename EvaluationRType>
+struct EvaluationDependsOnDofBinary
+{
+    static const bool value = EvaluationDependsOnDof<EvaluationLType>::value || EvaluationDependsOnDof<EvaluationRType>::value;
+};
+
+template <typename EvaluationLType, typename EvaluationRType>
+struct EvaluationDependsOnDof<EvaluationAddition<EvaluationLType, EvaluationRType> > : public EvaluationDependsOnDofBinary<EvaluationLType, EvaluationRType> {};
+
+template <typename EvaluationLType, typename EvaluationRType>
+struct EvaluationDependsOnDof<EvaluationSubstraction<EvaluationLType, EvaluationRType> > : public EvaluationDependsOnDofBinary<EvaluationLType, EvaluationRType> {};
+
+template <typename EvaluationLType, typename EvaluationRType>
+struct EvaluationDependsOnDof<EvaluationProduct<EvaluationLType, EvaluationRType> > : public EvaluationDependsOnDofBinary<EvaluationLType, EvaluationRType> {};
+
+template <typename EvaluationLType, typename EvaluationRType>
+struct EvaluationDependsOnDof<EvaluationDivision<EvaluationLType, EvaluationRType> > : public EvaluationDependsOnDofBinary<EvaluationLType, EvaluationRType> {};
+
+template <typename EvaluationLType, typename EvaluationRType>
+struct EvaluationDependsOnDof<EvaluationDot<EvaluationLType, EvaluationRType> > : public EvaluationDependsOnDofBinary<EvaluationLType, EvaluationRType> {};
+
+template <typename EvaluationLType, typename EvaluationRType>
+struct EvaluationDependsOnDof<EvaluationEmult<EvaluationLType, EvaluationRType> > : public EvaluationDependsOnDofBinary<EvaluationLType, EvaluationRType> {};
+
+template <typename EvaluationLType, typename EvaluationRType>
+struct EvaluationDependsOnDof<EvaluationOuterProduct<EvaluationLType, EvaluationRType> > : public EvaluationDependsOnDofBinary<EvaluationLType, EvaluationRType> {};
+
+template <typename FunctorType, typename Argument1EvaluationType, typename Argument2EvaluationType>
+struct EvaluationDependsOnDof<EvaluationFunctor2<FunctorType, Argument1EvaluationType, Argument2EvaluationType> >
+    : public EvaluationDependsOnDofBinary<Argument1EvaluationType, Argument2EvaluationType> {};
+
+template <typename FunctorType, typename Argument1EvaluationType, typename Argument2EvaluationType, typename Argument3EvaluationType>
+struct EvaluationDependsOnDof<EvaluationFunctor3<FunctorType, Argument1EvaluationType, Argument2EvaluationType, Argument3EvaluationType> >
+{
+    static const bool value = EvaluationDependsOnDof<Argument1EvaluationType>::value
+                              || EvaluationDependsOnDof<Argument2EvaluationType>::value
+                              || EvaluationDependsOnDof<Argument3EvaluationType>::value;
+};
+
+
+//! Tag to select, at compile time, between the cached and the direct computation (see EvaluationCached)
+template <bool IsCached>
+struct EvaluationCacheTag
+{
+};
+
+
+//! Cache for the values of an Evaluation at the quadrature nodes
+/*!
+  This class is used by the Evaluations that are expensive to compute (functors,
+  powers, exponentials, determinants, inverses...) when their argument does not depend
+  on the basis functions (see EvaluationDependsOnDof). In this case, value_qij is the
+  same for all the basis functions, so it is computed only at the first call for each
+  quadrature node, instead of nbTestDof * nbSolutionDof times.
+
+  The values are computed lazily, as the current FEs are updated after the Evaluation
+  tree in the integration loops. The cache must be reset (see reset()) when the tree
+  is updated on a new element.
+
+  <b> Template requirement </b>
+
+  <i> ReturnType </i> The type of the values, it must be default constructible and copiable.
+ */
+template <typename ReturnType>
+class EvaluationQuadratureCache
+{
+public:
+
+    //! @name Constructors, destructor
+    //@{
+
+    //! Empty constructor
+    EvaluationQuadratureCache()
+        : M_values(),
+          M_isComputed()
+    {}
+
+    //! Copy constructor
+    EvaluationQuadratureCache (const EvaluationQuadratureCache<ReturnType>& cache)
+        : M_values (cache.M_values),
+          M_isComputed (cache.M_isComputed)
+    {}
+
+    //! Destructor
+    ~EvaluationQuadratureCache() {}
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! Forget the stored values (to be called when the element changes)
+    void reset()
+    {
+        std::fill (M_isComputed.begin(), M_isComputed.end(), false);
+    }
+
+    //@}
+
+
+    //! @name Set Methods
+    //@{
+
+    //! Setter for the quadrature rule (reshape the cache)
+    void setQuadrature (const QuadratureRule& qr)
+    {
+        M_values.resize (qr.nbQuadPt() );
+        M_isComputed.assign (qr.nbQuadPt(), false);
+    }
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! Getter for the value at a quadrature node, computed with the value_q method of the Evaluation if needed
+    template <typename EvaluationType>
+    const ReturnType& value (const EvaluationType& evaluation, const UInt& q) const
+    {
+        ASSERT ( q < M_values.size(), "Quadrature point index invalid");
+
+        if (!M_isComputed[q])
+        {
+            M_values[q] = evaluation.value_q (q);
+            M_isComputed[q] = true;
+        }
+        return M_values[q];
+    }
+
+    //@}
+
+private:
+
+    // The values are computed within the const getters of the Evaluations
+    mutable std::vector<ReturnType> M_values;
+    mutable std::vector<bool> M_isComputed;
+};
+
+
+//! Base class of the Evaluations whose values can be cached at the quadrature nodes
+/*!
+  This class provides the value_qi and value_qij methods of the Evaluation EvaluationType
+  (CRTP): if IsCached is true, they return the value computed once for each quadrature node
+  with EvaluationType::value_q; otherwise they return EvaluationType::valueDirect_qi and
+  EvaluationType::valueDirect_qij, which compute the value for each basis function.
+
+  The Evaluation must call resetCache() in its update method and setCacheQuadrature()
+  in its setQuadrature method.
+
+  <b> Template requirement </b>
+
+  <i> EvaluationType </i> The derived Evaluation, with the methods value_q, valueDirect_qi and valueDirect_qij.
+
+  <i> ReturnType </i> The return_Type of the derived Evaluation.
+
+  <i> IsCached </i> Usually, the negation of EvaluationDependsOnDof for the arguments of the Evaluation.
+ */
+template <typename EvaluationType, typename ReturnType, bool IsCached>
+class EvaluationCached
+{
+public:
+
+    //! @name Get Methods
+    //@{
+
+    //! Getter for the value for a vector
+    ReturnType value_qi (const UInt& q, const UInt& i) const
+    {
+        return value_qi (q, i, EvaluationCacheTag<IsCached>() );
+    }
+
+    //! Getter for the value for a matrix
+    ReturnType value_qij (const UInt& q, const UInt& i, const UInt& j) const
+    {
+        return value_qij (q, i, j, EvaluationCacheTag<IsCached>() );
+    }
+
+    //@}
+
+protected:
+
+    //! @name Constructors, destructor
+    //@{
+
+    //! Empty constructor
+    EvaluationCached()
+        : M_cache()
+    {}
+
+    //! Copy constructor
+    EvaluationCached (const EvaluationCached<EvaluationType, ReturnType, IsCached>& evaluation)
+        : M_cache (evaluation.M_cache)
+    {}
+
+    //! Destructor
+    ~EvaluationCached() {}
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! Forget the cached values (to be called by the update method)
+    void resetCache()
+    {
+        if (IsCached)
+        {
+            M_cache.reset();
+        }
+    }
+
+    //! Reshape the cache (to be called by the setQuadrature method)
+    void setCacheQuadrature (const QuadratureRule& qr)
+    {
+        if (IsCached)
+        {
+            M_cache.setQuadrature (qr);
+        }
+    }
+
+    //@}
+
+private:
+
+    //! @name Private Methods
+    //@{
+
+    //! The derived Evaluation
+    const EvaluationType& evaluation() const
+    {
+        return static_cast<const EvaluationType&> (*this);
+    }
+
+    //! Value for a vector, computed for each basis function
+    ReturnType value_qi (const UInt& q, const UInt& i, EvaluationCacheTag<false>) const
+    {
+        return evaluation().valueDirect_qi (q, i);
+    }
+
+    //! Value for a vector, computed once for each quadrature node
+    ReturnType value_qi (const UInt& q, const UInt& /*i*/, EvaluationCacheTag<true>) const
+    {
+        return M_cache.value (evaluation(), q);
+    }
+
+    //! Value for a matrix, computed for each pair of basis functions
+    ReturnType value_qij (const UInt& q, const UInt& i, const UInt& j, EvaluationCacheTag<false>) const
+    {
+        return evaluation().valueDirect_qij (q, i, j);
+    }
+
+    //! Value for a matrix, computed once for each quadrature node
+    ReturnType value_qij (const UInt& q, const UInt& /*i*/, const UInt& /*j*/, EvaluationCacheTag<true>) const
+    {
+        return M_cache.value (evaluation(), q);
+    }
+
+    //@}
+
+    //! Cache of the values at the quadrature nodes
+    EvaluationQuadratureCache<ReturnType> M_cache;
+};
+
+} // Namespace ExpressionAssembly
+
+} // Namespace LifeV
+#endif
@@ -58,6 +58,7 @@
 #include <lifev/eta/expression/IntegrateVectorVolumeID.hpp>
 #include <lifev/eta/expression/IntegrateVectorFaceID.hpp>
 #include <lifev/eta/expression/IntegrateMatrixFaceID.hpp>
+#include <lifev/eta/expression/IntegrateValueFaceID.hpp>
 
 #include <lifev/eta/expression/IntegrateValueElementLSAdapted.hpp>
 #include <lifev/eta/expression/IntegrateVectorElementLSAdapted.hpp>
@@ -261,6 +262,58 @@ integrate ( const RequestLoopElement<MeshType>& request,
            (request.mesh(), QRAdapterNeverAdapt (quadrature), testSpace, expression, offset);
 }
 
+//! Integrate function for vectorial expressions (multi-threaded path)
+/*!
+  This is an overload of the integrate function for vectors, which
+  uses multiple threads to do the assembly
+
+  This function is repeated 4 times:
+  versions with and without QR adapter
+  versions with and without Offset
+
+ */
+template < typename MeshType, typename TestSpaceType, typename ExpressionType, typename QRAdapterType>
+IntegrateVectorElement<MeshType, TestSpaceType, ExpressionType, QRAdapterType>
+integrate ( const RequestLoopElement<MeshType>& request,
+            const QRAdapterBase<QRAdapterType>& qrAdapterBase,
+            const boost::shared_ptr<TestSpaceType>& testSpace,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams,
+            const UInt offset = 0);
+template < typename MeshType, typename TestSpaceType, typename ExpressionType, typename QRAdapterType>
+IntegrateVectorElement<MeshType, TestSpaceType, ExpressionType, QRAdapterType>
+integrate ( const RequestLoopElement<MeshType>& request,
+            const QRAdapterBase<QRAdapterType>& qrAdapterBase,
+            const boost::shared_ptr<TestSpaceType>& testSpace,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams,
+            const UInt offset)
+{
+    return IntegrateVectorElement<MeshType, TestSpaceType, ExpressionType, QRAdapterType>
+           (request.mesh(), qrAdapterBase.implementation(), testSpace, expression, ompParams, offset);
+}
+
+template < typename MeshType, typename TestSpaceType, typename ExpressionType>
+IntegrateVectorElement<MeshType, TestSpaceType, ExpressionType, QRAdapterNeverAdapt>
+integrate ( const RequestLoopElement<MeshType>& request,
+            const QuadratureRule& quadrature,
+            const boost::shared_ptr<TestSpaceType>& testSpace,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams,
+            const UInt offset = 0);
+template < typename MeshType, typename TestSpaceType, typename ExpressionType>
+IntegrateVectorElement<MeshType, TestSpaceType, ExpressionType, QRAdapterNeverAdapt>
+integrate ( const RequestLoopElement<MeshType>& request,
+            const QuadratureRule& quadrature,
+            const boost::shared_ptr<TestSpaceType>& testSpace,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams,
+            const UInt offset)
+{
+    return IntegrateVectorElement<MeshType, TestSpaceType, ExpressionType, QRAdapterNeverAdapt>
+           (request.mesh(), QRAdapterNeverAdapt (quadrature), testSpace, expression, ompParams, offset);
+}
+
 //! Integrate function for benchmark expressions
 /*!
   @author Samuel Quinodoz <samuel.quinodoz@epfl.ch>
@@ -293,6 +346,37 @@ integrate ( const RequestLoopElement<MeshType>& request,
            (request.mesh(), QRAdapterNeverAdapt (quadrature), expression);
 }
 
+//! Integrate function for benchmark expressions (multi-threaded path)
+/*!
+  This is an overload of the integrate function for values, which
+  uses multiple threads to do the integration
+
+  This function is repeated 2 times:
+  versions with and without QR adapter
+
+ */
+template < typename MeshType, typename ExpressionType, typename QRAdapterType>
+IntegrateValueElement<MeshType, ExpressionType, QRAdapterType>
+integrate ( const RequestLoopElement<MeshType>& request,
+            const QRAdapterBase<QRAdapterType>& qrAdapterBase,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams)
+{
+    return IntegrateValueElement<MeshType, ExpressionType, QRAdapterType>
+           (request.mesh(), qrAdapterBase.implementation(), expression, ompParams);
+}
+
+template < typename MeshType, typename ExpressionType>
+IntegrateValueElement<MeshType, ExpressionType, QRAdapterNeverAdapt>
+integrate ( const RequestLoopElement<MeshType>& request,
+            const QuadratureRule& quadrature,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams)
+{
+    return IntegrateValueElement<MeshType, ExpressionType, QRAdapterNeverAdapt>
+           (request.mesh(), QRAdapterNeverAdapt (quadrature), expression, ompParams);
+}
+
 // =============================================================
 // Methods to integrate over a portion of the mesh
 // =============================================================
@@ -341,6 +425,58 @@ integrate ( const RequestLoopVolumeID<MeshType>& request,
            (request.volumeList(), request.indexList(), qrAdapter.implementation(), testSpace, expression);
 }
 
+/* Multi-threaded integration over a portion of the mesh */
+
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType>
+IntegrateMatrixVolumeID<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType, QRAdapterNeverAdapt>
+integrate ( const RequestLoopVolumeID<MeshType>& request,
+            const QuadratureRule& quadrature,
+            const boost::shared_ptr<TestSpaceType>& testSpace,
+            const boost::shared_ptr<SolutionSpaceType>& solutionSpace,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams)
+{
+    return IntegrateMatrixVolumeID<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType, QRAdapterNeverAdapt>
+           (request.volumeList(), request.indexList(), QRAdapterNeverAdapt (quadrature), testSpace, solutionSpace, expression, ompParams);
+}
+
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType, typename QRAdapterType>
+IntegrateMatrixVolumeID<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType, QRAdapterType>
+integrate ( const RequestLoopVolumeID<MeshType>& request,
+            const QRAdapterBase<QRAdapterType>& qrAdapter,
+            const boost::shared_ptr<TestSpaceType>& testSpace,
+            const boost::shared_ptr<SolutionSpaceType>& solutionSpace,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams)
+{
+    return IntegrateMatrixVolumeID<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType, QRAdapterType>
+           (request.volumeList(), request.indexList(), qrAdapter.implementation(), testSpace, solutionSpace, expression, ompParams);
+}
+
+template < typename MeshType, typename TestSpaceType, typename ExpressionType>
+IntegrateVectorVolumeID<MeshType, TestSpaceType, ExpressionType, QRAdapterNeverAdapt>
+integrate ( const RequestLoopVolumeID<MeshType>& request,
+            const QuadratureRule& quadrature,
+            const boost::shared_ptr<TestSpaceType>& testSpace,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams)
+{
+    return IntegrateVectorVolumeID<MeshType, TestSpaceType, ExpressionType, QRAdapterNeverAdapt>
+           (request.volumeList(), request.indexList(), QRAdapterNeverAdapt (quadrature), testSpace, expression, ompParams);
+}
+
+template < typename MeshType, typename TestSpaceType, typename ExpressionType, typename QRAdapterType>
+IntegrateVectorVolumeID<MeshType, TestSpaceType, ExpressionType, QRAdapterType>
+integrate ( const RequestLoopVolumeID<MeshType>& request,
+            const QRAdapterBase<QRAdapterType>& qrAdapter,
+            const boost::shared_ptr<TestSpaceType>& testSpace,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams)
+{
+    return IntegrateVectorVolumeID<MeshType, TestSpaceType, ExpressionType, QRAdapterType>
+           (request.volumeList(), request.indexList(), qrAdapter.implementation(), testSpace, expression, ompParams);
+}
+
 /* Integration on the boundary of the domain */
 
 
@@ -368,6 +504,79 @@ integrate ( const RequestLoopFaceID<MeshType>& request,
            (request.mesh(), request.id(), quadratureBoundary, testSpace, solutionSpace, expression);
 }
 
+template < typename MeshType, typename ExpressionType>
+IntegrateValueFaceID<MeshType, ExpressionType>
+integrate ( const RequestLoopFaceID<MeshType>& request,
+            const QuadratureBoundary& quadratureBoundary,
+            const ExpressionType& expression)
+{
+    return IntegrateValueFaceID<MeshType, ExpressionType>
+           (request.mesh(), std::vector<UInt> (1, request.id() ), quadratureBoundary, expression);
+}
+
+
+template < typename MeshType, typename ExpressionType>
+IntegrateValueFaceID<MeshType, ExpressionType>
+integrate ( const RequestLoopFaceIDList<MeshType>& request,
+            const QuadratureBoundary& quadratureBoundary,
+            const ExpressionType& expression)
+{
+    return IntegrateValueFaceID<MeshType, ExpressionType>
+           (request.mesh(), request.ids(), quadratureBoundary, expression);
+}
+
+/* Multi-threaded integration on the boundary of the domain */
+
+template < typename MeshType, typename TestSpaceType, typename ExpressionType>
+IntegrateVectorFaceID<MeshType, TestSpaceType, ExpressionType>
+integrate ( const RequestLoopFaceID<MeshType>& request,
+            const QuadratureBoundary& quadratureBoundary,
+            const boost::shared_ptr<TestSpaceType>& testSpace,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams)
+{
+    return IntegrateVectorFaceID<MeshType, TestSpaceType, ExpressionType>
+           (request.mesh(), request.id(), quadratureBoundary, testSpace, expression, ompParams);
+}
+
+
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType>
+IntegrateMatrixFaceID<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>
+integrate ( const RequestLoopFaceID<MeshType>& request,
+            const QuadratureBoundary& quadratureBoundary,
+            const boost::shared_ptr<TestSpaceType> testSpace,
+            const boost::shared_ptr<SolutionSpaceType> solutionSpace,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams)
+{
+    return IntegrateMatrixFaceID<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>
+           (request.mesh(), request.id(), quadratureBoundary, testSpace, solutionSpace, expression, ompParams);
+}
+
+
+template < typename MeshType, typename ExpressionType>
+IntegrateValueFaceID<MeshType, ExpressionType>
+integrate ( const RequestLoopFaceID<MeshType>& request,
+            const QuadratureBoundary& quadratureBoundary,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams)
+{
+    return IntegrateValueFaceID<MeshType, ExpressionType>
+           (request.mesh(), std::vector<UInt> (1, request.id() ), quadratureBoundary, expression, ompParams);
+}
+
+
+template < typename MeshType, typename ExpressionType>
+IntegrateValueFaceID<MeshType, ExpressionType>
+integrate ( const RequestLoopFaceIDList<MeshType>& request,
+            const QuadratureBoundary& quadratureBoundary,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams)
+{
+    return IntegrateValueFaceID<MeshType, ExpressionType>
+           (request.mesh(), request.ids(), quadratureBoundary, expression, ompParams);
+}
+
 
 template < typename MeshType,
          typename TestSpaceType,
@@ -52,6 +52,7 @@
 #include <lifev/eta/expression/ExpressionToEvaluation.hpp>
 
 #include <lifev/eta/array/ETMatrixElemental.hpp>
+#include <lifev/eta/array/ETMatrixElementalBatch.hpp>
 
 #include <boost/shared_ptr.hpp>
 #include <boost/scoped_ptr.hpp>
@@ -93,6 +94,12 @@ public:
             SolutionSpaceType::field_dim,
             MeshType::S_geoDimensions >::evaluation_Type  evaluation_Type;
 
+    //! Number of elements integrated together in the batched assembly
+    static const UInt S_batchWidth = 4;
+
+    //! Type of the elemental matrices of a batch
+    typedef ETMatrixElementalBatch<S_batchWidth> elementalBatch_Type;
+
     //@}
 
 
@@ -176,6 +183,8 @@ public:
       performed: update the values, update the local matrix,
       sum over the quadrature nodes, assemble in the global
       matrix.
+      If a region flag is given, only the elements of the region are
+      visited and the matrix gets no entry from the other elements.
      */
     template <typename MatrixType>
     void addTo (MatrixType& mat);
@@ -228,6 +237,30 @@ public:
     }
     //@}
 
+
+    //! @name Set Methods
+    //@{
+
+    //! Setter for the batched assembly
+    /*!
+      In the batched assembly (default), the elements using the standard
+      quadrature rule are integrated by batches of S_batchWidth elements:
+      each element of a batch (lane) has its own copy of the Evaluation and
+      of the current FEs, the values of the lanes are stored next to each
+      other and the weighted sums over the quadrature nodes are computed for
+      all the lanes at once. The elemental matrices are then pushed in the
+      global matrix one after the other. The elements using an adapted
+      quadrature rule are integrated one by one.
+
+      @param enable False to integrate all the elements one by one
+     */
+    void setBatchedAssembly (const bool& enable)
+    {
+        M_isBatchedAssembly = enable;
+    }
+
+    //@}
+
 private:
 
     //! @name Private Methods
@@ -236,6 +269,40 @@ private:
     //! No empty constructor
     IntegrateMatrixElement();
 
+    //! Evaluations and current FEs of the lanes of a batch
+    struct BatchLanes
+    {
+        BatchLanes (const IntegrateMatrixElement& integrator, const QuadratureRule& qr)
+            : wDet (qr.nbQuadPt() * S_batchWidth, 0.0)
+        {
+            for (UInt lane (0); lane < S_batchWidth; ++lane)
+            {
+                globalCFE[lane].reset (createGlobalCFE (qr) );
+                testCFE[lane].reset (new ETCurrentFE<TestSpaceType::space_dim, TestSpaceType::field_dim>
+                                     (integrator.M_testSpace->refFE(), integrator.M_testSpace->geoMap(), qr) );
+                solutionCFE[lane].reset (new ETCurrentFE<SolutionSpaceType::space_dim, SolutionSpaceType::field_dim>
+                                         (integrator.M_solutionSpace->refFE(), integrator.M_testSpace->geoMap(), qr) );
+
+                evaluation[lane].reset (new evaluation_Type (integrator.M_evaluation) );
+                evaluation[lane]->setQuadrature (qr);
+                evaluation[lane]->setGlobalCFE (globalCFE[lane].get() );
+                evaluation[lane]->setTestCFE (testCFE[lane].get() );
+                evaluation[lane]->setSolutionCFE (solutionCFE[lane].get() );
+            }
+        }
+
+        boost::scoped_ptr<evaluation_Type> evaluation[S_batchWidth];
+        boost::scoped_ptr<ETCurrentFE<MeshType::S_geoDimensions, 1> > globalCFE[S_batchWidth];
+        boost::scoped_ptr<ETCurrentFE<TestSpaceType::space_dim, TestSpaceType::field_dim> > testCFE[S_batchWidth];
+        boost::scoped_ptr<ETCurrentFE<SolutionSpaceType::space_dim, SolutionSpaceType::field_dim> > solutionCFE[S_batchWidth];
+
+        // Weights (wDet) of the quadrature nodes, the lanes of each node being contiguous
+        std::vector<Real> wDet;
+    };
+
+    //! Create the current FE for the geometric quantities, depending on the shape of the elements
+    static ETCurrentFE<MeshType::S_geoDimensions, 1>* createGlobalCFE (const QuadratureRule& qr);
+
     //! Perform the computations for a single element
     /*!
      * This method computes the elemental matrix for a given element
@@ -250,6 +317,20 @@ private:
                             ETCurrentFE<MeshType::S_geoDimensions, 1>& globalCFE,
                             ETCurrentFE<TestSpaceType::space_dim, TestSpaceType::field_dim>& testCFE,
                             ETCurrentFE<SolutionSpaceType::space_dim, SolutionSpaceType::field_dim>& solutionCFE);
+
+    //! Perform the computations for a batch of elements
+    /*!
+     * This method computes the elemental matrices of the first nbLanes
+     * lanes of the batch for the given element indices. The other lanes
+     * are left to zero.
+     */
+    void integrateBatch (const UInt* batchElements,
+                         const UInt nbLanes,
+                         const UInt nbQuadPt,
+                         const UInt nbTestDof,
+                         const UInt nbSolutionDof,
+                         elementalBatch_Type& elementalBatch,
+                         BatchLanes& lanes);
     //@}
 
     // Pointer on the mesh
@@ -283,6 +364,9 @@ private:
     // Data for integration on one subRegion
     const UInt M_regionFlag;
 
+    // Integrate the elements by batches
+    bool M_isBatchedAssembly;
+
 };
 
 
@@ -290,6 +374,9 @@ private:
 // IMPLEMENTATION
 // ===================================================
 
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType, typename QRAdapterType>
+const UInt IntegrateMatrixElement<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType, QRAdapterType>::S_batchWidth;
+
 // ===================================================
 // Constructors & Destructor
 // ===================================================
@@ -319,7 +406,8 @@ IntegrateMatrixElement (const boost::shared_ptr<MeshType>& mesh,
         M_offsetUp (offsetUp),
         M_offsetLeft (offsetLeft),
         M_ompParams(),
-        M_regionFlag( regionFlag )
+        M_regionFlag( regionFlag ),
+        M_isBatchedAssembly (true)
 
 {
     switch (MeshType::geoShape_Type::BasRefSha::S_shape)
@@ -379,7 +467,8 @@ IntegrateMatrixElement (const boost::shared_ptr<MeshType>& mesh,
         M_offsetUp (offsetUp),
         M_offsetLeft (offsetLeft),
         M_ompParams (ompParams),
-        M_regionFlag( regionFlag )
+        M_regionFlag( regionFlag ),
+        M_isBatchedAssembly (true)
 {
     switch (MeshType::geoShape_Type::BasRefSha::S_shape)
     {
@@ -433,7 +522,8 @@ IntegrateMatrixElement (const IntegrateMatrixElement<MeshType, TestSpaceType, So
         M_offsetLeft (integrator.M_offsetLeft),
 
         M_ompParams (integrator.M_ompParams),
-        M_regionFlag( integrator.M_regionFlag )
+        M_regionFlag( integrator.M_regionFlag ),
+        M_isBatchedAssembly (integrator.M_isBatchedAssembly)
 {
     switch (MeshType::geoShape_Type::BasRefSha::S_shape)
     {
@@ -554,6 +644,123 @@ integrateElement (const UInt iElement, const UInt nbQuadPt,
     }
 }
 
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType, typename QRAdapterType>
+ETCurrentFE<MeshType::S_geoDimensions, 1>*
+IntegrateMatrixElement<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType, QRAdapterType>::
+createGlobalCFE (const QuadratureRule& qr)
+{
+    switch (MeshType::geoShape_Type::BasRefSha::S_shape)
+    {
+        case LINE:
+            return new ETCurrentFE<MeshType::S_geoDimensions, 1> (feSegP0, geometricMapFromMesh<MeshType>(), qr);
+        case TRIANGLE:
+            return new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTriaP0, geometricMapFromMesh<MeshType>(), qr);
+        case QUAD:
+            return new ETCurrentFE<MeshType::S_geoDimensions, 1> (feQuadQ0, geometricMapFromMesh<MeshType>(), qr);
+        case TETRA:
+            return new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTetraP0, geometricMapFromMesh<MeshType>(), qr);
+        case HEXA:
+            return new ETCurrentFE<MeshType::S_geoDimensions, 1> (feHexaQ0, geometricMapFromMesh<MeshType>(), qr);
+        default:
+            ERROR_MSG ("Unrecognized element shape");
+    }
+    return 0;
+}
+
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType, typename QRAdapterType>
+void
+IntegrateMatrixElement<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType, QRAdapterType>::
+integrateBatch (const UInt* batchElements,
+                const UInt nbLanes,
+                const UInt nbQuadPt,
+                const UInt nbTestDof,
+                const UInt nbSolutionDof,
+                elementalBatch_Type& elementalBatch,
+                BatchLanes& lanes)
+{
+    // Zeros out the matrices
+    elementalBatch.zero();
+
+    // Update the evaluations and the currentFEs of the lanes, and
+    // gather the weights of the quadrature nodes lane by lane
+    for (UInt lane (0); lane < nbLanes; ++lane)
+    {
+        const UInt iElement (batchElements[lane]);
+
+        lanes.evaluation[lane]->update (iElement);
+
+        lanes.globalCFE[lane]->update (M_mesh->element (iElement), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
+        lanes.testCFE[lane]->update (M_mesh->element (iElement), evaluation_Type::S_testUpdateFlag);
+        lanes.solutionCFE[lane]->update (M_mesh->element (iElement), evaluation_Type::S_solutionUpdateFlag);
+
+        for (UInt iQuadPt (0); iQuadPt < nbQuadPt; ++iQuadPt)
+        {
+            lanes.wDet[iQuadPt * S_batchWidth + lane] = lanes.globalCFE[lane]->wDet (iQuadPt);
+        }
+    }
+
+    // The lanes without element get zero weights and zero values
+    for (UInt lane (nbLanes); lane < S_batchWidth; ++lane)
+    {
+        for (UInt iQuadPt (0); iQuadPt < nbQuadPt; ++iQuadPt)
+        {
+            lanes.wDet[iQuadPt * S_batchWidth + lane] = 0.0;
+        }
+    }
+
+    Real values[S_batchWidth];
+    for (UInt lane (0); lane < S_batchWidth; ++lane)
+    {
+        values[lane] = 0.0;
+    }
+
+    // Loop on the blocks
+
+    for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
+    {
+        for (UInt jblock (0); jblock < SolutionSpaceType::field_dim; ++jblock)
+        {
+
+            // Set the global indices of the lanes in the local matrices
+            for (UInt lane (0); lane < nbLanes; ++lane)
+            {
+                const UInt iElement (batchElements[lane]);
+
+                for (UInt i (0); i < nbTestDof; ++i)
+                {
+                    elementalBatch.setRowIndex
+                    (lane, i + iblock * nbTestDof,
+                     M_testSpace->dof().localToGlobalMap (iElement, i) + iblock * M_testSpace->dof().numTotalDof() + M_offsetUp);
+                }
+
+                for (UInt j (0); j < nbSolutionDof; ++j)
+                {
+                    elementalBatch.setColumnIndex
+                    (lane, j + jblock * nbSolutionDof,
+                     M_solutionSpace->dof().localToGlobalMap (iElement, j) + jblock * M_solutionSpace->dof().numTotalDof() + M_offsetLeft);
+                }
+            }
+
+            for (UInt iQuadPt (0); iQuadPt < nbQuadPt; ++iQuadPt)
+            {
+                for (UInt i (0); i < nbTestDof; ++i)
+                {
+                    for (UInt j (0); j < nbSolutionDof; ++j)
+                    {
+                        for (UInt lane (0); lane < nbLanes; ++lane)
+                        {
+                            values[lane] = lanes.evaluation[lane]->value_qij (iQuadPt, i + iblock * nbTestDof, j + jblock * nbSolutionDof);
+                        }
+
+                        elementalBatch.accumulate (i + iblock * nbTestDof, j + jblock * nbSolutionDof,
+                                                   values, &lanes.wDet[iQuadPt * S_batchWidth]);
+                    }
+                }
+            }
+        }
+    }
+}
+
 
 template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType, typename QRAdapterType>
 template <typename MatrixType>
@@ -576,72 +783,107 @@ addTo (MatrixType& mat)
 
     evaluation_Type evaluation (M_evaluation);
 
+    // Lanes of the batched assembly
+    boost::scoped_ptr<BatchLanes> lanes;
+    boost::scoped_ptr<elementalBatch_Type> elementalBatch;
+    UInt batchElements[S_batchWidth];
+    UInt nbBatchElements (0);
+
+    if (M_isBatchedAssembly)
+    {
+        lanes.reset (new BatchLanes (*this, M_qrAdapter.standardQR() ) );
+        elementalBatch.reset (new elementalBatch_Type (TestSpaceType::field_dim * nbTestDof,
+                                                       SolutionSpaceType::field_dim * nbSolutionDof) );
+    }
+
     // Defaulted to true for security
     bool isPreviousAdapted (true);
 
 //    std::cout << "M_regionFlag is " << M_regionFlag << std::endl;
 
-    for (UInt iElement (0); iElement < nbElements; ++iElement)
+    // Elements of the region (all the elements if no region is given).
+    // The elements outside the region add no entry to the matrix, not even zeros:
+    // its graph is the one of the region only.
+    const std::vector<UInt>* regionElements ( 0 );
+    if ( M_regionFlag != 0 )
     {
-        // Extracting the marker
-        UInt markerID = M_testSpace->mesh()->element ( iElement ).markerID( );
-
+        regionElements = &M_mesh->elementsWithMarker ( M_regionFlag );
+        nbElements = regionElements->size();
+    }
 
-        if ( M_regionFlag == 0 )
-        {
-            markerID = M_regionFlag;
-        }
+    for (UInt iRegionElement (0); iRegionElement < nbElements; ++iRegionElement)
+    {
+        const UInt iElement ( regionElements ? (*regionElements) [iRegionElement] : iRegionElement );
 
         elementalMatrix.zero();
 
-        if ( markerID == M_regionFlag )
-        {
+        // Update the quadrature rule adapter
+        M_qrAdapter.update (iElement);
 
-            // Update the quadrature rule adapter
-            M_qrAdapter.update (iElement);
+        if (M_isBatchedAssembly && !M_qrAdapter.isAdaptedElement() )
+        {
+            // Add the element to the batch, integrated once full
+            batchElements[nbBatchElements++] = iElement;
 
-            if (M_qrAdapter.isAdaptedElement() )
+            if (nbBatchElements == S_batchWidth)
             {
-                // Set the quadrature rule everywhere
-                evaluation.setQuadrature ( M_qrAdapter.adaptedQR() );
-                M_globalCFE_adapted -> setQuadratureRule ( M_qrAdapter.adaptedQR() );
-                M_testCFE_adapted -> setQuadratureRule ( M_qrAdapter.adaptedQR() );
-                M_solutionCFE_adapted -> setQuadratureRule ( M_qrAdapter.adaptedQR() );
+                integrateBatch (batchElements, nbBatchElements, M_qrAdapter.standardQR().nbQuadPt(),
+                                nbTestDof, nbSolutionDof, *elementalBatch, *lanes);
+                elementalBatch->pushToGlobal (mat, nbBatchElements);
+                nbBatchElements = 0;
+            }
+            continue;
+        }
 
-                // Reset the CurrentFEs in the evaluation
-                evaluation.setGlobalCFE ( M_globalCFE_adapted );
-                evaluation.setTestCFE ( M_testCFE_adapted );
-                evaluation.setSolutionCFE ( M_solutionCFE_adapted );
+        if (M_qrAdapter.isAdaptedElement() )
+        {
+            // Set the quadrature rule everywhere
+            evaluation.setQuadrature ( M_qrAdapter.adaptedQR() );
+            M_globalCFE_adapted -> setQuadratureRule ( M_qrAdapter.adaptedQR() );
+            M_testCFE_adapted -> setQuadratureRule ( M_qrAdapter.adaptedQR() );
+            M_solutionCFE_adapted -> setQuadratureRule ( M_qrAdapter.adaptedQR() );
 
-                integrateElement (iElement, M_qrAdapter.adaptedQR().nbQuadPt(), nbTestDof, nbSolutionDof,
-                                  elementalMatrix, evaluation, *M_globalCFE_adapted , //*globalCFE,
-                                  *M_testCFE_adapted, *M_solutionCFE_adapted);
+            // Reset the CurrentFEs in the evaluation
+            evaluation.setGlobalCFE ( M_globalCFE_adapted );
+            evaluation.setTestCFE ( M_testCFE_adapted );
+            evaluation.setSolutionCFE ( M_solutionCFE_adapted );
 
-                isPreviousAdapted = true;
+            integrateElement (iElement, M_qrAdapter.adaptedQR().nbQuadPt(), nbTestDof, nbSolutionDof,
+                              elementalMatrix, evaluation, *M_globalCFE_adapted , //*globalCFE,
+                              *M_testCFE_adapted, *M_solutionCFE_adapted);
 
-            }
-            else
+            isPreviousAdapted = true;
+
+        }
+        else
+        {
+            // Change in the evaluation if needed
+            if (isPreviousAdapted)
             {
-                // Change in the evaluation if needed
-                if (isPreviousAdapted)
-                {
-                    M_evaluation.setQuadrature ( M_qrAdapter.standardQR() );
-                    M_evaluation.setGlobalCFE ( M_globalCFE_std );
-                    M_evaluation.setTestCFE ( M_testCFE_std );
-                    M_evaluation.setSolutionCFE ( M_solutionCFE_std );
+                M_evaluation.setQuadrature ( M_qrAdapter.standardQR() );
+                M_evaluation.setGlobalCFE ( M_globalCFE_std );
+                M_evaluation.setTestCFE ( M_testCFE_std );
+                M_evaluation.setSolutionCFE ( M_solutionCFE_std );
 
-                    isPreviousAdapted = false;
-                }
+                isPreviousAdapted = false;
+            }
 
-                integrateElement (iElement, M_qrAdapter.standardQR().nbQuadPt(), nbTestDof, nbSolutionDof,
-                                  elementalMatrix, evaluation, *M_globalCFE_std , //*globalCFE,
-                                  *M_testCFE_std, *M_solutionCFE_std);
+            integrateElement (iElement, M_qrAdapter.standardQR().nbQuadPt(), nbTestDof, nbSolutionDof,
+                              elementalMatrix, evaluation, *M_globalCFE_std , //*globalCFE,
+                              *M_testCFE_std, *M_solutionCFE_std);
 
-            }
         }
 
         elementalMatrix.pushToGlobal (mat);
     }
+
+    // Last, incomplete batch
+    if (nbBatchElements > 0)
+    {
+        integrateBatch (batchElements, nbBatchElements, M_qrAdapter.standardQR().nbQuadPt(),
+                        nbTestDof, nbSolutionDof, *elementalBatch, *lanes);
+        elementalBatch->pushToGlobal (mat, nbBatchElements);
+    }
 }
 
 template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType, typename QRAdapterType>
@@ -720,15 +962,43 @@ addToClosed (MatrixType& mat)
         ETMatrixElemental elementalMatrix (TestSpaceType::field_dim * M_testSpace->refFE().nbDof(),
                                            SolutionSpaceType::field_dim * M_solutionSpace->refFE().nbDof() );
 
+        // Lanes of the batched assembly, for this thread
+        boost::scoped_ptr<BatchLanes> lanes;
+        boost::scoped_ptr<elementalBatch_Type> elementalBatch;
+        UInt batchElements[S_batchWidth];
+        UInt nbBatchElements (0);
+
+        if (M_isBatchedAssembly)
+        {
+            lanes.reset (new BatchLanes (*this, qrAdapter.standardQR() ) );
+            elementalBatch.reset (new elementalBatch_Type (TestSpaceType::field_dim * nbTestDof,
+                                                           SolutionSpaceType::field_dim * nbSolutionDof) );
+        }
+
         // Defaulted to true for security
         bool isPreviousAdapted (true);
 
         #pragma omp for schedule(runtime)
-        for (UInt iElement (0); iElement < nbElements; ++iElement)
+        for (UInt iElement = 0; iElement < nbElements; ++iElement)
         {
             // Update the quadrature rule adapter
             qrAdapter.update (iElement);
 
+            if (M_isBatchedAssembly && !qrAdapter.isAdaptedElement() )
+            {
+                // Add the element to the batch, integrated once full
+                batchElements[nbBatchElements++] = iElement;
+
+                if (nbBatchElements == S_batchWidth)
+                {
+                    integrateBatch (batchElements, nbBatchElements, qrAdapter.standardQR().nbQuadPt(),
+                                    nbTestDof, nbSolutionDof, *elementalBatch, *lanes);
+                    elementalBatch->pushToGlobal (mat, nbBatchElements);
+                    nbBatchElements = 0;
+                }
+                continue;
+            }
+
             // TODO: move QRule choice inside a common method for AddTo and AddToClosed
             // TODO: Remove the members repeated here
             // TODO: use a policy to say if: 1) matrix open/closed (with graph) 2) with or without QR adapter
@@ -775,6 +1045,14 @@ addToClosed (MatrixType& mat)
             elementalMatrix.pushToGlobal (mat);
         }
 
+        // Last, incomplete batch of this thread
+        if (nbBatchElements > 0)
+        {
+            integrateBatch (batchElements, nbBatchElements, qrAdapter.standardQR().nbQuadPt(),
+                            nbTestDof, nbSolutionDof, *elementalBatch, *lanes);
+            elementalBatch->pushToGlobal (mat, nbBatchElements);
+        }
+
         M_ompParams.restorePreviousNumThreads();
     }
 }
@@ -38,6 +38,8 @@
 
 #include <lifev/core/LifeV.hpp>
 
+#include <lifev/core/util/OpenMPParameters.hpp>
+
 #include <lifev/eta/fem/QuadratureBoundary.hpp>
 #include <lifev/eta/fem/ETCurrentFE.hpp>
 #include <lifev/eta/fem/ETCurrentBDFE.hpp>
@@ -95,6 +97,15 @@ public:
                            const boost::shared_ptr<SolutionSpaceType> solutionSpace,
                            const ExpressionType& expression);
 
+    //! Full data constructor for the multi-threaded assembly
+    IntegrateMatrixFaceID (const boost::shared_ptr<MeshType>& mesh,
+                           const UInt boundaryID,
+                           const QuadratureBoundary& quadratureBD,
+                           const boost::shared_ptr<TestSpaceType> testSpace,
+                           const boost::shared_ptr<SolutionSpaceType> solutionSpace,
+                           const ExpressionType& expression,
+                           const OpenMPParameters& ompParams);
+
     //! Copy constructor
     IntegrateMatrixFaceID ( const IntegrateMatrixFaceID < MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>& integrator);
 
@@ -182,6 +193,9 @@ private:
     std::vector<ETCurrentFE<3, SolutionSpaceType::field_dim>*> M_solutionCFE;
 
     ETMatrixElemental M_elementalMatrix;
+
+    // Data for multi-threaded assembly
+    OpenMPParameters M_ompParams;
 };
 
 
@@ -212,7 +226,92 @@ IntegrateMatrixFaceID (const boost::shared_ptr<MeshType>& mesh,
         M_testCFE (4),
         M_solutionCFE (4),
 
-        M_elementalMatrix (TestSpaceType::field_dim * testSpace->refFE().nbDof(), SolutionSpaceType::field_dim * solutionSpace->refFE().nbDof() )
+        M_elementalMatrix (TestSpaceType::field_dim * testSpace->refFE().nbDof(), SolutionSpaceType::field_dim * solutionSpace->refFE().nbDof() ),
+
+        M_ompParams()
+{
+    for (UInt i (0); i < 4; ++i)
+    {
+        M_globalCFE[i] = new ETCurrentBDFE<3> (geometricMapFromMesh<MeshType>()
+                                               , M_quadratureBoundary.qr (i) );
+
+        M_testCFE[i] = new ETCurrentFE<3, TestSpaceType::field_dim> (testSpace->refFE()
+                                                                     , testSpace->geoMap()
+                                                                     , M_quadratureBoundary.qr (i) );
+        M_solutionCFE[i] = new ETCurrentFE<3, SolutionSpaceType::field_dim> (solutionSpace->refFE()
+                                                                             , solutionSpace->geoMap()
+                                                                             , M_quadratureBoundary.qr (i) );
+    }
+
+    // Set the tangent on the different faces
+    std::vector< VectorSmall<3> > t0 (2, VectorSmall<3> (0.0, 0.0, 0.0) );
+    t0[0][0] = 1;
+    t0[0][1] = 0;
+    t0[0][2] = 0;
+    t0[1][0] = 0;
+    t0[1][1] = 1;
+    t0[1][2] = 0;
+    std::vector< VectorSmall<3> > t1 (2, VectorSmall<3> (0.0, 0.0, 0.0) );
+    t1[0][0] = 0;
+    t1[0][1] = 0;
+    t1[0][2] = 1;
+    t1[1][0] = 1;
+    t1[1][1] = 0;
+    t1[1][2] = 0;
+    std::vector< VectorSmall<3> > t2 (2, VectorSmall<3> (0.0, 0.0, 0.0) );
+    //t2[0][0]=-1/std::sqrt(6);    t2[0][1]=-1/std::sqrt(6);    t2[0][2]=2/std::sqrt(6);
+    //t2[1][0]=-1/std::sqrt(2);    t2[1][1]=1/std::sqrt(2);    t2[1][2]=0;
+    t2[0][0] = -1;
+    t2[0][1] = 0;
+    t2[0][2] = 1;
+    t2[1][0] = -1;
+    t2[1][1] = 1;
+    t2[1][2] = 0;
+
+    std::vector< VectorSmall<3> > t3 (2, VectorSmall<3> (0.0, 0.0, 0.0) );
+    t3[0][0] = 0;
+    t3[0][1] = 1;
+    t3[0][2] = 0;
+    t3[1][0] = 0;
+    t3[1][1] = 0;
+    t3[1][2] = 1;
+
+    M_globalCFE[0]->setRefTangents (t0);
+    M_globalCFE[1]->setRefTangents (t1);
+    M_globalCFE[2]->setRefTangents (t2);
+    M_globalCFE[3]->setRefTangents (t3);
+
+
+    M_evaluation.setQuadrature (M_quadratureBoundary.qr (0) );
+    M_evaluation.setGlobalCFE (M_globalCFE[0]);
+    M_evaluation.setTestCFE (M_testCFE[0]);
+    M_evaluation.setSolutionCFE (M_solutionCFE[0]);
+}
+
+
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType>
+IntegrateMatrixFaceID < MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>::
+IntegrateMatrixFaceID (const boost::shared_ptr<MeshType>& mesh,
+                       const UInt boundaryID,
+                       const QuadratureBoundary& quadratureBD,
+                       const boost::shared_ptr<TestSpaceType> testSpace,
+                       const boost::shared_ptr<SolutionSpaceType> solutionSpace,
+                       const ExpressionType& expression,
+                       const OpenMPParameters& ompParams)
+    :   M_mesh (mesh),
+        M_boundaryId (boundaryID),
+        M_quadratureBoundary (quadratureBD),
+        M_testSpace (testSpace),
+        M_solutionSpace (solutionSpace),
+        M_evaluation (expression),
+
+        M_globalCFE (4),
+        M_testCFE (4),
+        M_solutionCFE (4),
+
+        M_elementalMatrix (TestSpaceType::field_dim * testSpace->refFE().nbDof(), SolutionSpaceType::field_dim * solutionSpace->refFE().nbDof() ),
+
+        M_ompParams (ompParams)
 {
     for (UInt i (0); i < 4; ++i)
     {
@@ -287,7 +386,9 @@ IntegrateMatrixFaceID ( const IntegrateMatrixFaceID < MeshType, TestSpaceType, S
         M_testCFE (4),
         M_solutionCFE (4),
 
-        M_elementalMatrix (integrator.M_elementalMatrix)
+        M_elementalMatrix (integrator.M_elementalMatrix),
+
+        M_ompParams (integrator.M_ompParams)
 {
     for (UInt i (0); i < 4; ++i)
     {
@@ -382,84 +483,112 @@ void
 IntegrateMatrixFaceID < MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>::
 addTo (MatrixType& mat)
 {
-    UInt nbBoundaryFaces (M_mesh->numBFaces() );
+    // Boundary faces with the identifier
+    const std::vector<UInt>& boundaryFaces (M_mesh->boundaryFacetsWithMarker (M_boundaryId) );
+    UInt nbBoundaryFaces (boundaryFaces.size() );
     UInt nbTestDof (M_testSpace->refFE().nbDof() );
     UInt nbSolutionDof (M_solutionSpace->refFE().nbDof() );
 
-    for (UInt iFace (0); iFace < nbBoundaryFaces; ++iFace)
+    // OpenMP setup and pragmas around the loop
+    M_ompParams.apply();
+
+    #pragma omp parallel
     {
-        // Check the identifier
-        if ( M_mesh->face (iFace).markerID() != M_boundaryId )
+        // Thread-local copies of the structures modified in the loop
+        std::vector<boost::shared_ptr<ETCurrentBDFE<3> > > globalCFE (4);
+        std::vector<boost::shared_ptr<ETCurrentFE<3, TestSpaceType::field_dim> > > testCFE (4);
+        std::vector<boost::shared_ptr<ETCurrentFE<3, SolutionSpaceType::field_dim> > > solutionCFE (4);
+
+        for (UInt i (0); i < 4; ++i)
         {
-            continue;
+            globalCFE[i].reset (new ETCurrentBDFE<3> (*M_globalCFE[i]) );
+            testCFE[i].reset (new ETCurrentFE<3, TestSpaceType::field_dim> (M_testSpace->refFE()
+                                                                            , M_testSpace->geoMap()
+                                                                            , M_quadratureBoundary.qr (i) ) );
+            solutionCFE[i].reset (new ETCurrentFE<3, SolutionSpaceType::field_dim> (M_solutionSpace->refFE()
+                                                                                    , M_solutionSpace->geoMap()
+                                                                                    , M_quadratureBoundary.qr (i) ) );
         }
 
-        // Zeros out the elemental vector
-        M_elementalMatrix.zero();
+        evaluation_Type evaluation (M_evaluation);
 
-        // Get the number of the face in the adjacent element
-        UInt faceIDinAdjacentElement (M_mesh->face (iFace).firstAdjacentElementPosition() );
+        ETMatrixElemental elementalMatrix (M_elementalMatrix);
 
-        // Get the ID of the adjacent element
-        UInt adjacentElementID (M_mesh->face (iFace).firstAdjacentElementIdentity() );
+        #pragma omp for schedule(runtime)
+        for (UInt iBoundaryFace = 0; iBoundaryFace < nbBoundaryFaces; ++iBoundaryFace)
+        {
+            const UInt iFace (boundaryFaces[iBoundaryFace]);
 
-        // Update the currentFEs
-        M_globalCFE[faceIDinAdjacentElement]
-        ->update (M_mesh->element (adjacentElementID) );
-        M_testCFE[faceIDinAdjacentElement]
-        ->update (M_mesh->element (adjacentElementID), evaluation_Type::S_testUpdateFlag);
-        M_solutionCFE[faceIDinAdjacentElement]
-        ->update (M_mesh->element (adjacentElementID), evaluation_Type::S_solutionUpdateFlag);
+            // Zeros out the elemental matrix
+            elementalMatrix.zero();
 
+            // Get the number of the face in the adjacent element
+            UInt faceIDinAdjacentElement (M_mesh->face (iFace).firstAdjacentElementPosition() );
 
-        // Update the evaluation
-        M_evaluation.setQuadrature (M_quadratureBoundary.qr (faceIDinAdjacentElement) );
-        M_evaluation.setGlobalCFE (M_globalCFE[faceIDinAdjacentElement]);
-        M_evaluation.setTestCFE (M_testCFE[faceIDinAdjacentElement]);
-        M_evaluation.setSolutionCFE (M_solutionCFE[faceIDinAdjacentElement]);
+            // Get the ID of the adjacent element
+            UInt adjacentElementID (M_mesh->face (iFace).firstAdjacentElementIdentity() );
 
-        M_evaluation.update (adjacentElementID);
+            // Update the currentFEs
+            globalCFE[faceIDinAdjacentElement]
+            ->update (M_mesh->element (adjacentElementID) );
+            testCFE[faceIDinAdjacentElement]
+            ->update (M_mesh->element (adjacentElementID), evaluation_Type::S_testUpdateFlag);
+            solutionCFE[faceIDinAdjacentElement]
+            ->update (M_mesh->element (adjacentElementID), evaluation_Type::S_solutionUpdateFlag);
 
-        // Loop on the blocks
-        for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
-        {
-            for (UInt jblock (0); jblock < SolutionSpaceType::field_dim; ++jblock)
-            {
+            // Update the evaluation
+            evaluation.setQuadrature (M_quadratureBoundary.qr (faceIDinAdjacentElement) );
+            evaluation.setGlobalCFE (globalCFE[faceIDinAdjacentElement].get() );
+            evaluation.setTestCFE (testCFE[faceIDinAdjacentElement].get() );
+            evaluation.setSolutionCFE (solutionCFE[faceIDinAdjacentElement].get() );
 
-                // Set the row global indices in the local matrix
-                for (UInt i (0); i < nbTestDof; ++i)
-                {
-                    M_elementalMatrix.setRowIndex
-                    (i + iblock * nbTestDof,
-                     M_testSpace->dof().localToGlobalMap (adjacentElementID, i) + iblock * M_testSpace->dof().numTotalDof() );
-                }
+            evaluation.update (adjacentElementID);
 
-                for (UInt j (0); j < nbSolutionDof; ++j)
+            // Loop on the blocks
+            for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
+            {
+                for (UInt jblock (0); jblock < SolutionSpaceType::field_dim; ++jblock)
                 {
-                    M_elementalMatrix.setColumnIndex
-                    (j + jblock * nbSolutionDof,
-                     M_solutionSpace->dof().localToGlobalMap (adjacentElementID, j) + jblock * M_solutionSpace->dof().numTotalDof() );
-                }
-
 
-                // Make the assembly
-                for (UInt iQuadPt (0); iQuadPt < M_quadratureBoundary.qr (faceIDinAdjacentElement).nbQuadPt(); ++iQuadPt)
-                {
+                    // Set the row global indices in the local matrix
                     for (UInt i (0); i < nbTestDof; ++i)
                     {
-                        for (UInt j (0); j < nbSolutionDof; ++j)
+                        elementalMatrix.setRowIndex
+                        (i + iblock * nbTestDof,
+                         M_testSpace->dof().localToGlobalMap (adjacentElementID, i) + iblock * M_testSpace->dof().numTotalDof() );
+                    }
+
+                    for (UInt j (0); j < nbSolutionDof; ++j)
+                    {
+                        elementalMatrix.setColumnIndex
+                        (j + jblock * nbSolutionDof,
+                         M_solutionSpace->dof().localToGlobalMap (adjacentElementID, j) + jblock * M_solutionSpace->dof().numTotalDof() );
+                    }
+
+
+                    // Make the assembly
+                    for (UInt iQuadPt (0); iQuadPt < M_quadratureBoundary.qr (faceIDinAdjacentElement).nbQuadPt(); ++iQuadPt)
+                    {
+                        for (UInt i (0); i < nbTestDof; ++i)
                         {
-                            M_elementalMatrix.element (i + iblock * nbTestDof, j + jblock * nbSolutionDof) +=
-                                M_evaluation.value_qij (iQuadPt, i + iblock * nbTestDof, j + jblock * nbSolutionDof)
-                                * M_globalCFE[faceIDinAdjacentElement]->M_wMeas[iQuadPt];
+                            for (UInt j (0); j < nbSolutionDof; ++j)
+                            {
+                                elementalMatrix.element (i + iblock * nbTestDof, j + jblock * nbSolutionDof) +=
+                                    evaluation.value_qij (iQuadPt, i + iblock * nbTestDof, j + jblock * nbSolutionDof)
+                                    * globalCFE[faceIDinAdjacentElement]->M_wMeas[iQuadPt];
+                            }
                         }
                     }
                 }
             }
-        }
 
-        M_elementalMatrix.pushToGlobal (mat);
+            // The global matrix is not thread safe when still open
+            #pragma omp critical
+            elementalMatrix.pushToGlobal (mat);
+        }
     }
+
+    M_ompParams.restorePreviousNumThreads();
 }
 
 
@@ -417,17 +417,15 @@ void
 IntegrateMatrixFaceIDLSAdapted < MeshType, TestSpaceType, SolutionSpaceType, ExpressionType, LSFESpaceType, LSVectorType>::
 addTo (MatrixType& mat)
 {
-    UInt nbBoundaryFaces (M_mesh->numBFaces() );
+    // Boundary faces with the identifier
+    const std::vector<UInt>& boundaryFaces (M_mesh->boundaryFacetsWithMarker (M_boundaryId) );
+    UInt nbBoundaryFaces (boundaryFaces.size() );
     UInt nbTestDof (M_testSpace->refFE().nbDof() );
     UInt nbSolutionDof (M_solutionSpace->refFE().nbDof() );
 
-    for (UInt iFace (0); iFace < nbBoundaryFaces; ++iFace)
+    for (UInt iBoundaryFace (0); iBoundaryFace < nbBoundaryFaces; ++iBoundaryFace)
     {
-        // Check the identifier
-        if ( M_mesh->face (iFace).markerID() != M_boundaryId )
-        {
-            continue;
-        }
+        const UInt iFace (boundaryFaces[iBoundaryFace]);
 
         // Zeros out the elemental vector
         M_elementalMatrix.zero();
@@ -38,6 +38,8 @@
 
 #include <lifev/core/LifeV.hpp>
 
+#include <lifev/core/util/OpenMPParameters.hpp>
+
 #include <lifev/core/fem/QuadratureRule.hpp>
 #include <lifev/core/mesh/RegionMesh.hpp>
 #include <lifev/eta/fem/ETCurrentFE.hpp>
@@ -104,6 +106,15 @@ public:
                              const boost::shared_ptr<SolutionSpaceType>& solutionSpace,
                              const ExpressionType& expression);
 
+    //! Full data constructor for the multi-threaded assembly
+    IntegrateMatrixVolumeID (const vectorVolumesPtr_Type volumeList,
+                             const vectorIndexPtr_Type indexList,
+                             const QRAdapterType& qrAdapter,
+                             const boost::shared_ptr<TestSpaceType>& testSpace,
+                             const boost::shared_ptr<SolutionSpaceType>& solutionSpace,
+                             const ExpressionType& expression,
+                             const OpenMPParameters& ompParams);
+
     //! Copy constructor
     IntegrateMatrixVolumeID ( const IntegrateMatrixVolumeID < MeshType, TestSpaceType, SolutionSpaceType, ExpressionType, QRAdapterType>& integrator);
 
@@ -193,6 +204,9 @@ private:
     ETCurrentFE<3, SolutionSpaceType::field_dim>* M_solutionCFE_adapted;
 
     ETMatrixElemental M_elementalMatrix;
+
+    // Data for multi-threaded assembly
+    OpenMPParameters M_ompParams;
 };
 
 
@@ -229,7 +243,45 @@ IntegrateMatrixVolumeID (const vectorVolumesPtr_Type volumeList,
         M_solutionCFE_adapted (new ETCurrentFE<3, SolutionSpaceType::field_dim> (solutionSpace->refFE(), testSpace->geoMap(), qrAdapter.standardQR() ) ),
 
         M_elementalMatrix (TestSpaceType::field_dim * testSpace->refFE().nbDof(),
-                           SolutionSpaceType::field_dim * solutionSpace->refFE().nbDof() )
+                           SolutionSpaceType::field_dim * solutionSpace->refFE().nbDof() ),
+
+        M_ompParams()
+{
+    M_evaluation.setQuadrature (qrAdapter.standardQR() );
+    M_evaluation.setGlobalCFE (M_globalCFE_std);
+    M_evaluation.setTestCFE (M_testCFE_std);
+    M_evaluation.setSolutionCFE (M_solutionCFE_std);
+}
+
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType, typename QRAdapterType>
+IntegrateMatrixVolumeID<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType, QRAdapterType>::
+IntegrateMatrixVolumeID (const vectorVolumesPtr_Type volumeList,
+                         const vectorIndexPtr_Type indexList,
+                         const QRAdapterType& qrAdapter,
+                         const boost::shared_ptr<TestSpaceType>& testSpace,
+                         const boost::shared_ptr<SolutionSpaceType>& solutionSpace,
+                         const ExpressionType& expression,
+                         const OpenMPParameters& ompParams)
+    :   M_volumeList ( volumeList ),
+        M_indexList ( indexList ),
+        M_qrAdapter (qrAdapter),
+        M_testSpace (testSpace),
+        M_solutionSpace (solutionSpace),
+        M_evaluation (expression),
+
+        M_globalCFE_std (new ETCurrentFE<3, 1> (feTetraP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) ),
+        M_globalCFE_adapted (new ETCurrentFE<3, 1> (feTetraP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) ),
+
+        M_testCFE_std (new ETCurrentFE<3, TestSpaceType::field_dim> (testSpace->refFE(), testSpace->geoMap(), qrAdapter.standardQR() ) ),
+        M_testCFE_adapted (new ETCurrentFE<3, TestSpaceType::field_dim> (testSpace->refFE(), testSpace->geoMap(), qrAdapter.standardQR() ) ),
+
+        M_solutionCFE_std (new ETCurrentFE<3, SolutionSpaceType::field_dim> (solutionSpace->refFE(), testSpace->geoMap(), qrAdapter.standardQR() ) ),
+        M_solutionCFE_adapted (new ETCurrentFE<3, SolutionSpaceType::field_dim> (solutionSpace->refFE(), testSpace->geoMap(), qrAdapter.standardQR() ) ),
+
+        M_elementalMatrix (TestSpaceType::field_dim * testSpace->refFE().nbDof(),
+                           SolutionSpaceType::field_dim * solutionSpace->refFE().nbDof() ),
+
+        M_ompParams (ompParams)
 {
     M_evaluation.setQuadrature (qrAdapter.standardQR() );
     M_evaluation.setGlobalCFE (M_globalCFE_std);
@@ -257,7 +309,9 @@ IntegrateMatrixVolumeID (const IntegrateMatrixVolumeID<MeshType, TestSpaceType,
         M_solutionCFE_adapted (new ETCurrentFE<3, SolutionSpaceType::field_dim> (M_solutionSpace->refFE(), M_solutionSpace->geoMap(), integrator.M_qrAdapter.standardQR() )
                               ),
 
-        M_elementalMatrix (integrator.M_elementalMatrix)
+        M_elementalMatrix (integrator.M_elementalMatrix),
+
+        M_ompParams (integrator.M_ompParams)
 {
     M_evaluation.setQuadrature (integrator.M_qrAdapter.standardQR() );
     M_evaluation.setGlobalCFE (M_globalCFE_std);
@@ -302,9 +356,6 @@ void
 IntegrateMatrixVolumeID<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType, QRAdapterType>::
 addTo (MatrixType& mat)
 {
-    // Defaulted to true for security
-    bool isPreviousAdapted (true);
-
     //number of volumes
     UInt nbElements ( (*M_volumeList).size() );
     UInt nbIndexes ( (*M_indexList).size() );
@@ -315,140 +366,176 @@ addTo (MatrixType& mat)
     UInt nbTestDof (M_testSpace->refFE().nbDof() );
     UInt nbSolutionDof (M_solutionSpace->refFE().nbDof() );
 
-    for (UInt iElement (0); iElement < nbElements; ++iElement)
+    // OpenMP setup and pragmas around the loop
+    M_ompParams.apply();
+
+    #pragma omp parallel
     {
-        // Zeros out the matrix
-        M_elementalMatrix.zero();
+        // Thread-local copies of the structures modified in the loop
+        QRAdapterType qrAdapter (M_qrAdapter);
 
-        // Update the quadrature rule adapter
-        M_qrAdapter.update ( (*M_indexList) [iElement] );
+        ETCurrentFE<3, 1> globalCFE_std (*M_globalCFE_std);
+        ETCurrentFE<3, 1> globalCFE_adapted (*M_globalCFE_adapted);
 
-        if (M_qrAdapter.isAdaptedElement() )
-        {
-            // Set the quadrature rule everywhere
-            M_evaluation.setQuadrature ( M_qrAdapter.adaptedQR() );
-            M_globalCFE_adapted -> setQuadratureRule ( M_qrAdapter.adaptedQR() );
-            M_testCFE_adapted -> setQuadratureRule ( M_qrAdapter.adaptedQR() );
-            M_solutionCFE_adapted -> setQuadratureRule ( M_qrAdapter.adaptedQR() );
+        ETCurrentFE<3, TestSpaceType::field_dim>
+        testCFE_std (M_testSpace->refFE(), M_testSpace->geoMap(), M_qrAdapter.standardQR() );
+
+        ETCurrentFE<3, TestSpaceType::field_dim>
+        testCFE_adapted (M_testSpace->refFE(), M_testSpace->geoMap(), M_qrAdapter.standardQR() );
+
+        ETCurrentFE<3, SolutionSpaceType::field_dim>
+        solutionCFE_std (M_solutionSpace->refFE(), M_testSpace->geoMap(), M_qrAdapter.standardQR() );
 
-            // Reset the CurrentFEs in the evaluation
-            M_evaluation.setGlobalCFE ( M_globalCFE_adapted );
-            M_evaluation.setTestCFE ( M_testCFE_adapted );
-            M_evaluation.setSolutionCFE ( M_solutionCFE_adapted );
+        ETCurrentFE<3, SolutionSpaceType::field_dim>
+        solutionCFE_adapted (M_solutionSpace->refFE(), M_testSpace->geoMap(), M_qrAdapter.standardQR() );
 
-            M_evaluation.update ( (*M_indexList) [iElement] );
+        evaluation_Type evaluation (M_evaluation);
 
-            // Update the CurrentFEs
-            M_globalCFE_adapted->update (* ( (*M_volumeList) [iElement]), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
-            M_testCFE_adapted->update (* ( (*M_volumeList) [iElement]), evaluation_Type::S_testUpdateFlag);
-            M_solutionCFE_adapted->update (* ( (*M_volumeList) [iElement]), evaluation_Type::S_solutionUpdateFlag);
+        ETMatrixElemental elementalMatrix (M_elementalMatrix);
+
+        // Defaulted to true for security
+        bool isPreviousAdapted (true);
+
+        #pragma omp for schedule(runtime)
+        for (UInt iElement = 0; iElement < nbElements; ++iElement)
+        {
+            // Zeros out the matrix
+            elementalMatrix.zero();
 
+            // Update the quadrature rule adapter
+            qrAdapter.update ( (*M_indexList) [iElement] );
 
-            // Assembly
-            for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
+            if (qrAdapter.isAdaptedElement() )
             {
-                for (UInt jblock (0); jblock < SolutionSpaceType::field_dim; ++jblock)
-                {
+                // Set the quadrature rule everywhere
+                evaluation.setQuadrature ( qrAdapter.adaptedQR() );
+                globalCFE_adapted.setQuadratureRule ( qrAdapter.adaptedQR() );
+                testCFE_adapted.setQuadratureRule ( qrAdapter.adaptedQR() );
+                solutionCFE_adapted.setQuadratureRule ( qrAdapter.adaptedQR() );
 
-                    // Set the row global indices in the local matrix
-                    for (UInt i (0); i < nbTestDof; ++i)
-                    {
-                        M_elementalMatrix.setRowIndex
-                        (i + iblock * nbTestDof,
-                         M_testSpace->dof().localToGlobalMap ( (*M_indexList) [iElement], i) + iblock * M_testSpace->dof().numTotalDof() );
-                    }
+                // Reset the CurrentFEs in the evaluation
+                evaluation.setGlobalCFE ( &globalCFE_adapted );
+                evaluation.setTestCFE ( &testCFE_adapted );
+                evaluation.setSolutionCFE ( &solutionCFE_adapted );
 
-                    // Set the column global indices in the local matrix
-                    for (UInt j (0); j < nbSolutionDof; ++j)
-                    {
-                        M_elementalMatrix.setColumnIndex
-                        (j + jblock * nbSolutionDof,
-                         M_solutionSpace->dof().localToGlobalMap ( (*M_indexList) [iElement], j) + jblock * M_solutionSpace->dof().numTotalDof() );
-                    }
+                evaluation.update ( (*M_indexList) [iElement] );
 
-                    for (UInt iQuadPt (0); iQuadPt < M_qrAdapter.adaptedQR().nbQuadPt(); ++iQuadPt)
+                // Update the CurrentFEs
+                globalCFE_adapted.update (* ( (*M_volumeList) [iElement]), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
+                testCFE_adapted.update (* ( (*M_volumeList) [iElement]), evaluation_Type::S_testUpdateFlag);
+                solutionCFE_adapted.update (* ( (*M_volumeList) [iElement]), evaluation_Type::S_solutionUpdateFlag);
+
+
+                // Assembly
+                for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
+                {
+                    for (UInt jblock (0); jblock < SolutionSpaceType::field_dim; ++jblock)
                     {
+
+                        // Set the row global indices in the local matrix
                         for (UInt i (0); i < nbTestDof; ++i)
                         {
-                            for (UInt j (0); j < nbSolutionDof; ++j)
+                            elementalMatrix.setRowIndex
+                            (i + iblock * nbTestDof,
+                             M_testSpace->dof().localToGlobalMap ( (*M_indexList) [iElement], i) + iblock * M_testSpace->dof().numTotalDof() );
+                        }
+
+                        // Set the column global indices in the local matrix
+                        for (UInt j (0); j < nbSolutionDof; ++j)
+                        {
+                            elementalMatrix.setColumnIndex
+                            (j + jblock * nbSolutionDof,
+                             M_solutionSpace->dof().localToGlobalMap ( (*M_indexList) [iElement], j) + jblock * M_solutionSpace->dof().numTotalDof() );
+                        }
+
+                        for (UInt iQuadPt (0); iQuadPt < qrAdapter.adaptedQR().nbQuadPt(); ++iQuadPt)
+                        {
+                            for (UInt i (0); i < nbTestDof; ++i)
                             {
-                                M_elementalMatrix.element (i + iblock * nbTestDof, j + jblock * nbSolutionDof) +=
-                                    M_evaluation.value_qij (iQuadPt, i + iblock * nbTestDof, j + jblock * nbSolutionDof)
-                                    * M_globalCFE_adapted->wDet (iQuadPt);
+                                for (UInt j (0); j < nbSolutionDof; ++j)
+                                {
+                                    elementalMatrix.element (i + iblock * nbTestDof, j + jblock * nbSolutionDof) +=
+                                        evaluation.value_qij (iQuadPt, i + iblock * nbTestDof, j + jblock * nbSolutionDof)
+                                        * globalCFE_adapted.wDet (iQuadPt);
 
+                                }
                             }
                         }
                     }
                 }
-            }
 
-            isPreviousAdapted = true;
+                isPreviousAdapted = true;
 
-        }
-        else
-        {
-            // Change in the evaluation if needed
-            if (isPreviousAdapted)
+            }
+            else
             {
-                M_evaluation.setQuadrature ( M_qrAdapter.standardQR() );
-                M_evaluation.setGlobalCFE ( M_globalCFE_std );
-                M_evaluation.setTestCFE ( M_testCFE_std );
-                M_evaluation.setSolutionCFE ( M_solutionCFE_std );
+                // Change in the evaluation if needed
+                if (isPreviousAdapted)
+                {
+                    evaluation.setQuadrature ( qrAdapter.standardQR() );
+                    evaluation.setGlobalCFE ( &globalCFE_std );
+                    evaluation.setTestCFE ( &testCFE_std );
+                    evaluation.setSolutionCFE ( &solutionCFE_std );
 
-                isPreviousAdapted = false;
-            }
+                    isPreviousAdapted = false;
+                }
 
-            // Update the currentFEs
-            M_globalCFE_std->update (* ( (*M_volumeList) [iElement]), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
-            M_testCFE_std->update (* ( (*M_volumeList) [iElement]), evaluation_Type::S_testUpdateFlag);
-            M_solutionCFE_std->update (* ( (*M_volumeList) [iElement]), evaluation_Type::S_solutionUpdateFlag);
+                // Update the currentFEs
+                globalCFE_std.update (* ( (*M_volumeList) [iElement]), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
+                testCFE_std.update (* ( (*M_volumeList) [iElement]), evaluation_Type::S_testUpdateFlag);
+                solutionCFE_std.update (* ( (*M_volumeList) [iElement]), evaluation_Type::S_solutionUpdateFlag);
 
-            // Update the evaluation
-            M_evaluation.update ( (*M_indexList) [iElement] );
+                // Update the evaluation
+                evaluation.update ( (*M_indexList) [iElement] );
 
-            // Loop on the blocks
+                // Loop on the blocks
 
-            for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
-            {
-                for (UInt jblock (0); jblock < SolutionSpaceType::field_dim; ++jblock)
+                for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
                 {
-
-                    // Set the row global indices in the local matrix
-                    for (UInt i (0); i < nbTestDof; ++i)
-                    {
-                        M_elementalMatrix.setRowIndex
-                        (i + iblock * nbTestDof,
-                         M_testSpace->dof().localToGlobalMap ( (*M_indexList) [iElement], i) + iblock * M_testSpace->dof().numTotalDof() );
-                    }
-
-                    // Set the column global indices in the local matrix
-                    for (UInt j (0); j < nbSolutionDof; ++j)
+                    for (UInt jblock (0); jblock < SolutionSpaceType::field_dim; ++jblock)
                     {
-                        M_elementalMatrix.setColumnIndex
-                        (j + jblock * nbSolutionDof,
-                         M_solutionSpace->dof().localToGlobalMap ( (*M_indexList) [iElement], j) + jblock * M_solutionSpace->dof().numTotalDof() );
-                    }
 
-                    for (UInt iQuadPt (0); iQuadPt < nbQuadPt_std; ++iQuadPt)
-                    {
+                        // Set the row global indices in the local matrix
                         for (UInt i (0); i < nbTestDof; ++i)
                         {
-                            for (UInt j (0); j < nbSolutionDof; ++j)
+                            elementalMatrix.setRowIndex
+                            (i + iblock * nbTestDof,
+                             M_testSpace->dof().localToGlobalMap ( (*M_indexList) [iElement], i) + iblock * M_testSpace->dof().numTotalDof() );
+                        }
+
+                        // Set the column global indices in the local matrix
+                        for (UInt j (0); j < nbSolutionDof; ++j)
+                        {
+                            elementalMatrix.setColumnIndex
+                            (j + jblock * nbSolutionDof,
+                             M_solutionSpace->dof().localToGlobalMap ( (*M_indexList) [iElement], j) + jblock * M_solutionSpace->dof().numTotalDof() );
+                        }
+
+                        for (UInt iQuadPt (0); iQuadPt < nbQuadPt_std; ++iQuadPt)
+                        {
+                            for (UInt i (0); i < nbTestDof; ++i)
                             {
-                                M_elementalMatrix.element (i + iblock * nbTestDof, j + jblock * nbSolutionDof) +=
-                                    M_evaluation.value_qij (iQuadPt, i + iblock * nbTestDof, j + jblock * nbSolutionDof)
-                                    * M_globalCFE_std->wDet (iQuadPt);
+                                for (UInt j (0); j < nbSolutionDof; ++j)
+                                {
+                                    elementalMatrix.element (i + iblock * nbTestDof, j + jblock * nbSolutionDof) +=
+                                        evaluation.value_qij (iQuadPt, i + iblock * nbTestDof, j + jblock * nbSolutionDof)
+                                        * globalCFE_std.wDet (iQuadPt);
 
+                                }
                             }
                         }
                     }
                 }
+
             }
 
+            // The global matrix is not thread safe when still open
+            #pragma omp critical
+            elementalMatrix.pushToGlobal (mat);
         }
-
-        M_elementalMatrix.pushToGlobal (mat);
     }
+
+    M_ompParams.restorePreviousNumThreads();
 }
 
 } // Namespace ExpressionAssembly
@@ -39,6 +39,7 @@
 #include <lifev/core/LifeV.hpp>
 
 #include <lifev/core/fem/QuadratureRule.hpp>
+#include <lifev/core/util/OpenMPParameters.hpp>
 #include <lifev/eta/fem/ETCurrentFE.hpp>
 #include <lifev/eta/fem/MeshGeometricMap.hpp>
 #include <lifev/eta/fem/QRAdapterBase.hpp>
@@ -89,6 +90,12 @@ public:
                            const QRAdapterType& qrAdapter,
                            const ExpressionType& expression);
 
+    //! Full data constructor for the multi-threaded integration
+    IntegrateValueElement (const boost::shared_ptr<MeshType>& mesh,
+                           const QRAdapterType& qrAdapter,
+                           const ExpressionType& expression,
+                           const OpenMPParameters& ompParams);
+
     //! Copy constructor
     IntegrateValueElement ( const IntegrateValueElement < MeshType, ExpressionType, QRAdapterType>& integrator);
 
@@ -122,6 +129,8 @@ public:
       in this method. Everything for the assembly is then
       performed: update the values, sum over the quadrature nodes,
       sum into the global value.
+      The elements are shared among the threads given in the
+      OpenMPParameters and the partial sums are reduced at the end.
      */
     void addTo (Real& value);
 
@@ -152,6 +161,9 @@ private:
     // CurrentFE for the adapted quadrature
     ETCurrentFE<MeshType::S_geoDimensions, 1>* M_globalCFE_adapted;
 
+    // Data for multi-threaded integration
+    OpenMPParameters M_ompParams;
+
 };
 
 
@@ -170,7 +182,50 @@ IntegrateValueElement (const boost::shared_ptr<MeshType>& mesh,
                        const ExpressionType& expression)
     :   M_mesh (mesh),
         M_qrAdapter (qrAdapter),
-        M_evaluation (expression)
+        M_evaluation (expression),
+        M_ompParams()
+
+{
+    switch (MeshType::geoShape_Type::BasRefSha::S_shape)
+    {
+        case LINE:
+            M_globalCFE_std = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feSegP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            M_globalCFE_adapted = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feSegP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            break;
+        case TRIANGLE:
+            M_globalCFE_std = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTriaP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            M_globalCFE_adapted = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTriaP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            break;
+        case QUAD:
+            M_globalCFE_std = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feQuadQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            M_globalCFE_adapted = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feQuadQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            break;
+        case TETRA:
+            M_globalCFE_std = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTetraP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            M_globalCFE_adapted = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTetraP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            break;
+        case HEXA:
+            M_globalCFE_std = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feHexaQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            M_globalCFE_adapted = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feHexaQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            break;
+        default:
+            ERROR_MSG ("Unrecognized element shape");
+    }
+    M_evaluation.setQuadrature (qrAdapter.standardQR() );
+    M_evaluation.setGlobalCFE (M_globalCFE_std);
+}
+
+
+template < typename MeshType, typename ExpressionType, typename QRAdapterType>
+IntegrateValueElement < MeshType, ExpressionType, QRAdapterType>::
+IntegrateValueElement (const boost::shared_ptr<MeshType>& mesh,
+                       const QRAdapterType& qrAdapter,
+                       const ExpressionType& expression,
+                       const OpenMPParameters& ompParams)
+    :   M_mesh (mesh),
+        M_qrAdapter (qrAdapter),
+        M_evaluation (expression),
+        M_ompParams (ompParams)
 
 {
     switch (MeshType::geoShape_Type::BasRefSha::S_shape)
@@ -208,7 +263,8 @@ IntegrateValueElement < MeshType, ExpressionType, QRAdapterType>::
 IntegrateValueElement ( const IntegrateValueElement < MeshType, ExpressionType, QRAdapterType>& integrator)
     :   M_mesh (integrator.M_mesh),
         M_qrAdapter (integrator.M_qrAdapter),
-        M_evaluation (integrator.M_evaluation)
+        M_evaluation (integrator.M_evaluation),
+        M_ompParams (integrator.M_ompParams)
 {
     switch (MeshType::geoShape_Type::BasRefSha::S_shape)
     {
@@ -272,71 +328,93 @@ addTo (Real& value)
     UInt nbElements (M_mesh->numElements() );
     UInt nbQuadPt_std (M_qrAdapter.standardQR().nbQuadPt() );
 
-    // This flag reports whether the previous element
-    // needed an adapted integration. It is set to true
-    // by default for security.
-    bool isPreviousAdapted (true);
+    // Sum of the contributions of the elements, reduced over the threads
+    Real integral (0.0);
 
-    for (UInt iElement (0); iElement < nbElements; ++iElement)
-    {
-        // Update the quadrature adapter
-        M_qrAdapter.update (iElement);
+    // OpenMP setup and pragmas around the loop
+    M_ompParams.apply();
 
-        // Check if the current element needs an adapted
-        // quadrature rule.
-        if ( M_qrAdapter.isAdaptedElement() )
-        {
+    #pragma omp parallel reduction(+:integral)
+    {
+        // Thread-local copies of the structures modified in the loop
+        QRAdapterType qrAdapter (M_qrAdapter);
 
-            // Set the adapted QR
-            M_evaluation.setQuadrature ( M_qrAdapter.adaptedQR() );
-            M_globalCFE_adapted->setQuadratureRule ( M_qrAdapter.adaptedQR() );
+        ETCurrentFE<MeshType::S_geoDimensions, 1> globalCFE_std (*M_globalCFE_std);
+        ETCurrentFE<MeshType::S_geoDimensions, 1> globalCFE_adapted (*M_globalCFE_adapted);
 
-            // Set the right CFE (even if the previous one was
-            // adapted! The memory locations might have changed!
-            M_evaluation.setGlobalCFE ( M_globalCFE_adapted );
+        evaluation_Type evaluation (M_evaluation);
 
-            // Update the currentFE
-            M_globalCFE_adapted->update (M_mesh->element (iElement), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
+        // This flag reports whether the previous element
+        // needed an adapted integration. It is set to true
+        // by default for security.
+        bool isPreviousAdapted (true);
 
-            // Update the evaluation
-            M_evaluation.update (iElement);
+        #pragma omp for schedule(runtime)
+        for (UInt iElement = 0; iElement < nbElements; ++iElement)
+        {
+            // Update the quadrature adapter
+            qrAdapter.update (iElement);
 
-            // Make the assembly
-            for (UInt iQuadPt (0); iQuadPt < M_qrAdapter.adaptedQR().nbQuadPt(); ++iQuadPt)
+            // Check if the current element needs an adapted
+            // quadrature rule.
+            if ( qrAdapter.isAdaptedElement() )
             {
-                value += M_evaluation.value_q (iQuadPt)
-                         * M_globalCFE_adapted->wDet (iQuadPt);
-            }
 
-            // Finally, set the flag
-            isPreviousAdapted = true;
-        }
-        else
-        {
-            // Check if the previous one was adapted
-            if (isPreviousAdapted)
-            {
-                M_evaluation.setQuadrature ( M_qrAdapter.standardQR() );
-                M_evaluation.setGlobalCFE ( M_globalCFE_std );
-                // Update the flag
-                isPreviousAdapted = false;
-            }
+                // Set the adapted QR
+                evaluation.setQuadrature ( qrAdapter.adaptedQR() );
+                globalCFE_adapted.setQuadratureRule ( qrAdapter.adaptedQR() );
+
+                // Set the right CFE (even if the previous one was
+                // adapted! The memory locations might have changed!
+                evaluation.setGlobalCFE ( &globalCFE_adapted );
 
-            // Update the currentFEs
-            M_globalCFE_std->update (M_mesh->element (iElement), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
+                // Update the currentFE
+                globalCFE_adapted.update (M_mesh->element (iElement), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
 
-            // Update the evaluation
-            M_evaluation.update (iElement);
+                // Update the evaluation
+                evaluation.update (iElement);
 
+                // Make the assembly
+                for (UInt iQuadPt (0); iQuadPt < qrAdapter.adaptedQR().nbQuadPt(); ++iQuadPt)
+                {
+                    integral += evaluation.value_q (iQuadPt)
+                                * globalCFE_adapted.wDet (iQuadPt);
+                }
 
-            // Make the assembly
-            for (UInt iQuadPt (0); iQuadPt < nbQuadPt_std; ++iQuadPt)
+                // Finally, set the flag
+                isPreviousAdapted = true;
+            }
+            else
             {
-                value += M_evaluation.value_q (iQuadPt)
-                         * M_globalCFE_std->wDet (iQuadPt);
+                // Check if the previous one was adapted
+                if (isPreviousAdapted)
+                {
+                    evaluation.setQuadrature ( qrAdapter.standardQR() );
+                    evaluation.setGlobalCFE ( &globalCFE_std );
+                    // Update the flag
+                    isPreviousAdapted = false;
+                }
+
+                // Update the currentFEs
+                globalCFE_std.update (M_mesh->element (iElement), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
+
+                // Update the evaluation
+                evaluation.update (iElement);
+
+
+                // Make the assembly
+                for (UInt iQuadPt (0); iQuadPt < nbQuadPt_std; ++iQuadPt)
+                {
+                    integral += evaluation.value_q (iQuadPt)
+                                * globalCFE_std.wDet (iQuadPt);
+                }
             }
         }
     }
+
+    M_ompParams.restorePreviousNumThreads();
+
+    value += integral;
 }
 
 
@@ -0,0 +1,503 @@
+//@HEADER
+/*
+*******************************************************************************
+
+   Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+   Copyright (C) 2010 EPFL, Politecnico di Milano, Emory UNiversity
+
+   This file is part of the LifeV library
+
+   LifeV is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   LifeV is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, see <http://www.gnu.org/licenses/>
+
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+ *   @file
+     @brief This file contains the definition of the IntegrateValueFaceID class.
+
+     @date 10/2026
+ */
+
+#ifndef INTEGRATE_VALUE_FACE_ID_HPP
+#define INTEGRATE_VALUE_FACE_ID_HPP
+
+#include <lifev/core/LifeV.hpp>
+
+#include <lifev/core/array/VectorSmall.hpp>
+#include <lifev/core/util/OpenMPParameters.hpp>
+
+#include <lifev/eta/fem/QuadratureBoundary.hpp>
+#include <lifev/eta/fem/ETCurrentBDFE.hpp>
+#include <lifev/eta/fem/MeshGeometricMap.hpp>
+
+#include <lifev/eta/expression/ExpressionToEvaluation.hpp>
+
+#include <boost/shared_ptr.hpp>
+
+#include <algorithm>
+#include <vector>
+
+
+namespace LifeV
+{
+
+namespace ExpressionAssembly
+{
+
+//! The class to actually perform the loop over the boundary faces to compute a value
+/*!
+  This class is the boundary counterpart of IntegrateValueElement: it integrates
+  an expression without test function over the boundary faces with one or several
+  identifiers. The value of the expression can be a Real or a VectorSmall, the
+  latter being a way to compute several functionals in the same loop.
+
+  The integral is computed on the faces owned by the process and the partial
+  sums of all the processes are summed with a single reduction, so that the
+  result is the same on all the processes. No global vector is involved.
+
+  With several identifiers, the values can be summed (operator>> with a single
+  value) or computed separately, one for each identifier (operator>> with a
+  std::vector); in both cases the loop on the faces and the reduction are done
+  only once.
+ */
+template < typename MeshType, typename ExpressionType>
+class IntegrateValueFaceID
+{
+public:
+
+    //! @name Public Types
+    //@{
+
+    //! Type of the Evaluation
+    typedef typename ExpressionToEvaluation < ExpressionType,
+            0,
+            0,
+            3 >::evaluation_Type evaluation_Type;
+
+    //! Type of the value of the integral
+    typedef typename evaluation_Type::return_Type value_Type;
+
+    //@}
+
+
+    //! @name Constructors, destructor
+    //@{
+
+    //! Full data constructor
+    IntegrateValueFaceID (const boost::shared_ptr<MeshType>& mesh,
+                          const std::vector<UInt>& boundaryIDs,
+                          const QuadratureBoundary& quadratureBD,
+                          const ExpressionType& expression);
+
+    //! Full data constructor for the multi-threaded integration
+    IntegrateValueFaceID (const boost::shared_ptr<MeshType>& mesh,
+                          const std::vector<UInt>& boundaryIDs,
+                          const QuadratureBoundary& quadratureBD,
+                          const ExpressionType& expression,
+                          const OpenMPParameters& ompParams);
+
+    //! Copy constructor
+    IntegrateValueFaceID ( const IntegrateValueFaceID < MeshType, ExpressionType>& integrator);
+
+    //! Destructor
+    ~IntegrateValueFaceID();
+
+    //@}
+
+
+    //! @name Operators
+    //@{
+
+    //! Operator wrapping the addTo method
+    inline void operator>> (value_Type& value)
+    {
+        addTo (value);
+    }
+
+    //! Operator wrapping the addTo method (one value for each boundary identifier)
+    inline void operator>> (std::vector<value_Type>& values)
+    {
+        addTo (values);
+    }
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! Ouput method
+    void check (std::ostream& out = std::cout);
+
+    //! Method that performs the integration
+    /*!
+      The integral over all the boundary identifiers is added to the value.
+     */
+    void addTo (value_Type& value);
+
+    //! Method that performs the integration, separately for each boundary identifier
+    /*!
+      The integral over the i-th boundary identifier is added to values[i]; the
+      vector is resized to the number of identifiers if needed.
+     */
+    void addTo (std::vector<value_Type>& values);
+
+    //@}
+
+private:
+
+    //! @name Private Methods
+    //@{
+
+    //! No empty constructor
+    IntegrateValueFaceID();
+
+    //! Set the reference tangents of the faces and the evaluation
+    void setup();
+
+    //! Compute the local integral for each identifier and sum it over the processes
+    void integrate (std::vector<value_Type>& integrals);
+
+    //@}
+
+    // Pointer on the mesh
+    boost::shared_ptr<MeshType> M_mesh;
+
+    // Identifiers of the boundary
+    std::vector<UInt> M_boundaryIds;
+
+    // Quadrature to be used
+    QuadratureBoundary M_quadratureBoundary;
+
+    // Tree to compute the values for the integration
+    evaluation_Type M_evaluation;
+
+    std::vector<ETCurrentBDFE<3>*> M_globalCFE;
+
+    // Data for multi-threaded integration
+    OpenMPParameters M_ompParams;
+};
+
+
+//! Number of Real entries of the value of an integral
+inline UInt integralValueSize (const Real& /*value*/)
+{
+    return 1;
+}
+
+template <UInt Dim>
+inline UInt integralValueSize (const VectorSmall<Dim>& /*value*/)
+{
+    return Dim;
+}
+
+//! Pointer to the Real entries of the value of an integral
+inline Real* integralValueData (Real& value)
+{
+    return &value;
+}
+
+template <UInt Dim>
+inline Real* integralValueData (VectorSmall<Dim>& value)
+{
+    return &value[0];
+}
+
+
+// ===================================================
+// IMPLEMENTATION
+// ===================================================
+
+// ===================================================
+// Constructors & Destructor
+// ===================================================
+
+template < typename MeshType, typename ExpressionType>
+IntegrateValueFaceID < MeshType, ExpressionType>::
+IntegrateValueFaceID (const boost::shared_ptr<MeshType>& mesh,
+                      const std::vector<UInt>& boundaryIDs,
+                      const QuadratureBoundary& quadratureBD,
+                      const ExpressionType& expression)
+    :   M_mesh (mesh),
+        M_boundaryIds (boundaryIDs),
+        M_quadratureBoundary (quadratureBD),
+        M_evaluation (expression),
+        M_globalCFE (4),
+        M_ompParams()
+{
+    setup();
+}
+
+
+template < typename MeshType, typename ExpressionType>
+IntegrateValueFaceID < MeshType, ExpressionType>::
+IntegrateValueFaceID (const boost::shared_ptr<MeshType>& mesh,
+                      const std::vector<UInt>& boundaryIDs,
+                      const QuadratureBoundary& quadratureBD,
+                      const ExpressionType& expression,
+                      const OpenMPParameters& ompParams)
+    :   M_mesh (mesh),
+        M_boundaryIds (boundaryIDs),
+        M_quadratureBoundary (quadratureBD),
+        M_evaluation (expression),
+        M_globalCFE (4),
+        M_ompParams (ompParams)
+{
+    setup();
+}
+
+
+template < typename MeshType, typename ExpressionType>
+IntegrateValueFaceID < MeshType, ExpressionType>::
+IntegrateValueFaceID ( const IntegrateValueFaceID < MeshType, ExpressionType>& integrator)
+    :   M_mesh (integrator.M_mesh),
+        M_boundaryIds (integrator.M_boundaryIds),
+        M_quadratureBoundary (integrator.M_quadratureBoundary),
+        M_evaluation (integrator.M_evaluation),
+        M_globalCFE (4),
+        M_ompParams (integrator.M_ompParams)
+{
+    setup();
+}
+
+
+template < typename MeshType, typename ExpressionType>
+IntegrateValueFaceID < MeshType, ExpressionType>::
+~IntegrateValueFaceID()
+{
+    for (UInt i (0); i < 4; ++i)
+    {
+        delete M_globalCFE[i];
+    }
+}
+
+
+// ===================================================
+// Methods
+// ===================================================
+
+template < typename MeshType, typename ExpressionType>
+void
+IntegrateValueFaceID < MeshType, ExpressionType>::
+check (std::ostream& out)
+{
+    out << " Checking the integration : " << std::endl;
+    M_evaluation.display (out);
+}
+
+
+template < typename MeshType, typename ExpressionType>
+void
+IntegrateValueFaceID < MeshType, ExpressionType>::
+addTo (value_Type& value)
+{
+    std::vector<value_Type> integrals;
+    integrate (integrals);
+
+    for (UInt iId (0); iId < integrals.size(); ++iId)
+    {
+        value += integrals[iId];
+    }
+}
+
+
+template < typename MeshType, typename ExpressionType>
+void
+IntegrateValueFaceID < MeshType, ExpressionType>::
+addTo (std::vector<value_Type>& values)
+{
+    std::vector<value_Type> integrals;
+    integrate (integrals);
+
+    if (values.size() != integrals.size() )
+    {
+        values.resize (integrals.size(), value_Type() );
+    }
+
+    for (UInt iId (0); iId < integrals.size(); ++iId)
+    {
+        values[iId] += integrals[iId];
+    }
+}
+
+
+// ===================================================
+// Private Methods
+// ===================================================
+
+template < typename MeshType, typename ExpressionType>
+void
+IntegrateValueFaceID < MeshType, ExpressionType>::
+setup()
+{
+    for (UInt i (0); i < 4; ++i)
+    {
+        M_globalCFE[i] = new ETCurrentBDFE<3> (geometricMapFromMesh<MeshType>()
+                                               , M_quadratureBoundary.qr (i) );
+    }
+
+    // Set the tangent on the different faces (see IntegrateVectorFaceID)
+    std::vector< VectorSmall<3> > t0 (2, VectorSmall<3> (0.0, 0.0, 0.0) );
+    t0[0][0] = 1;
+    t0[0][1] = 0;
+    t0[0][2] = 0;
+    t0[1][0] = 0;
+    t0[1][1] = 1;
+    t0[1][2] = 0;
+
+    std::vector< VectorSmall<3> > t1 (2, VectorSmall<3> (0.0, 0.0, 0.0) );
+    t1[0][0] = 0;
+    t1[0][1] = 0;
+    t1[0][2] = 1;
+    t1[1][0] = 1;
+    t1[1][1] = 0;
+    t1[1][2] = 0;
+
+    std::vector< VectorSmall<3> > t2 (2, VectorSmall<3> (0.0, 0.0, 0.0) );
+    t2[0][0] = -1;
+    t2[0][1] = 0;
+    t2[0][2] = 1;
+    t2[1][0] = -1;
+    t2[1][1] = 1;
+    t2[1][2] = 0;
+
+    std::vector< VectorSmall<3> > t3 (2, VectorSmall<3> (0.0, 0.0, 0.0) );
+    t3[0][0] = 0;
+    t3[0][1] = 1;
+    t3[0][2] = 0;
+    t3[1][0] = 0;
+    t3[1][1] = 0;
+    t3[1][2] = 1;
+
+    M_globalCFE[0]->setRefTangents (t0);
+    M_globalCFE[1]->setRefTangents (t1);
+    M_globalCFE[2]->setRefTangents (t2);
+    M_globalCFE[3]->setRefTangents (t3);
+
+    M_evaluation.setQuadrature (M_quadratureBoundary.qr (0) );
+    M_evaluation.setGlobalCFE (M_globalCFE[0]);
+}
+
+
+template < typename MeshType, typename ExpressionType>
+void
+IntegrateValueFaceID < MeshType, ExpressionType>::
+integrate (std::vector<value_Type>& integrals)
+{
+    const UInt nbIds (M_boundaryIds.size() );
+
+    // Value-initialization gives a zero value for Real and VectorSmall
+    const value_Type zero = value_Type();
+    const UInt valueSize (integralValueSize (zero) );
+
+    integrals.assign (nbIds, zero);
+
+    // OpenMP setup and pragmas around the loop
+    M_ompParams.apply();
+
+    for (UInt iId (0); iId < nbIds; ++iId)
+    {
+        // Boundary faces with the identifier
+        const std::vector<UInt>& boundaryFaces (M_mesh->boundaryFacetsWithMarker (M_boundaryIds[iId]) );
+        UInt nbBoundaryFaces (boundaryFaces.size() );
+
+        value_Type& integral (integrals[iId]);
+
+        #pragma omp parallel
+        {
+            // Thread-local copies of the structures modified in the loop
+            std::vector<boost::shared_ptr<ETCurrentBDFE<3> > > globalCFE (4);
+            for (UInt i (0); i < 4; ++i)
+            {
+                globalCFE[i].reset (new ETCurrentBDFE<3> (*M_globalCFE[i]) );
+            }
+
+            evaluation_Type evaluation (M_evaluation);
+
+            value_Type partialIntegral (zero);
+
+            #pragma omp for schedule(runtime)
+            for (UInt iBoundaryFace = 0; iBoundaryFace < nbBoundaryFaces; ++iBoundaryFace)
+            {
+                const UInt iFace (boundaryFaces[iBoundaryFace]);
+
+                // Only the faces owned by the process are integrated,
+                // the others are integrated by their owner
+                if ( M_mesh->face (iFace).isOwned() == false )
+                {
+                    continue;
+                }
+
+                // Get the number of the face in the adjacent element
+                UInt faceIDinAdjacentElement (M_mesh->face (iFace).firstAdjacentElementPosition() );
+
+                // Get the ID of the adjacent element
+                UInt adjacentElementID (M_mesh->face (iFace).firstAdjacentElementIdentity() );
+
+                // Update the currentFE
+                globalCFE[faceIDinAdjacentElement]
+                ->update (M_mesh->element (adjacentElementID) );
+
+                // Update the evaluation
+                evaluation.setQuadrature (M_quadratureBoundary.qr (faceIDinAdjacentElement) );
+                evaluation.setGlobalCFE (globalCFE[faceIDinAdjacentElement].get() );
+
+                evaluation.update (adjacentElementID);
+
+                // Sum over the quadrature nodes
+                for (UInt iQuadPt (0); iQuadPt < M_quadratureBoundary.qr (faceIDinAdjacentElement).nbQuadPt(); ++iQuadPt)
+                {
+                    partialIntegral += evaluation.value_q (iQuadPt)
+                                       * globalCFE[faceIDinAdjacentElement]->M_wMeas[iQuadPt];
+                }
+            }
+
+            #pragma omp critical
+            integral += partialIntegral;
+        }
+    }
+
+    M_ompParams.restorePreviousNumThreads();
+
+    // Sum of the contributions of the processes, for all the identifiers at once
+    std::vector<Real> localValues (nbIds * valueSize);
+    std::vector<Real> globalValues (nbIds * valueSize);
+    for (UInt iId (0); iId < nbIds; ++iId)
+    {
+        const Real* data (integralValueData (integrals[iId]) );
+        std::copy (data, data + valueSize, localValues.begin() + iId * valueSize);
+    }
+
+    if ( !localValues.empty() )
+    {
+        M_mesh->comm()->SumAll (&localValues[0], &globalValues[0], localValues.size() );
+    }
+
+    for (UInt iId (0); iId < nbIds; ++iId)
+    {
+        std::copy (globalValues.begin() + iId * valueSize,
+                   globalValues.begin() + (iId + 1) * valueSize,
+                   integralValueData (integrals[iId]) );
+    }
+}
+
+
+} // Namespace ExpressionAssembly
+
+} // Namespace LifeV
+
+#endif
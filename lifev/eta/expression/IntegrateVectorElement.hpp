@@ -39,6 +39,7 @@
 #include <lifev/core/LifeV.hpp>
 
 #include <lifev/core/fem/QuadratureRule.hpp>
+#include <lifev/core/util/OpenMPParameters.hpp>
 #include <lifev/eta/fem/ETCurrentFE.hpp>
 #include <lifev/eta/fem/MeshGeometricMap.hpp>
 #include <lifev/eta/fem/QRAdapterBase.hpp>
@@ -47,6 +48,7 @@
 #include <lifev/eta/expression/EvaluationPhiI.hpp>
 
 #include <lifev/eta/array/ETVectorElemental.hpp>
+#include <lifev/eta/array/ETVectorElementalBuffer.hpp>
 
 #include <boost/shared_ptr.hpp>
 
@@ -94,6 +96,14 @@ public:
                             const ExpressionType& expression,
                             const UInt offset = 0);
 
+    //! Full data constructor for the multi-threaded assembly
+    IntegrateVectorElement (const boost::shared_ptr<MeshType>& mesh,
+                            const QRAdapterType& qrAdapter,
+                            const boost::shared_ptr<TestSpaceType>& testSpace,
+                            const ExpressionType& expression,
+                            const OpenMPParameters& ompParams,
+                            const UInt offset = 0);
+
     //! Copy constructor
     IntegrateVectorElement ( const IntegrateVectorElement < MeshType, TestSpaceType, ExpressionType, QRAdapterType>& integrator);
 
@@ -136,6 +146,9 @@ public:
       performed: update the values, update the local vector,
       sum over the quadrature nodes, assemble in the global
       vector.
+      The elements are shared among the threads given in the
+      OpenMPParameters; each thread buffers its elemental vectors
+      and sums them into the global vector in a critical section.
      */
     template <typename VectorType>
     void addTo (VectorType& vec);
@@ -174,6 +187,9 @@ private:
 
     // Offset
     UInt M_offset;
+
+    // Data for multi-threaded assembly
+    OpenMPParameters M_ompParams;
 };
 
 
@@ -202,7 +218,61 @@ IntegrateVectorElement (const boost::shared_ptr<MeshType>& mesh,
 
         M_elementalVector (TestSpaceType::field_dim * testSpace->refFE().nbDof() ),
 
-        M_offset (offset)
+        M_offset (offset),
+        M_ompParams()
+{
+    switch (MeshType::geoShape_Type::BasRefSha::S_shape)
+    {
+        case LINE:
+            M_globalCFE_std = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feSegP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            M_globalCFE_adapted = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feSegP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            break;
+        case TRIANGLE:
+            M_globalCFE_std = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTriaP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            M_globalCFE_adapted = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTriaP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            break;
+        case QUAD:
+            M_globalCFE_std = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feQuadQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            M_globalCFE_adapted = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feQuadQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            break;
+        case TETRA:
+            M_globalCFE_std = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTetraP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            M_globalCFE_adapted = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTetraP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            break;
+        case HEXA:
+            M_globalCFE_std = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feHexaQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            M_globalCFE_adapted = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feHexaQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            break;
+        default:
+            ERROR_MSG ("Unrecognized element shape");
+    }
+    M_evaluation.setQuadrature ( qrAdapter.standardQR() );
+
+    M_evaluation.setGlobalCFE (M_globalCFE_std);
+    M_evaluation.setTestCFE (M_testCFE_std);
+}
+
+
+template < typename MeshType, typename TestSpaceType, typename ExpressionType, typename QRAdapterType>
+IntegrateVectorElement < MeshType, TestSpaceType, ExpressionType, QRAdapterType>::
+IntegrateVectorElement (const boost::shared_ptr<MeshType>& mesh,
+                        const QRAdapterType& qrAdapter,
+                        const boost::shared_ptr<TestSpaceType>& testSpace,
+                        const ExpressionType& expression,
+                        const OpenMPParameters& ompParams,
+                        const UInt offset)
+    :   M_mesh (mesh),
+        M_qrAdapter (qrAdapter),
+        M_testSpace (testSpace),
+        M_evaluation (expression),
+
+        M_testCFE_std (new ETCurrentFE<TestSpaceType::space_dim, TestSpaceType::field_dim> (testSpace->refFE(), testSpace->geoMap(), qrAdapter.standardQR() ) ),
+        M_testCFE_adapted (new ETCurrentFE<TestSpaceType::space_dim, TestSpaceType::field_dim> (testSpace->refFE(), testSpace->geoMap(), qrAdapter.standardQR() ) ),
+
+        M_elementalVector (TestSpaceType::field_dim * testSpace->refFE().nbDof() ),
+
+        M_offset (offset),
+        M_ompParams (ompParams)
 {
     switch (MeshType::geoShape_Type::BasRefSha::S_shape)
     {
@@ -248,7 +318,8 @@ IntegrateVectorElement ( const IntegrateVectorElement < MeshType, TestSpaceType,
         M_testCFE_adapted (new ETCurrentFE<TestSpaceType::space_dim, TestSpaceType::field_dim> (M_testSpace->refFE(), M_testSpace->geoMap(), integrator.M_qrAdapter.standardQR() ) ),
 
         M_elementalVector (integrator.M_elementalVector),
-        M_offset (integrator.M_offset)
+        M_offset (integrator.M_offset),
+        M_ompParams (integrator.M_ompParams)
 {
     switch (MeshType::geoShape_Type::BasRefSha::S_shape)
     {
@@ -318,112 +389,149 @@ addTo (VectorType& vec)
     UInt nbQuadPt_std (M_qrAdapter.standardQR().nbQuadPt() );
     UInt nbTestDof (M_testSpace->refFE().nbDof() );
 
-    // Defaulted to true for security
-    bool isPreviousAdapted (true);
+    // OpenMP setup and pragmas around the loop
+    M_ompParams.apply();
 
-    for (UInt iElement (0); iElement < nbElements; ++iElement)
+    #pragma omp parallel
     {
-        // Zeros out the elemental vector
-        M_elementalVector.zero();
+        // Thread-local copies of the structures modified in the loop
+        QRAdapterType qrAdapter (M_qrAdapter);
 
-        // Update the quadrature rule adapter
-        M_qrAdapter.update (iElement);
+        ETCurrentFE<MeshType::S_geoDimensions, 1> globalCFE_std (*M_globalCFE_std);
+        ETCurrentFE<MeshType::S_geoDimensions, 1> globalCFE_adapted (*M_globalCFE_adapted);
 
+        ETCurrentFE<TestSpaceType::space_dim, TestSpaceType::field_dim>
+        testCFE_std (M_testSpace->refFE(), M_testSpace->geoMap(), M_qrAdapter.standardQR() );
 
-        if (M_qrAdapter.isAdaptedElement() )
-        {
-            // Reset the quadrature in the different structures
-            M_evaluation.setQuadrature ( M_qrAdapter.adaptedQR() );
-            M_globalCFE_adapted -> setQuadratureRule ( M_qrAdapter.adaptedQR() );
-            M_testCFE_adapted -> setQuadratureRule ( M_qrAdapter.adaptedQR() );
+        ETCurrentFE<TestSpaceType::space_dim, TestSpaceType::field_dim>
+        testCFE_adapted (M_testSpace->refFE(), M_testSpace->geoMap(), M_qrAdapter.standardQR() );
+
+        evaluation_Type evaluation (M_evaluation);
+
+        ETVectorElemental elementalVector (M_elementalVector);
 
-            // Reset the CurrentFEs in the evaluation
-            M_evaluation.setGlobalCFE ( M_globalCFE_adapted );
-            M_evaluation.setTestCFE ( M_testCFE_adapted );
+        // Elemental contributions waiting to be summed in the global vector
+        ETVectorElementalBuffer scatterBuffer;
 
-            // Update with the correct element
-            M_evaluation.update (iElement);
+        // Defaulted to true for security
+        bool isPreviousAdapted (true);
 
-            // Update the currentFEs
-            M_globalCFE_adapted->update (M_mesh->element (iElement), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
-            M_testCFE_adapted->update (M_mesh->element (iElement), evaluation_Type::S_testUpdateFlag);
+        #pragma omp for schedule(runtime)
+        for (UInt iElement = 0; iElement < nbElements; ++iElement)
+        {
+            // Zeros out the elemental vector
+            elementalVector.zero();
+
+            // Update the quadrature rule adapter
+            qrAdapter.update (iElement);
 
 
-            // Assembly
-            for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
+            if (qrAdapter.isAdaptedElement() )
             {
-                // Set the row global indices in the local vector
-                for (UInt i (0); i < nbTestDof; ++i)
-                {
-                    M_elementalVector.setRowIndex
-                    (i + iblock * nbTestDof,
-                     M_testSpace->dof().localToGlobalMap (iElement, i) + iblock * M_testSpace->dof().numTotalDof() );
-                }
+                // Reset the quadrature in the different structures
+                evaluation.setQuadrature ( qrAdapter.adaptedQR() );
+                globalCFE_adapted.setQuadratureRule ( qrAdapter.adaptedQR() );
+                testCFE_adapted.setQuadratureRule ( qrAdapter.adaptedQR() );
+
+                // Reset the CurrentFEs in the evaluation
+                evaluation.setGlobalCFE ( &globalCFE_adapted );
+                evaluation.setTestCFE ( &testCFE_adapted );
+
+                // Update with the correct element
+                evaluation.update (iElement);
+
+                // Update the currentFEs
+                globalCFE_adapted.update (M_mesh->element (iElement), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
+                testCFE_adapted.update (M_mesh->element (iElement), evaluation_Type::S_testUpdateFlag);
+
 
-                // Make the assembly
-                for (UInt iQuadPt (0); iQuadPt < M_qrAdapter.adaptedQR().nbQuadPt(); ++iQuadPt)
+                // Assembly
+                for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
                 {
+                    // Set the row global indices in the local vector
                     for (UInt i (0); i < nbTestDof; ++i)
                     {
-                        M_elementalVector.element (i + iblock * nbTestDof) +=
-                            M_evaluation.value_qi (iQuadPt, i + iblock * nbTestDof)
-                            * M_globalCFE_adapted->wDet (iQuadPt);
+                        elementalVector.setRowIndex
+                        (i + iblock * nbTestDof,
+                         M_testSpace->dof().localToGlobalMap (iElement, i) + iblock * M_testSpace->dof().numTotalDof() );
+                    }
+
+                    // Make the assembly
+                    for (UInt iQuadPt (0); iQuadPt < qrAdapter.adaptedQR().nbQuadPt(); ++iQuadPt)
+                    {
+                        for (UInt i (0); i < nbTestDof; ++i)
+                        {
+                            elementalVector.element (i + iblock * nbTestDof) +=
+                                evaluation.value_qi (iQuadPt, i + iblock * nbTestDof)
+                                * globalCFE_adapted.wDet (iQuadPt);
 
+                        }
                     }
                 }
-            }
 
-            // Finally, set the flag
-            isPreviousAdapted = true;
-        }
-        else
-        {
-            // Check if the last one was adapted
-            if (isPreviousAdapted)
-            {
-                M_evaluation.setQuadrature ( M_qrAdapter.standardQR() );
-                M_evaluation.setGlobalCFE ( M_globalCFE_std );
-                M_evaluation.setTestCFE ( M_testCFE_std );
-
-                isPreviousAdapted = false;
+                // Finally, set the flag
+                isPreviousAdapted = true;
             }
+            else
+            {
+                // Check if the last one was adapted
+                if (isPreviousAdapted)
+                {
+                    evaluation.setQuadrature ( qrAdapter.standardQR() );
+                    evaluation.setGlobalCFE ( &globalCFE_std );
+                    evaluation.setTestCFE ( &testCFE_std );
 
+                    isPreviousAdapted = false;
+                }
 
-            // Update the currentFEs
-            M_globalCFE_std->update (M_mesh->element (iElement), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
-            M_testCFE_std->update (M_mesh->element (iElement), evaluation_Type::S_testUpdateFlag);
 
-            // Update the evaluation
-            M_evaluation.update (iElement);
+                // Update the currentFEs
+                globalCFE_std.update (M_mesh->element (iElement), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
+                testCFE_std.update (M_mesh->element (iElement), evaluation_Type::S_testUpdateFlag);
 
-            // Loop on the blocks
-            for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
-            {
-                // Set the row global indices in the local vector
-                for (UInt i (0); i < nbTestDof; ++i)
-                {
-                    M_elementalVector.setRowIndex
-                    (i + iblock * nbTestDof,
-                     M_testSpace->dof().localToGlobalMap (iElement, i) + iblock * M_testSpace->dof().numTotalDof() + M_offset);
-                }
+                // Update the evaluation
+                evaluation.update (iElement);
 
-                // Make the assembly
-                for (UInt iQuadPt (0); iQuadPt < nbQuadPt_std; ++iQuadPt)
+                // Loop on the blocks
+                for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
                 {
+                    // Set the row global indices in the local vector
                     for (UInt i (0); i < nbTestDof; ++i)
                     {
-                        M_elementalVector.element (i + iblock * nbTestDof) +=
-                            M_evaluation.value_qi (iQuadPt, i + iblock * nbTestDof)
-                            * M_globalCFE_std->wDet (iQuadPt);
+                        elementalVector.setRowIndex
+                        (i + iblock * nbTestDof,
+                         M_testSpace->dof().localToGlobalMap (iElement, i) + iblock * M_testSpace->dof().numTotalDof() + M_offset);
+                    }
+
+                    // Make the assembly
+                    for (UInt iQuadPt (0); iQuadPt < nbQuadPt_std; ++iQuadPt)
+                    {
+                        for (UInt i (0); i < nbTestDof; ++i)
+                        {
+                            elementalVector.element (i + iblock * nbTestDof) +=
+                                evaluation.value_qi (iQuadPt, i + iblock * nbTestDof)
+                                * globalCFE_std.wDet (iQuadPt);
 
+                        }
                     }
                 }
+
             }
 
+            scatterBuffer.append (elementalVector);
+
+            if (scatterBuffer.isFull() )
+            {
+                #pragma omp critical
+                scatterBuffer.pushToGlobal (vec);
+            }
         }
 
-        M_elementalVector.pushToGlobal (vec);
+        #pragma omp critical
+        scatterBuffer.pushToGlobal (vec);
     }
+
+    M_ompParams.restorePreviousNumThreads();
 }
 
 
@@ -38,6 +38,8 @@
 
 #include <lifev/core/LifeV.hpp>
 
+#include <lifev/core/util/OpenMPParameters.hpp>
+
 #include <lifev/eta/fem/QuadratureBoundary.hpp>
 #include <lifev/eta/fem/ETCurrentFE.hpp>
 #include <lifev/eta/fem/ETCurrentBDFE.hpp>
@@ -46,6 +48,7 @@
 #include <lifev/eta/expression/ExpressionToEvaluation.hpp>
 
 #include <lifev/eta/array/ETVectorElemental.hpp>
+#include <lifev/eta/array/ETVectorElementalBuffer.hpp>
 
 #include <boost/shared_ptr.hpp>
 
@@ -93,6 +96,14 @@ public:
                            const boost::shared_ptr<TestSpaceType>& testSpace,
                            const ExpressionType& expression);
 
+    //! Full data constructor for the multi-threaded assembly
+    IntegrateVectorFaceID (const boost::shared_ptr<MeshType>& mesh,
+                           const UInt boundaryID,
+                           const QuadratureBoundary& quadratureBD,
+                           const boost::shared_ptr<TestSpaceType>& testSpace,
+                           const ExpressionType& expression,
+                           const OpenMPParameters& ompParams);
+
     //! Copy constructor
     IntegrateVectorFaceID ( const IntegrateVectorFaceID < MeshType, TestSpaceType, ExpressionType>& integrator);
 
@@ -135,6 +146,9 @@ public:
       performed: update the values, update the local vector,
       sum over the quadrature nodes, assemble in the global
       vector.
+      The loop is shared among the threads given in the
+      OpenMPParameters; each thread buffers its elemental vectors
+      and sums them into the global vector in a critical section.
      */
     template <typename VectorType>
     void addTo (VectorType& vec);
@@ -170,6 +184,9 @@ private:
     std::vector<ETCurrentFE<3, TestSpaceType::field_dim>*> M_testCFE;
 
     ETVectorElemental M_elementalVector;
+
+    // Data for multi-threaded assembly
+    OpenMPParameters M_ompParams;
 };
 
 
@@ -197,7 +214,84 @@ IntegrateVectorFaceID (const boost::shared_ptr<MeshType>& mesh,
         M_globalCFE (4),
         M_testCFE (4),
 
-        M_elementalVector (TestSpaceType::field_dim * testSpace->refFE().nbDof() )
+        M_elementalVector (TestSpaceType::field_dim * testSpace->refFE().nbDof() ),
+
+        M_ompParams()
+{
+    for (UInt i (0); i < 4; ++i)
+    {
+        M_globalCFE[i] = new ETCurrentBDFE<3> (geometricMapFromMesh<MeshType>()
+                                               , M_quadratureBoundary.qr (i) );
+        M_testCFE[i] = new ETCurrentFE<3, TestSpaceType::field_dim> (testSpace->refFE()
+                                                                     , testSpace->geoMap()
+                                                                     , M_quadratureBoundary.qr (i) );
+    }
+
+    // Set the tangent on the different faces
+    std::vector< VectorSmall<3> > t0 (2, VectorSmall<3> (0.0, 0.0, 0.0) );
+    t0[0][0] = 1;
+    t0[0][1] = 0;
+    t0[0][2] = 0;
+    t0[1][0] = 0;
+    t0[1][1] = 1;
+    t0[1][2] = 0;
+    std::vector< VectorSmall<3> > t1 (2, VectorSmall<3> (0.0, 0.0, 0.0) );
+    t1[0][0] = 0;
+    t1[0][1] = 0;
+    t1[0][2] = 1;
+    t1[1][0] = 1;
+    t1[1][1] = 0;
+    t1[1][2] = 0;
+    std::vector< VectorSmall<3> > t2 (2, VectorSmall<3> (0.0, 0.0, 0.0) );
+    //t2[0][0]=-1/std::sqrt(6);    t2[0][1]=-1/std::sqrt(6);    t2[0][2]=2/std::sqrt(6);
+    //t2[1][0]=-1/std::sqrt(2);    t2[1][1]=1/std::sqrt(2);    t2[1][2]=0;
+    t2[0][0] = -1;
+    t2[0][1] = 0;
+    t2[0][2] = 1;
+    t2[1][0] = -1;
+    t2[1][1] = 1;
+    t2[1][2] = 0;
+
+    std::vector< VectorSmall<3> > t3 (2, VectorSmall<3> (0.0, 0.0, 0.0) );
+    t3[0][0] = 0;
+    t3[0][1] = 1;
+    t3[0][2] = 0;
+    t3[1][0] = 0;
+    t3[1][1] = 0;
+    t3[1][2] = 1;
+
+    M_globalCFE[0]->setRefTangents (t0);
+    M_globalCFE[1]->setRefTangents (t1);
+    M_globalCFE[2]->setRefTangents (t2);
+    M_globalCFE[3]->setRefTangents (t3);
+
+
+    M_evaluation.setQuadrature (M_quadratureBoundary.qr (0) );
+    M_evaluation.setGlobalCFE (M_globalCFE[0]);
+    M_evaluation.setTestCFE (M_testCFE[0]);
+}
+
+
+template < typename MeshType, typename TestSpaceType, typename ExpressionType>
+IntegrateVectorFaceID < MeshType, TestSpaceType, ExpressionType>::
+IntegrateVectorFaceID (const boost::shared_ptr<MeshType>& mesh,
+                       const UInt boundaryID,
+                       const QuadratureBoundary& quadratureBD,
+                       const boost::shared_ptr<TestSpaceType>& testSpace,
+                       const ExpressionType& expression,
+                       const OpenMPParameters& ompParams)
+    :   M_mesh (mesh),
+        M_boundaryId (boundaryID),
+        M_quadratureBoundary (quadratureBD),
+        M_testSpace (testSpace),
+        M_evaluation (expression),
+
+        M_globalCFE (4),
+        M_testCFE (4),
+
+        M_elementalVector (TestSpaceType::field_dim * testSpace->refFE().nbDof() ),
+
+        M_ompParams (ompParams)
 {
     for (UInt i (0); i < 4; ++i)
     {
@@ -265,7 +359,9 @@ IntegrateVectorFaceID ( const IntegrateVectorFaceID < MeshType, TestSpaceType, E
         M_globalCFE (4),
         M_testCFE (4),
 
-        M_elementalVector (integrator.M_elementalVector)
+        M_elementalVector (integrator.M_elementalVector),
+
+        M_ompParams (integrator.M_ompParams)
 {
     for (UInt i (0); i < 4; ++i)
     {
@@ -355,71 +451,100 @@ void
 IntegrateVectorFaceID < MeshType, TestSpaceType, ExpressionType>::
 addTo (VectorType& vec)
 {
-    UInt nbBoundaryFaces (M_mesh->numBFaces() );
+    // Boundary faces with the identifier
+    const std::vector<UInt>& boundaryFaces (M_mesh->boundaryFacetsWithMarker (M_boundaryId) );
+    UInt nbBoundaryFaces (boundaryFaces.size() );
     UInt nbTestDof (M_testSpace->refFE().nbDof() );
 
-    /*CurrentBoundaryFE origFE(M_testSpace->refFE().boundaryFE(),
-                             M_testSpace->geoMap().boundaryMap(),
-                             quadRuleTria3pt);*/
+    // OpenMP setup and pragmas around the loop
+    M_ompParams.apply();
 
-    for (UInt iFace (0); iFace < nbBoundaryFaces; ++iFace)
+    #pragma omp parallel
     {
-        // Check the identifier
-        if ( M_mesh->face (iFace).markerID() != M_boundaryId )
+        // Thread-local copies of the structures modified in the loop
+        std::vector<boost::shared_ptr<ETCurrentBDFE<3> > > globalCFE (4);
+        std::vector<boost::shared_ptr<ETCurrentFE<3, TestSpaceType::field_dim> > > testCFE (4);
+
+        for (UInt i (0); i < 4; ++i)
         {
-            continue;
+            globalCFE[i].reset (new ETCurrentBDFE<3> (*M_globalCFE[i]) );
+            testCFE[i].reset (new ETCurrentFE<3, TestSpaceType::field_dim> (M_testSpace->refFE()
+                                                                            , M_testSpace->geoMap()
+                                                                            , M_quadratureBoundary.qr (i) ) );
         }
 
-        //origFE.updateMeasNormalQuadPt(M_mesh->face(iFace));
+        evaluation_Type evaluation (M_evaluation);
 
-        // Zeros out the elemental vector
-        M_elementalVector.zero();
+        ETVectorElemental elementalVector (M_elementalVector);
 
-        // Get the number of the face in the adjacent element
-        UInt faceIDinAdjacentElement (M_mesh->face (iFace).firstAdjacentElementPosition() );
+        // Elemental contributions waiting to be summed in the global vector
+        ETVectorElementalBuffer scatterBuffer;
 
-        // Get the ID of the adjacent element
-        UInt adjacentElementID (M_mesh->face (iFace).firstAdjacentElementIdentity() );
+        #pragma omp for schedule(runtime)
+        for (UInt iBoundaryFace = 0; iBoundaryFace < nbBoundaryFaces; ++iBoundaryFace)
+        {
+            const UInt iFace (boundaryFaces[iBoundaryFace]);
 
-        // Update the currentFEs
-        M_globalCFE[faceIDinAdjacentElement]
-        ->update (M_mesh->element (adjacentElementID) );
-        M_testCFE[faceIDinAdjacentElement]
-        ->update (M_mesh->element (adjacentElementID), evaluation_Type::S_testUpdateFlag);
+            // Zeros out the elemental vector
+            elementalVector.zero();
 
-        // Update the evaluation
-        M_evaluation.setQuadrature (M_quadratureBoundary.qr (faceIDinAdjacentElement) );
-        M_evaluation.setGlobalCFE (M_globalCFE[faceIDinAdjacentElement]);
-        M_evaluation.setTestCFE (M_testCFE[faceIDinAdjacentElement]);
+            // Get the number of the face in the adjacent element
+            UInt faceIDinAdjacentElement (M_mesh->face (iFace).firstAdjacentElementPosition() );
 
-        M_evaluation.update (adjacentElementID);
+            // Get the ID of the adjacent element
+            UInt adjacentElementID (M_mesh->face (iFace).firstAdjacentElementIdentity() );
 
-        // Loop on the blocks
-        for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
-        {
-            // Set the row global indices in the local vector
-            for (UInt i (0); i < nbTestDof; ++i)
-            {
-                M_elementalVector.setRowIndex
-                (i + iblock * nbTestDof,
-                 M_testSpace->dof().localToGlobalMap (adjacentElementID, i) + iblock * M_testSpace->dof().numTotalDof() );
-            }
+            // Update the currentFEs
+            globalCFE[faceIDinAdjacentElement]
+            ->update (M_mesh->element (adjacentElementID) );
+            testCFE[faceIDinAdjacentElement]
+            ->update (M_mesh->element (adjacentElementID), evaluation_Type::S_testUpdateFlag);
+
+            // Update the evaluation
+            evaluation.setQuadrature (M_quadratureBoundary.qr (faceIDinAdjacentElement) );
+            evaluation.setGlobalCFE (globalCFE[faceIDinAdjacentElement].get() );
+            evaluation.setTestCFE (testCFE[faceIDinAdjacentElement].get() );
+
+            evaluation.update (adjacentElementID);
 
-            // Make the assembly
-            for (UInt iQuadPt (0); iQuadPt < M_quadratureBoundary.qr (faceIDinAdjacentElement).nbQuadPt(); ++iQuadPt)
+            // Loop on the blocks
+            for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
             {
+                // Set the row global indices in the local vector
                 for (UInt i (0); i < nbTestDof; ++i)
                 {
-                    M_elementalVector.element (i + iblock * nbTestDof) +=
-                        M_evaluation.value_qi (iQuadPt, i + iblock * nbTestDof)
-                        * M_globalCFE[faceIDinAdjacentElement]->M_wMeas[iQuadPt];
+                    elementalVector.setRowIndex
+                    (i + iblock * nbTestDof,
+                     M_testSpace->dof().localToGlobalMap (adjacentElementID, i) + iblock * M_testSpace->dof().numTotalDof() );
+                }
+
+                // Make the assembly
+                for (UInt iQuadPt (0); iQuadPt < M_quadratureBoundary.qr (faceIDinAdjacentElement).nbQuadPt(); ++iQuadPt)
+                {
+                    for (UInt i (0); i < nbTestDof; ++i)
+                    {
+                        elementalVector.element (i + iblock * nbTestDof) +=
+                            evaluation.value_qi (iQuadPt, i + iblock * nbTestDof)
+                            * globalCFE[faceIDinAdjacentElement]->M_wMeas[iQuadPt];
 
+                    }
                 }
             }
+
+            scatterBuffer.append (elementalVector);
+
+            if (scatterBuffer.isFull() )
+            {
+                #pragma omp critical
+                scatterBuffer.pushToGlobal (vec);
+            }
         }
 
-        M_elementalVector.pushToGlobal (vec);
+        #pragma omp critical
+        scatterBuffer.pushToGlobal (vec);
     }
+
+    M_ompParams.restorePreviousNumThreads();
 }
 
 
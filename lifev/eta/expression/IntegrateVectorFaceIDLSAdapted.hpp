@@ -396,16 +396,14 @@ void
 IntegrateVectorFaceIDLSAdapted < MeshType, TestSpaceType, ExpressionType, LSFESpaceType, LSVectorType>::
 addTo (VectorType& vec)
 {
-    UInt nbBoundaryFaces (M_mesh->numBFaces() );
+    // Boundary faces with the identifier
+    const std::vector<UInt>& boundaryFaces (M_mesh->boundaryFacetsWithMarker (M_boundaryId) );
+    UInt nbBoundaryFaces (boundaryFaces.size() );
     UInt nbTestDof (M_testSpace->refFE().nbDof() );
 
-    for (UInt iFace (0); iFace < nbBoundaryFaces; ++iFace)
+    for (UInt iBoundaryFace (0); iBoundaryFace < nbBoundaryFaces; ++iBoundaryFace)
     {
-        // Check the identifier
-        if ( M_mesh->face (iFace).markerID() != M_boundaryId )
-        {
-            continue;
-        }
+        const UInt iFace (boundaryFaces[iBoundaryFace]);
 
         // Zeros out the elemental vector
         M_elementalVector.zero();
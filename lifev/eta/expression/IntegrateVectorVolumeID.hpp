@@ -38,6 +38,8 @@
 
 #include <lifev/core/LifeV.hpp>
 
+#include <lifev/core/util/OpenMPParameters.hpp>
+
 #include <lifev/core/fem/QuadratureRule.hpp>
 #include <lifev/core/mesh/RegionMesh.hpp>
 #include <lifev/eta/fem/ETCurrentFE.hpp>
@@ -47,6 +49,7 @@
 #include <lifev/eta/expression/ExpressionToEvaluation.hpp>
 
 #include <lifev/eta/array/ETVectorElemental.hpp>
+#include <lifev/eta/array/ETVectorElementalBuffer.hpp>
 
 #include <boost/shared_ptr.hpp>
 
@@ -103,6 +106,14 @@ public:
                              const boost::shared_ptr<TestSpaceType>& testSpace,
                              const ExpressionType& expression);
 
+    //! Full data constructor for the multi-threaded assembly
+    IntegrateVectorVolumeID (const vectorVolumesPtr_Type volumeList,
+                             const vectorIndexesPtr_Type indexList,
+                             const QRAdapterType& qrAdapter,
+                             const boost::shared_ptr<TestSpaceType>& testSpace,
+                             const ExpressionType& expression,
+                             const OpenMPParameters& ompParams);
+
     //! Copy constructor
     IntegrateVectorVolumeID ( const IntegrateVectorVolumeID < MeshType, TestSpaceType, ExpressionType, QRAdapterType>& integrator);
 
@@ -145,6 +156,9 @@ public:
       performed: update the values, update the local vector,
       sum over the quadrature nodes, assemble in the global
       vector.
+      The loop is shared among the threads given in the
+      OpenMPParameters; each thread buffers its elemental vectors
+      and sums them into the global vector in a critical section.
      */
     template <typename Vector>
     void addTo (Vector& vec);
@@ -181,6 +195,9 @@ private:
     ETCurrentFE<3, TestSpaceType::field_dim>* M_testCFE_adapted;
 
     ETVectorElemental M_elementalVector;
+
+    // Data for multi-threaded assembly
+    OpenMPParameters M_ompParams;
 };
 
 
@@ -211,7 +228,39 @@ IntegrateVectorVolumeID (const vectorVolumesPtr_Type volumeList,
         M_testCFE_std (new ETCurrentFE<3, TestSpaceType::field_dim> (testSpace->refFE(), testSpace->geoMap(), qrAdapter.standardQR() ) ),
         M_testCFE_adapted (new ETCurrentFE<3, TestSpaceType::field_dim> (testSpace->refFE(), testSpace->geoMap(), qrAdapter.standardQR() ) ),
 
-        M_elementalVector (TestSpaceType::field_dim * testSpace->refFE().nbDof() )
+        M_elementalVector (TestSpaceType::field_dim * testSpace->refFE().nbDof() ),
+
+        M_ompParams()
+{
+    M_evaluation.setQuadrature (qrAdapter.standardQR() );
+    M_evaluation.setGlobalCFE (M_globalCFE_std);
+    M_evaluation.setTestCFE (M_testCFE_std);
+}
+
+
+template < typename MeshType, typename TestSpaceType, typename ExpressionType, typename QRAdapterType>
+IntegrateVectorVolumeID < MeshType, TestSpaceType, ExpressionType, QRAdapterType>::
+IntegrateVectorVolumeID (const vectorVolumesPtr_Type volumeList,
+                         const vectorIndexesPtr_Type indexList,
+                         const QRAdapterType& qrAdapter,
+                         const boost::shared_ptr<TestSpaceType>& testSpace,
+                         const ExpressionType& expression,
+                         const OpenMPParameters& ompParams)
+    :   M_volumeList ( volumeList ),
+        M_indexList ( indexList ),
+        M_qrAdapter (qrAdapter),
+        M_testSpace (testSpace),
+        M_evaluation (expression),
+
+        M_globalCFE_std (new ETCurrentFE<3, 1> (feTetraP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) ),
+        M_globalCFE_adapted (new ETCurrentFE<3, 1> (feTetraP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) ),
+
+        M_testCFE_std (new ETCurrentFE<3, TestSpaceType::field_dim> (testSpace->refFE(), testSpace->geoMap(), qrAdapter.standardQR() ) ),
+        M_testCFE_adapted (new ETCurrentFE<3, TestSpaceType::field_dim> (testSpace->refFE(), testSpace->geoMap(), qrAdapter.standardQR() ) ),
+
+        M_elementalVector (TestSpaceType::field_dim * testSpace->refFE().nbDof() ),
+
+        M_ompParams (ompParams)
 {
     M_evaluation.setQuadrature (qrAdapter.standardQR() );
     M_evaluation.setGlobalCFE (M_globalCFE_std);
@@ -234,7 +283,9 @@ IntegrateVectorVolumeID ( const IntegrateVectorVolumeID <MeshType,  TestSpaceTyp
         M_testCFE_std (new ETCurrentFE<3, TestSpaceType::field_dim> (M_testSpace->refFE(), M_testSpace->geoMap(), integrator.M_qrAdapter.standardQR() ) ),
         M_testCFE_adapted (new ETCurrentFE<3, TestSpaceType::field_dim> (M_testSpace->refFE(), M_testSpace->geoMap(), integrator.M_qrAdapter.standardQR() ) ),
 
-        M_elementalVector (integrator.M_elementalVector)
+        M_elementalVector (integrator.M_elementalVector),
+
+        M_ompParams (integrator.M_ompParams)
 {
     M_evaluation.setQuadrature (integrator.M_qrAdapter.standardQR() );
     M_evaluation.setGlobalCFE (M_globalCFE_std);
@@ -275,9 +326,6 @@ void
 IntegrateVectorVolumeID <MeshType, TestSpaceType, ExpressionType, QRAdapterType>::
 addTo (Vector& vec)
 {
-    // Defaulted to true for security
-    bool isPreviousAdapted (true);
-
     //number of volumes
     UInt nbElements ( (*M_volumeList).size() );
     UInt nbIndexes ( (*M_indexList).size() );
@@ -287,109 +335,150 @@ addTo (Vector& vec)
     UInt nbQuadPt_std (M_qrAdapter.standardQR().nbQuadPt() );
     UInt nbTestDof (M_testSpace->refFE().nbDof() );
 
-    for (UInt iElement (0); iElement < nbElements; ++iElement)
+    // OpenMP setup and pragmas around the loop
+    M_ompParams.apply();
+
+    #pragma omp parallel
     {
-        // Zeros out the elemental vector
-        M_elementalVector.zero();
+        // Thread-local copies of the structures modified in the loop
+        QRAdapterType qrAdapter (M_qrAdapter);
 
-        // Update the quadrature rule adapter
-        M_qrAdapter.update ( (*M_indexList) [iElement] );
+        ETCurrentFE<3, 1> globalCFE_std (*M_globalCFE_std);
+        ETCurrentFE<3, 1> globalCFE_adapted (*M_globalCFE_adapted);
 
+        ETCurrentFE<3, TestSpaceType::field_dim>
+        testCFE_std (M_testSpace->refFE(), M_testSpace->geoMap(), M_qrAdapter.standardQR() );
 
-        if (M_qrAdapter.isAdaptedElement() )
-        {
-            // Reset the quadrature in the different structures
-            M_evaluation.setQuadrature ( M_qrAdapter.adaptedQR() );
-            M_globalCFE_adapted -> setQuadratureRule ( M_qrAdapter.adaptedQR() );
-            M_testCFE_adapted -> setQuadratureRule ( M_qrAdapter.adaptedQR() );
+        ETCurrentFE<3, TestSpaceType::field_dim>
+        testCFE_adapted (M_testSpace->refFE(), M_testSpace->geoMap(), M_qrAdapter.standardQR() );
+
+        evaluation_Type evaluation (M_evaluation);
 
-            // Reset the CurrentFEs in the evaluation
-            M_evaluation.setGlobalCFE ( M_globalCFE_adapted );
-            M_evaluation.setTestCFE ( M_testCFE_adapted );
+        ETVectorElemental elementalVector (M_elementalVector);
 
-            // Update with the correct element
-            M_evaluation.update ( (*M_indexList) [iElement] );
+        // Elemental contributions waiting to be summed in the global vector
+        ETVectorElementalBuffer scatterBuffer;
 
-            // Update the currentFEs
-            M_globalCFE_adapted->update (* ( (*M_volumeList) [iElement]), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
-            M_testCFE_adapted->update (* ( (*M_volumeList) [iElement]), evaluation_Type::S_testUpdateFlag);
+        // Defaulted to true for security
+        bool isPreviousAdapted (true);
+
+        #pragma omp for schedule(runtime)
+        for (UInt iElement = 0; iElement < nbElements; ++iElement)
+        {
+            // Zeros out the elemental vector
+            elementalVector.zero();
 
+            // Update the quadrature rule adapter
+            qrAdapter.update ( (*M_indexList) [iElement] );
 
-            // Assembly
-            for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
+
+            if (qrAdapter.isAdaptedElement() )
             {
-                // Set the row global indices in the local vector
-                for (UInt i (0); i < nbTestDof; ++i)
-                {
-                    M_elementalVector.setRowIndex
-                    (i + iblock * nbTestDof,
-                     M_testSpace->dof().localToGlobalMap ( (*M_indexList) [iElement], i) + iblock * M_testSpace->dof().numTotalDof() );
-                }
+                // Reset the quadrature in the different structures
+                evaluation.setQuadrature ( qrAdapter.adaptedQR() );
+                globalCFE_adapted.setQuadratureRule ( qrAdapter.adaptedQR() );
+                testCFE_adapted.setQuadratureRule ( qrAdapter.adaptedQR() );
+
+                // Reset the CurrentFEs in the evaluation
+                evaluation.setGlobalCFE ( &globalCFE_adapted );
+                evaluation.setTestCFE ( &testCFE_adapted );
 
-                // Make the assembly
-                for (UInt iQuadPt (0); iQuadPt < M_qrAdapter.adaptedQR().nbQuadPt(); ++iQuadPt)
+                // Update with the correct element
+                evaluation.update ( (*M_indexList) [iElement] );
+
+                // Update the currentFEs
+                globalCFE_adapted.update (* ( (*M_volumeList) [iElement]), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
+                testCFE_adapted.update (* ( (*M_volumeList) [iElement]), evaluation_Type::S_testUpdateFlag);
+
+
+                // Assembly
+                for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
                 {
+                    // Set the row global indices in the local vector
                     for (UInt i (0); i < nbTestDof; ++i)
                     {
-                        M_elementalVector.element (i + iblock * nbTestDof) +=
-                            M_evaluation.value_qi (iQuadPt, i + iblock * nbTestDof)
-                            * M_globalCFE_adapted->wDet (iQuadPt);
+                        elementalVector.setRowIndex
+                        (i + iblock * nbTestDof,
+                         M_testSpace->dof().localToGlobalMap ( (*M_indexList) [iElement], i) + iblock * M_testSpace->dof().numTotalDof() );
+                    }
 
+                    // Make the assembly
+                    for (UInt iQuadPt (0); iQuadPt < qrAdapter.adaptedQR().nbQuadPt(); ++iQuadPt)
+                    {
+                        for (UInt i (0); i < nbTestDof; ++i)
+                        {
+                            elementalVector.element (i + iblock * nbTestDof) +=
+                                evaluation.value_qi (iQuadPt, i + iblock * nbTestDof)
+                                * globalCFE_adapted.wDet (iQuadPt);
+
+                        }
                     }
                 }
-            }
 
-            // Finally, set the flag
-            isPreviousAdapted = true;
-        }
-        else
-        {
-
-            // Check if the last one was adapted
-            if (isPreviousAdapted)
+                // Finally, set the flag
+                isPreviousAdapted = true;
+            }
+            else
             {
-                M_evaluation.setQuadrature ( M_qrAdapter.standardQR() );
-                M_evaluation.setGlobalCFE ( M_globalCFE_std );
-                M_evaluation.setTestCFE ( M_testCFE_std );
 
-                isPreviousAdapted = false;
-            }
+                // Check if the last one was adapted
+                if (isPreviousAdapted)
+                {
+                    evaluation.setQuadrature ( qrAdapter.standardQR() );
+                    evaluation.setGlobalCFE ( &globalCFE_std );
+                    evaluation.setTestCFE ( &testCFE_std );
 
+                    isPreviousAdapted = false;
+                }
 
-            // Update the currentFEs
-            M_globalCFE_std->update (* ( (*M_volumeList) [iElement]), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
-            M_testCFE_std->update (* ( (*M_volumeList) [iElement]), evaluation_Type::S_testUpdateFlag);
 
-            // Update the evaluation
-            M_evaluation.update ( (*M_indexList) [iElement] );
+                // Update the currentFEs
+                globalCFE_std.update (* ( (*M_volumeList) [iElement]), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
+                testCFE_std.update (* ( (*M_volumeList) [iElement]), evaluation_Type::S_testUpdateFlag);
 
-            // Loop on the blocks
-            for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
-            {
-                // Set the row global indices in the local vector
-                for (UInt i (0); i < nbTestDof; ++i)
-                {
-                    M_elementalVector.setRowIndex
-                    (i + iblock * nbTestDof,
-                     M_testSpace->dof().localToGlobalMap ( (*M_indexList) [iElement], i) + iblock * M_testSpace->dof().numTotalDof() );
-                }
+                // Update the evaluation
+                evaluation.update ( (*M_indexList) [iElement] );
 
-                // Make the assembly
-                for (UInt iQuadPt (0); iQuadPt < nbQuadPt_std; ++iQuadPt)
+                // Loop on the blocks
+                for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
                 {
+                    // Set the row global indices in the local vector
                     for (UInt i (0); i < nbTestDof; ++i)
                     {
-                        M_elementalVector.element (i + iblock * nbTestDof) +=
-                            M_evaluation.value_qi (iQuadPt, i + iblock * nbTestDof) *
-                            M_globalCFE_std->wDet (iQuadPt);
+                        elementalVector.setRowIndex
+                        (i + iblock * nbTestDof,
+                         M_testSpace->dof().localToGlobalMap ( (*M_indexList) [iElement], i) + iblock * M_testSpace->dof().numTotalDof() );
+                    }
 
+                    // Make the assembly
+                    for (UInt iQuadPt (0); iQuadPt < nbQuadPt_std; ++iQuadPt)
+                    {
+                        for (UInt i (0); i < nbTestDof; ++i)
+                        {
+                            elementalVector.element (i + iblock * nbTestDof) +=
+                                evaluation.value_qi (iQuadPt, i + iblock * nbTestDof) *
+                                globalCFE_std.wDet (iQuadPt);
+
+                        }
                     }
                 }
+
             }
 
+            scatterBuffer.append (elementalVector);
+
+            if (scatterBuffer.isFull() )
+            {
+                #pragma omp critical
+                scatterBuffer.pushToGlobal (vec);
+            }
         }
-        M_elementalVector.pushToGlobal (vec);
+
+        #pragma omp critical
+        scatterBuffer.pushToGlobal (vec);
     }
+
+    M_ompParams.restorePreviousNumThreads();
 }
 
 
@@ -41,6 +41,8 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include <vector>
+
 
 namespace LifeV
 {
@@ -109,6 +111,67 @@ private:
 };
 
 
+//! RequestLoopFaceIDList - Request for a loop on the boundary faces with several identifiers
+/*!
+  This request is used to compute several boundary integrals in a single
+  loop on the faces (see IntegrateValueFaceID).
+ */
+template <typename MeshType>
+class RequestLoopFaceIDList
+{
+public:
+
+    //! @name Constructors & Destructor
+    //@{
+
+    //! Simple constructor with a shared_ptr on the mesh
+    RequestLoopFaceIDList (const boost::shared_ptr<MeshType>& mesh, const std::vector<UInt>& boundaryIDs)
+        : M_mesh (mesh), M_boundaryIdentifiers (boundaryIDs)
+    {}
+
+    //! Copy constructor
+    RequestLoopFaceIDList (const RequestLoopFaceIDList& loop)
+        : M_mesh (loop.M_mesh), M_boundaryIdentifiers (loop.M_boundaryIdentifiers)
+    {}
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! Getter for the mesh pointer
+    const boost::shared_ptr<MeshType>& mesh() const
+    {
+        return M_mesh;
+    }
+
+    //! Getter for the identifiers
+    const std::vector<UInt>& ids() const
+    {
+        return M_boundaryIdentifiers;
+    }
+
+    //@}
+
+private:
+
+
+    //! @name Private Methods
+    //@{
+
+    //! No empty constructor
+    RequestLoopFaceIDList();
+
+    //@}
+
+    // Pointer on the mesh
+    boost::shared_ptr<MeshType> M_mesh;
+
+    const std::vector<UInt> M_boundaryIdentifiers;
+};
+
+
 //! elements - A helper method to trigger the loop on the elements of a mesh
 /*!
     @author Samuel Quinodoz
@@ -132,6 +195,14 @@ boundary (const boost::shared_ptr<MeshType>& mesh, const UInt id)
     return RequestLoopFaceID<MeshType> (mesh, id);
 }
 
+//! boundary - A helper method to trigger the loop on the boundary faces with several identifiers
+template< typename MeshType >
+RequestLoopFaceIDList<MeshType>
+boundary (const boost::shared_ptr<MeshType>& mesh, const std::vector<UInt>& ids)
+{
+    return RequestLoopFaceIDList<MeshType> (mesh, ids);
+}
+
 
 } // Namespace ExpressionAssembly
 
@@ -139,6 +139,29 @@ integrationOverSelectedVolumes (boost::shared_ptr<std::vector<typename MeshType:
     return RequestLoopVolumeID<MeshType> ( volumeListExtracted, indexListExtracted );
 }
 
+//! integrationOverSelectedVolumes - Loop on the elements of a mesh with a given marker
+/*!
+    The elements are taken from the lists by marker cached in the mesh
+    (see RegionMesh::elementsWithMarker), so that the cost of the extraction
+    is proportional to the number of selected elements.
+ */
+template<typename MeshType>
+RequestLoopVolumeID<MeshType>
+integrationOverSelectedVolumes (const boost::shared_ptr<MeshType>& mesh, const UInt flag )
+{
+    const std::vector<UInt>& elementIndexes ( mesh->elementsWithMarker ( flag ) );
+
+    boost::shared_ptr<std::vector<typename MeshType::element_Type*> > volumeList ( new std::vector<typename MeshType::element_Type*> ( elementIndexes.size() ) );
+    boost::shared_ptr<std::vector<UInt> > indexList ( new std::vector<UInt> ( elementIndexes ) );
+
+    for ( UInt i (0); i < elementIndexes.size(); ++i )
+    {
+        (*volumeList) [i] = &mesh->element ( elementIndexes[i] );
+    }
+
+    return RequestLoopVolumeID<MeshType> ( volumeList, indexList );
+}
+
 
 } // Namespace ExpressionAssembly
 
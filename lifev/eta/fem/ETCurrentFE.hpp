@@ -247,12 +247,35 @@ public:
      */
     void setQuadratureRule (const QuadratureRule& qr);
 
+    //! Setter for the use of the affine update
+    /*!
+      When the geometric map is affine (e.g. P1 simplices), the jacobian,
+      its determinant and its inverse are computed at the first quadrature
+      node only and copied to the other ones. This setter allows to disable
+      this shortcut, e.g. for testing purposes.
+
+      @param enable True to use the affine update when the map is affine
+     */
+    void setAffineUpdate (const bool& enable)
+    {
+        M_isAffineUpdateEnabled = enable;
+    }
+
     //@}
 
 
     //! @name Get Methods
     //@{
 
+    //! Getter for the use of the affine update
+    /*!
+      @return True if the geometric quantities are computed once per element
+     */
+    bool isAffine() const
+    {
+        return M_isAffine && M_isAffineUpdateEnabled;
+    }
+
     //! Getter for the number of degrees of freedom of this element
     /*!
       @return The number of number of degrees of freedom of this element
@@ -382,6 +405,9 @@ private:
     //Private typedefs for the 2D array of vector
     typedef std::vector< std::vector< VectorSmall<spaceDim> > > array2D_vector_Type;
 
+    //Private typedefs for the 1D array of matrices
+    typedef std::vector< MatrixSmall<spaceDim, spaceDim> > array1D_matrix_Type;
+
     //! @name Private Methods
     //@{
 
@@ -394,6 +420,9 @@ private:
     //! Resize all the internal containers w.r. to the stored data and compute the constant values
     void setupInternalConstants();
 
+    //! Check if the values of a quantity are the same at all the quadrature nodes
+    bool isConstantOverQuadPts (const array2D_vector_Type& values) const;
+
     //! Update the cell nodes
     template< typename ElementType >
     void updateCellNode (const ElementType& element);
@@ -472,19 +501,19 @@ private:
     array2D_Type M_phiMap;
 
     // Storage for the derivatives of the basis functions
-    array3D_Type M_dphiReferenceFE;
+    array2D_vector_Type M_dphiReferenceFE;
 
     // Storage for the derivatives of the geometric map
-    array3D_Type M_dphiGeometricMap;
+    array2D_vector_Type M_dphiGeometricMap;
 
     // Storage for the coordinates of the nodes of the current element
-    array2D_Type M_cellNode;
+    array1D_vector_Type M_cellNode;
 
     // Storage for the position the quadrature nodes (current element)
     array1D_vector_Type M_quadNode;
 
     // Storage for the jacobian of the transformation
-    array3D_Type M_jacobian;
+    array1D_matrix_Type M_jacobian;
 
     // Storage for the determinant of the jacobian of the transformation
     array1D_Type M_detJacobian;
@@ -493,11 +522,20 @@ private:
     array1D_Type M_wDet;
 
     // Storage for the inverse of the jacobian
-    array3D_Type M_tInverseJacobian;
+    array1D_matrix_Type M_tInverseJacobian;
 
     // Storage for the derivative of the basis functions
     array2D_vector_Type M_dphi;
 
+    // True if the derivatives of the geometric map are the same at all the quadrature nodes
+    bool M_isAffine;
+
+    // True if the derivatives of the reference basis functions are the same at all the quadrature nodes
+    bool M_isDphiReferenceConstant;
+
+    // Use the affine update when the geometric map is affine
+    bool M_isAffineUpdateEnabled;
+
 #ifdef HAVE_LIFEV_DEBUG
     // Debug informations, defined only if the code
     // is compiled in debug mode. These booleans store the
@@ -567,7 +605,10 @@ ETCurrentFE (const ReferenceFE& refFE, const GeometricMap& geoMap, const Quadrat
     M_detJacobian(),
     M_wDet(),
     M_tInverseJacobian(),
-    M_dphi()
+    M_dphi(),
+    M_isAffine (false),
+    M_isDphiReferenceConstant (false),
+    M_isAffineUpdateEnabled (true)
 
 #ifdef HAVE_LIFEV_DEBUG
     , M_isCellNodeUpdated (false),
@@ -617,7 +658,10 @@ ETCurrentFE (const ReferenceFE& refFE, const GeometricMap& geoMap)
     M_detJacobian(),
     M_wDet(),
     M_tInverseJacobian(),
-    M_dphi()
+    M_dphi(),
+    M_isAffine (false),
+    M_isDphiReferenceConstant (false),
+    M_isAffineUpdateEnabled (true)
 
 #ifdef HAVE_LIFEV_DEBUG
     , M_isCellNodeUpdated (false),
@@ -664,7 +708,10 @@ ETCurrentFE (const ETCurrentFE<spaceDim, 1>& otherFE)
     M_detJacobian (otherFE.M_detJacobian),
     M_wDet (otherFE.M_wDet),
     M_tInverseJacobian (otherFE.M_tInverseJacobian),
-    M_dphi (otherFE.M_dphi)
+    M_dphi (otherFE.M_dphi),
+    M_isAffine (otherFE.M_isAffine),
+    M_isDphiReferenceConstant (otherFE.M_isDphiReferenceConstant),
+    M_isAffineUpdateEnabled (otherFE.M_isAffineUpdateEnabled)
 
 #ifdef HAVE_LIFEV_DEBUG
     //Beware for the comma at the begining of this line!
@@ -732,6 +779,11 @@ update (const elementType& element, const flag_Type& flag)
         updateDiameter();
     }
 
+    // With an affine map, the values at the first quadrature node are
+    // copied to the other ones instead of being computed again
+    const bool copyGeometry ( isAffine() );
+    const bool copyDphi ( copyGeometry && M_isDphiReferenceConstant );
+
     // Loop over the quadrature nodes
     for (UInt i (0); i < M_nbQuadPt; ++i)
     {
@@ -740,17 +792,35 @@ update (const elementType& element, const flag_Type& flag)
         {
             updateQuadNode (i);
         }
-        if ( flag & ET_UPDATE_ONLY_JACOBIAN )
-        {
-            updateJacobian (i);
-        }
-        if ( flag & ET_UPDATE_ONLY_DET_JACOBIAN )
+        if ( copyGeometry && i > 0 )
         {
-            updateDetJacobian (i);
+            if ( flag & ET_UPDATE_ONLY_JACOBIAN )
+            {
+                M_jacobian[i] = M_jacobian[0];
+            }
+            if ( flag & ET_UPDATE_ONLY_DET_JACOBIAN )
+            {
+                M_detJacobian[i] = M_detJacobian[0];
+            }
+            if ( flag & ET_UPDATE_ONLY_T_INVERSE_JACOBIAN )
+            {
+                M_tInverseJacobian[i] = M_tInverseJacobian[0];
+            }
         }
-        if ( flag & ET_UPDATE_ONLY_T_INVERSE_JACOBIAN )
+        else
         {
-            updateInverseJacobian (i);
+            if ( flag & ET_UPDATE_ONLY_JACOBIAN )
+            {
+                updateJacobian (i);
+            }
+            if ( flag & ET_UPDATE_ONLY_DET_JACOBIAN )
+            {
+                updateDetJacobian (i);
+            }
+            if ( flag & ET_UPDATE_ONLY_T_INVERSE_JACOBIAN )
+            {
+                updateInverseJacobian (i);
+            }
         }
         if ( flag & ET_UPDATE_ONLY_W_DET_JACOBIAN )
         {
@@ -758,7 +828,14 @@ update (const elementType& element, const flag_Type& flag)
         }
         if ( flag & ET_UPDATE_ONLY_DPHI )
         {
-            updateDphi (i);
+            if ( copyDphi && i > 0 )
+            {
+                M_dphi[i] = M_dphi[0];
+            }
+            else
+            {
+                updateDphi (i);
+            }
         }
     }
 
@@ -905,7 +982,6 @@ setupInternalConstants()
         M_dphiReferenceFE[q].resize (M_nbFEDof);
         for (UInt i (0); i < M_nbFEDof; ++i)
         {
-            M_dphiReferenceFE[q][i].resize (spaceDim);
             for (UInt j (0); j < spaceDim; ++j)
             {
                 M_dphiReferenceFE[q][i][j] = M_referenceFE->dPhi (i, j, M_quadratureRule->quadPointCoor (q) );
@@ -920,7 +996,6 @@ setupInternalConstants()
         M_dphiGeometricMap[q].resize (M_nbMapDof);
         for (UInt i (0); i < M_nbMapDof; ++i)
         {
-            M_dphiGeometricMap[q][i].resize (spaceDim);
             for (UInt j (0); j < spaceDim; ++j)
             {
                 M_dphiGeometricMap[q][i][j] = M_geometricMap->dPhi (i, j, M_quadratureRule->quadPointCoor (q) );
@@ -934,10 +1009,6 @@ setupInternalConstants()
 
     // Cell nodes
     M_cellNode.resize (M_nbMapDof);
-    for (UInt i (0); i < M_nbMapDof; ++i)
-    {
-        M_cellNode[i].resize (spaceDim);
-    }
 
     // Quad nodes
     M_quadNode.resize (M_nbQuadPt);
@@ -948,14 +1019,6 @@ setupInternalConstants()
 
     // Jacobian
     M_jacobian.resize (M_nbQuadPt);
-    for (UInt i (0); i < M_nbQuadPt; ++i)
-    {
-        M_jacobian[i].resize (spaceDim);
-        for (UInt j (0); j < spaceDim; ++j)
-        {
-            M_jacobian[i][j].resize (spaceDim);
-        }
-    }
 
     // Det jacobian
     M_detJacobian.resize (M_nbQuadPt);
@@ -965,14 +1028,6 @@ setupInternalConstants()
 
     // tInverseJacobian
     M_tInverseJacobian.resize (M_nbQuadPt);
-    for (UInt i (0); i < M_nbQuadPt; ++i)
-    {
-        M_tInverseJacobian[i].resize (spaceDim);
-        for (UInt j (0); j < spaceDim; ++j)
-        {
-            M_tInverseJacobian[i][j].resize (spaceDim);
-        }
-    }
 
     // dphi
     M_dphi.resize (M_nbQuadPt);
@@ -981,6 +1036,32 @@ setupInternalConstants()
         M_dphi[i].resize (M_nbFEDof);
     }
 
+    // With an affine geometric map, the jacobian is constant on the element
+    M_isAffine = isConstantOverQuadPts (M_dphiGeometricMap);
+    M_isDphiReferenceConstant = isConstantOverQuadPts (M_dphiReferenceFE);
+}
+
+template< UInt spaceDim >
+bool
+ETCurrentFE<spaceDim, 1>::
+isConstantOverQuadPts (const array2D_vector_Type& values) const
+{
+    // The derivatives of an affine map are constant functions, so
+    // that their values at the quadrature nodes are exactly the same
+    for (UInt q (1); q < values.size(); ++q)
+    {
+        for (UInt i (0); i < values[q].size(); ++i)
+        {
+            for (UInt j (0); j < spaceDim; ++j)
+            {
+                if (values[q][i][j] != values[0][i][j])
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
 }
 
 
@@ -137,11 +137,34 @@ public:
      */
     void setQuadratureRule (const QuadratureRule& qr);
 
+    //! Setter for the use of the affine update
+    /*!
+      When the geometric map is affine (e.g. P1 simplices), the jacobian,
+      its determinant and its inverse are computed at the first quadrature
+      node only and copied to the other ones. This setter allows to disable
+      this shortcut, e.g. for testing purposes.
+
+      @param enable True to use the affine update when the map is affine
+     */
+    void setAffineUpdate (const bool& enable)
+    {
+        M_isAffineUpdateEnabled = enable;
+    }
+
     //@}
 
     //! @name Get Methods
     //@{
 
+    //! Getter for the use of the affine update
+    /*!
+      @return True if the geometric quantities are computed once per element
+     */
+    bool isAffine() const
+    {
+        return M_isAffine && M_isAffineUpdateEnabled;
+    }
+
     //! Getter for the number of degrees of freedom of this element
     /*!
       @return The number of number of degrees of freedom of this element
@@ -264,6 +287,15 @@ private:
     //Private typedefs for the 3D array (array of 2D array)
     typedef std::vector< array2D_Type > array3D_Type;
 
+    //Private typedefs for the 1D array of points
+    typedef std::vector< VectorSmall<spaceDim> > array1D_point_Type;
+
+    //Private typedefs for the 2D array of gradients
+    typedef std::vector< std::vector< VectorSmall<spaceDim> > > array2D_gradient_Type;
+
+    //Private typedefs for the 1D array of matrices
+    typedef std::vector< MatrixSmall<spaceDim, spaceDim> > array1D_matrix_Type;
+
     //! @name Private Methods
     //@{
 
@@ -276,6 +308,9 @@ private:
     //! Resize all the internal containers w.r. to the stored data and compute the constant values
     void setupInternalConstants();
 
+    //! Check if the values of a quantity are the same at all the quadrature nodes
+    bool isConstantOverQuadPts (const array2D_gradient_Type& values) const;
+
     //! Update the cell nodes
     template< typename ElementType >
     void updateCellNode (const ElementType& element);
@@ -328,22 +363,22 @@ private:
     // Storage for the values of the geometric map
     array2D_Type M_phiMap;
     // Storage for the derivatives of the basis functions
-    array3D_Type M_dphiReferenceFE;
+    array2D_gradient_Type M_dphiReferenceFE;
     // Storage for the derivatives of the geometric map
-    array3D_Type M_dphiGeometricMap;
+    array2D_gradient_Type M_dphiGeometricMap;
 
     // Storage for the coordinates of the nodes of the current element
-    array2D_Type M_cellNode;
+    array1D_point_Type M_cellNode;
     // Storage for the position the quadrature nodes (current element)
     array2D_Type M_quadNode;
     // Storage for the jacobian of the transformation
-    array3D_Type M_jacobian;
+    array1D_matrix_Type M_jacobian;
     // Storage for the determinant of the jacobian of the transformation
     array1D_Type M_detJacobian;
     // Storage for the weighted determinant
     array1D_Type M_wDet;
     // Storage for the inverse of the jacobian
-    array3D_Type M_tInverseJacobian;
+    array1D_matrix_Type M_tInverseJacobian;
 
     // Storage for the derivative of the basis functions
     array2D_matrix_Type M_dphi;
@@ -351,6 +386,15 @@ private:
     // Storage for the divergence of the basis functions
     array2D_Type M_divergence;
 
+    // True if the derivatives of the geometric map are the same at all the quadrature nodes
+    bool M_isAffine;
+
+    // True if the derivatives of the reference basis functions are the same at all the quadrature nodes
+    bool M_isDphiReferenceConstant;
+
+    // Use the affine update when the geometric map is affine
+    bool M_isAffineUpdateEnabled;
+
 #ifdef HAVE_LIFEV_DEBUG
     // Debug informations, defined only if the code
     // is compiled in debug mode. These booleans store the
@@ -410,7 +454,10 @@ ETCurrentFE (const ReferenceFE& refFE, const GeometricMap& geoMap, const Quadrat
     M_wDet(),
     M_tInverseJacobian(),
     M_dphi(),
-    M_divergence()
+    M_divergence(),
+    M_isAffine (false),
+    M_isDphiReferenceConstant (false),
+    M_isAffineUpdateEnabled (true)
 
 #ifdef HAVE_LIFEV_DEBUG
     , M_isCellNodeUpdated (false),
@@ -456,7 +503,10 @@ ETCurrentFE (const ReferenceFE& refFE, const GeometricMap& geoMap)
     M_wDet(),
     M_tInverseJacobian(),
     M_dphi(),
-    M_divergence()
+    M_divergence(),
+    M_isAffine (false),
+    M_isDphiReferenceConstant (false),
+    M_isAffineUpdateEnabled (true)
 
 #ifdef HAVE_LIFEV_DEBUG
     , M_isCellNodeUpdated (false),
@@ -501,7 +551,10 @@ ETCurrentFE (const ETCurrentFE<spaceDim, fieldDim>& otherFE)
     M_wDet (otherFE.M_wDet),
     M_tInverseJacobian (otherFE.M_tInverseJacobian),
     M_dphi (otherFE.M_dphi),
-    M_divergence (otherFE.M_divergence)
+    M_divergence (otherFE.M_divergence),
+    M_isAffine (otherFE.M_isAffine),
+    M_isDphiReferenceConstant (otherFE.M_isDphiReferenceConstant),
+    M_isAffineUpdateEnabled (otherFE.M_isAffineUpdateEnabled)
 
 #ifdef HAVE_LIFEV_DEBUG
     //Beware for the comma at the begining of this line!
@@ -555,6 +608,11 @@ update (const elementType& element, const flag_Type& flag)
         updateCellNode (element);
     }
 
+    // With an affine map, the values at the first quadrature node are
+    // copied to the other ones instead of being computed again
+    const bool copyGeometry ( isAffine() );
+    const bool copyDphi ( copyGeometry && M_isDphiReferenceConstant );
+
     // Loop over the quadrature nodes
     for (UInt i (0); i < M_nbQuadPt; ++i)
     {
@@ -563,29 +621,61 @@ update (const elementType& element, const flag_Type& flag)
         {
             updateQuadNode (i);
         }
-        if ( flag & ET_UPDATE_ONLY_JACOBIAN )
+        if ( copyGeometry && i > 0 )
         {
-            updateJacobian (i);
-        }
-        if ( flag & ET_UPDATE_ONLY_DET_JACOBIAN )
-        {
-            updateDetJacobian (i);
+            if ( flag & ET_UPDATE_ONLY_JACOBIAN )
+            {
+                M_jacobian[i] = M_jacobian[0];
+            }
+            if ( flag & ET_UPDATE_ONLY_DET_JACOBIAN )
+            {
+                M_detJacobian[i] = M_detJacobian[0];
+            }
+            if ( flag & ET_UPDATE_ONLY_T_INVERSE_JACOBIAN )
+            {
+                M_tInverseJacobian[i] = M_tInverseJacobian[0];
+            }
         }
-        if ( flag & ET_UPDATE_ONLY_T_INVERSE_JACOBIAN )
+        else
         {
-            updateInverseJacobian (i);
+            if ( flag & ET_UPDATE_ONLY_JACOBIAN )
+            {
+                updateJacobian (i);
+            }
+            if ( flag & ET_UPDATE_ONLY_DET_JACOBIAN )
+            {
+                updateDetJacobian (i);
+            }
+            if ( flag & ET_UPDATE_ONLY_T_INVERSE_JACOBIAN )
+            {
+                updateInverseJacobian (i);
+            }
         }
         if ( flag & ET_UPDATE_ONLY_W_DET_JACOBIAN )
         {
             updateWDet (i);
         }
-        if ( flag & ET_UPDATE_ONLY_DPHI )
+        if ( copyDphi && i > 0 )
         {
-            updateDphi (i);
+            if ( flag & ET_UPDATE_ONLY_DPHI )
+            {
+                M_dphi[i] = M_dphi[0];
+            }
+            if ( flag & ET_UPDATE_ONLY_DIVERGENCE )
+            {
+                M_divergence[i] = M_divergence[0];
+            }
         }
-        if ( flag & ET_UPDATE_ONLY_DIVERGENCE )
+        else
         {
-            updateDivergence (i);
+            if ( flag & ET_UPDATE_ONLY_DPHI )
+            {
+                updateDphi (i);
+            }
+            if ( flag & ET_UPDATE_ONLY_DIVERGENCE )
+            {
+                updateDivergence (i);
+            }
         }
     }
 }
@@ -742,7 +832,6 @@ setupInternalConstants()
         M_dphiReferenceFE[q].resize (M_nbFEDof);
         for (UInt i (0); i < M_nbFEDof; ++i)
         {
-            M_dphiReferenceFE[q][i].resize (spaceDim);
             for (UInt j (0); j < spaceDim; ++j)
             {
                 M_dphiReferenceFE[q][i][j] = M_referenceFE->dPhi (i, j, M_quadratureRule->quadPointCoor (q) );
@@ -757,7 +846,6 @@ setupInternalConstants()
         M_dphiGeometricMap[q].resize (M_nbMapDof);
         for (UInt i (0); i < M_nbMapDof; ++i)
         {
-            M_dphiGeometricMap[q][i].resize (spaceDim);
             for (UInt j (0); j < spaceDim; ++j)
             {
                 M_dphiGeometricMap[q][i][j] = M_geometricMap->dPhi (i, j, M_quadratureRule->quadPointCoor (q) );
@@ -770,10 +858,6 @@ setupInternalConstants()
     // So, we just make space for it.
     // Cell nodes
     M_cellNode.resize (M_nbMapDof);
-    for (UInt i (0); i < M_nbMapDof; ++i)
-    {
-        M_cellNode[i].resize (spaceDim);
-    }
 
     // Quad nodes
     M_quadNode.resize (M_nbQuadPt);
@@ -784,14 +868,6 @@ setupInternalConstants()
 
     // Jacobian
     M_jacobian.resize (M_nbQuadPt);
-    for (UInt i (0); i < M_nbQuadPt; ++i)
-    {
-        M_jacobian[i].resize (spaceDim);
-        for (UInt j (0); j < spaceDim; ++j)
-        {
-            M_jacobian[i][j].resize (spaceDim);
-        }
-    }
 
     // Det jacobian
     M_detJacobian.resize (M_nbQuadPt);
@@ -801,14 +877,6 @@ setupInternalConstants()
 
     // tInverseJacobian
     M_tInverseJacobian.resize (M_nbQuadPt);
-    for (UInt i (0); i < M_nbQuadPt; ++i)
-    {
-        M_tInverseJacobian[i].resize (spaceDim);
-        for (UInt j (0); j < spaceDim; ++j)
-        {
-            M_tInverseJacobian[i][j].resize (spaceDim);
-        }
-    }
 
     // dphi
     M_dphi.resize (M_nbQuadPt);
@@ -825,6 +893,33 @@ setupInternalConstants()
         // we have fieldDim * DoF basis functions
         M_divergence[i].resize ( fieldDim * M_nbFEDof );
     }
+
+    // With an affine geometric map, the jacobian is constant on the element
+    M_isAffine = isConstantOverQuadPts (M_dphiGeometricMap);
+    M_isDphiReferenceConstant = isConstantOverQuadPts (M_dphiReferenceFE);
+}
+
+template <UInt spaceDim, UInt fieldDim >
+bool
+ETCurrentFE<spaceDim, fieldDim>::
+isConstantOverQuadPts (const array2D_gradient_Type& values) const
+{
+    // The derivatives of an affine map are constant functions, so
+    // that their values at the quadrature nodes are exactly the same
+    for (UInt q (1); q < values.size(); ++q)
+    {
+        for (UInt i (0); i < values[q].size(); ++i)
+        {
+            for (UInt j (0); j < spaceDim; ++j)
+            {
+                if (values[q][i][j] != values[0][i][j])
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
 }
 
 template <UInt spaceDim, UInt fieldDim >
@@ -0,0 +1,332 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Benchmark of the affine update of ETCurrentFE and of the ETA assembly
+
+    @date 10-2026
+
+    On a structured P1 tetrahedral mesh, the update of the scalar and
+    vectorial current FEs is timed with and without the affine update
+    (the jacobian computed once per element and copied to the quadrature
+    nodes) and the values are checked to be the same. Then the Laplacian
+    and a hyperelastic (Neo-Hookean like) stiffness matrix are assembled
+    with ETA, which uses the affine update.
+
+    The hyperelastic matrix is then assembled again element by element
+    instead of by batches of elements, and with the values of the nonlinear
+    terms computed for each pair of basis functions instead of once per
+    quadrature node (zero times grad(phi_j) is added to the deformation
+    gradient). All the matrices must be the same.
+
+    Usage: Affine_Update [-n numberOfSubdivisions] [-r repetitions]
+ */
+
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+
+#include <cmath>
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#pragma GCC diagnostic warning "-Wunused-variable"
+#pragma GCC diagnostic warning "-Wunused-parameter"
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/util/LifeChrono.hpp>
+#include <lifev/core/filter/GetPot.hpp>
+
+#include <lifev/core/mesh/MeshPartitioner.hpp>
+#include <lifev/core/mesh/RegionMesh3DStructured.hpp>
+#include <lifev/core/mesh/RegionMesh.hpp>
+
+#include <lifev/core/array/MatrixEpetra.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+
+#include <lifev/eta/fem/ETFESpace.hpp>
+#include <lifev/eta/fem/ETCurrentFE.hpp>
+
+#include <lifev/eta/expression/Integrate.hpp>
+
+#include <boost/shared_ptr.hpp>
+
+
+using namespace LifeV;
+
+typedef RegionMesh<LinearTetra> mesh_Type;
+typedef MatrixEpetra<Real> matrix_Type;
+typedef VectorEpetra vector_Type;
+
+typedef ETFESpace< mesh_Type, MapEpetra, 3, 1 > scalarSpace_Type;
+typedef ETFESpace< mesh_Type, MapEpetra, 3, 3 > vectorSpace_Type;
+
+namespace
+{
+
+// Largest difference between the quantities computed by two scalar current FEs
+Real difference ( const ETCurrentFE<3, 1>& first, const ETCurrentFE<3, 1>& second, const UInt& nbQuadPt )
+{
+    Real diff (0.0);
+    for ( UInt q (0); q < nbQuadPt; ++q )
+    {
+        diff = std::max ( diff, std::abs ( first.wDet (q) - second.wDet (q) ) );
+        for ( UInt i (0); i < first.nbFEDof(); ++i )
+        {
+            for ( UInt iDim (0); iDim < 3; ++iDim )
+            {
+                diff = std::max ( diff, std::abs ( first.dphi (i, iDim, q) - second.dphi (i, iDim, q) ) );
+            }
+        }
+    }
+    return diff;
+}
+
+// Largest difference between the quantities computed by two vectorial current FEs
+Real difference ( const ETCurrentFE<3, 3>& first, const ETCurrentFE<3, 3>& second, const UInt& nbQuadPt )
+{
+    Real diff (0.0);
+    for ( UInt q (0); q < nbQuadPt; ++q )
+    {
+        diff = std::max ( diff, std::abs ( first.wDet (q) - second.wDet (q) ) );
+        for ( UInt i (0); i < 3 * first.nbFEDof(); ++i )
+        {
+            for ( UInt iCoor (0); iCoor < 3; ++iCoor )
+            {
+                for ( UInt iDim (0); iDim < 3; ++iDim )
+                {
+                    diff = std::max ( diff, std::abs ( first.dphi (i, iCoor, iDim, q) - second.dphi (i, iCoor, iDim, q) ) );
+                }
+            }
+        }
+    }
+    return diff;
+}
+
+// Update the current FE on all the elements of the mesh, the given number of times
+template< typename CurrentFEType >
+Real timeUpdate ( CurrentFEType& currentFE, const mesh_Type& mesh, const flag_Type& flag, const UInt& repetitions )
+{
+    LifeChrono chrono;
+    chrono.start();
+    for ( UInt r (0); r < repetitions; ++r )
+    {
+        for ( UInt iElement (0); iElement < mesh.numElements(); ++iElement )
+        {
+            currentFE.update ( mesh.element (iElement), flag );
+        }
+    }
+    chrono.stop();
+    return chrono.diff();
+}
+
+// Assemble a matrix with the given integrator, by batches of elements or element by element
+template< typename IntegratorType >
+Real assemble ( IntegratorType integrator, const bool& batched, const boost::shared_ptr<matrix_Type>& matrix )
+{
+    LifeChrono chrono;
+    chrono.start();
+    integrator.setBatchedAssembly ( batched );
+    integrator >> matrix;
+    matrix->globalAssemble();
+    chrono.stop();
+    return chrono.diff();
+}
+
+// Compare the affine update with the general one, on all the elements of the mesh
+template< UInt FieldDim >
+bool compareUpdates ( const mesh_Type& mesh, const QuadratureRule& qr, const flag_Type& flag,
+                      const UInt& repetitions, const bool& verbose, const std::string& name )
+{
+    ETCurrentFE<3, FieldDim> affineFE ( feTetraP1, geoLinearTetra, qr );
+    ETCurrentFE<3, FieldDim> generalFE ( feTetraP1, geoLinearTetra, qr );
+    generalFE.setAffineUpdate ( false );
+
+    Real diff (0.0);
+    for ( UInt iElement (0); iElement < mesh.numElements(); ++iElement )
+    {
+        affineFE.update ( mesh.element (iElement), flag );
+        generalFE.update ( mesh.element (iElement), flag );
+        diff = std::max ( diff, difference ( affineFE, generalFE, qr.nbQuadPt() ) );
+    }
+
+    const Real generalTime ( timeUpdate ( generalFE, mesh, flag, repetitions ) );
+    const Real affineTime ( timeUpdate ( affineFE, mesh, flag, repetitions ) );
+
+    if ( verbose )
+    {
+        std::cout << " " << name << " update, general : " << generalTime << " s" << std::endl;
+        std::cout << " " << name << " update, affine  : " << affineTime << " s" << std::endl;
+        std::cout << " " << name << " update, difference : " << diff << std::endl;
+    }
+
+    return affineFE.isAffine() && !generalFE.isAffine() && diff == 0.0;
+}
+
+}
+
+int main ( int argc, char** argv )
+{
+
+#ifdef HAVE_MPI
+    MPI_Init (&argc, &argv);
+    boost::shared_ptr<Epetra_Comm> Comm (new Epetra_MpiComm (MPI_COMM_WORLD) );
+#else
+    boost::shared_ptr<Epetra_Comm> Comm (new Epetra_SerialComm);
+#endif
+
+    const bool verbose (Comm->MyPID() == 0);
+    bool success (true);
+
+    GetPot command_line ( argc, argv );
+    const UInt Nelements ( command_line.follow ( 10, "-n" ) );
+    const UInt repetitions ( command_line.follow ( 5, "-r" ) );
+
+    boost::shared_ptr< mesh_Type > fullMeshPtr (new mesh_Type);
+
+    regularMesh3D ( *fullMeshPtr, 1, Nelements, Nelements, Nelements, false,
+                    2.0,   2.0,   2.0,
+                    -1.0,  -1.0,  -1.0);
+
+    MeshPartitioner< mesh_Type > meshPart (fullMeshPtr, Comm);
+    fullMeshPtr.reset();
+
+    const mesh_Type& mesh ( *meshPart.meshPartition() );
+
+    // Update of the current FEs alone
+    success = compareUpdates<1> ( mesh, quadRuleTetra4pt, ET_UPDATE_DPHI | ET_UPDATE_WDET,
+                                  repetitions, verbose, "Scalar P1" ) && success;
+    success = compareUpdates<3> ( mesh, quadRuleTetra4pt, ET_UPDATE_DPHI | ET_UPDATE_DIVERGENCE | ET_UPDATE_WDET,
+                                  repetitions, verbose, "Vector P1" ) && success;
+
+    // Assembly with ETA
+    boost::shared_ptr<scalarSpace_Type> scalarSpace ( new scalarSpace_Type (meshPart, &feTetraP1, Comm) );
+    boost::shared_ptr<vectorSpace_Type> vectorSpace ( new vectorSpace_Type (meshPart, &feTetraP1, Comm) );
+
+    boost::shared_ptr<matrix_Type> laplacianMatrix ( new matrix_Type ( scalarSpace->map() ) );
+    boost::shared_ptr<matrix_Type> stiffnessMatrix ( new matrix_Type ( vectorSpace->map() ) );
+    boost::shared_ptr<matrix_Type> elementByElementMatrix ( new matrix_Type ( vectorSpace->map() ) );
+    boost::shared_ptr<matrix_Type> uncachedMatrix ( new matrix_Type ( vectorSpace->map() ) );
+
+    // A smooth displacement for the hyperelastic stiffness
+    vector_Type displacement ( vectorSpace->map(), Repeated );
+    for ( Int i (0); i < displacement.epetraVector().MyLength(); ++i )
+    {
+        displacement.epetraVector() [0][i] = 1.e-2 * std::sin ( static_cast<Real> ( displacement.blockMap().GID (i) ) );
+    }
+
+    MatrixSmall<3, 3> identity;
+    identity (0, 0) = 1.0;
+    identity (1, 1) = 1.0;
+    identity (2, 2) = 1.0;
+
+    Real laplacianTime (0.0);
+    Real stiffnessTime (0.0);
+    Real elementByElementTime (0.0);
+    Real uncachedTime (0.0);
+    {
+        using namespace ExpressionAssembly;
+
+        laplacianTime = assemble ( integrate ( elements (scalarSpace->mesh() ),
+                                               quadRuleTetra4pt,
+                                               scalarSpace,
+                                               scalarSpace,
+                                               dot ( grad (phi_i) , grad (phi_j) ) ),
+                                   true, laplacianMatrix );
+
+#define deformationGradientTensor ( grad ( vectorSpace, displacement ) + value ( identity ) )
+#define stiffness pow ( det ( deformationGradientTensor ), - (2.0 / 3.0) ) * dot ( grad (phi_j), grad (phi_i) ) \
+    + value (1.0 / 3.0) * dot ( minusT ( deformationGradientTensor ) * transpose ( grad (phi_j) ) * minusT ( deformationGradientTensor ), grad (phi_i) )
+
+        stiffnessTime = assemble ( integrate ( elements (vectorSpace->mesh() ),
+                                               quadRuleTetra4pt,
+                                               vectorSpace,
+                                               vectorSpace,
+                                               stiffness ),
+                                   true, stiffnessMatrix );
+
+        elementByElementTime = assemble ( integrate ( elements (vectorSpace->mesh() ),
+                                                      quadRuleTetra4pt,
+                                                      vectorSpace,
+                                                      vectorSpace,
+                                                      stiffness ),
+                                          false, elementByElementMatrix );
+
+#undef deformationGradientTensor
+
+        // Same values, but the arguments of pow, det and minusT depend on the basis functions
+#define deformationGradientTensor ( grad ( vectorSpace, displacement ) + value ( identity ) + value (0.0) * grad (phi_j) )
+
+        uncachedTime = assemble ( integrate ( elements (vectorSpace->mesh() ),
+                                              quadRuleTetra4pt,
+                                              vectorSpace,
+                                              vectorSpace,
+                                              stiffness ),
+                                  true, uncachedMatrix );
+
+#undef deformationGradientTensor
+#undef stiffness
+    }
+
+    const Real laplacianNorm ( laplacianMatrix->normInf() );
+    const Real stiffnessNorm ( stiffnessMatrix->normInf() );
+
+    *elementByElementMatrix -= *stiffnessMatrix;
+    const Real elementByElementDifference ( elementByElementMatrix->normInf() );
+
+    *uncachedMatrix -= *stiffnessMatrix;
+    const Real uncachedDifference ( uncachedMatrix->normInf() );
+
+    if (verbose)
+    {
+        std::cout << " Laplacian assembly   : " << laplacianTime << " s (norm " << laplacianNorm << ")" << std::endl;
+        std::cout << " Hyperelastic assembly: " << stiffnessTime << " s (norm " << stiffnessNorm << ")" << std::endl;
+        std::cout << " Hyperelastic assembly, element by element : " << elementByElementTime
+                  << " s (difference " << elementByElementDifference << ")" << std::endl;
+        std::cout << " Hyperelastic assembly, not cached         : " << uncachedTime
+                  << " s (difference " << uncachedDifference << ")" << std::endl;
+    }
+
+    success = elementByElementDifference <= 1.e-12 * stiffnessNorm && success;
+    success = uncachedDifference <= 1.e-12 * stiffnessNorm && success;
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    if ( !success )
+    {
+        return ( EXIT_FAILURE );
+    }
+    return ( EXIT_SUCCESS );
+
+}
@@ -481,6 +481,7 @@ int main ( int argc, char** argv )
     Real errorL2Squared ( 0.0 );
     Real errorH1Squared ( 0.0 );
     Real errorH1BoundarySquared ( 0.0 );
+    Real errorH1BoundarySquaredValue ( 0.0 );
 
     vector_Type errorH1BoundaryVector ( ETuFESpace->map(), Repeated );
     vector_Type errorH1BoundaryVectorUnique ( ETuFESpace->map() );
@@ -529,6 +530,22 @@ int main ( int argc, char** argv )
 
                 >> errorH1BoundaryVector;
 
+        // Same boundary error, integrated directly as a value
+        integrate ( boundary (ETuFESpace->mesh(), wall),
+                    myBDQR,
+
+                    dot ( ( eval ( gradExactFct, X ) - dot ( eval ( gradExactFct, X ) , Nface ) * Nface )
+                          -  ( grad ( ETuFESpace , *uSolution ) - dot ( grad ( ETuFESpace , *uSolution ) , Nface ) * Nface ) ,
+                          ( eval ( gradExactFct, X ) - dot ( eval ( gradExactFct, X ) , Nface ) * Nface )
+                          -  ( grad ( ETuFESpace , *uSolution ) - dot ( grad ( ETuFESpace , *uSolution ) , Nface ) * Nface )
+                        ) +
+                    ( eval ( uExactFct, X ) - value ( ETuFESpace , *uSolution ) )
+                    * (  eval ( uExactFct, X ) - value ( ETuFESpace , *uSolution ) )
+
+                  )
+
+                >> errorH1BoundarySquaredValue;
+
     }
 
     Comm->Barrier();
@@ -548,6 +565,8 @@ int main ( int argc, char** argv )
         std::cout << " H1 error norm " <<  sqrt ( errorH1Squared ) << std::endl;
 
         std::cout << " H1 Gamma error norm " << std::sqrt ( errorH1BoundarySquared ) << std::endl;
+
+        std::cout << " H1 Gamma error norm (value) " << std::sqrt ( errorH1BoundarySquaredValue ) << std::endl;
     }
 
     exporter.closeFile();
@@ -558,6 +577,7 @@ int main ( int argc, char** argv )
     if ( (  abs ( sqrt (errorL2Squared) - 0.0768669 ) < tolerance )
             && (  abs ( sqrt (errorH1Squared) - 1.76249  ) < tolerance )
             && ( abs ( sqrt (errorH1BoundarySquared) - 2.35064 ) < tolerance )
+            && ( abs ( sqrt (errorH1BoundarySquaredValue) - 2.35064 ) < tolerance )
        )
     {
         success = true ;
@@ -60,6 +60,9 @@ MultiscaleModelFluid3D::MultiscaleModelFluid3D() :
     M_solution                     (),
     M_linearBC                     ( new bc_Type() ),
     M_updateLinearModel            ( true ),
+    M_linearPerturbedBC            (),
+    M_linearPerturbedSolution      (),
+    M_updateLinearPerturbedSolution ( true ),
     M_uFESpace                     (),
     M_pFESpace                     (),
     M_lmDOF                        ( 0 ),
@@ -246,6 +249,7 @@ MultiscaleModelFluid3D::updateModel()
 
     //Linear system need to be updated
     M_updateLinearModel = true;
+    M_updateLinearPerturbedSolution = true;
 }
 
 void
@@ -260,6 +264,9 @@ MultiscaleModelFluid3D::solveModel()
     displayModelStatus ( "Solve" );
     M_fluid->iterate ( *M_bc->handler() );
 
+    // The solutions of the linear problems have to be recomputed
+    M_updateLinearPerturbedSolution = true;
+
     // Non linear convective term with Aitken
     if ( M_subiterationsMaximumNumber > 0 )
     {
@@ -643,6 +650,11 @@ MultiscaleModelFluid3D::setupLinearModel()
     {
         i->setBCFunction ( bcBaseDeltaZero );
     }
+
+    // The perturbed BCHandlers are built from the linear BCHandler when they are first needed
+    M_linearPerturbedBC.clear();
+    M_linearPerturbedSolution.clear();
+    M_updateLinearPerturbedSolution = true;
 }
 
 void
@@ -678,61 +690,68 @@ MultiscaleModelFluid3D::solveLinearModel ( bool& solveLinearSystem )
         return;
     }
 
-    imposePerturbation();
+    // Find the perturbed coupling
+    UInt perturbedCoupling ( 0 );
+    while ( perturbedCoupling < M_couplings.size() && !M_couplings[perturbedCoupling]->isPerturbed() )
+    {
+        ++perturbedCoupling;
+    }
 
     if ( M_updateLinearModel )
     {
         updateLinearModel();
+        M_updateLinearPerturbedSolution = true;
     }
 
-    //Solve the linear problem
-    displayModelStatus ( "Solve linear" );
-    M_fluid->solveLinearSystem ( *M_linearBC );
-
-    resetPerturbation();
-
-    //This flag avoid recomputation of the same system
-    solveLinearSystem = false;
-}
-
-void
-MultiscaleModelFluid3D::imposePerturbation()
-{
-
-#ifdef HAVE_LIFEV_DEBUG
-    debugStream ( 8120 ) << "MultiscaleModelFluid3D::imposePerturbation() \n";
-#endif
-
-    for ( multiscaleCouplingsContainerConstIterator_Type i = M_couplings.begin(); i < M_couplings.end(); ++i )
-        if ( ( *i )->isPerturbed() )
+    if ( perturbedCoupling == M_couplings.size() )
+    {
+        //Solve the linear problem without perturbations
+        displayModelStatus ( "Solve linear" );
+        M_fluid->solveLinearSystem ( *M_linearBC );
+    }
+    else
+    {
+        //Solve the linear problems of all the perturbations at once
+        if ( M_updateLinearPerturbedSolution )
         {
-            BCFunctionBase bcBaseDeltaOne;
-            bcBaseDeltaOne.setFunction ( boost::bind ( &MultiscaleModelFluid3D::bcFunctionDeltaOne, this, _1, _2, _3, _4, _5 ) );
+            if ( M_linearPerturbedBC.size() != M_couplings.size() )
+            {
+                setupPerturbations();
+            }
 
-            M_linearBC->findBCWithFlag ( boundaryFlag ( ( *i )->boundaryID ( ( *i )->modelGlobalToLocalID ( M_ID ) ) ) ).setBCFunction ( bcBaseDeltaOne );
+            displayModelStatus ( "Solve linear" );
+            M_fluid->solveLinearSystem ( M_linearPerturbedBC, M_linearPerturbedSolution );
 
-            break;
+            M_updateLinearPerturbedSolution = false;
         }
+
+        M_fluid->setLinearSolution ( *M_linearPerturbedSolution[perturbedCoupling] );
+    }
+
+    //This flag avoid recomputation of the same system
+    solveLinearSystem = false;
 }
 
 void
-MultiscaleModelFluid3D::resetPerturbation()
+MultiscaleModelFluid3D::setupPerturbations()
 {
 
 #ifdef HAVE_LIFEV_DEBUG
-    debugStream ( 8120 ) << "MultiscaleModelFluid3D::resetPerturbation() \n";
+    debugStream ( 8120 ) << "MultiscaleModelFluid3D::setupPerturbations() \n";
 #endif
 
-    for ( multiscaleCouplingsContainerConstIterator_Type i = M_couplings.begin(); i < M_couplings.end(); ++i )
-        if ( ( *i )->isPerturbed() )
-        {
-            BCFunctionBase bcBaseDeltaZero;
-            bcBaseDeltaZero.setFunction ( boost::bind ( &MultiscaleModelFluid3D::bcFunctionDeltaZero, this, _1, _2, _3, _4, _5 ) );
+    BCFunctionBase bcBaseDeltaOne;
+    bcBaseDeltaOne.setFunction ( boost::bind ( &MultiscaleModelFluid3D::bcFunctionDeltaOne, this, _1, _2, _3, _4, _5 ) );
 
-            M_linearBC->findBCWithFlag ( boundaryFlag ( ( *i )->boundaryID ( ( *i )->modelGlobalToLocalID ( M_ID ) ) ) ).setBCFunction ( bcBaseDeltaZero );
+    M_linearPerturbedBC.resize ( M_couplings.size() );
+    M_linearPerturbedSolution.resize ( M_couplings.size() );
+    for ( UInt i ( 0 ); i < M_couplings.size(); ++i )
+    {
+        M_linearPerturbedBC[i].reset ( new bc_Type ( *M_linearBC ) );
+        M_linearPerturbedBC[i]->findBCWithFlag ( boundaryFlag ( M_couplings[i]->boundaryID ( M_couplings[i]->modelGlobalToLocalID ( M_ID ) ) ) ).setBCFunction ( bcBaseDeltaOne );
 
-            break;
-        }
+        M_linearPerturbedSolution[i].reset ( new fluidVector_Type ( M_fluid->linearSolution() ) );
+    }
 }
 
 } // Namespace multiscale
@@ -423,13 +423,15 @@ private:
     void updateLinearModel();
 
     //! Solve the linear problem
+    /*!
+     * The linear problems of all the coupling perturbations share the same matrix:
+     * they are solved together the first time one of them is needed and their solutions
+     * are kept until the model changes (see \c updateModel() and \c solveModel() ).
+     */
     void solveLinearModel ( bool& solveLinearSystem );
 
-    //! Impose the coupling perturbation on the correct BC inside the BCHandler
-    void imposePerturbation();
-
-    //! Reset all the coupling perturbations imposed on the BCHandler
-    void resetPerturbation();
+    //! Setup one BCHandler for each coupling, with the perturbation imposed on the BC of the coupling
+    void setupPerturbations();
 
     Real bcFunctionDeltaZero ( const Real& /*t*/, const Real& /*x*/, const Real& /*y*/, const Real& /*z*/, const UInt& /*id*/ )
     {
@@ -460,6 +462,9 @@ private:
     // Linear Fluid problem
     bcPtr_Type                              M_linearBC;
     bool                                    M_updateLinearModel;
+    std::vector< bcPtr_Type >               M_linearPerturbedBC;
+    std::vector< fluidVectorPtr_Type >      M_linearPerturbedSolution;
+    bool                                    M_updateLinearPerturbedSolution;
 
     // FE spaces
     FESpacePtr_Type                         M_uFESpace;
@@ -87,6 +87,8 @@ public:
     typedef typename oseenSolver_Type::preconditioner_Type    preconditioner_Type;
     typedef typename oseenSolver_Type::preconditionerPtr_Type preconditionerPtr_type;
     typedef typename oseenSolver_Type::bcHandler_Type         bcHandler_Type;
+    typedef typename oseenSolver_Type::bcHandlerPtr_Type      bcHandlerPtr_Type;
+    typedef typename oseenSolver_Type::vectorPtr_Type         vectorPtr_Type;
 
     //@}
 
@@ -165,6 +167,21 @@ public:
      */
     void solveLinearSystem ( bcHandler_Type& bcHandler );
 
+    //! Solve the linear system for several boundary conditions at once
+    /*!
+        The BC handlers must differ only in the data of their boundary conditions
+        (same types, flags and modes), so that the matrix is the same for all of them:
+        it is assembled once and all the right hand sides are given together to the linear solver.
+        The essential BCs in Normal, Tangential or Directional mode cannot be applied to the right hand
+        side only: if the BC handlers after the first contain some of them, the systems are solved one
+        after the other, as with solveLinearSystem( bcHandler ).
+        The linear solution is set to the one of the first BC handler.
+        @param bcHandlers BC handlers (one for each linear system)
+        @param linearSolutions solutions of the linear systems (also used as initial guesses)
+     */
+    void solveLinearSystem ( const std::vector<bcHandlerPtr_Type>& bcHandlers,
+                             std::vector<vectorPtr_Type>&          linearSolutions );
+
     //! Update linear system.
     /*!
         @param matrixNoBC Fluid matrix withoud BC
@@ -224,6 +241,15 @@ public:
         M_linearRightHandSideNoBC = rightHandSide;
     }
 
+    //! Set the solution of the Shape Derivative problem
+    /*!
+        @param linearSolution solution of the Shape Derivative problem (e.g., computed by a multiple solve)
+     */
+    void setLinearSolution ( const vector_Type& linearSolution )
+    {
+        M_linearSolution = linearSolution;
+    }
+
     //@}
 
     //! @name Get Methods
@@ -691,6 +717,121 @@ void OseenSolverShapeDerivative<MeshType, SolverType>::solveLinearSystem ( bcHan
     //         }
 } // solveLinearSystem
 
+template<typename MeshType, typename SolverType>
+void OseenSolverShapeDerivative<MeshType, SolverType>::solveLinearSystem ( const std::vector<bcHandlerPtr_Type>& bcHandlers,
+                                                                           std::vector<vectorPtr_Type>&          linearSolutions )
+{
+    ASSERT ( !bcHandlers.empty() && bcHandlers.size() == linearSolutions.size(),
+             "OseenSolverShapeDerivative::solveLinearSystem: one solution is needed for each BC handler" );
+
+    // bcManageRhs does not handle the essential BCs in Normal, Tangential or Directional mode,
+    // which also change the matrix (the Directional ones through their data)
+    bool rightHandSideOnly ( true );
+    for ( UInt i ( 1 ); i < bcHandlers.size(); ++i )
+    {
+        for ( ID j ( 0 ); j < bcHandlers[i]->size(); ++j )
+        {
+            const BCBase& boundaryCondition ( ( *bcHandlers[i] ) [j] );
+            if ( ( boundaryCondition.type() == Essential || boundaryCondition.type() == EssentialEdges
+                    || boundaryCondition.type() == EssentialVertices )
+                    && ( boundaryCondition.mode() == Normal || boundaryCondition.mode() == Tangential
+                         || boundaryCondition.mode() == Directional ) )
+            {
+                rightHandSideOnly = false;
+            }
+        }
+    }
+
+    if ( !rightHandSideOnly )
+    {
+        for ( UInt i ( 0 ); i < bcHandlers.size(); ++i )
+        {
+            M_linearSolution = *linearSolutions[i];
+            solveLinearSystem ( *bcHandlers[i] );
+            *linearSolutions[i] = M_linearSolution;
+        }
+
+        M_linearSolution = *linearSolutions[0];
+
+        *this->M_residual  = M_linearRightHandSideNoBC;
+        *this->M_residual -= *this->M_matrixNoBC * this->M_linearSolution;
+        return;
+    }
+
+    this->M_Displayer.leaderPrint ( " LF-  Finalizing the matrix and vectors ...    " );
+
+    LifeChrono chrono;
+    chrono.start();
+
+    // matrix and vector assembling communication
+    this->M_matrixNoBC->globalAssemble();
+
+    M_linearRightHandSideNoBC.globalAssemble();
+
+    matrixPtr_Type matrixFull ( new matrix_Type ( this->M_localMap, this->M_matrixNoBC->meanNumEntries() ) );
+
+    this->updateStabilization ( *matrixFull );
+    this->getFluidMatrix ( *matrixFull );
+
+    chrono.stop();
+    this->M_Displayer.leaderPrintMax ( "done in " , chrono.diff() );
+
+    // boundary conditions update
+    this->M_Displayer.leaderPrint ( " LF-  Applying boundary conditions ...         " );
+    chrono.start();
+
+    // The first BC handler is applied to the matrix and to its right hand side,
+    // the other ones only to their right hand sides
+    std::vector<vectorPtr_Type> rightHandSidesFull ( bcHandlers.size() );
+    rightHandSidesFull[0].reset ( new vector_Type ( M_linearRightHandSideNoBC ) );
+    this->applyBoundaryConditions ( *matrixFull, *rightHandSidesFull[0], *bcHandlers[0] );
+
+    for ( UInt i ( 1 ); i < bcHandlers.size(); ++i )
+    {
+        if ( !bcHandlers[i]->bcUpdateDone() || this->M_recomputeMatrix )
+        {
+            bcHandlers[i]->bcUpdate ( *this->M_velocityFESpace.mesh(),
+                                      this->M_velocityFESpace.feBd(),
+                                      this->M_velocityFESpace.dof() );
+        }
+
+        // ignoring non-local entries, Otherwise they are summed up lately
+        rightHandSidesFull[i].reset ( new vector_Type ( M_linearRightHandSideNoBC, Unique ) );
+
+        bcManageRhs ( *rightHandSidesFull[i],
+                      *this->M_velocityFESpace.mesh(),
+                      this->M_velocityFESpace.dof(),
+                      *bcHandlers[i],
+                      this->M_velocityFESpace.feBd(),
+                      1.,
+                      this->M_oseenData->dataTime()->time() );
+
+        // the matrix is already diagonalized: this only sets the pressure row of the right hand side
+        if ( bcHandlers[i]->hasOnlyEssential() && this->M_diagonalize )
+        {
+            matrixFull->diagonalize ( this->M_velocityFESpace.fieldDim() * this->dimVelocity(),
+                                      this->M_diagonalize,
+                                      *rightHandSidesFull[i],
+                                      0. );
+        }
+    }
+
+    chrono.stop();
+    this->M_Displayer.leaderPrintMax ( "done in ", chrono.diff() );
+
+    // solving the systems with the same preconditioner (as for the non linear problem)
+    matrixFull->globalAssemble();
+    this->M_linearSolver->setMatrix ( *matrixFull );
+    this->M_linearSolver->setReusePreconditioner ( M_reuseLinearPreconditioner );
+    boost::shared_ptr<MatrixEpetra<Real> > staticCast = boost::static_pointer_cast<MatrixEpetra<Real> > (matrixFull);
+    this->M_linearSolver->solveSystem ( rightHandSidesFull, linearSolutions, staticCast );
+
+    M_linearSolution = *linearSolutions[0];
+
+    *this->M_residual  = M_linearRightHandSideNoBC;
+    *this->M_residual -= *this->M_matrixNoBC * this->M_linearSolution;
+} // solveLinearSystem
+
 template<typename MeshType, typename SolverType>
 void
 OseenSolverShapeDerivative<MeshType, SolverType>::updateLinearSystem ( const matrix_Type& /*matrixNoBC*/,
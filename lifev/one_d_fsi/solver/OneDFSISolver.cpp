@@ -67,8 +67,6 @@ OneDFSISolver::OneDFSISolver() :
     M_displayer                    (),
     M_elementalMassMatrixPtr       (),
     M_elementalStiffnessMatrixPtr  (),
-    M_elementalGradientMatrixPtr   (),
-    M_elementalDivergenceMatrixPtr (),
     M_rhs                          (),
     M_residual                     (),
     M_fluxVector                   (),
@@ -76,11 +74,14 @@ OneDFSISolver::OneDFSISolver() :
     M_dFdUVector                   (),
     M_dSdUVector                   (),
     M_homogeneousMassMatrixPtr     (),
-    M_homogeneousGradientMatrixPtr (),
-    M_dSdUMassMatrixPtr            (),
-    M_dFdUStiffnessMatrixPtr       (),
-    M_dFdUGradientMatrixPtr        (),
-    M_dSdUDivergenceMatrixPtr      (),
+    M_elementLength                (),
+    M_homogeneousMassMatrix        (),
+    M_homogeneousGradientMatrix    (),
+    M_systemMatrix                 (),
+    M_dSdUMassMatrix               (),
+    M_dFdUStiffnessMatrix          (),
+    M_dFdUGradientMatrix           (),
+    M_dSdUDivergenceMatrix         (),
     M_linearSolverPtr              (),
     M_linearViscoelasticSolverPtr  ()
 {
@@ -92,39 +93,49 @@ OneDFSISolver::OneDFSISolver() :
 void
 OneDFSISolver::buildConstantMatrices()
 {
-    std::fill ( M_dFdUVector.begin(), M_dFdUVector.end(), ublas::zero_vector<Real> ( M_physicsPtr->data()->numberOfNodes() ) );
-    std::fill ( M_dSdUVector.begin(), M_dSdUVector.end(), ublas::zero_vector<Real> ( M_physicsPtr->data()->numberOfNodes() ) );
+    const UInt numberOfNodes ( M_physicsPtr->data()->numberOfNodes() );
+    const UInt numberOfElements ( M_physicsPtr->data()->numberOfElements() );
 
+    std::fill ( M_dFdUVector.begin(), M_dFdUVector.end(), ublas::zero_vector<Real> ( numberOfNodes ) );
+    std::fill ( M_dSdUVector.begin(), M_dSdUVector.end(), ublas::zero_vector<Real> ( numberOfNodes ) );
+
+    // The tridiagonal operators are allocated here once and refilled in place at each time step
+    M_homogeneousMassMatrix.resize ( numberOfNodes );
+    M_homogeneousGradientMatrix.resize ( numberOfNodes );
+    M_systemMatrix.resize ( numberOfNodes );
     for ( UInt i (0); i < 4; ++i )
     {
-        M_dSdUMassMatrixPtr[i].reset ( new matrix_Type ( M_feSpacePtr->map() ) );
-        M_dFdUStiffnessMatrixPtr[i].reset ( new matrix_Type ( M_feSpacePtr->map() ) );
-        M_dFdUGradientMatrixPtr[i].reset ( new matrix_Type ( M_feSpacePtr->map() ) );
-        M_dSdUDivergenceMatrixPtr[i].reset ( new matrix_Type ( M_feSpacePtr->map() ) );
+        M_dSdUMassMatrix[i].resize ( numberOfNodes );
+        M_dFdUStiffnessMatrix[i].resize ( numberOfNodes );
+        M_dFdUGradientMatrix[i].resize ( numberOfNodes );
+        M_dSdUDivergenceMatrix[i].resize ( numberOfNodes );
     }
+    M_elementLength.resize ( numberOfElements );
 
     // Elementary computation and matrix assembling
-    for ( UInt iElement (0); iElement < M_physicsPtr->data()->numberOfElements(); ++iElement )
+    for ( UInt iElement (0); iElement < numberOfElements; ++iElement )
     {
-        // set the elementary matrices to 0.
+        // set the elementary matrix to 0.
         M_elementalMassMatrixPtr->zero();
-        M_elementalGradientMatrixPtr->zero();
 
         // update the current element
         M_feSpacePtr->fe().update ( M_feSpacePtr->mesh()->edgeList ( iElement ), UPDATE_DPHI | UPDATE_WDET );
 
-        // update the mass and grad matrices
+        // update and assemble the mass matrix (used for the coupling)
         AssemblyElemental::mass ( 1, *M_elementalMassMatrixPtr, M_feSpacePtr->fe(), 0, 0 );
-        AssemblyElemental::grad ( 0 , -1, *M_elementalGradientMatrixPtr, M_feSpacePtr->fe(), M_feSpacePtr->fe(), 0, 0 );
-
-        // assemble the mass and grad matrices
         assembleMatrix ( *M_homogeneousMassMatrixPtr, *M_elementalMassMatrixPtr, M_feSpacePtr->fe(), M_feSpacePtr->dof() , 0, 0, 0, 0 );
-        assembleMatrix ( *M_homogeneousGradientMatrixPtr, *M_elementalGradientMatrixPtr, M_feSpacePtr->fe(), M_feSpacePtr->dof() , 0, 0, 0, 0  );
+
+        // signed length of the element (for P1Seg elements and canonical numbering only!)
+        M_elementLength[iElement] = M_feSpacePtr->mesh()->edgeList ( iElement ).point ( 1 ).x()
+                                    - M_feSpacePtr->mesh()->edgeList ( iElement ).point ( 0 ).x();
+
+        // update the tridiagonal mass and grad matrices
+        M_homogeneousMassMatrix.addMass ( iElement, M_elementLength[iElement], 1 );
+        M_homogeneousGradientMatrix.addGradient ( iElement, M_elementLength[iElement], 1 );
     }
 
     // Dirichlet boundary conditions set in the mass matrix
     M_homogeneousMassMatrixPtr->globalAssemble();
-    M_homogeneousGradientMatrixPtr->globalAssemble();
 
     // In the classical case the linear system use a mass matrix (with Dirichlet BC)
     //matrixPtr_Type systemMatrix( new matrix_Type( M_feSpacePtr->map() ) );
@@ -132,6 +143,12 @@ OneDFSISolver::buildConstantMatrices()
     matrix_Type systemMatrix ( *M_homogeneousMassMatrixPtr );
     applyDirichletBCToMatrix ( systemMatrix );
     M_linearSolverPtr->setMatrix ( systemMatrix );
+
+    // The same system is factorized once for the Thomas algorithm
+    M_systemMatrix = M_homogeneousMassMatrix;
+    M_systemMatrix.diagonalize ( 0 );
+    M_systemMatrix.diagonalize ( numberOfNodes - 1 );
+    M_systemMatrix.factorize();
 }
 
 void
@@ -265,38 +282,36 @@ OneDFSISolver::updateRHS ( const solution_Type& solution, const Real& timeStep )
     for ( UInt i (0); i < 2; ++i )
     {
         // rhs = rhs + dt * grad * F(Un)
-        *M_residual[i] += ( *M_homogeneousGradientMatrixPtr ) * ( timeStep * *M_fluxVector[i] );
+        M_homogeneousGradientMatrix.multiplyAdd ( timeStep, *M_fluxVector[i], *M_residual[i] );
 
         // rhs = rhs - dt * mass * S(Un)
-        *M_residual[i] += ( *M_homogeneousMassMatrixPtr ) * ( - timeStep * *M_sourceVector[i] );
+        M_homogeneousMassMatrix.multiplyAdd ( -timeStep, *M_sourceVector[i], *M_residual[i] );
 
         for ( UInt j (0); j < 2; ++j )
         {
             // rhs = rhs - dt^2/2 * gradDiffFlux * S(Un)
-            M_dFdUGradientMatrixPtr[2 * i + j]->globalAssemble();
-            *M_residual[i] += *M_dFdUGradientMatrixPtr[2 * i + j] * ( -dt2over2 * *M_sourceVector[j] );
+            M_dFdUGradientMatrix[2 * i + j].multiplyAdd ( -dt2over2, *M_sourceVector[j], *M_residual[i] );
 
             // rhs = rhs + dt^2/2 * divDiffSrc * F(Un)
-            M_dSdUDivergenceMatrixPtr[2 * i + j]->globalAssemble();
-            *M_residual[i] += *M_dSdUDivergenceMatrixPtr[2 * i + j] * ( dt2over2 * *M_fluxVector[j] );
+            M_dSdUDivergenceMatrix[2 * i + j].multiplyAdd ( dt2over2, *M_fluxVector[j], *M_residual[i] );
 
             // rhs = rhs - dt^2/2 * stiffDiffFlux * F(Un)
-            M_dFdUStiffnessMatrixPtr[2 * i + j]->globalAssemble();
-            *M_residual[i] += *M_dFdUStiffnessMatrixPtr[2 * i + j] * ( -dt2over2 * *M_fluxVector[j] );
+            M_dFdUStiffnessMatrix[2 * i + j].multiplyAdd ( -dt2over2, *M_fluxVector[j], *M_residual[i] );
 
             // rhs = rhs + dt^2/2 * massDiffSrc * S(Un)
-            M_dSdUMassMatrixPtr[2 * i + j]->globalAssemble();
-            *M_residual[i] += *M_dSdUMassMatrixPtr[2 * i + j] * ( dt2over2 * *M_sourceVector[j] );
+            M_dSdUMassMatrix[2 * i + j].multiplyAdd ( dt2over2, *M_sourceVector[j], *M_residual[i] );
         }
     }
 
     // rhs = mass * Un + residual
-    *M_rhs[0]  = *M_residual[0] + ( *M_homogeneousMassMatrixPtr ) * *solution.find ("A")->second;
-    *M_rhs[1]  = *M_residual[1] + ( *M_homogeneousMassMatrixPtr ) * *solution.find ("Q")->second;
+    *M_rhs[0] = *M_residual[0];
+    *M_rhs[1] = *M_residual[1];
+    M_homogeneousMassMatrix.multiplyAdd ( 1., *solution.find ("A")->second, *M_rhs[0] );
+    M_homogeneousMassMatrix.multiplyAdd ( 1., *solution.find ("Q")->second, *M_rhs[1] );
 
     if ( M_physicsPtr->data()->viscoelasticWall() )
     {
-        *M_rhs[1]  -= ( *M_homogeneousMassMatrixPtr ) * *solution.find ("Q_visc")->second;
+        M_homogeneousMassMatrix.multiplyAdd ( -1., *solution.find ("Q_visc")->second, *M_rhs[1] );
     }
 }
 
@@ -308,11 +323,11 @@ OneDFSISolver::iterate ( OneDFSIBCHandler& bcHandler, solution_Type& solution, c
 
     // Compute A^n+1
     vector_Type area ( *M_rhs[0] );
-    M_linearSolverPtr->solveSystem ( *M_rhs[0], area, M_homogeneousMassMatrixPtr );
+    M_systemMatrix.solve ( area );
 
     // Compute Q^n+1
     vector_Type flowRate ( *M_rhs[1] );
-    M_linearSolverPtr->solveSystem ( *M_rhs[1], flowRate, M_homogeneousMassMatrixPtr );
+    M_systemMatrix.solve ( flowRate );
 
     // Correct flux with inertial, viscoelastic and longitudinal terms
     if ( M_physicsPtr->data()->inertialWall() )
@@ -510,8 +525,6 @@ OneDFSISolver::setFESpace ( const feSpacePtr_Type& feSpacePtr )
     //Elementary Matrices
     M_elementalMassMatrixPtr.reset ( new MatrixElemental ( M_feSpacePtr->fe().nbFEDof(), 1, 1 ) );
     M_elementalStiffnessMatrixPtr.reset ( new MatrixElemental ( M_feSpacePtr->fe().nbFEDof(), 1, 1 ) );
-    M_elementalGradientMatrixPtr.reset ( new MatrixElemental ( M_feSpacePtr->fe().nbFEDof(), 1, 1 ) );
-    M_elementalDivergenceMatrixPtr.reset  ( new MatrixElemental ( M_feSpacePtr->fe().nbFEDof(), 1, 1 ) );
 
     //Vectors
     for ( UInt i (0) ; i < 2 ; ++i )
@@ -524,7 +537,6 @@ OneDFSISolver::setFESpace ( const feSpacePtr_Type& feSpacePtr )
 
     //Matrix
     M_homogeneousMassMatrixPtr.reset ( new matrix_Type ( M_feSpacePtr->map() ) );
-    M_homogeneousGradientMatrixPtr.reset ( new matrix_Type ( M_feSpacePtr->map() ) );
 }
 
 void
@@ -735,102 +747,34 @@ OneDFSISolver::updatedSdU ( const solution_Type& solution )
 void
 OneDFSISolver::updateMatrices()
 {
-    // Matrices initialization
+    // Matrices initialization (the storage is reused)
     for ( UInt i (0); i < 4; ++i )
     {
-        M_dSdUMassMatrixPtr[i].reset ( new matrix_Type ( M_feSpacePtr->map() ) );
-        M_dFdUStiffnessMatrixPtr[i].reset ( new matrix_Type ( M_feSpacePtr->map() ) );
-        M_dFdUGradientMatrixPtr[i].reset ( new matrix_Type ( M_feSpacePtr->map() ) );
-        M_dSdUDivergenceMatrixPtr[i].reset ( new matrix_Type ( M_feSpacePtr->map() ) );
+        M_dSdUMassMatrix[i].zero();
+        M_dFdUStiffnessMatrix[i].zero();
+        M_dFdUGradientMatrix[i].zero();
+        M_dSdUDivergenceMatrix[i].zero();
     }
 
     // Elementary computation and matrix assembling
     for ( UInt iElement (0); iElement < M_physicsPtr->data()->numberOfElements(); ++iElement )
     {
-        // Update the current element
-        M_feSpacePtr->fe().update ( M_feSpacePtr->mesh()->edgeList ( iElement), UPDATE_DPHI | UPDATE_WDET );
-
         for ( UInt ii (0); ii < 2; ++ii )
         {
             for ( UInt jj (0); jj < 2; ++jj )
             {
-                // Update the elemental matrices
-                updateElementalMatrices ( M_dFdUVector[ 2 * ii + jj ] ( iElement ), M_dSdUVector[ 2 * ii + jj ] ( iElement ) );
+                const Real& dFdU = M_dFdUVector[ 2 * ii + jj ] ( iElement );
+                const Real& dSdU = M_dSdUVector[ 2 * ii + jj ] ( iElement );
 
-                // Assemble the global matrices
-                matrixAssemble ( ii, jj );
+                M_dSdUMassMatrix[ 2 * ii + jj ].addMass             ( iElement, M_elementLength[iElement], dSdU );
+                M_dFdUStiffnessMatrix[ 2 * ii + jj ].addStiffness   ( iElement, M_elementLength[iElement], dFdU );
+                M_dFdUGradientMatrix[ 2 * ii + jj ].addGradient     ( iElement, M_elementLength[iElement], dFdU );
+                M_dSdUDivergenceMatrix[ 2 * ii + jj ].addDivergence ( iElement, M_elementLength[iElement], dSdU );
             }
         }
     }
 }
 
-void
-OneDFSISolver::updateElementalMatrices ( const Real& dFdU, const Real& dSdU )
-{
-    // Set the elementary matrices to 0.
-    M_elementalMassMatrixPtr->zero();
-    M_elementalStiffnessMatrixPtr->zero();
-    M_elementalGradientMatrixPtr->zero();
-    M_elementalDivergenceMatrixPtr->zero();
-
-    // Update the mass matrix
-    AssemblyElemental::mass ( dSdU, *M_elementalMassMatrixPtr, M_feSpacePtr->fe(), 0, 0 );
-    //    std::cout << "Elem Stiff matrix :" << std::endl;
-    //    M_elementalMassMatrixPtr->showMe( std::cout );
-
-    // Update the stiffness matrix
-    AssemblyElemental::stiff ( dFdU, *M_elementalStiffnessMatrixPtr, M_feSpacePtr->fe(), 0 , 0 );
-    //AssemblyElemental::stiffness( *M_elementalStiffnessMatrixPtr, M_feSpacePtr->fe(), M_coeffStiff, 0 );
-    //    std::cout << "Elem Stiff matrix :" << std::endl;
-    //    M_elementalStiffnessMatrixPtr->showMe( std::cout );
-
-    /*! Update the gradient matrix
-      gradient operator:
-      grad_{ij} = \int_{fe} coeff \phi_j \frac{d \phi_i}{d x}
-
-      BEWARE :
-      \param 0: the first argument "0" corresponds to the first
-      and only coordinate (1D!), and HERE it starts from 0... (Damm'!)
-
-      \param - M_coeffGrad: the sign "-" in the second argument
-      is added to correspond to the described operator.
-      (There is a minus in the elemOper implementation).
-    */
-    AssemblyElemental::grad ( 0, -dFdU, *M_elementalGradientMatrixPtr, M_feSpacePtr->fe(), M_feSpacePtr->fe(), 0, 0 );
-    //    std::cout << "Elem Grad matrix :" << std::endl;
-    //    M_elementalGradientMatrixPtr->showMe( std::cout );
-
-    /*! update the divergence matrix
-      divergence operator: (transpose of the gradient)
-      div_{ij} = \int_{fe} coeff \frac{d \phi_j}{d x} \phi_i
-
-      \note formally this M_elementalDivergenceMatrixPtr is not necessary
-      as it is the transpose of the M_elementalGradientMatrixPtr.
-      But for the sake of clarity, I prefer to keep it. (low cost!)
-
-      BEWARE : same remarks as grad (see above).
-    */
-    AssemblyElemental::div ( 0, -dSdU, *M_elementalDivergenceMatrixPtr, M_feSpacePtr->fe(), M_feSpacePtr->fe(), 0, 0 );
-    //    std::cout << "Elem Div matrix :" << std::endl;
-    //    M_elementalDivergenceMatrixPtr->showMe( std::cout );
-}
-
-void
-OneDFSISolver::matrixAssemble ( const UInt& ii, const UInt& jj )
-{
-    // Assemble the mass matrix
-    assembleMatrix ( *M_dSdUMassMatrixPtr[ 2 * ii + jj ], *M_elementalMassMatrixPtr, M_feSpacePtr->fe(), M_feSpacePtr->dof(), 0, 0, 0, 0 );
-
-    // Assemble the stiffness matrix
-    assembleMatrix ( *M_dFdUStiffnessMatrixPtr[ 2 * ii + jj ], *M_elementalStiffnessMatrixPtr, M_feSpacePtr->fe(), M_feSpacePtr->dof(), 0, 0, 0, 0 );
-
-    // Assemble the gradient matrix
-    assembleMatrix ( *M_dFdUGradientMatrixPtr[ 2 * ii + jj ], *M_elementalGradientMatrixPtr, M_feSpacePtr->fe(), M_feSpacePtr->dof(), 0, 0, 0, 0 );
-
-    // Assemble the divergence matrix
-    assembleMatrix ( *M_dSdUDivergenceMatrixPtr[ 2 * ii + jj ], *M_elementalDivergenceMatrixPtr, M_feSpacePtr->fe(), M_feSpacePtr->dof(), 0, 0, 0, 0 );
-}
-
 void
 OneDFSISolver::applyDirichletBCToMatrix ( matrix_Type& matrix )
 {
@@ -928,7 +872,6 @@ OneDFSISolver::inertialFlowRateCorrection ( const vector_Type& flux )
 
     vector_Type sol ( rhs);
 
-    M_linearSolverPtr->setMatrix ( matrixLHS );
     //@int numIter = M_linearSolverPtr->solveSystem( _rhs, _sol, _matrixLHS, true);
 
     //std::cout <<" iterations number :  " << numIter << std::endl;
@@ -63,6 +63,7 @@
 
 #include <lifev/one_d_fsi/fem/OneDFSIBCHandler.hpp>
 #include <lifev/one_d_fsi/solver/OneDFSIDefinitions.hpp>
+#include <lifev/one_d_fsi/solver/OneDFSITridiagonalMatrix.hpp>
 
 
 namespace LifeV
@@ -138,13 +139,15 @@ namespace LifeV
  *  <b>DEVELOPMENT NOTES:</b> <BR>
  *  The option taken here is to define the different tridiagonal matrix
  *  operators (div, grad, mass, stiff) and reconstruct them at each time
- *  step (as they depend on diffFlux and diffSrc). They are thus rebuilt
- *  at the element level and reassembled.
+ *  step (as they depend on diffFlux and diffSrc).
+ *  The operators are stored in banded form (see OneDFSITridiagonalMatrix), allocated once
+ *  in \c buildConstantMatrices(), and refilled in place at each time step with the
+ *  closed-form P1 elemental coefficients (exact for P1Seg elements and canonical numbering).
  *  Afterwards, there remains to do only some tridiagonal matrix vector
- *  products to obtain the right hand side. This procedure might appear a bit memory consuming (there are 18
- *  tridiagonal matrices stored), but it has the advantage of being
- *  very clear. If it is too costly, it should be quite easy to improve
- *  it.
+ *  products to obtain the right hand side, and the mass system is solved with the
+ *  Thomas algorithm, factorized once.
+ *  The mass matrix is still assembled as a \c MatrixEpetra (see \c massMatrix()) and set
+ *  in the linear solver, as required by the coupling and by the viscoelastic correction.
  */
 class OneDFSISolver
 {
@@ -186,6 +189,9 @@ public:
     typedef boost::shared_ptr<matrix_Type>          matrixPtr_Type;
     typedef boost::array<matrixPtr_Type, 4 >        matrixPtrContainer_Type;
 
+    typedef OneDFSITridiagonalMatrix                tridiagonalMatrix_Type;
+    typedef boost::array<tridiagonalMatrix_Type, 4> tridiagonalMatrixContainer_Type;
+
     typedef std::map< std::string, vectorPtr_Type > solution_Type;
     typedef boost::shared_ptr< solution_Type >      solutionPtr_Type;
     typedef solution_Type::const_iterator           solutionConstIterator_Type;
@@ -507,29 +513,17 @@ private:
     /*!
      *  \cond \TODO improve doxygen description with latex equation, input/output parameter, etc... \endcond
      *
-     *  M_massMatrixDiffSrcij, M_stiffMatrixDiffFluxij
-     *  M_gradMatrixDiffFluxij, and M_divMatrixDiffSrcij (i,j=1,2)
+     *  M_dSdUMassMatrix, M_dFdUStiffnessMatrix
+     *  M_dFdUGradientMatrix, and M_dSdUDivergenceMatrix (i,j=1,2)
      *
      *  from the values of diffFlux(Un) and diffSrc(Un)
-     *  that are computed with _updateMatrixCoefficients.
+     *  that are computed with updatedFdU and updatedSdU.
      *
-     *  call of  _updateMatrixCoefficients,
-     *  _updateMatrixElementalrices and _assemble_matrices.
+     *  The tridiagonal storage is reused: the coefficients are overwritten in place
+     *  with the closed-form P1 elemental matrices (works only for P1Seg elements and canonical numbering).
      */
     void updateMatrices();
 
-    //! Update the element matrices with the current element
-    /*!
-     * \cond \TODO improve doxygen description with latex equation, input/output parameter, etc... \endcond
-     */
-    void updateElementalMatrices ( const Real& dFdU, const Real& dSdU );
-
-    //! Assemble the matrices
-    /*!
-     * \cond \TODO improve doxygen description with latex equation, input/output parameter, etc... \endcond
-     */
-    void matrixAssemble ( const UInt& ii, const UInt& jj );
-
     //! Update the matrices to take into account Dirichlet BC.
     /*!
      *  \cond \TODO improve doxygen description with latex equation, input/output parameter, etc... \endcond
@@ -578,8 +572,6 @@ private:
 
     boost::shared_ptr< MatrixElemental > M_elementalMassMatrixPtr;       //!< element mass matrix
     boost::shared_ptr< MatrixElemental > M_elementalStiffnessMatrixPtr;  //!< element stiffness matrix
-    boost::shared_ptr< MatrixElemental > M_elementalGradientMatrixPtr;   //!< element gradient matrix
-    boost::shared_ptr< MatrixElemental > M_elementalDivergenceMatrixPtr; //!< element divergence matrix
 
     //! Right hand sides of the linear system i: "mass * M_Ui = M_rhsi"
     vectorPtrContainer_Type            M_rhs;
@@ -599,23 +591,32 @@ private:
     //! diffSrc = dSource(U)/dU (in P0)
     scalarVectorContainer_Type         M_dSdUVector;
 
-    //! tridiagonal mass matrix
+    //! mass matrix (without BC) for the coupling and the viscoelastic correction
     matrixPtr_Type                     M_homogeneousMassMatrixPtr;
 
+    //! length of the elements
+    std::vector< Real >                M_elementLength;
+
+    //! tridiagonal mass matrix
+    tridiagonalMatrix_Type             M_homogeneousMassMatrix;
+
     //! tridiagonal gradient matrix
-    matrixPtr_Type                     M_homogeneousGradientMatrixPtr;
+    tridiagonalMatrix_Type             M_homogeneousGradientMatrix;
+
+    //! tridiagonal mass matrix with Dirichlet BC (factorized)
+    tridiagonalMatrix_Type             M_systemMatrix;
 
     //! tridiagonal mass matrices multiplied by diffSrcij
-    matrixPtrContainer_Type            M_dSdUMassMatrixPtr;
+    tridiagonalMatrixContainer_Type    M_dSdUMassMatrix;
 
     //! tridiagonal stiffness matrices multiplied by diffFluxij
-    matrixPtrContainer_Type            M_dFdUStiffnessMatrixPtr;
+    tridiagonalMatrixContainer_Type    M_dFdUStiffnessMatrix;
 
     //! tridiagonal gradient matrices multiplied by diffFluxij
-    matrixPtrContainer_Type            M_dFdUGradientMatrixPtr;
+    tridiagonalMatrixContainer_Type    M_dFdUGradientMatrix;
 
     //! tridiagonal divergence matrices multiplied by diffSrcij
-    matrixPtrContainer_Type            M_dSdUDivergenceMatrixPtr;
+    tridiagonalMatrixContainer_Type    M_dSdUDivergenceMatrix;
 
     //! The linear solver
     linearSolverPtr_Type               M_linearSolverPtr;
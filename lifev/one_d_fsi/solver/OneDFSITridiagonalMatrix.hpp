@@ -0,0 +1,354 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+ *  @file
+ *  @brief File containing a tridiagonal matrix class for the operators of the 1D model.
+ *
+ *  @date 10-2026
+ */
+
+#ifndef OneDFSITridiagonalMatrix_H
+#define OneDFSITridiagonalMatrix_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <lifev/core/LifeV.hpp>
+
+namespace LifeV
+{
+
+//! OneDFSITridiagonalMatrix - Tridiagonal matrix for the P1 operators of the 1D model.
+/*!
+ *  On a 1D mesh with canonical numbering (the vertices of the element \f$i\f$ are the nodes \f$i\f$ and \f$i+1\f$)
+ *  all the P1 operators (mass, stiffness, gradient, divergence) are tridiagonal.
+ *  This class stores the three diagonals in contiguous arrays, which are allocated once by \c resize()
+ *  and then refilled in place, element by element, with \c addElementalMatrix() or with the closed-form
+ *  P1 elemental operators (\c addMass(), \c addStiffness(), \c addGradient(), \c addDivergence()).
+ *
+ *  The matrix can be factorized with the Thomas algorithm (LU without pivoting), which is stable
+ *  for the diagonally dominant matrices of the 1D model (mass matrices, possibly with Dirichlet rows).
+ *
+ *  The vector methods are templates: any vector with an \c operator[] indexed by the node ID
+ *  (e.g., \c VectorEpetra on a non distributed map or a ublas vector) can be used.
+ */
+class OneDFSITridiagonalMatrix
+{
+public:
+
+    //! @name Type definitions
+    //@{
+
+    typedef std::vector< Real >                   container_Type;
+
+    //@}
+
+
+    //! @name Constructors & Destructor
+    //@{
+
+    //! Constructor
+    /*!
+     * @param size number of rows of the matrix
+     */
+    explicit OneDFSITridiagonalMatrix ( const UInt& size = 0 ) :
+        M_lower            ( size, 0. ),
+        M_diagonal         ( size, 0. ),
+        M_upper            ( size, 0. ),
+        M_factorizedUpper  (),
+        M_inversePivot     ()
+    {}
+
+    //! Destructor
+    virtual ~OneDFSITridiagonalMatrix() {}
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! Resize the matrix and set all the coefficients to zero
+    /*!
+     * @param size number of rows of the matrix
+     */
+    void resize ( const UInt& size )
+    {
+        M_lower.assign ( size, 0. );
+        M_diagonal.assign ( size, 0. );
+        M_upper.assign ( size, 0. );
+        M_factorizedUpper.clear();
+        M_inversePivot.clear();
+    }
+
+    //! Set all the coefficients to zero (without reallocating)
+    void zero()
+    {
+        std::fill ( M_lower.begin(), M_lower.end(), 0. );
+        std::fill ( M_diagonal.begin(), M_diagonal.end(), 0. );
+        std::fill ( M_upper.begin(), M_upper.end(), 0. );
+    }
+
+    //! Add the 2x2 elemental matrix of the element between the nodes iElement and iElement + 1
+    /*!
+     * @param iElement ID of the element
+     * @param a00 coefficient (iElement, iElement)
+     * @param a01 coefficient (iElement, iElement + 1)
+     * @param a10 coefficient (iElement + 1, iElement)
+     * @param a11 coefficient (iElement + 1, iElement + 1)
+     */
+    void addElementalMatrix ( const UInt& iElement, const Real& a00, const Real& a01, const Real& a10, const Real& a11 )
+    {
+        M_diagonal[iElement]     += a00;
+        M_upper[iElement]        += a01;
+        M_lower[iElement + 1]    += a10;
+        M_diagonal[iElement + 1] += a11;
+    }
+
+    //! Add the P1 mass matrix of an element, multiplied by a coefficient
+    /*!
+     * Mass operator: \f$ mass_{ij} = \int_{fe} coeff \phi_j \phi_i \f$
+     * @param iElement ID of the element
+     * @param elementLength signed length of the element (coordinate of the node iElement + 1 minus the one of the node iElement)
+     * @param coefficient coefficient of the operator on the element
+     */
+    void addMass ( const UInt& iElement, const Real& elementLength, const Real& coefficient )
+    {
+        // coeff * h / 6 * [ 2 1; 1 2 ]
+        const Real value ( coefficient * std::fabs ( elementLength ) / 6. );
+
+        addElementalMatrix ( iElement, 2 * value, value, value, 2 * value );
+    }
+
+    //! Add the P1 stiffness matrix of an element, multiplied by a coefficient
+    /*!
+     * Stiffness operator: \f$ stiff_{ij} = \int_{fe} coeff \frac{d \phi_j}{d x} \frac{d \phi_i}{d x} \f$
+     * @param iElement ID of the element
+     * @param elementLength signed length of the element
+     * @param coefficient coefficient of the operator on the element
+     */
+    void addStiffness ( const UInt& iElement, const Real& elementLength, const Real& coefficient )
+    {
+        // coeff / h * [ 1 -1; -1 1 ]
+        const Real value ( coefficient / std::fabs ( elementLength ) );
+
+        addElementalMatrix ( iElement, value, -value, -value, value );
+    }
+
+    //! Add the P1 gradient matrix of an element, multiplied by a coefficient
+    /*!
+     * Gradient operator: \f$ grad_{ij} = \int_{fe} coeff \phi_j \frac{d \phi_i}{d x} \f$
+     * @param iElement ID of the element
+     * @param elementLength signed length of the element
+     * @param coefficient coefficient of the operator on the element
+     */
+    void addGradient ( const UInt& iElement, const Real& elementLength, const Real& coefficient )
+    {
+        // coeff / 2 * [ -1 -1; 1 1 ] (for increasing coordinates)
+        const Real value ( elementLength > 0 ? 0.5 * coefficient : -0.5 * coefficient );
+
+        addElementalMatrix ( iElement, -value, -value, value, value );
+    }
+
+    //! Add the P1 divergence matrix of an element, multiplied by a coefficient
+    /*!
+     * Divergence operator (transpose of the gradient): \f$ div_{ij} = \int_{fe} coeff \frac{d \phi_j}{d x} \phi_i \f$
+     * @param iElement ID of the element
+     * @param elementLength signed length of the element
+     * @param coefficient coefficient of the operator on the element
+     */
+    void addDivergence ( const UInt& iElement, const Real& elementLength, const Real& coefficient )
+    {
+        // coeff / 2 * [ -1 1; -1 1 ] (for increasing coordinates)
+        const Real value ( elementLength > 0 ? 0.5 * coefficient : -0.5 * coefficient );
+
+        addElementalMatrix ( iElement, -value, value, -value, value );
+    }
+
+    //! Set the row to zero and its diagonal coefficient to a given value
+    /*!
+     * @param row ID of the row
+     * @param coefficient value of the diagonal coefficient
+     */
+    void diagonalize ( const UInt& row, const Real& coefficient = 1. )
+    {
+        M_lower[row]    = 0.;
+        M_diagonal[row] = coefficient;
+        M_upper[row]    = 0.;
+    }
+
+    //! Compute y = y + alpha * A * x
+    /*!
+     * @param alpha scaling coefficient
+     * @param x input vector
+     * @param y output vector
+     */
+    template< typename InputVectorType, typename OutputVectorType >
+    void multiplyAdd ( const Real& alpha, const InputVectorType& x, OutputVectorType& y ) const
+    {
+        const UInt size ( M_diagonal.size() );
+        if ( size == 0 )
+        {
+            return;
+        }
+        if ( size == 1 )
+        {
+            y[0] += alpha * M_diagonal[0] * x[0];
+            return;
+        }
+
+        Real xPrevious ( x[0] );
+        Real xCurrent  ( x[0] );
+        Real xNext     ( x[1] );
+
+        y[0] += alpha * ( M_diagonal[0] * xCurrent + M_upper[0] * xNext );
+        for ( UInt i (1); i < size - 1; ++i )
+        {
+            xPrevious = xCurrent;
+            xCurrent  = xNext;
+            xNext     = x[i + 1];
+
+            y[i] += alpha * ( M_lower[i] * xPrevious + M_diagonal[i] * xCurrent + M_upper[i] * xNext );
+        }
+        y[size - 1] += alpha * ( M_lower[size - 1] * xCurrent + M_diagonal[size - 1] * xNext );
+    }
+
+    //! Compute the LU factorization (Thomas algorithm)
+    /*!
+     * The factorization is stored separately from the coefficients,
+     * so that the matrix can still be used for products.
+     */
+    void factorize()
+    {
+        const UInt size ( M_diagonal.size() );
+
+        M_factorizedUpper.resize ( size );
+        M_inversePivot.resize ( size );
+
+        Real pivot;
+        for ( UInt i (0); i < size; ++i )
+        {
+            pivot = M_diagonal[i] - ( i > 0 ? M_lower[i] * M_factorizedUpper[i - 1] : 0. );
+
+            ASSERT ( pivot != 0., "OneDFSITridiagonalMatrix::factorize: zero pivot" );
+
+            M_inversePivot[i]    = 1. / pivot;
+            M_factorizedUpper[i] = M_upper[i] * M_inversePivot[i];
+        }
+    }
+
+    //! Solve the linear system using the factorization computed by \c factorize()
+    /*!
+     * @param vector right hand side on input, solution on output
+     */
+    template< typename VectorType >
+    void solve ( VectorType& vector ) const
+    {
+        ASSERT ( M_inversePivot.size() == M_diagonal.size(), "OneDFSITridiagonalMatrix::solve: the matrix is not factorized" );
+
+        const UInt size ( M_diagonal.size() );
+        if ( size == 0 )
+        {
+            return;
+        }
+
+        // Forward substitution
+        Real previous ( vector[0] * M_inversePivot[0] );
+        vector[0] = previous;
+        for ( UInt i (1); i < size; ++i )
+        {
+            previous  = ( vector[i] - M_lower[i] * previous ) * M_inversePivot[i];
+            vector[i] = previous;
+        }
+
+        // Backward substitution
+        for ( UInt i ( size - 1 ); i > 0; --i )
+        {
+            previous      = vector[i - 1] - M_factorizedUpper[i - 1] * previous;
+            vector[i - 1] = previous;
+        }
+    }
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! Get the number of rows
+    /*!
+     * @return number of rows of the matrix
+     */
+    UInt size() const
+    {
+        return M_diagonal.size();
+    }
+
+    //! Get the lower diagonal: lower()[i] is the coefficient (i, i-1)
+    /*!
+     * @return the lower diagonal
+     */
+    const container_Type& lower() const
+    {
+        return M_lower;
+    }
+
+    //! Get the diagonal
+    /*!
+     * @return the diagonal
+     */
+    const container_Type& diagonal() const
+    {
+        return M_diagonal;
+    }
+
+    //! Get the upper diagonal: upper()[i] is the coefficient (i, i+1)
+    /*!
+     * @return the upper diagonal
+     */
+    const container_Type& upper() const
+    {
+        return M_upper;
+    }
+
+    //@}
+
+private:
+
+    container_Type                     M_lower;
+    container_Type                     M_diagonal;
+    container_Type                     M_upper;
+
+    //! Thomas factorization: normalized upper diagonal and inverse of the pivots
+    container_Type                     M_factorizedUpper;
+    container_Type                     M_inversePivot;
+};
+
+}
+
+#endif // OneDFSITridiagonalMatrix_H
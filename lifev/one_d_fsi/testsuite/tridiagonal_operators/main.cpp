@@ -0,0 +1,286 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+
+/*!
+    @file
+    @brief Tridiagonal operators of the 1D model against the assembled MatrixEpetra
+
+    @date 10-2026
+
+    On a non uniform 1D mesh, the tridiagonal mass, stiffness, gradient and
+    divergence operators (OneDFSITridiagonalMatrix, as filled by OneDFSISolver)
+    are compared with the MatrixEpetra assembled with AssemblyElemental, as the
+    solver did before, with a different coefficient on each element. Then the mass
+    system with Dirichlet rows is solved with the Thomas algorithm and with the
+    linear solver of the 1D model.
+ */
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <cmath>
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/filter/GetPot.hpp>
+#include <lifev/core/array/MatrixEpetra.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+#include <lifev/core/array/MatrixElemental.hpp>
+#include <lifev/core/mesh/RegionMesh.hpp>
+#include <lifev/core/mesh/RegionMesh1DStructured.hpp>
+#include <lifev/core/fem/FESpace.hpp>
+#include <lifev/core/fem/AssemblyElemental.hpp>
+#include <lifev/core/fem/Assembly.hpp>
+#include <lifev/core/algorithm/SolverAmesos.hpp>
+
+#include <lifev/one_d_fsi/solver/OneDFSITridiagonalMatrix.hpp>
+
+using namespace LifeV;
+
+typedef RegionMesh<LinearLine>                mesh_Type;
+typedef FESpace<mesh_Type, MapEpetra>         feSpace_Type;
+typedef boost::shared_ptr<feSpace_Type>       feSpacePtr_Type;
+typedef MatrixEpetra<Real>                    matrix_Type;
+typedef boost::shared_ptr<matrix_Type>        matrixPtr_Type;
+typedef VectorEpetra                          vector_Type;
+typedef OneDFSITridiagonalMatrix              tridiagonalMatrix_Type;
+
+namespace
+{
+
+enum OperatorType { Mass, Stiffness, Gradient, Divergence };
+
+// Coefficient of the operators on an element
+Real coefficient ( const UInt& iElement )
+{
+    return 1. + 0.5 * std::sin ( 1. + iElement );
+}
+
+// Assemble an operator in a MatrixEpetra with AssemblyElemental (see the former OneDFSISolver::updateElementalMatrices)
+void assembleOperator ( const OperatorType& type, feSpace_Type& feSpace, matrix_Type& matrix )
+{
+    MatrixElemental elementalMatrix ( feSpace.fe().nbFEDof(), 1, 1 );
+
+    for ( UInt iElement (0); iElement < feSpace.mesh()->numElements(); ++iElement )
+    {
+        elementalMatrix.zero();
+        feSpace.fe().update ( feSpace.mesh()->edgeList ( iElement ), UPDATE_DPHI | UPDATE_WDET );
+
+        // there is a minus in the AssemblyElemental implementation of grad and div
+        switch ( type )
+        {
+            case Mass:
+                AssemblyElemental::mass ( coefficient ( iElement ), elementalMatrix, feSpace.fe(), 0, 0 );
+                break;
+            case Stiffness:
+                AssemblyElemental::stiff ( coefficient ( iElement ), elementalMatrix, feSpace.fe(), 0, 0 );
+                break;
+            case Gradient:
+                AssemblyElemental::grad ( 0, -coefficient ( iElement ), elementalMatrix, feSpace.fe(), feSpace.fe(), 0, 0 );
+                break;
+            case Divergence:
+                AssemblyElemental::div ( 0, -coefficient ( iElement ), elementalMatrix, feSpace.fe(), feSpace.fe(), 0, 0 );
+                break;
+        }
+
+        assembleMatrix ( matrix, elementalMatrix, feSpace.fe(), feSpace.dof(), 0, 0, 0, 0 );
+    }
+
+    matrix.globalAssemble();
+}
+
+// Fill the same operator in a tridiagonal matrix (see OneDFSISolver::updateMatrices)
+void fillOperator ( const OperatorType& type, const mesh_Type& mesh, tridiagonalMatrix_Type& matrix )
+{
+    matrix.resize ( mesh.numVertices() );
+
+    for ( UInt iElement (0); iElement < mesh.numElements(); ++iElement )
+    {
+        const Real elementLength ( mesh.edgeList ( iElement ).point ( 1 ).x() - mesh.edgeList ( iElement ).point ( 0 ).x() );
+
+        switch ( type )
+        {
+            case Mass:
+                matrix.addMass ( iElement, elementLength, coefficient ( iElement ) );
+                break;
+            case Stiffness:
+                matrix.addStiffness ( iElement, elementLength, coefficient ( iElement ) );
+                break;
+            case Gradient:
+                matrix.addGradient ( iElement, elementLength, coefficient ( iElement ) );
+                break;
+            case Divergence:
+                matrix.addDivergence ( iElement, elementLength, coefficient ( iElement ) );
+                break;
+        }
+    }
+}
+
+// Largest difference between the coefficients of the two matrices, relative to the largest coefficient.
+// The product with the vector which is one on the nodes i = r (mod 3) extracts, on each row,
+// exactly one of the three diagonals: all the coefficients are compared with three products.
+Real operatorDifference ( const matrix_Type& matrix, const tridiagonalMatrix_Type& tridiagonalMatrix, const MapEpetra& map )
+{
+    Real difference (0.), maximum (0.);
+    for ( UInt r (0); r < 3; ++r )
+    {
+        vector_Type pattern ( map, Unique );
+        pattern *= 0.;
+        for ( UInt i (r); i < tridiagonalMatrix.size(); i += 3 )
+        {
+            pattern[i] = 1.;
+        }
+
+        vector_Type product ( map, Unique );
+        matrix.multiply ( false, pattern, product );
+
+        vector_Type tridiagonalProduct ( map, Unique );
+        tridiagonalProduct *= 0.;
+        tridiagonalMatrix.multiplyAdd ( 1., pattern, tridiagonalProduct );
+
+        for ( UInt i (0); i < tridiagonalMatrix.size(); ++i )
+        {
+            difference = std::max ( difference, std::abs ( product[i] - tridiagonalProduct[i] ) );
+            maximum    = std::max ( maximum, std::abs ( product[i] ) );
+        }
+    }
+    return difference / maximum;
+}
+
+}
+
+int main ( int argc, char** argv )
+{
+#ifdef HAVE_MPI
+    MPI_Init ( &argc, &argv );
+#endif
+
+    bool success (true);
+
+    // this brace is important to destroy the Epetra_Comm object before calling MPI_Finalize
+    {
+#ifdef EPETRA_MPI
+        boost::shared_ptr<Epetra_Comm> comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+#else
+        boost::shared_ptr<Epetra_Comm> comm ( new Epetra_SerialComm() );
+#endif
+
+        GetPot command_line ( argc, argv );
+        const std::string dataFileName = command_line.follow ( "data", 2, "-f", "--file" );
+        GetPot dataFile ( dataFileName );
+
+        // The 1D model is not distributed
+        ASSERT ( comm->NumProc() == 1, "The 1D model runs on one process" );
+
+        // Non uniform mesh with canonical numbering, as in OneDFSIData
+        const Real length = dataFile ( "space_discretization/Length", 2. );
+        const UInt numberOfElements = dataFile ( "space_discretization/NumberOfElements", 25 );
+
+        boost::shared_ptr<mesh_Type> meshPtr ( new mesh_Type ( comm ) );
+        regularMesh1D ( *meshPtr, 1, numberOfElements, false, length, 0 );
+
+        const Real h ( length / numberOfElements );
+        for ( UInt i (1); i < meshPtr->numVertices() - 1; ++i )
+        {
+            meshPtr->point ( i ).x() += 0.3 * h * std::sin ( 2. * i );
+        }
+
+        feSpacePtr_Type feSpacePtr ( new feSpace_Type ( meshPtr, feSegP1, quadRuleSeg3pt, quadRuleSeg1pt, 1, comm ) );
+        const MapEpetra& map ( feSpacePtr->map() );
+
+        // Operators
+        const std::string names[4] = { "mass", "stiffness", "gradient", "divergence" };
+        const OperatorType types[4] = { Mass, Stiffness, Gradient, Divergence };
+
+        for ( UInt iOperator (0); iOperator < 4; ++iOperator )
+        {
+            matrix_Type matrix ( map );
+            assembleOperator ( types[iOperator], *feSpacePtr, matrix );
+
+            tridiagonalMatrix_Type tridiagonalMatrix;
+            fillOperator ( types[iOperator], *meshPtr, tridiagonalMatrix );
+
+            const Real difference ( operatorDifference ( matrix, tridiagonalMatrix, map ) );
+            std::cout << "Relative difference of the " << names[iOperator] << " operator: " << difference << std::endl;
+
+            success = success && difference < 1.e-13;
+        }
+
+        // Mass system with Dirichlet rows (see OneDFSISolver::buildConstantMatrices)
+        matrix_Type systemMatrix ( map );
+        assembleOperator ( Mass, *feSpacePtr, systemMatrix );
+        systemMatrix.diagonalize ( 0, 1, 0 );
+        systemMatrix.diagonalize ( meshPtr->numVertices() - 1, 1, 0 );
+
+        tridiagonalMatrix_Type tridiagonalSystemMatrix;
+        fillOperator ( Mass, *meshPtr, tridiagonalSystemMatrix );
+        tridiagonalSystemMatrix.diagonalize ( 0 );
+        tridiagonalSystemMatrix.diagonalize ( meshPtr->numVertices() - 1 );
+        tridiagonalSystemMatrix.factorize();
+
+        vector_Type rhs ( map, Unique );
+        for ( UInt i (0); i < meshPtr->numVertices(); ++i )
+        {
+            rhs[i] = std::cos ( 3. * meshPtr->point ( i ).x() ) + 0.1 * i;
+        }
+
+        SolverAmesos linearSolver ( comm );
+        linearSolver.setDataFromGetPot ( dataFile, "solver" );
+        linearSolver.setParameter ( "Verbose", false );
+        linearSolver.setParameters();
+        linearSolver.setMatrix ( systemMatrix );
+
+        vector_Type solution ( map, Unique );
+        linearSolver.solveSystem ( rhs, solution, matrixPtr_Type() );
+
+        vector_Type thomasSolution ( rhs );
+        tridiagonalSystemMatrix.solve ( thomasSolution );
+
+        Real difference (0.);
+        for ( UInt i (0); i < meshPtr->numVertices(); ++i )
+        {
+            difference = std::max ( difference, std::abs ( thomasSolution[i] - solution[i] ) );
+        }
+        difference /= solution.normInf();
+        std::cout << "Relative difference of the Thomas solution: " << difference << std::endl;
+
+        success = success && difference < 1.e-12;
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    if ( !success )
+    {
+        std::cout << "Test Failed!" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
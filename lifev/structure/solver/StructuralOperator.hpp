@@ -984,11 +984,11 @@ void StructuralOperator<Mesh>::setupMapMarkersVolumes ( void )
     for (  UInt i (0); i < M_data->vectorFlags().size(); i++ )
     {
 
-        //Create the functor to extract volumes
-        markerSelectorPtr_Type ref ( new markerSelector_Type (M_data->vectorFlags() [i]) );
+        //Indexes of the volumes with the current marker, cached in the mesh
+        const vectorIndexes_Type& markerIndexes = this->M_dispFESpace->mesh()->elementsWithMarker ( M_data->vectorFlags() [i] );
 
         //Number of volumes with the current marker
-        UInt numExtractedVolumes = this->M_dispFESpace->mesh()->elementList().countAccordingToPredicate ( *ref );
+        UInt numExtractedVolumes = markerIndexes.size();
 
         this->M_Displayer->leaderPrint (" Current marker: ", M_data->vectorFlags() [i]);
         this->M_Displayer->leaderPrint (" \n");
@@ -997,10 +997,13 @@ void StructuralOperator<Mesh>::setupMapMarkersVolumes ( void )
 
         //Vector large enough to contain the number of volumes with the current marker
         vectorVolumes_Type extractedVolumes ( numExtractedVolumes );
-        vectorIndexes_Type extractedIndexes;
+        vectorIndexes_Type extractedIndexes ( markerIndexes );
 
-        //Extracting the volumes and the corresponding position
-        extractedVolumes = this->M_dispFESpace->mesh()->elementList().extractAccordingToPredicateNonConstElement ( *ref, extractedIndexes );
+        //Extracting the volumes
+        for ( UInt j (0); j < numExtractedVolumes; j++ )
+        {
+            extractedVolumes[j] = &this->M_dispFESpace->mesh()->element ( extractedIndexes[j] );
+        }
 
         //Insert the correspondande Marker <--> List of Volumes inside the map
         M_mapMarkersVolumes->insert ( std::pair<UInt, vectorVolumes_Type> (M_data->vectorFlags() [i], extractedVolumes) ) ;